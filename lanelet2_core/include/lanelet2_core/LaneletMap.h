@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <unordered_map>
 #include "lanelet2_core/Forward.h"
 #include "lanelet2_core/primitives/Area.h"
@@ -21,6 +24,38 @@ struct SearchBox<Point3d> {
 template <typename T>
 using SearchBoxT = typename SearchBox<T>::Type;
 }  // namespace internal
+
+/**
+ * @brief A view on the primitives of a layer that use a certain primitive, as returned by PrimitiveLayer::usages
+ *
+ * If the layer has a usage index (see PrimitiveLayer::buildUsageIndex), the view refers directly to the memory of the
+ * index and nothing is allocated. In this case it is only valid until the layer is modified or destroyed. Otherwise the
+ * view holds a copy of the usages.
+ */
+template <typename T>
+class UsageRange {
+ public:
+  using ConstPrimitiveT = traits::ConstPrimitiveType<T>;
+  using const_iterator = internal::TransformIterator<const T*, const ConstPrimitiveT>;  // NOLINT
+
+  UsageRange() = default;
+  UsageRange(const T* begin, const T* end) : begin_{begin}, end_{end} {}
+  explicit UsageRange(std::vector<T> usages)
+      : copy_{std::make_shared<const std::vector<T>>(std::move(usages))},
+        begin_{copy_->data()},
+        end_{copy_->data() + copy_->size()} {}
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+  size_t size() const { return size_t(end_ - begin_); }
+  bool empty() const { return begin_ == end_; }
+  const ConstPrimitiveT& operator[](size_t idx) const { return begin()[idx]; }
+
+ private:
+  std::shared_ptr<const std::vector<T>> copy_;
+  const T* begin_{nullptr};
+  const T* end_{nullptr};
+};
    /**
     * @brief Each primitive in lanelet2 has its own layer in the map.
     *
@@ -33,6 +68,10 @@ using SearchBoxT = typename SearchBox<T>::Type;
     *
     * Internally, the elements are identified by their id, therefore it is
     * absolutely important that an id is unique within one layer.
+    *
+    * The elements and the search trees of a layer can be shared between
+    * several maps (see LaneletMap::shallowCopy). They are copied as soon as
+    * one of the maps modifies the layer.
     */
 template <typename T>
 class PrimitiveLayer {
@@ -53,7 +92,6 @@ class PrimitiveLayer {
   using const_iterator =  // NOLINT
       internal::TransformIterator<typename Map::const_iterator, const ConstPrimitiveT,
                                   internal::PairConverter<const ConstPrimitiveT>>;
-  PrimitiveLayer(const PrimitiveLayer& rhs) = delete;
   PrimitiveLayer& operator=(const PrimitiveLayer& rhs) = delete;
 
   /**
@@ -108,6 +146,29 @@ class PrimitiveLayer {
    */
   std::vector<PrimitiveT> findUsages(const traits::ConstPrimitiveType<traits::OwnedT<PrimitiveT>>& primitive);
 
+  /**
+   * @brief returns a view on the usages of an owned primitive within this layer
+   *
+   * Same as findUsages, but does not allocate memory if the layer has a usage index. The view must not be used after
+   * the layer was modified.
+   */
+  UsageRange<PrimitiveT> usages(const traits::ConstPrimitiveType<traits::OwnedT<PrimitiveT>>& primitive) const;
+
+  /**
+   * @brief replaces the hash maps behind findUsages and usages by a compact, sorted index
+   *
+   * The hash maps need one node per usage, which amounts to a lot of small allocations on large maps. The index stores
+   * all usages of a primitive next to each other in a single array (compressed sparse rows) and is searched by id.
+   * This is intended for maps that are no longer modified, e.g. after loading or for snapshots of LaneletMapVersions.
+   *
+   * Modifying the layer afterwards is still possible, the hash maps are then rebuilt and the index is dropped.
+   * The layer of points does not have usages, calling this on it has no effect.
+   */
+  void buildUsageIndex();
+
+  //! returns true if buildUsageIndex has been called and the layer was not modified since
+  bool hasUsageIndex() const;
+
   /**
    * @brief iterator to beginning of the elements (not ordered by id!)
    * @return the iterator
@@ -143,13 +204,13 @@ class PrimitiveLayer {
    * @brief returns whether this layer contains something
    * @return true if no elements
    */
-  bool empty() const { return elements_.empty(); }
+  bool empty() const { return elements_->empty(); }
 
   /**
    * @brief returns number of elements in this layer
    * @return number of elements
    */
-  size_t size() const { return elements_.size(); }
+  size_t size() const { return elements_->size(); }
 
   using ConstSearchFunction = std::function<bool(const internal::SearchBoxT<T>& box, const ConstPrimitiveT& prim)>;
   using SearchFunction = std::function<bool(const internal::SearchBoxT<T>& box, const PrimitiveT& prim)>;
@@ -222,6 +283,38 @@ class PrimitiveLayer {
     return nearestUntil(point.basicPoint2d(), func);
   }
 
+  /**
+   * @brief builds a secondary R-Tree that indexes the individual boundary segments of the primitives in this layer
+   *
+   * The index stores every segment together with the primitive it belongs to and the index of the segment within the
+   * primitive. Once built, it is updated whenever elements are added to the layer and is used by
+   * lanelet::geometry::findNearest and lanelet::geometry::findNearestOnBoundary to compute exact distances without
+   * visiting every primitive whose (possibly huge) bounding box is close to the query point.
+   *
+   * For lanelets the segments are those of the lanelet polygon, for areas those of the outer and inner bounds.
+   * Points and regulatory elements do not have segments, calling this on their layer has no effect.
+   */
+  void buildSegmentIndex();
+
+  //! returns true if buildSegmentIndex has been called and the layer supports segments
+  bool hasSegmentIndex() const;
+
+  using ConstSegmentSearchFunction =
+      std::function<bool(const BasicSegment2d& segment, size_t segmentIdx, const ConstPrimitiveT& prim)>;
+  using SegmentSearchFunction =
+      std::function<bool(const BasicSegment2d& segment, size_t segmentIdx, const PrimitiveT& prim)>;
+
+  /**
+   * @brief repeatedly calls a user-defined predicate with segments of increasing distance until it returns true.
+   * @return the primitive owning the segment for which func returned true. If it was never true or there is no
+   * segment index (see buildSegmentIndex), an empty Optional is returned.
+   *
+   * Other than nearestUntil, the order is determined by the exact distance of the segments to the point, not by the
+   * distance of bounding boxes. A primitive is usually passed to func several times, once for each of its segments.
+   */
+  OptConstPrimitiveT nearestSegmentUntil(const BasicPoint2d& point, const ConstSegmentSearchFunction& func) const;
+  OptPrimitiveT nearestSegmentUntil(const BasicPoint2d& point, const SegmentSearchFunction& func);
+
   /**
    * @brief returns a unique id. it is guaranteed that the id is not used within
    * this layer
@@ -237,18 +330,27 @@ class PrimitiveLayer {
   friend class LaneletMapLayers;
   friend class LaneletSubmap;
   explicit PrimitiveLayer(const Map& primitives = Map());
+  //! Creates a layer that shares its elements and trees with rhs until one of them is modified
+  PrimitiveLayer(const PrimitiveLayer& rhs);
   PrimitiveLayer(PrimitiveLayer&& rhs) noexcept;
   PrimitiveLayer& operator=(PrimitiveLayer&& rhs) noexcept;
   ~PrimitiveLayer() noexcept;
 
   void add(const PrimitiveT& element);
+  //! Removes an element from the layer and its lookups. Does nothing if it does not exist.
   void remove(Id element);
 
+  //! Makes sure elements and trees are not shared with another layer. Must be called before modifying them.
+  void detach();
+
+  //! Detaches the layer and switches back from the usage index to the hash maps. Called before adding or removing.
+  void prepareModification();
+
   // NOLINTNEXTLINE
-  Map elements_;  //!< the list of elements in this layer
+  std::shared_ptr<Map> elements_;  //!< the list of elements in this layer
   struct Tree;
   // NOLINTNEXTLINE
-  std::unique_ptr<Tree> tree_;  //!< Hides boost trees from you/the compiler
+  std::shared_ptr<Tree> tree_;  //!< Hides boost trees from you/the compiler
 };
 
 // we need this ifndef for LaneletMap.cpp
@@ -265,18 +367,20 @@ extern template class PrimitiveLayer<RegulatoryElementPtr>;
 class AreaLayer : public PrimitiveLayer<Area> {
  public:
   using PrimitiveLayer::findUsages;
+  using PrimitiveLayer::usages;
   AreaLayer() = default;
   ~AreaLayer() = default;
-  AreaLayer(const AreaLayer&) = delete;
   AreaLayer operator=(AreaLayer&) = delete;
   Areas findUsages(const RegulatoryElementConstPtr& regElem);
   ConstAreas findUsages(const RegulatoryElementConstPtr& regElem) const;
+  UsageRange<Area> usages(const RegulatoryElementConstPtr& regElem) const;
 
  private:
   friend class LaneletMap;
   friend class LaneletMapLayers;
   friend class LaneletSubmap;
   using PrimitiveLayer<Area>::PrimitiveLayer;
+  AreaLayer(const AreaLayer& rhs) = default;
   AreaLayer(AreaLayer&& rhs) noexcept = default;
   AreaLayer& operator=(AreaLayer&& rhs) noexcept = default;
 };
@@ -285,18 +389,20 @@ class AreaLayer : public PrimitiveLayer<Area> {
 class LaneletLayer : public PrimitiveLayer<Lanelet> {
  public:
   using PrimitiveLayer::findUsages;
+  using PrimitiveLayer::usages;
   LaneletLayer() = default;
   ~LaneletLayer() = default;
-  LaneletLayer(const LaneletLayer&) = delete;
   LaneletLayer operator=(LaneletLayer&) = delete;
   Lanelets findUsages(const RegulatoryElementConstPtr& regElem);
   ConstLanelets findUsages(const RegulatoryElementConstPtr& regElem) const;
+  UsageRange<Lanelet> usages(const RegulatoryElementConstPtr& regElem) const;
 
  private:
   friend class LaneletMap;
   friend class LaneletMapLayers;
   friend class LaneletSubmap;
   using PrimitiveLayer<Lanelet>::PrimitiveLayer;
+  LaneletLayer(const LaneletLayer& rhs) = default;
   LaneletLayer(LaneletLayer&& rhs) noexcept = default;
   LaneletLayer& operator=(LaneletLayer&& rhs) noexcept = default;
 };
@@ -314,7 +420,6 @@ class LaneletMapLayers {
   LaneletMapLayers() = default;
   LaneletMapLayers(LaneletMapLayers&& rhs) noexcept = default;
   LaneletMapLayers& operator=(LaneletMapLayers&& rhs) noexcept = default;
-  LaneletMapLayers(const LaneletMapLayers& rhs) = delete;
   LaneletMapLayers& operator=(const LaneletMapLayers& rhs) = delete;
   ~LaneletMapLayers() noexcept = default;
 
@@ -349,12 +454,19 @@ class LaneletMapLayers {
            lineStringLayer.size() + pointLayer.size();
   }
 
+  //! Calls PrimitiveLayer::buildUsageIndex on all layers. Use this once a map is no longer modified.
+  void buildUsageIndex();
+
   LaneletLayer laneletLayer;                      //!< access to the lanelets within this map
   AreaLayer areaLayer;                            //!< access to areas
   RegulatoryElementLayer regulatoryElementLayer;  //!< access to regElems
   PolygonLayer polygonLayer;                      //!< access to the polygons
   LineStringLayer lineStringLayer;                //!< access to the lineStrings
   PointLayer pointLayer;                          //!< access to the points
+
+ protected:
+  //! Shares all layers with rhs, see LaneletMap::shallowCopy
+  LaneletMapLayers(const LaneletMapLayers& rhs) = default;
 };
 
 /**
@@ -363,7 +475,7 @@ class LaneletMapLayers {
  * The map is divided in individual layers, one for each primitive in lanelet2.
  * Each layer offers efficient functions to find elements by its id or spacial
  * position. A LaneletMap can not be copied because maps are unique. You can
- * only std::move them.
+ * only std::move them or create a shallowCopy that shares the layers.
  *
  * A LaneletMap is designed to be *always* self contained. This means it always contains all elements that are used by
  * any element in the map. If you add a Lanelet, all its LineString boundaries, all RegulatoryElements, all things
@@ -374,6 +486,10 @@ class LaneletMapLayers {
 class LaneletMap : public LaneletMapLayers {
  public:
   using LaneletMapLayers::LaneletMapLayers;
+  LaneletMap() = default;
+  LaneletMap(LaneletMap&& rhs) noexcept = default;
+  LaneletMap& operator=(LaneletMap&& rhs) noexcept = default;
+  ~LaneletMap() noexcept = default;
 
   /**
    * @brief adds a lanelet and all the elements it owns to the map
@@ -434,6 +550,75 @@ class LaneletMap : public LaneletMapLayers {
    * sure that the id has not already been for a different element.
    */
   void add(Point3d point);
+
+  /**
+   * @brief replaces the lanelet with the same id by a new one
+   * @throws NoSuchPrimitiveError if there is no lanelet with this id
+   *
+   * Adds everything the new lanelet owns (just like add), but does not remove the elements only the old lanelet used.
+   * Use this to change a lanelet within a shallow copy of a map: Create a new lanelet with the same id and the modified
+   * data and replace the old one. Regulatory elements that reference the old lanelet are not updated.
+   */
+  void replace(Lanelet lanelet);
+
+  //! Same as replace(Lanelet), but for areas
+  void replace(Area area);
+
+  /**
+   * @brief creates a copy of this map that shares the layers and primitives with this map.
+   *
+   * Creating the copy is cheap. A layer of the copy is only duplicated (without its primitives) once the copy adds
+   * or replaces something in this layer, unmodified layers remain shared. The primitives are always shared, therefore
+   * they must not be modified if the other map is still used. Replace them by modified copies instead.
+   *
+   * This is the base for LaneletMapVersions, which publishes new versions of a map while others are still reading it.
+   */
+  LaneletMapUPtr shallowCopy() const;
+
+ private:
+  LaneletMap(const LaneletMap& rhs) = default;
+};
+
+/**
+ * @brief Publishes immutable versions of a LaneletMap for concurrent readers
+ *
+ * Readers obtain the current version with snapshot(). It is a const map that is never modified and stays valid for as
+ * long as the reader holds it, no matter how many updates happen in the meantime. Writers call update() with a function
+ * that modifies a shallow copy of the current version (see LaneletMap::shallowCopy), which is published atomically
+ * once the function returns. Unmodified layers and all unmodified primitives are shared between the versions. The usage
+ * index (see LaneletMapLayers::buildUsageIndex) of every published version is built before it is published.
+ *
+ * snapshot() can be called from any thread at any time. Concurrent calls to update() are serialized. Primitives are
+ * shared between versions, therefore writers must never modify primitives that are already part of the map but
+ * replace them (LaneletMap::replace) by modified copies.
+ */
+class LaneletMapVersions {
+ public:
+  using UpdateFunction = std::function<void(LaneletMap& map)>;
+
+  //! Creates the first version from a map. The map must not be modified through other pointers afterwards. Consider
+  //! calling LaneletMapLayers::buildUsageIndex on it before.
+  explicit LaneletMapVersions(LaneletMapConstPtr map);
+
+  //! Returns the current version of the map
+  LaneletMapConstPtr snapshot() const;
+
+  //! Returns how often a new version has been published. Starts at 0.
+  size_t version() const noexcept { return version_.load(); }
+
+  /**
+   * @brief creates and publishes a new version of the map
+   * @param modify is called with a shallow copy of the current version
+   * @return the new version
+   *
+   * If modify throws, nothing is published and the exception is passed on.
+   */
+  LaneletMapConstPtr update(const UpdateFunction& modify);
+
+ private:
+  LaneletMapConstPtr current_;
+  std::atomic<size_t> version_{0};
+  std::mutex updateMutex_;
 };
 
 /**
@@ -450,6 +635,11 @@ class LaneletMap : public LaneletMapLayers {
 class LaneletSubmap : public LaneletMapLayers {
  public:
   LaneletSubmap() = default;
+  LaneletSubmap(LaneletSubmap&& rhs) noexcept = default;
+  LaneletSubmap& operator=(LaneletSubmap&& rhs) noexcept = default;
+  LaneletSubmap(const LaneletSubmap& rhs) = delete;
+  LaneletSubmap& operator=(const LaneletSubmap& rhs) = delete;
+  ~LaneletSubmap() noexcept = default;
   using LaneletMapLayers::LaneletMapLayers;
 
   //! Constructs a submap from a moved-from LaneletMap
@@ -579,12 +769,43 @@ template <typename PrimT>
 std::vector<std::pair<double, traits::ConstPrimitiveType<PrimT>>> findNearest(const PrimitiveLayer<PrimT>& map,
                                                                               const BasicPoint2d& pt, unsigned count);
 
+//! Closest point on the boundary of a primitive, as returned by findNearestOnBoundary
+template <typename PrimT>
+struct BoundaryProjection {
+  double distance{};            //!< distance in 2d between the query point and projectedPoint
+  BasicPoint2d projectedPoint;  //!< the closest point on the boundary
+  PrimT primitive;              //!< the primitive this boundary belongs to
+  size_t segmentIdx{};          //!< index of the segment that contains projectedPoint
+};
+
+/**
+ * @brief returns the closest points on the boundaries of the n nearest primitives to a point.
+ * @return for each of the count primitives with the closest boundary one result, in ascending distance.
+ *
+ * Other than findNearest, a point inside a lanelet or area does not have distance 0 to it, the distance to its
+ * boundary is reported instead. Boundaries are the linestrings themselves, the polygon of a lanelet and the outer and
+ * inner bounds of an area. The segment index is as in PrimitiveLayer::nearestSegmentUntil.
+ *
+ * This is fast if PrimitiveLayer::buildSegmentIndex was called on the layer, otherwise the primitives are traversed
+ * in order of their bounding box distance. Not available for points and regulatory elements.
+ */
+template <typename PrimT>
+std::vector<BoundaryProjection<PrimT>> findNearestOnBoundary(PrimitiveLayer<PrimT>& map, const BasicPoint2d& pt,
+                                                             unsigned count);
+template <typename PrimT>
+std::vector<BoundaryProjection<traits::ConstPrimitiveType<PrimT>>> findNearestOnBoundary(
+    const PrimitiveLayer<PrimT>& map, const BasicPoint2d& pt, unsigned count);
+
 #ifndef LANELET_LAYER_DEFINITION
 // clang-format off
 // NOLINTNEXTLINE
 #define EXTERN_FIND_NEAREST(PRIM) extern template std::vector<std::pair<double, PRIM>> findNearest(PrimitiveLayer<PRIM>&, const BasicPoint2d&, unsigned)
 // NOLINTNEXTLINE
 #define EXTERN_CONST_FIND_NEAREST(PRIM) extern template std::vector<std::pair<double, traits::ConstPrimitiveType<PRIM>>> findNearest(const PrimitiveLayer<PRIM>&, const BasicPoint2d&, unsigned)
+// NOLINTNEXTLINE
+#define EXTERN_FIND_NEAREST_ON_BOUNDARY(PRIM) extern template std::vector<BoundaryProjection<PRIM>> findNearestOnBoundary(PrimitiveLayer<PRIM>&, const BasicPoint2d&, unsigned)
+// NOLINTNEXTLINE
+#define EXTERN_CONST_FIND_NEAREST_ON_BOUNDARY(PRIM) extern template std::vector<BoundaryProjection<traits::ConstPrimitiveType<PRIM>>> findNearestOnBoundary(const PrimitiveLayer<PRIM>&, const BasicPoint2d&, unsigned)
 // clang-format on
 EXTERN_FIND_NEAREST(Area);
 EXTERN_FIND_NEAREST(Polygon3d);
@@ -598,8 +819,18 @@ EXTERN_CONST_FIND_NEAREST(Lanelet);
 EXTERN_CONST_FIND_NEAREST(LineString3d);
 EXTERN_CONST_FIND_NEAREST(Point3d);
 EXTERN_CONST_FIND_NEAREST(RegulatoryElementPtr);
+EXTERN_FIND_NEAREST_ON_BOUNDARY(Area);
+EXTERN_FIND_NEAREST_ON_BOUNDARY(Polygon3d);
+EXTERN_FIND_NEAREST_ON_BOUNDARY(Lanelet);
+EXTERN_FIND_NEAREST_ON_BOUNDARY(LineString3d);
+EXTERN_CONST_FIND_NEAREST_ON_BOUNDARY(Area);
+EXTERN_CONST_FIND_NEAREST_ON_BOUNDARY(Polygon3d);
+EXTERN_CONST_FIND_NEAREST_ON_BOUNDARY(Lanelet);
+EXTERN_CONST_FIND_NEAREST_ON_BOUNDARY(LineString3d);
 #undef EXTERN_FIND_NEAREST
 #undef EXTERN_CONST_FIND_NEAREST
+#undef EXTERN_FIND_NEAREST_ON_BOUNDARY
+#undef EXTERN_CONST_FIND_NEAREST_ON_BOUNDARY
 #endif
 }  // namespace geometry
 
@@ -7,6 +7,7 @@
 #include "lanelet2_core/geometry/BoundingBox.h"
 #include "lanelet2_core/geometry/GeometryHelper.h"
 #include "lanelet2_core/geometry/Point.h"
+#include "lanelet2_core/primitives/ArcLengthIndex.h"
 #include "lanelet2_core/primitives/CompoundLineString.h"
 #include "lanelet2_core/primitives/LineString.h"
 
@@ -285,6 +286,70 @@ Segment<BasicPoint2d> closestSegment(const BasicLineString2d& lineString, const
  * @returns a new segment that is identical to the closest one on the line string
  */
 Segment<BasicPoint3d> closestSegment(const BasicLineString3d& lineString, const BasicPoint3d& pointToProject);
+
+/**
+ * @brief Projects the given point in 2d to a basic linestring.
+ *
+ * Overload of project for linestrings that store their points contiguously. The closest segment is searched with
+ * SSE2 instructions where the platform has them (all x86-64 CPUs), the result is identical to the generic version.
+ * @throws InvalidInputError if the linestring is empty
+ */
+BasicPoint2d project(const BasicLineString2d& lineString, const BasicPoint2d& pointToProject);
+
+//! Projects the given point in 3d to a basic linestring. See the 2d version for details.
+BasicPoint3d project(const BasicLineString3d& lineString, const BasicPoint3d& pointToProject);
+
+/**
+ * @brief Projects multiple points to a basic linestring at once.
+ * @return the projected points, in the order of pointsToProject
+ * @throws InvalidInputError if the linestring is empty
+ */
+BasicPoints2d project(const BasicLineString2d& lineString, const BasicPoints2d& pointsToProject);
+
+//! Signed distance of a point to a basic linestring. Same result as the generic version, but vectorized.
+double signedDistance(const BasicLineString2d& lineString, const BasicPoint2d& p);
+
+//! Signed distance of a point to a basic linestring in 3d. Same result as the generic version, but vectorized.
+double signedDistance(const BasicLineString3d& lineString, const BasicPoint3d& p);
+
+//! Signed distances of multiple points to a basic linestring, in the order of the points.
+std::vector<double> signedDistance(const BasicLineString2d& lineString, const BasicPoints2d& points);
+
+/**
+ * @brief Transform a point to the coordinates of a basic linestring.
+ *
+ * Vectorized overload of toArcCoordinates. The arc length is computed from the index of the closest segment, so
+ * linestrings containing the same point twice are handled correctly.
+ * @throws InvalidInputError if the linestring is empty
+ */
+ArcCoordinates toArcCoordinates(const BasicLineString2d& lineString, const BasicPoint2d& point);
+
+/**
+ * @brief Transforms multiple points to the coordinates of a basic linestring.
+ *
+ * The accumulated lengths of the linestring are only computed once, which makes this considerably faster than
+ * calling toArcCoordinates for every point.
+ * @throws InvalidInputError if the linestring is empty
+ */
+std::vector<ArcCoordinates> toArcCoordinates(const BasicLineString2d& lineString, const BasicPoints2d& points);
+
+/**
+ * @brief Transform a point to the coordinates of an indexed linestring.
+ *
+ * Uses the accumulated lengths of the index instead of measuring the linestring again.
+ * @throws InvalidInputError if the index is empty
+ */
+ArcCoordinates toArcCoordinates(const ArcLengthIndex2d& index, const BasicPoint2d& point);
+
+//! Transforms multiple points to the coordinates of an indexed linestring
+std::vector<ArcCoordinates> toArcCoordinates(const ArcLengthIndex2d& index, const BasicPoints2d& points);
+
+/**
+ * @brief create a point by moving laterally arcCoords.distance from the point at arcCoords.length of an indexed
+ * linestring. Same as fromArcCoordinates for linestrings, but finds the segment by binary search.
+ * @throws InvalidInputError if the index has less than two points
+ */
+BasicPoint2d fromArcCoordinates(const ArcLengthIndex2d& index, const ArcCoordinates& arcCoords);
 }  // namespace geometry
 }  // namespace lanelet
 
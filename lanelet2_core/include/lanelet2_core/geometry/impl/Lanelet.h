@@ -102,7 +102,7 @@ BasicPoints2d intersectCenterlines2d(const Lanelet1T& lanelet, const Lanelet2T&
   }
   if (distanceOther != nullptr) {
     std::transform(intersections.begin(), intersections.end(), std::back_inserter(*distanceOther),
-                   [&centerline](const auto& elem) { return toArcCoordinates(centerline, elem).length; });
+                   [&otherCenterline](const auto& elem) { return toArcCoordinates(otherCenterline, elem).length; });
   }
   return intersections;
 }
@@ -66,24 +66,32 @@ inline BasicLineString3d invert(const BasicLineString3d& ls) {
   return BasicLineString3d{ls.rbegin(), ls.rend()};
 }
 
+//! Side of a point that is projected onto pSeg2, the corner between the segments pSeg1-pSeg2 and pSeg2-nextSegPoint
+template <typename BasicPointT>
+bool isLeftOfCorner(const BasicPointT& pSeg1, const BasicPointT& pSeg2, const BasicPointT& nextSegPoint,
+                    const BasicPointT& p) {
+  // see stackoverflow.com/questions/10583212
+  bool isLeft = pointIsLeftOf(pSeg1, pSeg2, p);
+  if (isLeft != pointIsLeftOf(pSeg2, nextSegPoint, p) && isLeft == pointIsLeftOf(pSeg1, pSeg2, nextSegPoint)) {
+    return !isLeft;
+  }
+  return isLeft;
+}
+
 template <typename LineStringT, typename BasicPointT>
 bool isLeftOf(const LineStringT& ls, const BasicPointT& p, const helper::ProjectedPoint<BasicPointT>& projectedPoint) {
   BasicPointT pSeg1 = projectedPoint.result->segmentPoint1;
   BasicPointT pSeg2 = projectedPoint.result->segmentPoint2;
   BasicPointT projPoint = projectedPoint.result->projectedPoint;
-  bool isLeft = pointIsLeftOf(pSeg1, pSeg2, p);
   if (pSeg2 == projPoint) {
     auto nextSegPointIt = std::next(findPoint(ls, pSeg2));
     if (nextSegPointIt != ls.end()) {
-      // see stackoverflow.com/questions/10583212
       BasicPointT nextSegPoint;
       boost::geometry::convert(*nextSegPointIt, nextSegPoint);
-      if (isLeft != pointIsLeftOf(pSeg2, nextSegPoint, p) && isLeft == pointIsLeftOf(pSeg1, pSeg2, nextSegPoint)) {
-        return !isLeft;
-      }
+      return isLeftOfCorner(pSeg1, pSeg2, nextSegPoint, p);
     }
   }
-  return isLeft;
+  return pointIsLeftOf(pSeg1, pSeg2, p);
 }
 
 template <typename LineStringT, typename PointT>
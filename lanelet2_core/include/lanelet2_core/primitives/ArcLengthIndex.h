@@ -0,0 +1,111 @@
+#pragma once
+#include <type_traits>
+#include <vector>
+#include "lanelet2_core/primitives/LineString.h"
+
+namespace lanelet {
+
+/**
+ * @brief Immutable lookup table for the arc length along a linestring
+ *
+ * Stores a copy of the points of a linestring together with the accumulated length up to every point. Lookups by arc
+ * length become a binary search instead of a walk over all segments, which pays off as soon as a linestring is queried
+ * more than once.
+ *
+ * The index does not notice if the linestring it was created from is modified afterwards. In this case a new index has
+ * to be created.
+ *
+ * @tparam BasicLineStringT BasicLineString2d or BasicLineString3d. Lengths are measured in this dimension.
+ * @see ArcLengthIndex2d, ArcLengthIndex3d
+ */
+template <typename BasicLineStringT>
+class ArcLengthIndex {
+ public:
+  using LineStringType = BasicLineStringT;
+  using PointType =
+      std::conditional_t<std::is_same<BasicLineStringT, BasicLineString2d>::value, BasicPoint2d, BasicPoint3d>;
+
+  ArcLengthIndex() = default;
+
+  //! Creates the index for a basic linestring
+  explicit ArcLengthIndex(BasicLineStringT lineString);
+
+  /**
+   * @brief Creates the index for any linestring with a matching dimension
+   *
+   * E.g. ConstLineString2d or CompoundLineString2d for an ArcLengthIndex2d. Use utils::to2D to create a 2d index for a
+   * 3d linestring.
+   */
+  template <typename LineStringT,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<LineStringT>, BasicLineStringT>::value>>
+  explicit ArcLengthIndex(const LineStringT& lineString) : ArcLengthIndex(toBasicLineString(lineString)) {}
+
+  //! The points of the indexed linestring
+  const BasicLineStringT& lineString() const noexcept { return lineString_; }
+
+  //! The length from the first point up to each point of the linestring. Has the size of the linestring.
+  const std::vector<double>& accumulatedLengths() const noexcept { return accumulatedLengths_; }
+
+  size_t size() const noexcept { return lineString_.size(); }
+  bool empty() const noexcept { return lineString_.empty(); }
+
+  //! Total length of the linestring
+  double length() const noexcept { return accumulatedLengths_.empty() ? 0. : accumulatedLengths_.back(); }
+
+  //! Length between the points with index from and to, negative if to < from
+  double rangedLength(size_t from, size_t to) const {
+    return accumulatedLengths_.at(to) - accumulatedLengths_.at(from);
+  }
+
+  //! Same as geometry::accumulatedLengthRatios
+  std::vector<double> accumulatedLengthRatios() const;
+
+  /**
+   * @brief Returns the index of the segment at the given distance along the linestring
+   * @return index of the first point of the segment. Distances before the start or after the end are clamped to the
+   * first or last segment.
+   * @throws InvalidInputError if the linestring has less than two points
+   */
+  size_t segmentIndexAtDistance(double dist) const;
+
+  /**
+   * @brief Returns the piecewise linearly interpolated point at the given distance
+   *
+   * Same as geometry::interpolatedPointAtDistance. Negative distances are measured from the end, distances beyond the
+   * linestring return the respective end point.
+   */
+  PointType interpolatedPointAtDistance(double dist) const;
+
+  //! Returns the index of the point closest to the given distance. Negative distances are measured from the end.
+  size_t nearestPointIndexAtDistance(double dist) const;
+
+  /**
+   * @brief Returns the part of the linestring between two distances
+   *
+   * The first and last point are interpolated, all points in between are copied. Distances are clamped to the length of
+   * the linestring, if to <= from only the interpolated point at from is returned.
+   */
+  BasicLineStringT subLineString(double from, double to) const;
+
+ private:
+  template <typename LineStringT>
+  static BasicLineStringT toBasicLineString(const LineStringT& lineString) {
+    BasicLineStringT result;
+    result.reserve(lineString.size());
+    for (const auto& p : lineString) {
+      result.push_back(utils::toBasicPoint(p));
+    }
+    return result;
+  }
+
+  BasicLineStringT lineString_;
+  std::vector<double> accumulatedLengths_;
+};
+
+using ArcLengthIndex2d = ArcLengthIndex<BasicLineString2d>;
+using ArcLengthIndex3d = ArcLengthIndex<BasicLineString3d>;
+using ArcLengthIndex2dConstPtr = std::shared_ptr<const ArcLengthIndex2d>;
+
+extern template class ArcLengthIndex<BasicLineString2d>;
+extern template class ArcLengthIndex<BasicLineString3d>;
+}  // namespace lanelet
@@ -0,0 +1,96 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "lanelet2_core/primitives/ArcLengthIndex.h"
+#include "lanelet2_core/primitives/LaneletSequence.h"
+
+namespace lanelet {
+namespace internal {
+struct FrenetSegmentTree;
+}  // namespace internal
+
+/**
+ * @brief Immutable frenet frame along the 2d centerline of a sequence of lanelets
+ *
+ * The frame is built once and can then be queried repeatedly, e.g. by a planner that converts many points per cycle.
+ * It stores the concatenated centerline with its accumulated lengths and a search tree over its segments. Converting
+ * from arc coordinates is a binary search, converting to arc coordinates is a search in the tree. Both run in
+ * logarithmic time instead of walking the centerlines of all lanelets.
+ *
+ * The width of the lane left and right of the centerline and the curvature of the centerline are computed at every
+ * centerline point when the frame is built and are linearly interpolated in between. The centerlines of lanelets are
+ * not smooth, therefore the curvature at a point is measured through the points that are curvatureWindow before and
+ * after it.
+ *
+ * Arc coordinates follow the same convention as geometry::toArcCoordinates: the length is measured along the
+ * centerline and clamped to it, the distance is positive left of the centerline. All member functions can be called
+ * from several threads at the same time.
+ */
+class FrenetFrame {
+ public:
+  FrenetFrame() = default;
+
+  /**
+   * @brief Builds the frame along the centerline of a lanelet sequence
+   * @param curvatureWindow arc length before and after a point that is used to estimate the curvature
+   * @throws InvalidInputError if the centerline has less than two distinct points
+   */
+  explicit FrenetFrame(const LaneletSequence& lanelets, double curvatureWindow = 2.);
+
+  //! Same as above, the lanelets are expected to follow each other
+  explicit FrenetFrame(const ConstLanelets& lanelets, double curvatureWindow = 2.)
+      : FrenetFrame(LaneletSequence(lanelets), curvatureWindow) {}
+
+  //! The lanelets the frame was built from
+  const ConstLanelets& lanelets() const noexcept { return lanelets_; }
+
+  //! The reference line. Consecutive duplicate points of the centerline are removed.
+  const ArcLengthIndex2d& centerline() const noexcept { return centerline_; }
+
+  //! Total length of the reference line
+  double length() const noexcept { return centerline_.length(); }
+
+  bool empty() const noexcept { return centerline_.empty(); }
+
+  //! Index of the first point of the centerline segment that is closest to the point
+  size_t closestSegment(const BasicPoint2d& point) const;
+
+  //! Converts a point to arc coordinates. Same as geometry::toArcCoordinates on the centerline.
+  ArcCoordinates toArcCoordinates(const BasicPoint2d& point) const;
+  std::vector<ArcCoordinates> toArcCoordinates(const BasicPoints2d& points) const;
+
+  //! Converts arc coordinates to a point. Same as geometry::fromArcCoordinates on the centerline.
+  BasicPoint2d fromArcCoordinates(const ArcCoordinates& arcCoordinates) const;
+  BasicPoints2d fromArcCoordinates(const std::vector<ArcCoordinates>& arcCoordinates) const;
+
+  //! Orientation of the centerline at the arc length in radians
+  double heading(double arcLength) const;
+
+  //! Signed curvature of the centerline at the arc length. Positive for left turns.
+  double curvature(double arcLength) const;
+
+  //! Distance from the centerline to the left bound at the arc length
+  double leftWidth(double arcLength) const { return interpolate(leftWidths_, arcLength); }
+
+  //! Distance from the centerline to the right bound at the arc length
+  double rightWidth(double arcLength) const { return interpolate(rightWidths_, arcLength); }
+
+  //! Width of the lane at the arc length
+  double width(double arcLength) const { return leftWidth(arcLength) + rightWidth(arcLength); }
+
+  //! The lanelet at the arc length. Lengths outside of the frame return the first or last lanelet.
+  const ConstLanelet& laneletAt(double arcLength) const;
+
+ private:
+  double interpolate(const std::vector<double>& values, double arcLength) const;
+
+  ConstLanelets lanelets_;
+  std::vector<double> laneletStarts_;  //!< Arc length at which each lanelet starts
+  ArcLengthIndex2d centerline_;
+  std::shared_ptr<const internal::FrenetSegmentTree> tree_;
+  std::vector<double> curvatures_;   //!< Curvature at each centerline point
+  std::vector<double> leftWidths_;   //!< Distance to the left bound at each centerline point
+  std::vector<double> rightWidths_;  //!< Distance to the right bound at each centerline point
+};
+
+}  // namespace lanelet
@@ -1,5 +1,6 @@
 #pragma once
 #include <utility>
+#include "lanelet2_core/primitives/ArcLengthIndex.h"
 #include "lanelet2_core/primitives/CompoundLineString.h"
 #include "lanelet2_core/primitives/CompoundPolygon.h"
 #include "lanelet2_core/primitives/Lanelet.h"
@@ -51,6 +52,12 @@ class LaneletSequenceData : public boost::noncopyable {
    */
   CompoundPolygon3d polygon() const;
 
+  /**
+   * @brief arc length index of the 2d centerline. Result is cached
+   * @param inverted return the index of the inverted centerline
+   */
+  ArcLengthIndex2dConstPtr centerlineArcLengthIndex(bool inverted) const;
+
   iterator begin(bool inverted) const noexcept {
     return inverted ? iterator(lanelets_.rbegin()) : iterator(lanelets_.begin());
   }
@@ -66,6 +73,8 @@ class LaneletSequenceData : public boost::noncopyable {
   const CompoundLineString3d rightBound_;                     // NOLINT
   mutable std::shared_ptr<CompoundLineString3d> centerline_;  //!< combined centerline
   mutable std::shared_ptr<CompoundPolygon3d> polygon_;        //!< combined polygon
+  mutable ArcLengthIndex2dConstPtr centerlineIndex_;          //!< arc length index of the centerline
+  mutable ArcLengthIndex2dConstPtr invertedCenterlineIndex_;  //!< arc length index of the inverted centerline
 };
 
 /**
@@ -182,6 +191,16 @@ class LaneletSequence {
   }
   CompoundLineString2d centerline2d() const { return utils::to2D(centerline3d()); }
 
+  /**
+   * @brief get an arc length index of the 2d centerline
+   *
+   * The index is cached, so lookups along the centerline (interpolating points, converting to or from arc coordinates)
+   * do not have to measure the centerline again. Call resetCache if the lanelets were modified.
+   */
+  ArcLengthIndex2dConstPtr centerlineArcLengthIndex2d() const {
+    return constData()->centerlineArcLengthIndex(inverted());
+  }
+
   /**
    * @brief returns the surface covered by the lanelets as 3-dimensional
    * polygon.
@@ -0,0 +1,100 @@
+#include "lanelet2_core/primitives/ArcLengthIndex.h"
+#include <algorithm>
+#include <cassert>
+#include "lanelet2_core/Exceptions.h"
+
+namespace lanelet {
+
+template <typename BasicLineStringT>
+ArcLengthIndex<BasicLineStringT>::ArcLengthIndex(BasicLineStringT lineString) : lineString_{std::move(lineString)} {
+  accumulatedLengths_.reserve(lineString_.size());
+  double length = 0.;
+  for (auto i = 0u; i < lineString_.size(); ++i) {
+    if (i > 0) {
+      length += (lineString_[i] - lineString_[i - 1]).norm();
+    }
+    accumulatedLengths_.push_back(length);
+  }
+}
+
+template <typename BasicLineStringT>
+std::vector<double> ArcLengthIndex<BasicLineStringT>::accumulatedLengthRatios() const {
+  if (size() <= 1) {
+    return {};
+  }
+  const auto totalLength = length();
+  std::vector<double> ratios;
+  ratios.reserve(size() - 1);
+  std::transform(std::next(accumulatedLengths_.begin()), accumulatedLengths_.end(), std::back_inserter(ratios),
+                 [totalLength](double l) { return l / totalLength; });
+  return ratios;
+}
+
+template <typename BasicLineStringT>
+size_t ArcLengthIndex<BasicLineStringT>::segmentIndexAtDistance(double dist) const {
+  if (size() < 2) {
+    throw InvalidInputError("Can't find a segment on a linestring with less than two points");
+  }
+  // first point that is further away than dist is the end of the segment
+  auto segmentEnd =
+      std::upper_bound(std::next(accumulatedLengths_.begin()), std::prev(accumulatedLengths_.end()), dist);
+  return size_t(std::distance(accumulatedLengths_.begin(), segmentEnd)) - 1;
+}
+
+template <typename BasicLineStringT>
+typename ArcLengthIndex<BasicLineStringT>::PointType ArcLengthIndex<BasicLineStringT>::interpolatedPointAtDistance(
+    double dist) const {
+  assert(!empty());
+  if (dist < 0) {
+    dist = std::max(length() + dist, 0.);
+  }
+  // first point whose accumulated length reaches dist is the end of the segment
+  auto segmentEnd = std::lower_bound(std::next(accumulatedLengths_.begin()), accumulatedLengths_.end(), dist);
+  if (segmentEnd == accumulatedLengths_.end()) {
+    return lineString_.back();
+  }
+  const auto endIdx = size_t(std::distance(accumulatedLengths_.begin(), segmentEnd));
+  const PointType p1 = lineString_[endIdx - 1];
+  const PointType p2 = lineString_[endIdx];
+  const double remainingDistance = dist - accumulatedLengths_[endIdx - 1];
+  if (remainingDistance < 1.e-8) {
+    return p1;
+  }
+  return p1 + remainingDistance / (*segmentEnd - accumulatedLengths_[endIdx - 1]) * (p2 - p1);
+}
+
+template <typename BasicLineStringT>
+size_t ArcLengthIndex<BasicLineStringT>::nearestPointIndexAtDistance(double dist) const {
+  assert(!empty());
+  if (dist < 0) {
+    dist = std::max(length() + dist, 0.);
+  }
+  auto segmentEnd = std::lower_bound(std::next(accumulatedLengths_.begin()), accumulatedLengths_.end(), dist);
+  if (segmentEnd == accumulatedLengths_.end()) {
+    return size() - 1;
+  }
+  const auto endIdx = size_t(std::distance(accumulatedLengths_.begin(), segmentEnd));
+  const double segmentCenter = (accumulatedLengths_[endIdx - 1] + *segmentEnd) / 2;
+  return dist > segmentCenter ? endIdx : endIdx - 1;
+}
+
+template <typename BasicLineStringT>
+BasicLineStringT ArcLengthIndex<BasicLineStringT>::subLineString(double from, double to) const {
+  assert(!empty());
+  from = std::min(std::max(from, 0.), length());
+  to = std::min(std::max(to, 0.), length());
+  BasicLineStringT result{interpolatedPointAtDistance(from)};
+  if (to <= from) {
+    return result;
+  }
+  auto first = std::upper_bound(accumulatedLengths_.begin(), accumulatedLengths_.end(), from);
+  auto last = std::lower_bound(first, accumulatedLengths_.end(), to);
+  result.insert(result.end(), std::next(lineString_.begin(), std::distance(accumulatedLengths_.begin(), first)),
+                std::next(lineString_.begin(), std::distance(accumulatedLengths_.begin(), last)));
+  result.push_back(interpolatedPointAtDistance(to));
+  return result;
+}
+
+template class ArcLengthIndex<BasicLineString2d>;
+template class ArcLengthIndex<BasicLineString3d>;
+}  // namespace lanelet
@@ -0,0 +1,170 @@
+#include "lanelet2_core/primitives/FrenetFrame.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "lanelet2_core/Exceptions.h"
+#include "lanelet2_core/geometry/LineString.h"
+
+namespace lanelet {
+namespace internal {
+struct FrenetSegmentTree {
+  geometry::internal::IndexedSegmentTree tree;
+};
+}  // namespace internal
+
+namespace {
+namespace bgi = boost::geometry::index;
+
+BasicLineString2d withoutDuplicates(const BasicLineString2d& lineString) {
+  BasicLineString2d result;
+  result.reserve(lineString.size());
+  for (const auto& p : lineString) {
+    if (result.empty() || result.back() != p) {
+      result.push_back(p);
+    }
+  }
+  return result;
+}
+
+// Menger curvature of the circle through three points, positive if the points turn left
+double mengerCurvature(const BasicPoint2d& p1, const BasicPoint2d& p2, const BasicPoint2d& p3) {
+  const BasicPoint2d a = p2 - p1;
+  const BasicPoint2d b = p3 - p2;
+  const double denominator = a.norm() * b.norm() * (p3 - p1).norm();
+  if (denominator <= 0.) {
+    return 0.;
+  }
+  return 2. * (a.x() * b.y() - a.y() * b.x()) / denominator;
+}
+
+std::vector<double> distancesTo(const BasicLineString2d& bound, const BasicLineString2d& points) {
+  if (bound.size() < 2) {
+    return utils::transform(points, [&](const BasicPoint2d& p) {
+      return bound.empty() ? 0. : (bound.front() - p).norm();
+    });
+  }
+  auto tree = geometry::internal::makeIndexedSegmenTree(bound);
+  return utils::transform(points, [&](const BasicPoint2d& p) {
+    std::vector<geometry::internal::IndexedSegment2d> nearest;
+    tree.query(bgi::nearest(p, 1), std::back_inserter(nearest));
+    return boost::geometry::distance(p, nearest.front().first);
+  });
+}
+}  // namespace
+
+FrenetFrame::FrenetFrame(const LaneletSequence& lanelets, double curvatureWindow)
+    : lanelets_{lanelets.inverted() ? utils::transform(lanelets.lanelets(), [](auto& llt) { return llt.invert(); })
+                                    : lanelets.lanelets()} {
+  centerline_ = ArcLengthIndex2d(withoutDuplicates(lanelets.centerlineArcLengthIndex2d()->lineString()));
+  if (centerline_.size() < 2) {
+    throw InvalidInputError("A frenet frame needs a centerline with at least two distinct points");
+  }
+  const auto& points = centerline_.lineString();
+  tree_ = std::make_shared<internal::FrenetSegmentTree>(
+      internal::FrenetSegmentTree{geometry::internal::makeIndexedSegmenTree(points)});
+
+  laneletStarts_.reserve(lanelets_.size());
+  double start = 0.;
+  for (const auto& llt : lanelets_) {
+    laneletStarts_.push_back(start);
+    start += geometry::length(utils::to2D(llt.centerline()));
+  }
+
+  const auto& lengths = centerline_.accumulatedLengths();
+  curvatures_ = utils::transform(lengths, [&](double s) {
+    // near the ends, the window is moved inwards instead of being cut off
+    const double from = std::max(0., std::min(s - curvatureWindow, length() - 2 * curvatureWindow));
+    const double to = std::min(length(), from + 2 * curvatureWindow);
+    return mengerCurvature(centerline_.interpolatedPointAtDistance(from),
+                           centerline_.interpolatedPointAtDistance((from + to) / 2),
+                           centerline_.interpolatedPointAtDistance(to));
+  });
+
+  leftWidths_ = distancesTo(lanelets.leftBound2d().basicLineString(), points);
+  rightWidths_ = distancesTo(lanelets.rightBound2d().basicLineString(), points);
+}
+
+size_t FrenetFrame::closestSegment(const BasicPoint2d& point) const {
+  if (!tree_) {
+    throw InvalidInputError("Can not search in an empty frenet frame");
+  }
+  // segments that are equally close (e.g. at a corner) are resolved to the first one, like in geometry::project
+  std::vector<geometry::internal::IndexedSegment2d> nearest;
+  nearest.reserve(4);
+  tree_->tree.query(bgi::nearest(point, 4), std::back_inserter(nearest));
+  auto minDistance = std::numeric_limits<double>::infinity();
+  auto segment = centerline_.size();
+  for (const auto& candidate : nearest) {
+    const auto distance = boost::geometry::comparable_distance(point, candidate.first);
+    if (distance < minDistance || (distance == minDistance && candidate.second < segment)) {
+      minDistance = distance;
+      segment = candidate.second;
+    }
+  }
+  return segment;
+}
+
+ArcCoordinates FrenetFrame::toArcCoordinates(const BasicPoint2d& point) const {
+  const auto segment = closestSegment(point);
+  const auto& points = centerline_.lineString();
+  const BasicPoint2d& pSeg1 = points[segment];
+  const BasicPoint2d& pSeg2 = points[segment + 1];
+  const BasicPoint2d direction = pSeg2 - pSeg1;
+  const double ratio = std::max(0., std::min(1., (point - pSeg1).dot(direction) / direction.squaredNorm()));
+  const BasicPoint2d projected = pSeg1 + ratio * direction;
+  const double distance = (point - projected).norm();
+
+  // same as geometry::signedDistance, points behind a corner are left if they are left of the next segment
+  bool isLeft = geometry::internal::pointIsLeftOf(pSeg1, pSeg2, point);
+  if (ratio >= 1. && segment + 2 < points.size()) {
+    const BasicPoint2d& next = points[segment + 2];
+    if (isLeft != geometry::internal::pointIsLeftOf(pSeg2, next, point) &&
+        isLeft == geometry::internal::pointIsLeftOf(pSeg1, pSeg2, next)) {
+      isLeft = !isLeft;
+    }
+  }
+  return {centerline_.accumulatedLengths()[segment] + ratio * direction.norm(), isLeft ? distance : -distance};
+}
+
+std::vector<ArcCoordinates> FrenetFrame::toArcCoordinates(const BasicPoints2d& points) const {
+  return utils::transform(points, [this](const BasicPoint2d& p) { return toArcCoordinates(p); });
+}
+
+BasicPoint2d FrenetFrame::fromArcCoordinates(const ArcCoordinates& arcCoordinates) const {
+  return geometry::fromArcCoordinates(centerline_, arcCoordinates);
+}
+
+BasicPoints2d FrenetFrame::fromArcCoordinates(const std::vector<ArcCoordinates>& arcCoordinates) const {
+  BasicPoints2d result;
+  result.reserve(arcCoordinates.size());
+  for (const auto& arcCoordinate : arcCoordinates) {
+    result.push_back(fromArcCoordinates(arcCoordinate));
+  }
+  return result;
+}
+
+double FrenetFrame::heading(double arcLength) const {
+  const auto segment = centerline_.segmentIndexAtDistance(arcLength);
+  const BasicPoint2d direction = centerline_.lineString()[segment + 1] - centerline_.lineString()[segment];
+  return std::atan2(direction.y(), direction.x());
+}
+
+double FrenetFrame::curvature(double arcLength) const { return interpolate(curvatures_, arcLength); }
+
+const ConstLanelet& FrenetFrame::laneletAt(double arcLength) const {
+  if (lanelets_.empty()) {
+    throw InvalidInputError("Can not find a lanelet in an empty frenet frame");
+  }
+  auto next = std::upper_bound(std::next(laneletStarts_.begin()), laneletStarts_.end(), arcLength);
+  return lanelets_[size_t(std::distance(laneletStarts_.begin(), next)) - 1];
+}
+
+double FrenetFrame::interpolate(const std::vector<double>& values, double arcLength) const {
+  const auto segment = centerline_.segmentIndexAtDistance(arcLength);
+  const auto& lengths = centerline_.accumulatedLengths();
+  const double ratio =
+      std::max(0., std::min(1., (arcLength - lengths[segment]) / (lengths[segment + 1] - lengths[segment])));
+  return values[segment] + ratio * (values[segment + 1] - values[segment]);
+}
+
+}  // namespace lanelet
@@ -3,7 +3,10 @@
 #include <atomic>
 #include <boost/geometry/index/rtree.hpp>
 #include <chrono>
+#include <iterator>
+#include <limits>
 #include <random>
+#include <unordered_set>
 #include "lanelet2_core/geometry/Area.h"
 #include "lanelet2_core/geometry/BoundingBox.h"
 #include "lanelet2_core/geometry/Lanelet.h"
@@ -190,6 +193,43 @@ Optional<RetT> nearestUntilImpl(TreeT&& tree, const BasicPoint2d& point, const F
   return {};
 }
 
+template <typename RetT, typename TreePtrT, typename Func>
+Optional<RetT> nearestSegmentUntilImpl(TreePtrT&& tree, const BasicPoint2d& point, const Func& func) {
+  if (!tree || tree->empty()) {
+    return {};
+  }
+  // an incremental query over all segments is slow, so the k nearest segments are queried with doubling k until func
+  // is satisfied. Neighbouring primitives share segments, so the k nearest can end between two segments of the same
+  // distance. Segments as far away as the furthest returned one are therefore only passed to func in the next round.
+  using NodeT = typename std::decay_t<decltype(*tree)>::value_type;
+  std::vector<std::pair<double, const NodeT*>> sorted;
+  std::vector<NodeT> nodes;
+  double processedUntil = 0.;
+  for (size_t k = 16;; k *= 2) {
+    k = std::min(k, tree->size());
+    nodes.clear();
+    tree->query(bgi::nearest(point, unsigned(k)), std::back_inserter(nodes));
+    const bool isLastRound = k == tree->size();
+    sorted = utils::transform(nodes, [&point](const NodeT& node) {
+      return std::make_pair(boost::geometry::comparable_distance(point, std::get<0>(node)), &node);
+    });
+    std::sort(sorted.begin(), sorted.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+    const double until = isLastRound ? std::numeric_limits<double>::infinity() : sorted.back().first;
+    auto first = std::lower_bound(sorted.begin(), sorted.end(), processedUntil,
+                                  [](auto& elem, double d) { return elem.first < d; });
+    for (auto it = first; it != sorted.end() && it->first < until; ++it) {
+      const auto& node = *it->second;
+      if (func(std::get<0>(node), std::get<2>(node), std::get<1>(node))) {
+        return RetT(std::get<1>(node));
+      }
+    }
+    if (isLastRound) {
+      return {};
+    }
+    processedUntil = until;
+  }
+}
+
 template <typename T>
 void checkId(T& t) {
   if (t.id() == InvalId) {
@@ -214,6 +254,127 @@ LaneletMapUPtr createMapFromConst(const ConstLaneletsT& fromLanelets, const Cons
 }  // namespace lanelet
 
 namespace lanelet {
+namespace {
+template <typename MapT, typename KeyT, typename ValueT>
+void eraseFromMultiMap(MapT& map, const KeyT& key, const ValueT& value) {
+  auto range = map.equal_range(key);
+  for (auto it = range.first; it != range.second;) {
+    it = it->second == value ? map.erase(it) : std::next(it);
+  }
+}
+
+//! Identifies the key of a usage lookup in the compact usage index. Same semantics as operator== on the key.
+struct UsageKey {
+  Id id{InvalId};
+  const void* data{nullptr};
+  int type{0};
+  bool inverted{false};
+  bool operator<(const UsageKey& rhs) const {
+    return std::tie(id, data, type, inverted) < std::tie(rhs.id, rhs.data, rhs.type, rhs.inverted);
+  }
+  bool operator==(const UsageKey& rhs) const {
+    return id == rhs.id && data == rhs.data && type == rhs.type && inverted == rhs.inverted;
+  }
+};
+
+UsageKey usageKey(const ConstPoint3d& p) { return {p.id(), p.constData().get()}; }
+UsageKey usageKey(const ConstLineString3d& ls) { return {ls.id(), ls.constData().get(), 0, ls.inverted()}; }
+UsageKey usageKey(const ConstPolygon3d& poly) { return {poly.id(), poly.constData().get()}; }
+UsageKey usageKey(const ConstLanelet& ll) { return {ll.id(), ll.constData().get(), 0, ll.inverted()}; }
+UsageKey usageKey(const ConstArea& ar) { return {ar.id(), ar.constData().get()}; }
+UsageKey usageKey(const RegulatoryElementConstPtr& regElem) {
+  return regElem ? UsageKey{regElem->id(), regElem.get()} : UsageKey{};
+}
+
+struct UsageKeyVisitor : public boost::static_visitor<UsageKey> {
+  template <typename PrimT>
+  UsageKey operator()(const PrimT& prim) const {
+    return usageKey(prim);
+  }
+  UsageKey operator()(const ConstWeakLanelet& ll) const { return ll.expired() ? UsageKey{} : usageKey(ll.lock()); }
+  UsageKey operator()(const ConstWeakArea& ar) const { return ar.expired() ? UsageKey{} : usageKey(ar.lock()); }
+};
+
+UsageKey usageKey(const ConstRuleParameter& param) {
+  auto key = boost::apply_visitor(UsageKeyVisitor(), param);
+  key.type = param.which();
+  return key;
+}
+
+//! Read-only replacement for the multimaps of a UsageLookup. All values of one key are stored next to each other
+//! (compressed sparse rows), the keys are sorted by id.
+template <typename ValueT>
+class CompactUsageMap {
+ public:
+  template <typename MultiMapT>
+  explicit CompactUsageMap(const MultiMapT& lookup) {
+    std::vector<std::pair<UsageKey, const ValueT*>> entries;
+    entries.reserve(lookup.size());
+    for (const auto& elem : lookup) {
+      entries.emplace_back(usageKey(elem.first), &elem.second);
+    }
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    values_.reserve(entries.size());
+    for (const auto& entry : entries) {
+      if (keys_.empty() || !(keys_.back() == entry.first)) {
+        keys_.push_back(entry.first);
+        offsets_.push_back(values_.size());
+      }
+      values_.push_back(*entry.second);
+    }
+    offsets_.push_back(values_.size());
+    keys_.shrink_to_fit();
+    offsets_.shrink_to_fit();
+  }
+
+  template <typename KeyT>
+  std::pair<const ValueT*, const ValueT*> find(const KeyT& key) const {
+    const auto searchKey = usageKey(key);
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), searchKey);
+    if (it == keys_.end() || !(*it == searchKey)) {
+      return {nullptr, nullptr};
+    }
+    const auto idx = size_t(std::distance(keys_.begin(), it));
+    return {values_.data() + offsets_[idx], values_.data() + offsets_[idx + 1]};
+  }
+
+ private:
+  std::vector<UsageKey> keys_;
+  std::vector<size_t> offsets_;
+  std::vector<ValueT> values_;
+};
+
+template <typename ValueT>
+using CompactUsageMapPtr = std::shared_ptr<const CompactUsageMap<ValueT>>;
+
+template <typename ValueT, typename MultiMapT>
+CompactUsageMapPtr<ValueT> compactLookup(MultiMapT& lookup) {
+  auto compact = std::make_shared<const CompactUsageMap<ValueT>>(lookup);
+  MultiMapT().swap(lookup);
+  return compact;
+}
+
+template <typename RetT, typename MultiMapT, typename ValueT, typename KeyT>
+std::vector<RetT> findInLookup(const MultiMapT& lookup, const CompactUsageMapPtr<ValueT>& compact, const KeyT& key) {
+  if (compact) {
+    auto range = compact->find(key);
+    return std::vector<RetT>(range.first, range.second);
+  }
+  return forEachMatchInMultiMap<RetT>(lookup, key, [](const auto& elem) { return RetT(elem.second); });
+}
+
+template <typename MultiMapT, typename ValueT, typename KeyT>
+UsageRange<ValueT> usagesInLookup(const MultiMapT& lookup, const CompactUsageMapPtr<ValueT>& compact,
+                                  const KeyT& key) {
+  if (compact) {
+    auto range = compact->find(key);
+    return {range.first, range.second};
+  }
+  return UsageRange<ValueT>(findInLookup<ValueT>(lookup, compact, key));
+}
+}  // namespace
+
 template <typename T>
 struct UsageLookup {
   void add(const T& prim) {
@@ -221,7 +382,21 @@ struct UsageLookup {
       ownedLookup.insert(std::make_pair(elem, prim));
     }
   }
+  void remove(const T& prim) {
+    for (const auto& elem : prim) {
+      eraseFromMultiMap(ownedLookup, elem, prim);
+    }
+  }
+  bool isCompact() const { return !!compactOwned; }
+  void compact() { compactOwned = compactLookup<T>(ownedLookup); }
+  void expand(const std::unordered_map<Id, T>& elements) {
+    if (isCompact()) {
+      compactOwned.reset();
+      utils::forEach(elements, [this](const auto& elem) { this->add(elem.second); });
+    }
+  }
   std::unordered_multimap<traits::ConstPrimitiveType<traits::OwnedT<T>>, T> ownedLookup;
+  CompactUsageMapPtr<T> compactOwned;
 };
 
 template <>
@@ -233,7 +408,23 @@ struct UsageLookup<RegulatoryElementPtr> {
       }
     }
   }
+  void remove(const RegulatoryElementPtr& prim) {
+    for (const auto& param : prim->getParameters()) {
+      for (const auto& rule : param.second) {
+        eraseFromMultiMap(ownedLookup, rule, prim);
+      }
+    }
+  }
+  bool isCompact() const { return !!compactOwned; }
+  void compact() { compactOwned = compactLookup<RegulatoryElementPtr>(ownedLookup); }
+  void expand(const std::unordered_map<Id, RegulatoryElementPtr>& elements) {
+    if (isCompact()) {
+      compactOwned.reset();
+      utils::forEach(elements, [this](const auto& elem) { this->add(elem.second); });
+    }
+  }
   std::unordered_multimap<ConstRuleParameter, RegulatoryElementPtr> ownedLookup;
+  CompactUsageMapPtr<RegulatoryElementPtr> compactOwned;
 };
 template <>
 struct UsageLookup<Area> {
@@ -249,8 +440,34 @@ struct UsageLookup<Area> {
       regElemLookup.insert(std::make_pair(elem, area));
     }
   }
+  void remove(const Area& area) {
+    auto eraseElement = [&area, this](const auto& elem) { eraseFromMultiMap(ownedLookup, elem, area); };
+    utils::forEach(area.outerBound(), eraseElement);
+
+    for (const auto& innerBound : area.innerBounds()) {
+      utils::forEach(innerBound, eraseElement);
+    }
+
+    for (const auto& elem : area.regulatoryElements()) {
+      eraseFromMultiMap(regElemLookup, elem, area);
+    }
+  }
+  bool isCompact() const { return !!compactOwned; }
+  void compact() {
+    compactOwned = compactLookup<Area>(ownedLookup);
+    compactRegElem = compactLookup<Area>(regElemLookup);
+  }
+  void expand(const std::unordered_map<Id, Area>& elements) {
+    if (isCompact()) {
+      compactOwned.reset();
+      compactRegElem.reset();
+      utils::forEach(elements, [this](const auto& elem) { this->add(elem.second); });
+    }
+  }
   std::unordered_multimap<ConstLineString3d, Area> ownedLookup;
   std::unordered_multimap<RegulatoryElementConstPtr, Area> regElemLookup;
+  CompactUsageMapPtr<Area> compactOwned;
+  CompactUsageMapPtr<Area> compactRegElem;
 };
 template <>
 struct UsageLookup<Lanelet> {
@@ -261,13 +478,147 @@ struct UsageLookup<Lanelet> {
       regElemLookup.insert(std::make_pair(elem, ll));
     }
   }
+  void remove(const Lanelet& ll) {
+    eraseFromMultiMap(ownedLookup, ConstLineString3d(ll.leftBound()), ll);
+    eraseFromMultiMap(ownedLookup, ConstLineString3d(ll.rightBound()), ll);
+    for (const auto& elem : ll.regulatoryElements()) {
+      eraseFromMultiMap(regElemLookup, RegulatoryElementConstPtr(elem), ll);
+    }
+  }
+  bool isCompact() const { return !!compactOwned; }
+  void compact() {
+    compactOwned = compactLookup<Lanelet>(ownedLookup);
+    compactRegElem = compactLookup<Lanelet>(regElemLookup);
+  }
+  void expand(const std::unordered_map<Id, Lanelet>& elements) {
+    if (isCompact()) {
+      compactOwned.reset();
+      compactRegElem.reset();
+      utils::forEach(elements, [this](const auto& elem) { this->add(elem.second); });
+    }
+  }
   std::unordered_multimap<ConstLineString3d, Lanelet> ownedLookup;
   std::unordered_multimap<RegulatoryElementConstPtr, Lanelet> regElemLookup;
+  CompactUsageMapPtr<Lanelet> compactOwned;
+  CompactUsageMapPtr<Lanelet> compactRegElem;
 };
 
 template <>
 struct UsageLookup<Point3d> {
   void add(const Point3d& /*unused*/) {}
+  void remove(const Point3d& /*unused*/) {}
+  bool isCompact() const { return false; }
+  void compact() {}
+  void expand(const std::unordered_map<Id, Point3d>& /*elements*/) {}
+};
+
+//! Enumerates the boundary segments of a primitive for the segment index. Primitives without a boundary have none.
+template <typename T>
+struct SegmentSource {
+  static constexpr bool Available = false;
+  static constexpr bool Areal = false;
+  template <typename Func>
+  static void forEach(const T& /*prim*/, Func&& /*f*/) {}
+};
+
+template <typename PointsT, typename Func>
+void forEachRingSegment(const PointsT& ring, size_t& idx, Func&& f) {
+  if (ring.size() < 2) {
+    return;
+  }
+  for (auto i = 0u; i < ring.size(); ++i) {
+    f(BasicSegment2d(ring[i], ring[(i + 1) % ring.size()]), idx++);
+  }
+}
+
+template <>
+struct SegmentSource<LineString3d> {
+  static constexpr bool Available = true;
+  static constexpr bool Areal = false;
+  template <typename Func>
+  static void forEach(const ConstLineString3d& ls, Func&& f) {
+    for (auto i = 1u; i < ls.size(); ++i) {
+      f(BasicSegment2d(ls[i - 1].basicPoint2d(), ls[i].basicPoint2d()), i - 1);
+    }
+  }
+};
+
+template <>
+struct SegmentSource<Polygon3d> {
+  static constexpr bool Available = true;
+  static constexpr bool Areal = true;
+  template <typename Func>
+  static void forEach(const ConstPolygon3d& poly, Func&& f) {
+    size_t idx = 0;
+    forEachRingSegment(traits::to2D(poly).basicPolygon(), idx, f);
+  }
+};
+
+template <>
+struct SegmentSource<Lanelet> {
+  static constexpr bool Available = true;
+  static constexpr bool Areal = true;
+  template <typename Func>
+  static void forEach(const ConstLanelet& ll, Func&& f) {
+    size_t idx = 0;
+    forEachRingSegment(ll.polygon2d().basicPolygon(), idx, f);
+  }
+};
+
+template <>
+struct SegmentSource<Area> {
+  static constexpr bool Available = true;
+  static constexpr bool Areal = true;
+  template <typename Func>
+  static void forEach(const ConstArea& area, Func&& f) {
+    size_t idx = 0;
+    forEachRingSegment(traits::to2D(area.outerBoundPolygon()).basicPolygon(), idx, f);
+    for (const auto& inner : area.innerBoundPolygons()) {
+      forEachRingSegment(traits::to2D(inner).basicPolygon(), idx, f);
+    }
+  }
+};
+
+//! Optional rtree of the individual segments of the primitives of a layer. Only built on request.
+template <typename T>
+struct SegmentIndex {
+  using SegmentNode = std::tuple<BasicSegment2d, T, size_t>;
+  using RTree = bgi::rtree<SegmentNode, bgi::quadratic<16>>;
+
+  SegmentIndex() = default;
+  SegmentIndex(const SegmentIndex& rhs) : rTree{rhs.rTree ? std::make_unique<RTree>(*rhs.rTree) : nullptr} {}
+
+  static void appendSegments(const T& elem, std::vector<SegmentNode>& nodes) {
+    SegmentSource<T>::forEach(elem, [&](const BasicSegment2d& segment, size_t idx) {
+      nodes.emplace_back(segment, elem, idx);
+    });
+  }
+  void build(const std::unordered_map<Id, T>& primitives) {
+    std::vector<SegmentNode> nodes;
+    for (const auto& primitive : primitives) {
+      appendSegments(primitive.second, nodes);
+    }
+    rTree = std::make_unique<RTree>(nodes);
+  }
+  void insert(const T& elem) {
+    if (!rTree) {
+      return;
+    }
+    std::vector<SegmentNode> nodes;
+    appendSegments(elem, nodes);
+    rTree->insert(nodes.begin(), nodes.end());
+  }
+  void erase(const T& elem) {
+    if (!rTree) {
+      return;
+    }
+    std::vector<SegmentNode> nodes;
+    appendSegments(elem, nodes);
+    for (const auto& node : nodes) {
+      rTree->remove(node);
+    }
+  }
+  std::unique_ptr<RTree> rTree;
 };
 
 template <typename T>
@@ -292,15 +643,18 @@ struct PrimitiveLayer<T>::Tree {
     if (!node.first.isEmpty()) {
       rTree.insert(node);
     }
+    segments.insert(elem);
   }
   void erase(const T& elem) {
     TreeNode node = treeNode(elem);
     if (!node.first.isEmpty()) {
       rTree.remove(node);
     }
+    segments.erase(elem);
   }
   RTree rTree;
   UsageLookup<T> usage;
+  SegmentIndex<T> segments;
 };
 
 template <>
@@ -319,11 +673,12 @@ struct PrimitiveLayer<Point3d>::Tree {
   void erase(const Point3d& elem) { rTree.remove(treeNode(elem)); }
   RTree rTree;
   UsageLookup<Point3d> usage;
+  SegmentIndex<Point3d> segments;
 };
 
 template <typename T>
 PrimitiveLayer<T>::PrimitiveLayer(const PrimitiveLayer::Map& primitives)
-    : elements_{primitives}, tree_{std::make_unique<Tree>(primitives)} {
+    : elements_{std::make_shared<Map>(primitives)}, tree_{std::make_shared<Tree>(primitives)} {
   for (const auto& prim : primitives) {
     tree_->usage.add(prim.second);
   }
@@ -331,7 +686,7 @@ PrimitiveLayer<T>::PrimitiveLayer(const PrimitiveLayer::Map& primitives)
 
 template <>
 PrimitiveLayer<Lanelet>::PrimitiveLayer(const PrimitiveLayer::Map& primitives)
-    : elements_{primitives}, tree_{std::make_unique<Tree>(primitives)} {
+    : elements_{std::make_shared<Map>(primitives)}, tree_{std::make_shared<Tree>(primitives)} {
   for (const auto& prim : primitives) {
     tree_->usage.add(prim.second);
   }
@@ -339,7 +694,7 @@ PrimitiveLayer<Lanelet>::PrimitiveLayer(const PrimitiveLayer::Map& primitives)
 
 template <>
 PrimitiveLayer<Area>::PrimitiveLayer(const PrimitiveLayer::Map& primitives)
-    : elements_{primitives}, tree_{std::make_unique<Tree>(primitives)} {
+    : elements_{std::make_shared<Map>(primitives)}, tree_{std::make_shared<Tree>(primitives)} {
   for (const auto& prim : primitives) {
     tree_->usage.add(prim.second);
     utils::registerId(prim.first);
@@ -348,7 +703,7 @@ PrimitiveLayer<Area>::PrimitiveLayer(const PrimitiveLayer::Map& primitives)
 
 template <typename T>
 bool PrimitiveLayer<T>::exists(Id id) const {
-  return id != InvalId && elements_.find(id) != elements_.end();
+  return id != InvalId && elements_->find(id) != elements_->end();
 }
 
 template <typename T>
@@ -357,7 +712,7 @@ typename PrimitiveLayer<T>::PrimitiveT PrimitiveLayer<T>::get(Id id) {
     throw NoSuchPrimitiveError("Tried to lookup an element with id InvalId!");
   }
   try {
-    return elements_.at(id);
+    return elements_->at(id);
   } catch (std::out_of_range&) {
     throw NoSuchPrimitiveError("Failed to lookup element with id " + std::to_string(id));
   }
@@ -369,7 +724,7 @@ typename PrimitiveLayer<T>::ConstPrimitiveT PrimitiveLayer<T>::get(Id id) const
     throw NoSuchPrimitiveError("Tried to lookup an element with id InvalId!");
   }
   try {
-    return elements_.at(id);
+    return elements_->at(id);
   } catch (std::out_of_range&) {
     throw NoSuchPrimitiveError("Failed to lookup element with id " + std::to_string(id));
   }
@@ -377,53 +732,106 @@ typename PrimitiveLayer<T>::ConstPrimitiveT PrimitiveLayer<T>::get(Id id) const
 
 template <typename T>
 void PrimitiveLayer<T>::add(const PrimitiveLayer<T>::PrimitiveT& element) {
+  prepareModification();
   for (const auto& elem : element) {
     tree_->usage.ownedLookup.insert(std::make_pair(elem, element));
   }
-  elements_.insert({element.id(), element});
+  elements_->insert({element.id(), element});
   tree_->insert(element);
 }
 
 template <>
 void PrimitiveLayer<Area>::add(const Area& area) {
+  prepareModification();
   tree_->usage.add(area);
-  elements_.insert({area.id(), area});
+  elements_->insert({area.id(), area});
   tree_->insert(area);
 }
 
 template <>
 void PrimitiveLayer<Lanelet>::add(const Lanelet& ll) {
+  prepareModification();
   tree_->usage.add(ll);
-  elements_.insert({ll.id(), ll});
+  elements_->insert({ll.id(), ll});
   tree_->insert(ll);
 }
 
 template <>
 void PrimitiveLayer<Point3d>::add(const Point3d& p) {
+  prepareModification();
   tree_->usage.add(p);
-  elements_.insert({p.id(), p});
+  elements_->insert({p.id(), p});
   tree_->insert(p);
 }
 
 template <>
 void PrimitiveLayer<RegulatoryElementPtr>::add(const PrimitiveLayer<RegulatoryElementPtr>::PrimitiveT& element) {
+  prepareModification();
   tree_->usage.add(element);
-  elements_.insert({element->id(), element});
+  elements_->insert({element->id(), element});
   tree_->insert(element);
 }
 
+template <typename T>
+void PrimitiveLayer<T>::remove(Id element) {
+  if (!exists(element)) {
+    return;
+  }
+  prepareModification();
+  auto elem = elements_->find(element);
+  tree_->usage.remove(elem->second);
+  tree_->erase(elem->second);
+  elements_->erase(elem);
+}
+
+template <typename T>
+void PrimitiveLayer<T>::detach() {
+  if (elements_.use_count() > 1) {
+    elements_ = std::make_shared<Map>(*elements_);
+  }
+  if (tree_.use_count() > 1) {
+    tree_ = std::make_shared<Tree>(*tree_);
+  }
+}
+
+template <typename T>
+void PrimitiveLayer<T>::prepareModification() {
+  detach();
+  tree_->usage.expand(*elements_);
+}
+
+template <typename T>
+void PrimitiveLayer<T>::buildUsageIndex() {
+  if (!tree_->usage.isCompact()) {
+    detach();
+    tree_->usage.compact();
+  }
+}
+
+template <>
+void PrimitiveLayer<Point3d>::buildUsageIndex() {}
+
+template <typename T>
+bool PrimitiveLayer<T>::hasUsageIndex() const {
+  return tree_->usage.isCompact();
+}
+
 template <typename T>
 std::vector<typename PrimitiveLayer<T>::ConstPrimitiveT> PrimitiveLayer<T>::findUsages(
     const traits::ConstPrimitiveType<traits::OwnedT<PrimitiveLayer<T>::PrimitiveT>>& primitive) const {
-  return forEachMatchInMultiMap<traits::ConstPrimitiveType<typename PrimitiveLayer<T>::PrimitiveT>>(
-      tree_->usage.ownedLookup, primitive, [](const auto& elem) { return traits::toConst(elem.second); });
+  return findInLookup<ConstPrimitiveT>(tree_->usage.ownedLookup, tree_->usage.compactOwned, primitive);
 }
 
 template <typename T>
 std::vector<typename PrimitiveLayer<T>::PrimitiveT> PrimitiveLayer<T>::findUsages(
     const traits::ConstPrimitiveType<traits::OwnedT<PrimitiveT>>& primitive) {
-  return forEachMatchInMultiMap<typename PrimitiveLayer<T>::PrimitiveT>(tree_->usage.ownedLookup, primitive,
-                                                                        [](const auto& elem) { return elem.second; });
+  return findInLookup<PrimitiveT>(tree_->usage.ownedLookup, tree_->usage.compactOwned, primitive);
+}
+
+template <typename T>
+UsageRange<T> PrimitiveLayer<T>::usages(
+    const traits::ConstPrimitiveType<traits::OwnedT<PrimitiveT>>& primitive) const {
+  return usagesInLookup(tree_->usage.ownedLookup, tree_->usage.compactOwned, primitive);
 }
 
 template <>
@@ -436,61 +844,72 @@ Points3d PointLayer::findUsages(const ConstPoint3d& /*primitive*/) {
   return Points3d();
 }
 
+template <>
+UsageRange<Point3d> PointLayer::usages(const ConstPoint3d& /*primitive*/) const {
+  return {};
+}
+
 Areas AreaLayer::findUsages(const RegulatoryElementConstPtr& regElem) {
-  return forEachMatchInMultiMap<Area>(tree_->usage.regElemLookup, regElem,
-                                      [](const auto& elem) { return elem.second; });
+  return findInLookup<Area>(tree_->usage.regElemLookup, tree_->usage.compactRegElem, regElem);
 }
 
 ConstAreas AreaLayer::findUsages(const RegulatoryElementConstPtr& regElem) const {
-  return forEachMatchInMultiMap<ConstArea>(tree_->usage.regElemLookup, regElem,
-                                           [](const auto& elem) { return traits::toConst(elem.second); });
+  return findInLookup<ConstArea>(tree_->usage.regElemLookup, tree_->usage.compactRegElem, regElem);
+}
+
+UsageRange<Area> AreaLayer::usages(const RegulatoryElementConstPtr& regElem) const {
+  return usagesInLookup(tree_->usage.regElemLookup, tree_->usage.compactRegElem, regElem);
 }
 
 Lanelets LaneletLayer::findUsages(const RegulatoryElementConstPtr& regElem) {
-  return forEachMatchInMultiMap<Lanelet>(tree_->usage.regElemLookup, regElem,
-                                         [](const auto& elem) { return elem.second; });
+  return findInLookup<Lanelet>(tree_->usage.regElemLookup, tree_->usage.compactRegElem, regElem);
 }
 
 ConstLanelets LaneletLayer::findUsages(const RegulatoryElementConstPtr& regElem) const {
-  return forEachMatchInMultiMap<ConstLanelet>(tree_->usage.regElemLookup, regElem,
-                                              [](const auto& elem) { return traits::toConst(elem.second); });
+  return findInLookup<ConstLanelet>(tree_->usage.regElemLookup, tree_->usage.compactRegElem, regElem);
+}
+
+UsageRange<Lanelet> LaneletLayer::usages(const RegulatoryElementConstPtr& regElem) const {
+  return usagesInLookup(tree_->usage.regElemLookup, tree_->usage.compactRegElem, regElem);
 }
 
 template <typename T>
 PrimitiveLayer<T>::~PrimitiveLayer() noexcept = default;
 template <typename T>
+PrimitiveLayer<T>::PrimitiveLayer(const PrimitiveLayer& rhs) = default;
+template <typename T>
 PrimitiveLayer<T>::PrimitiveLayer(PrimitiveLayer&& rhs) noexcept = default;
 template <typename T>
 PrimitiveLayer<T>& PrimitiveLayer<T>::operator=(PrimitiveLayer&& rhs) noexcept = default;
 
 template <typename T>
 typename PrimitiveLayer<T>::const_iterator PrimitiveLayer<T>::find(Id id) const {
-  return elements_.find(id);
+  return static_cast<const Map&>(*elements_).find(id);
 }
 
 template <typename T>
 typename PrimitiveLayer<T>::const_iterator PrimitiveLayer<T>::begin() const {
-  return elements_.begin();
+  return elements_->cbegin();
 }
 
 template <typename T>
 typename PrimitiveLayer<T>::const_iterator PrimitiveLayer<T>::end() const {
-  return elements_.end();
+  return elements_->cend();
 }
 
 template <typename T>
 typename PrimitiveLayer<T>::iterator PrimitiveLayer<T>::find(Id id) {
-  return elements_.find(id);
+  return elements_->find(id);
 }
 
 template <typename T>
 typename PrimitiveLayer<T>::iterator PrimitiveLayer<T>::begin() {
-  return elements_.begin();
+  return elements_->begin();
 }
 
 template <typename T>
 typename PrimitiveLayer<T>::iterator PrimitiveLayer<T>::end() {
-  return elements_.end();
+  return elements_->end();
 }
 template <typename T>
 typename PrimitiveLayer<T>::ConstPrimitiveVec PrimitiveLayer<T>::search(const BoundingBox2d& area) const {
@@ -545,6 +964,31 @@ typename PrimitiveLayer<T>::OptPrimitiveT PrimitiveLayer<T>::nearestUntil(const
   return nearestUntilImpl<PrimitiveT>(tree_->rTree, point, func);
 }
 
+template <typename T>
+void PrimitiveLayer<T>::buildSegmentIndex() {
+  if (SegmentSource<T>::Available && !tree_->segments.rTree) {
+    detach();
+    tree_->segments.build(*elements_);
+  }
+}
+
+template <typename T>
+bool PrimitiveLayer<T>::hasSegmentIndex() const {
+  return !!tree_->segments.rTree;
+}
+
+template <typename T>
+typename PrimitiveLayer<T>::OptConstPrimitiveT PrimitiveLayer<T>::nearestSegmentUntil(
+    const BasicPoint2d& point, const ConstSegmentSearchFunction& func) const {
+  return nearestSegmentUntilImpl<ConstPrimitiveT>(tree_->segments.rTree, point, func);
+}
+
+template <typename T>
+typename PrimitiveLayer<T>::OptPrimitiveT PrimitiveLayer<T>::nearestSegmentUntil(const BasicPoint2d& point,
+                                                                                 const SegmentSearchFunction& func) {
+  return nearestSegmentUntilImpl<PrimitiveT>(tree_->segments.rTree, point, func);
+}
+
 template <typename T>
 Id PrimitiveLayer<T>::uniqueId() const {
   return utils::getId();
@@ -561,6 +1005,15 @@ LaneletMapLayers::LaneletMapLayers(const LaneletLayer::Map& lanelets, const Area
       lineStringLayer(lineStrings),
       pointLayer(points) {}
 
+void LaneletMapLayers::buildUsageIndex() {
+  laneletLayer.buildUsageIndex();
+  areaLayer.buildUsageIndex();
+  regulatoryElementLayer.buildUsageIndex();
+  polygonLayer.buildUsageIndex();
+  lineStringLayer.buildUsageIndex();
+  pointLayer.buildUsageIndex();
+}
+
 void LaneletMap::add(Lanelet lanelet) {
   if (lanelet.id() == InvalId) {
     lanelet.setId(laneletLayer.uniqueId());
@@ -678,6 +1131,47 @@ void LaneletMap::add(Point3d point) {
   pointLayer.add(point);
 }
 
+void LaneletMap::replace(Lanelet lanelet) {
+  if (!laneletLayer.exists(lanelet.id())) {
+    throw NoSuchPrimitiveError("Can not replace lanelet " + std::to_string(lanelet.id()) + ", it is not in the map");
+  }
+  laneletLayer.remove(lanelet.id());
+  add(lanelet);
+}
+
+void LaneletMap::replace(Area area) {
+  if (!areaLayer.exists(area.id())) {
+    throw NoSuchPrimitiveError("Can not replace area " + std::to_string(area.id()) + ", it is not in the map");
+  }
+  areaLayer.remove(area.id());
+  add(area);
+}
+
+LaneletMapUPtr LaneletMap::shallowCopy() const { return LaneletMapUPtr(new LaneletMap(*this)); }
+
+LaneletMapVersions::LaneletMapVersions(LaneletMapConstPtr map) : current_{std::move(map)} {
+  if (!current_) {
+    throw NullptrError("LaneletMapVersions requires a valid map!");
+  }
+}
+
+LaneletMapConstPtr LaneletMapVersions::snapshot() const {
+  return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+}
+
+LaneletMapConstPtr LaneletMapVersions::update(const UpdateFunction& modify) {
+  std::lock_guard<std::mutex> lock(updateMutex_);
+  LaneletMapConstPtr next = [&] {
+    auto map = snapshot()->shallowCopy();
+    modify(*map);
+    map->buildUsageIndex();
+    return LaneletMapConstPtr(std::move(map));
+  }();
+  std::atomic_store_explicit(&current_, next, std::memory_order_release);
+  ++version_;
+  return next;
+}
+
 void LaneletSubmap::add(Lanelet lanelet) {
   checkId(lanelet);
   utils::forEach(lanelet.regulatoryElements(), [&](auto& regElem) { this->trackParameters(*regElem); });
@@ -786,24 +1280,29 @@ template std::vector<ConstLayerPrimitive<Polygon3d>> findUsages<Polygon3d>(const
 template std::vector<ConstLayerPrimitive<RegulatoryElementPtr>> findUsages<RegulatoryElementPtr>(
     const PrimitiveLayer<RegulatoryElementPtr>&, Id);
 
+namespace {
+template <typename RetT, typename LayerT>
+RetT findUsagesOfLineStrings(const LayerT& layer, const UsageRange<LineString3d>& lineStrings) {
+  RetT usages;
+  auto append = [&usages](const auto& range) { usages.insert(usages.end(), range.begin(), range.end()); };
+  for (const auto& ls : lineStrings) {
+    append(layer.usages(ls));
+  }
+  for (const auto& ls : lineStrings) {
+    append(layer.usages(ls.invert()));
+  }
+  auto remove = std::unique(usages.begin(), usages.end());
+  usages.erase(remove, usages.end());
+  return usages;
+}
+}  // namespace
+
 ConstLanelets findUsagesInLanelets(const LaneletMapLayers& map, const ConstPoint3d& p) {
-  auto ls = map.lineStringLayer.findUsages(p);
-  auto llts = utils::concatenate(ls, [&map](const auto& ls) { return map.laneletLayer.findUsages(ls); });
-  auto lltsInv = utils::concatenate(ls, [&map](const auto& ls) { return map.laneletLayer.findUsages(ls.invert()); });
-  llts.insert(llts.end(), lltsInv.begin(), lltsInv.end());
-  auto remove = std::unique(llts.begin(), llts.end());
-  llts.erase(remove, llts.end());
-  return llts;
+  return findUsagesOfLineStrings<ConstLanelets>(map.laneletLayer, map.lineStringLayer.usages(p));
 }
 
 ConstAreas findUsagesInAreas(const LaneletMapLayers& map, const ConstPoint3d& p) {
-  auto ls = map.lineStringLayer.findUsages(p);
-  auto areas = utils::concatenate(ls, [&map](const auto& ls) { return map.areaLayer.findUsages(ls); });
-  auto areasInv = utils::concatenate(ls, [&map](const auto& ls) { return map.areaLayer.findUsages(ls.invert()); });
-  areas.insert(areas.end(), areasInv.begin(), areasInv.end());
-  auto remove = std::unique(areas.begin(), areas.end());
-  areas.erase(remove, areas.end());
-  return areas;
+  return findUsagesOfLineStrings<ConstAreas>(map.areaLayer, map.lineStringLayer.usages(p));
 }
 
 LaneletMapUPtr createMap(const Points3d& fromPoints) {
@@ -937,6 +1436,9 @@ class NSmallestElements {
         std::lower_bound(values_.begin(), values_.end(), measure, [](auto& v1, double v2) { return v1.first < v2; });
     if (pos != values_.end() || values_.size() < n_) {
       values_.emplace(pos, measure, value);
+      if (values_.size() > n_) {
+        values_.pop_back();
+      }
       return true;
     }
     return false;
@@ -969,19 +1471,136 @@ auto findNearestImpl(LayerT&& map, const BasicPoint2d& pt, unsigned count) {
   map.nearestUntil(pt, searchFunction);
   return closest.values();
 }
+
+BasicPoint2d projectOnSegment(const BasicSegment2d& segment, const BasicPoint2d& pt) {
+  const BasicPoint2d dir = segment.second - segment.first;
+  const double squaredLength = dir.squaredNorm();
+  if (squaredLength <= 0.) {
+    return segment.first;
+  }
+  const double t = std::max(0., std::min(1., (pt - segment.first).dot(dir) / squaredLength));
+  return segment.first + t * dir;
+}
+
+template <typename RetT, typename LayerT>
+auto findNearestSegmentImpl(LayerT&& map, const BasicPoint2d& pt, unsigned count, std::false_type /*hasSegments*/) {
+  return findNearestImpl<RetT>(map, pt, count);
+}
+
+template <typename RetT, typename LayerT>
+auto findNearestSegmentImpl(LayerT&& map, const BasicPoint2d& pt, unsigned count, std::true_type /*hasSegments*/) {
+  // Idea: The segment index passes us segments with increasing distance. The
+  // first segment we see of a primitive is therefore its closest one. Only
+  // points inside lanelets, areas and polygons have to be handled separately,
+  // because their distance is 0 even if the boundary is far away.
+  using PrimT = typename std::decay_t<LayerT>::PrimitiveT;
+  NSmallestElements<RetT> closest(count);
+  std::unordered_set<Id> seen;
+  if (count == 0) {
+    return closest.values();
+  }
+  if (SegmentSource<PrimT>::Areal) {
+    auto containing = map.search(BoundingBox2d(pt, pt));
+    for (auto& prim : containing) {
+      if (!closest.full() && distance2d(prim, pt) <= 0.) {
+        closest.insert(0., prim);
+        seen.insert(prim.id());
+      }
+    }
+  }
+  map.nearestSegmentUntil(pt, [&](const BasicSegment2d& segment, size_t /*idx*/, const RetT& prim) {
+    if (closest.full()) {
+      return true;
+    }
+    if (seen.insert(prim.id()).second) {
+      closest.insert((projectOnSegment(segment, pt) - pt).norm(), prim);
+    }
+    return false;
+  });
+  return closest.values();
+}
+
+template <typename RetT, typename LayerT>
+std::vector<BoundaryProjection<RetT>> findNearestOnBoundaryImpl(LayerT&& map, const BasicPoint2d& pt,
+                                                                unsigned count) {
+  using PrimT = typename std::decay_t<LayerT>::PrimitiveT;
+  NSmallestElements<BoundaryProjection<RetT>> closest(count);
+  if (count == 0) {
+    return {};
+  }
+  if (map.hasSegmentIndex()) {
+    std::unordered_set<Id> seen;
+    map.nearestSegmentUntil(pt, [&](const BasicSegment2d& segment, size_t idx, const RetT& prim) {
+      if (closest.full()) {
+        return true;
+      }
+      if (seen.insert(prim.id()).second) {
+        auto projected = projectOnSegment(segment, pt);
+        auto d = (projected - pt).norm();
+        closest.insert(d, BoundaryProjection<RetT>{d, projected, prim, idx});
+      }
+      return false;
+    });
+  } else {
+    // the boundary of a primitive is always inside its bounding box, so we can
+    // stop once the box distance exceeds the count-th closest boundary.
+    map.nearestUntil(pt, [&](auto& box, const RetT& prim) {
+      if (closest.full() && distance(box, pt) > closest.values().back().first) {
+        return true;
+      }
+      double bestDistance = std::numeric_limits<double>::infinity();
+      BasicPoint2d bestProjected(0., 0.);
+      size_t bestIdx = 0;
+      SegmentSource<PrimT>::forEach(prim, [&](const BasicSegment2d& segment, size_t idx) {
+        auto projected = projectOnSegment(segment, pt);
+        auto d = (projected - pt).norm();
+        if (d < bestDistance) {
+          bestDistance = d;
+          bestProjected = projected;
+          bestIdx = idx;
+        }
+      });
+      if (bestDistance < std::numeric_limits<double>::infinity()) {
+        closest.insert(bestDistance, BoundaryProjection<RetT>{bestDistance, bestProjected, prim, bestIdx});
+      }
+      return false;
+    });
+  }
+  return utils::transform(closest.values(), [](const auto& elem) { return elem.second; });
+}
 }  // namespace
 
 template <typename PrimT>
 std::vector<std::pair<double, PrimT>> findNearest(PrimitiveLayer<PrimT>& map, const BasicPoint2d& pt, unsigned count) {
+  if (map.hasSegmentIndex()) {
+    return findNearestSegmentImpl<PrimT>(map, pt, count,
+                                         std::integral_constant<bool, SegmentSource<PrimT>::Available>{});
+  }
   return findNearestImpl<PrimT>(map, pt, count);
 }
 
 template <typename PrimT>
 std::vector<std::pair<double, traits::ConstPrimitiveType<PrimT>>> findNearest(const PrimitiveLayer<PrimT>& map,
                                                                               const BasicPoint2d& pt, unsigned count) {
+  if (map.hasSegmentIndex()) {
+    return findNearestSegmentImpl<traits::ConstPrimitiveType<PrimT>>(
+        map, pt, count, std::integral_constant<bool, SegmentSource<PrimT>::Available>{});
+  }
   return findNearestImpl<traits::ConstPrimitiveType<PrimT>>(map, pt, count);
 }
 
+template <typename PrimT>
+std::vector<BoundaryProjection<PrimT>> findNearestOnBoundary(PrimitiveLayer<PrimT>& map, const BasicPoint2d& pt,
+                                                             unsigned count) {
+  return findNearestOnBoundaryImpl<PrimT>(map, pt, count);
+}
+
+template <typename PrimT>
+std::vector<BoundaryProjection<traits::ConstPrimitiveType<PrimT>>> findNearestOnBoundary(
+    const PrimitiveLayer<PrimT>& map, const BasicPoint2d& pt, unsigned count) {
+  return findNearestOnBoundaryImpl<traits::ConstPrimitiveType<PrimT>>(map, pt, count);
+}
+
 // instanciate
 // clang-format off
 // NOLINTNEXTLINE
@@ -1004,5 +1623,23 @@ INSTANCIATE_CONST_FIND_NEAREST(RegulatoryElementPtr, RegulatoryElementConstPtr);
 INSTANCIATE_CONST_FIND_NEAREST(Polygon3d, ConstPolygon3d);
 INSTANCIATE_CONST_FIND_NEAREST(Point3d, ConstPoint3d);
 #undef INSTANCIATE_CONST_FIND_NEAREST
+
+// clang-format off
+// NOLINTNEXTLINE
+#define INSTANCIATE_FIND_NEAREST_ON_BOUNDARY(PRIM) template std::vector<BoundaryProjection<PRIM>> findNearestOnBoundary<PRIM>(PrimitiveLayer<PRIM>&, const BasicPoint2d&, unsigned)
+// NOLINTNEXTLINE
+#define INSTANCIATE_CONST_FIND_NEAREST_ON_BOUNDARY(PRIM, CPRIM) template std::vector<BoundaryProjection<CPRIM>> findNearestOnBoundary<PRIM>(const PrimitiveLayer<PRIM>&, const BasicPoint2d&, unsigned)
+// clang-format on
+INSTANCIATE_FIND_NEAREST_ON_BOUNDARY(Lanelet);
+INSTANCIATE_FIND_NEAREST_ON_BOUNDARY(Area);
+INSTANCIATE_FIND_NEAREST_ON_BOUNDARY(LineString3d);
+INSTANCIATE_FIND_NEAREST_ON_BOUNDARY(Polygon3d);
+#undef INSTANCIATE_FIND_NEAREST_ON_BOUNDARY
+
+INSTANCIATE_CONST_FIND_NEAREST_ON_BOUNDARY(Lanelet, ConstLanelet);
+INSTANCIATE_CONST_FIND_NEAREST_ON_BOUNDARY(Area, ConstArea);
+INSTANCIATE_CONST_FIND_NEAREST_ON_BOUNDARY(LineString3d, ConstLineString3d);
+INSTANCIATE_CONST_FIND_NEAREST_ON_BOUNDARY(Polygon3d, ConstPolygon3d);
+#undef INSTANCIATE_CONST_FIND_NEAREST_ON_BOUNDARY
 }  // namespace geometry
 }  // namespace lanelet
@@ -26,6 +26,18 @@ lanelet::CompoundPolygon3d lanelet::LaneletSequenceData::polygon() const {
   return *polygon;
 }
 
+ArcLengthIndex2dConstPtr LaneletSequenceData::centerlineArcLengthIndex(bool inverted) const {
+  auto& cache = inverted ? invertedCenterlineIndex_ : centerlineIndex_;
+  auto index = std::atomic_load_explicit(&cache, std::memory_order_acquire);
+  if (!index) {
+    auto centerline = utils::to2D(this->centerline());
+    index = inverted ? std::make_shared<const ArcLengthIndex2d>(centerline.invert())
+                     : std::make_shared<const ArcLengthIndex2d>(centerline);
+    std::atomic_store_explicit(&cache, index, std::memory_order_release);
+  }
+  return index;
+}
+
 RegulatoryElementConstPtrs LaneletSequence::regulatoryElements() const {
   return utils::concatenate(lanelets(), [](const auto& elem) { return elem.regulatoryElements(); });
 }
@@ -6,6 +6,10 @@
 #include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/pointing_segment.hpp>
 #include <boost/geometry/index/rtree.hpp>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "lanelet2_core/Exceptions.h"
 #include "lanelet2_core/geometry/LineString.h"
 #include "lanelet2_core/geometry/Polygon.h"
 
@@ -151,6 +155,196 @@ std::pair<BasicPoint3d, BasicPoint3d> projectedPoint3dImpl(const LineString1T& l
   auto res = projectedPoint3dOrdered(l2, l1);
   return {res.second, res.first};
 }
+// Vectorized search for the segment of a contiguous linestring that is closest to a point. The points of the
+// linestring are read directly from the memory of the std::vector, Dim is the number of doubles per point.
+struct ClosestSegmentResult {
+  size_t idx{0};
+  double squaredDistance{std::numeric_limits<double>::infinity()};
+};
+
+template <int Dim>
+inline double segmentParameter(const double* a, const double* b, const double* p) {
+  double dot = 0.;
+  double squaredLength = 0.;
+  for (int k = 0; k < Dim; ++k) {
+    const double d = b[k] - a[k];
+    dot += (p[k] - a[k]) * d;
+    squaredLength += d * d;
+  }
+  const double t = squaredLength > 0. ? dot / squaredLength : 0.;
+  return std::min(std::max(t, 0.), 1.);
+}
+
+template <int Dim>
+inline void projectOnSegment(const double* a, const double* b, const double* p, double* result) {
+  const double t = segmentParameter<Dim>(a, b, p);
+  for (int k = 0; k < Dim; ++k) {
+    result[k] = t >= 1. ? b[k] : a[k] + t * (b[k] - a[k]);
+  }
+}
+
+template <int Dim>
+inline double squaredDistanceToSegment(const double* a, const double* b, const double* p) {
+  double q[Dim];
+  projectOnSegment<Dim>(a, b, p, q);
+  double squaredDistance = 0.;
+  for (int k = 0; k < Dim; ++k) {
+    squaredDistance += (p[k] - q[k]) * (p[k] - q[k]);
+  }
+  return squaredDistance;
+}
+
+// merges the per-lane results of a vectorized search into best. Lanes are compared by distance, then by index, so
+// that the first of several equally close segments wins, as in the scalar version.
+template <size_t Lanes>
+inline void reduceLanes(const double (&squaredDistances)[Lanes], const double (&indices)[Lanes],
+                        ClosestSegmentResult& best) {
+  ClosestSegmentResult laneBest;
+  for (auto lane = 0u; lane < Lanes; ++lane) {
+    const auto idx = size_t(indices[lane]);
+    if (squaredDistances[lane] < laneBest.squaredDistance ||
+        (squaredDistances[lane] == laneBest.squaredDistance && idx < laneBest.idx)) {
+      laneBest = {idx, squaredDistances[lane]};
+    }
+  }
+  if (laneBest.squaredDistance < best.squaredDistance) {
+    best = laneBest;
+  }
+}
+
+#if defined(__SSE2__)
+inline __m128d select(const __m128d& mask, const __m128d& ifTrue, const __m128d& ifFalse) {
+  return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+// two segments at once, starting at segment i. Works for 2d and 3d points.
+template <int Dim>
+inline size_t closestSegmentSse(const double* pts, size_t i, size_t numSegments, const double* p,
+                                ClosestSegmentResult& best) {
+  if (i + 2 > numSegments) {
+    return i;
+  }
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d one = _mm_set1_pd(1.);
+  const __m128d two = _mm_set1_pd(2.);
+  __m128d idx = _mm_setr_pd(double(i), double(i + 1));
+  __m128d bestIdx = idx;
+  __m128d bestDist = _mm_set1_pd(std::numeric_limits<double>::infinity());
+  for (; i + 2 <= numSegments; i += 2) {
+    const double* seg = pts + Dim * i;
+    __m128d a[Dim];
+    __m128d b[Dim];
+    __m128d d[Dim];
+    __m128d dot = zero;
+    __m128d squaredLength = zero;
+    for (int k = 0; k < Dim; ++k) {
+      // coordinate k of the points i, i+1 and i+1, i+2
+      a[k] = _mm_loadh_pd(_mm_load_sd(seg + k), seg + Dim + k);
+      b[k] = _mm_loadh_pd(_mm_load_sd(seg + Dim + k), seg + 2 * Dim + k);
+      d[k] = _mm_sub_pd(b[k], a[k]);
+      dot = _mm_add_pd(dot, _mm_mul_pd(_mm_sub_pd(_mm_set1_pd(p[k]), a[k]), d[k]));
+      squaredLength = _mm_add_pd(squaredLength, _mm_mul_pd(d[k], d[k]));
+    }
+    // max returns its second operand for NaN, i.e. degenerated segments get t=0
+    const __m128d t = _mm_min_pd(_mm_max_pd(_mm_div_pd(dot, squaredLength), zero), one);
+    const __m128d atEnd = _mm_cmpge_pd(t, one);
+    __m128d squaredDistance = zero;
+    for (int k = 0; k < Dim; ++k) {
+      const __m128d q = select(atEnd, b[k], _mm_add_pd(a[k], _mm_mul_pd(t, d[k])));
+      const __m128d e = _mm_sub_pd(_mm_set1_pd(p[k]), q);
+      squaredDistance = _mm_add_pd(squaredDistance, _mm_mul_pd(e, e));
+    }
+    const __m128d closer = _mm_cmplt_pd(squaredDistance, bestDist);
+    bestDist = select(closer, squaredDistance, bestDist);
+    bestIdx = select(closer, idx, bestIdx);
+    idx = _mm_add_pd(idx, two);
+  }
+  double squaredDistances[2];
+  double indices[2];
+  _mm_storeu_pd(squaredDistances, bestDist);
+  _mm_storeu_pd(indices, bestIdx);
+  reduceLanes(squaredDistances, indices, best);
+  return i;
+}
+#endif
+
+template <int Dim>
+ClosestSegmentResult findClosestSegment(const double* pts, size_t numPoints, const double* p) {
+  ClosestSegmentResult best;
+  const size_t numSegments = numPoints - 1;
+  size_t i = 0;
+#if defined(__SSE2__)
+  i = closestSegmentSse<Dim>(pts, i, numSegments, p, best);
+#endif
+  for (; i < numSegments; ++i) {
+    const auto squaredDistance = squaredDistanceToSegment<Dim>(pts + Dim * i, pts + Dim * (i + 1), p);
+    if (squaredDistance < best.squaredDistance) {
+      best = {i, squaredDistance};
+    }
+  }
+  return best;
+}
+
+// the projection of a point on a contiguous linestring, including everything required to compute arc coordinates or
+// the side of the point
+template <typename PointT>
+struct ContiguousProjection {
+  size_t segmentIdx;  // index of the first point of the closest segment
+  PointT projectedPoint;
+};
+
+template <typename LineStringT, typename PointT>
+ContiguousProjection<PointT> projectContiguousImpl(const LineStringT& ls, const PointT& p) {
+  constexpr int Dim = PointT::RowsAtCompileTime;
+  static_assert(sizeof(typename LineStringT::value_type) == Dim * sizeof(double), "Points must be stored densely!");
+  if (ls.empty()) {
+    throw InvalidInputError("Can not project on an empty linestring");
+  }
+  if (ls.size() == 1) {
+    return {0, ls.front()};
+  }
+  const double* pts = ls.front().data();
+  const auto best = findClosestSegment<Dim>(pts, ls.size(), p.data());
+  ContiguousProjection<PointT> result{best.idx, PointT()};
+  projectOnSegment<Dim>(pts + Dim * best.idx, pts + Dim * (best.idx + 1), p.data(), result.projectedPoint.data());
+  return result;
+}
+
+// like internal::isLeftOf, but uses the known segment index instead of searching the segment
+template <typename LineStringT, typename PointT>
+bool isLeftOfContiguous(const LineStringT& ls, const PointT& p, const ContiguousProjection<PointT>& proj) {
+  if (ls.size() < 2) {
+    return false;
+  }
+  const PointT pSeg1 = ls[proj.segmentIdx];
+  const PointT pSeg2 = ls[proj.segmentIdx + 1];
+  if (pSeg2 == proj.projectedPoint && proj.segmentIdx + 2 < ls.size()) {
+    return internal::isLeftOfCorner(pSeg1, pSeg2, PointT(ls[proj.segmentIdx + 2]), p);
+  }
+  return internal::pointIsLeftOf(pSeg1, pSeg2, p);
+}
+
+template <typename LineStringT, typename PointT>
+double signedDistanceContiguous(const LineStringT& ls, const PointT& p) {
+  const auto proj = projectContiguousImpl(ls, p);
+  const auto d = (p - proj.projectedPoint).norm();
+  return isLeftOfContiguous(ls, p, proj) ? d : -d;
+}
+
+double lengthUntil(const BasicLineString2d& ls, size_t idx) {
+  double length = 0.;
+  for (auto i = 1u; i <= idx; ++i) {
+    length += (ls[i] - ls[i - 1]).norm();
+  }
+  return length;
+}
+
+ArcCoordinates toArcCoordinatesContiguous(const BasicLineString2d& ls, const BasicPoint2d& p,
+                                          const ContiguousProjection<BasicPoint2d>& proj, double segmentStartLength) {
+  const auto d = (p - proj.projectedPoint).norm();
+  const BasicPoint2d segmentStart = ls[proj.segmentIdx];
+  return {segmentStartLength + (proj.projectedPoint - segmentStart).norm(), isLeftOfContiguous(ls, p, proj) ? d : -d};
+}
 }  // namespace
 
 namespace internal {
@@ -199,14 +393,74 @@ std::pair<BasicPoint3d, BasicPoint3d> projectedBorderPoint3d(const CompoundHybri
 }  // namespace internal
 
 Segment<BasicPoint2d> closestSegment(const BasicLineString2d& lineString, const BasicPoint2d& pointToProject) {
-  helper::ProjectedPoint<BasicPoint2d> projectedPoint;
-  distance(lineString, pointToProject, projectedPoint);
-  return Segment<BasicPoint2d>(projectedPoint.result->segmentPoint1, projectedPoint.result->segmentPoint2);
+  const auto proj = projectContiguousImpl(lineString, pointToProject);
+  const auto last = std::min(proj.segmentIdx + 1, lineString.size() - 1);
+  return Segment<BasicPoint2d>(lineString[proj.segmentIdx], lineString[last]);
 }
 Segment<BasicPoint3d> closestSegment(const BasicLineString3d& lineString, const BasicPoint3d& pointToProject) {
-  helper::ProjectedPoint<BasicPoint3d> projectedPoint;
-  distance(lineString, pointToProject, projectedPoint);
-  return Segment<BasicPoint3d>(projectedPoint.result->segmentPoint1, projectedPoint.result->segmentPoint2);
+  const auto proj = projectContiguousImpl(lineString, pointToProject);
+  const auto last = std::min(proj.segmentIdx + 1, lineString.size() - 1);
+  return Segment<BasicPoint3d>(lineString[proj.segmentIdx], lineString[last]);
+}
+
+BasicPoint2d project(const BasicLineString2d& lineString, const BasicPoint2d& pointToProject) {
+  return projectContiguousImpl(lineString, pointToProject).projectedPoint;
+}
+
+BasicPoint3d project(const BasicLineString3d& lineString, const BasicPoint3d& pointToProject) {
+  return projectContiguousImpl(lineString, pointToProject).projectedPoint;
+}
+
+BasicPoints2d project(const BasicLineString2d& lineString, const BasicPoints2d& pointsToProject) {
+  BasicPoints2d result;
+  result.reserve(pointsToProject.size());
+  for (const BasicPoint2d p : pointsToProject) {
+    result.emplace_back(projectContiguousImpl(lineString, p).projectedPoint);
+  }
+  return result;
+}
+
+double signedDistance(const BasicLineString2d& lineString, const BasicPoint2d& p) {
+  return signedDistanceContiguous(lineString, p);
+}
+
+double signedDistance(const BasicLineString3d& lineString, const BasicPoint3d& p) {
+  return signedDistanceContiguous(lineString, p);
+}
+
+std::vector<double> signedDistance(const BasicLineString2d& lineString, const BasicPoints2d& points) {
+  return utils::transform(points,
+                          [&lineString](const BasicPoint2d& p) { return signedDistanceContiguous(lineString, p); });
+}
+
+ArcCoordinates toArcCoordinates(const BasicLineString2d& lineString, const BasicPoint2d& point) {
+  const auto proj = projectContiguousImpl(lineString, point);
+  return toArcCoordinatesContiguous(lineString, point, proj, lengthUntil(lineString, proj.segmentIdx));
+}
+
+std::vector<ArcCoordinates> toArcCoordinates(const BasicLineString2d& lineString, const BasicPoints2d& points) {
+  return toArcCoordinates(ArcLengthIndex2d(lineString), points);
+}
+
+ArcCoordinates toArcCoordinates(const ArcLengthIndex2d& index, const BasicPoint2d& point) {
+  const auto proj = projectContiguousImpl(index.lineString(), point);
+  return toArcCoordinatesContiguous(index.lineString(), point, proj, index.accumulatedLengths()[proj.segmentIdx]);
+}
+
+std::vector<ArcCoordinates> toArcCoordinates(const ArcLengthIndex2d& index, const BasicPoints2d& points) {
+  if (index.empty()) {
+    throw InvalidInputError("Can not project on an empty linestring");
+  }
+  return utils::transform(points, [&index](const BasicPoint2d& p) { return toArcCoordinates(index, p); });
+}
+
+BasicPoint2d fromArcCoordinates(const ArcLengthIndex2d& index, const ArcCoordinates& arcCoords) {
+  if (index.size() < 2) {
+    throw InvalidInputError("Can't use arc coordinates on degenerated line string");
+  }
+  const auto startIdx = index.segmentIndexAtDistance(arcCoords.length);
+  return internal::fromArcCoords(index.lineString(), index.interpolatedPointAtDistance(arcCoords.length), startIdx,
+                                 startIdx + 1, arcCoords.distance);
 }
 }  // namespace geometry
 }  // namespace lanelet
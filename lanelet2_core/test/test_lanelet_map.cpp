@@ -184,6 +184,78 @@ TEST_F(LaneletMapTest, findNearestWorksOnEmptyMap) {  // NOLINT
   });
 }
 
+TEST_F(LaneletMapTest, findNearestWithSegmentIndexWorksForLanelets) {  // NOLINT
+  this->map = utils::createMap({ll1, ll2});
+  this->map->laneletLayer.buildSegmentIndex();
+  EXPECT_TRUE(this->map->laneletLayer.hasSegmentIndex());
+  testConstAndNonConst([this](auto& map) {
+    auto llts = geometry::findNearest(map->laneletLayer, BasicPoint2d(0, -10), 10);
+    ASSERT_EQ(2ul, llts.size());
+    EXPECT_DOUBLE_EQ(9, llts.front().first);
+    EXPECT_EQ(ll2, llts.front().second);
+    auto inside = geometry::findNearest(map->laneletLayer, BasicPoint2d(0.5, 0.75), 1);
+    ASSERT_EQ(1ul, inside.size());
+    EXPECT_DOUBLE_EQ(0, inside.front().first);
+    EXPECT_EQ(ll1, inside.front().second);
+  });
+}
+
+TEST_F(LaneletMapTest, findNearestWithSegmentIndexWorksForLineStrings) {  // NOLINT
+  map->add(other);
+  map->add(outside);
+  auto expected = geometry::findNearest(map->lineStringLayer, BasicPoint2d(2, 0.25), 3);
+  map->lineStringLayer.buildSegmentIndex();
+  map->add(LineString3d(getId(), {Point3d(getId(), 2, 3, 0), Point3d(getId(), 2, 5, 0)}));
+  testConstAndNonConst([&](auto& map) {
+    auto ls = geometry::findNearest(map->lineStringLayer, BasicPoint2d(2, 0.25), 3);
+    ASSERT_EQ(expected.size(), ls.size());
+    for (auto i = 0u; i < ls.size(); ++i) {
+      EXPECT_DOUBLE_EQ(expected[i].first, ls[i].first);
+    }
+    auto added = geometry::findNearest(map->lineStringLayer, BasicPoint2d(2, 4), 1);
+    ASSERT_EQ(1ul, added.size());
+    EXPECT_DOUBLE_EQ(0, added.front().first);
+  });
+}
+
+TEST_F(LaneletMapTest, findNearestWithSegmentIndexFindsSharedSegments) {  // NOLINT
+  // many lines with the same segment, like the boundaries that neighbouring lanelets share
+  this->map = std::make_unique<LaneletMap>();
+  Point3d first(getId(), 1, 0, 0);
+  Point3d second(getId(), 1, 1, 0);
+  for (auto i = 0; i < 40; ++i) {
+    map->add(LineString3d(getId(), {first, second, Point3d(getId(), 2 + i, 1, 0)}));
+  }
+  map->lineStringLayer.buildSegmentIndex();
+  testConstAndNonConst([](auto& map) {
+    auto ls = geometry::findNearest(map->lineStringLayer, BasicPoint2d(0, 0.5), 40);
+    ASSERT_EQ(40ul, ls.size());
+    EXPECT_DOUBLE_EQ(1, ls.back().first);
+    auto boundary = geometry::findNearestOnBoundary(map->lineStringLayer, BasicPoint2d(0, 0.5), 40);
+    ASSERT_EQ(40ul, boundary.size());
+    EXPECT_DOUBLE_EQ(1, boundary.back().distance);
+  });
+}
+
+TEST_F(LaneletMapTest, segmentIndexIsIgnoredForPoints) {  // NOLINT
+  map->pointLayer.buildSegmentIndex();
+  EXPECT_FALSE(map->pointLayer.hasSegmentIndex());
+}
+
+TEST_F(LaneletMapTest, findNearestOnBoundary) {  // NOLINT
+  this->map = utils::createMap({ll1, ll2});
+  auto check = [this](auto& map) {
+    auto llts = geometry::findNearestOnBoundary(map->laneletLayer, BasicPoint2d(0.5, 0.8), 1);
+    ASSERT_EQ(1ul, llts.size());
+    EXPECT_NEAR(0.2, llts.front().distance, 1e-9);
+    EXPECT_NEAR(1., llts.front().projectedPoint.y(), 1e-9);
+    EXPECT_EQ(ll1, llts.front().primitive);
+  };
+  testConstAndNonConst(check);
+  this->map->laneletLayer.buildSegmentIndex();
+  testConstAndNonConst(check);
+}
+
 TEST_F(LaneletMapTest, findUsagesInLanelet) {  // NOLINT
   testConstAndNonConst([this](auto& map) {
     auto llts = utils::findUsagesInLanelets(*map, p4);
@@ -251,3 +323,163 @@ TEST_F(LaneletMapTest, createSubmap) {  // NOLINT
   EXPECT_LT(0ul, llMap->lineStringLayer.size());
   EXPECT_LT(0ul, llMap->pointLayer.size());
 }
+
+TEST_F(LaneletMapTest, shallowCopyIsIndependentOnceModified) {  // NOLINT
+  map->laneletLayer.buildSegmentIndex();
+  auto copy = map->shallowCopy();
+  EXPECT_EQ(map->size(), copy->size());
+  EXPECT_TRUE(copy->laneletLayer.hasSegmentIndex());
+  copy->add(ll2);
+  EXPECT_TRUE(copy->laneletLayer.exists(ll2.id()));
+  EXPECT_TRUE(copy->lineStringLayer.exists(other.id()));
+  EXPECT_FALSE(map->laneletLayer.exists(ll2.id()));
+  EXPECT_FALSE(map->lineStringLayer.exists(other.id()));
+  EXPECT_FALSE(map->pointLayer.exists(p8.id()));
+  EXPECT_EQ(1ul, map->laneletLayer.search(BoundingBox2d(BasicPoint2d(0, -1), BasicPoint2d(1, 1))).size());
+  EXPECT_EQ(2ul, copy->laneletLayer.search(BoundingBox2d(BasicPoint2d(0, -1), BasicPoint2d(1, 1))).size());
+  auto nearest = geometry::findNearest(map->laneletLayer, BasicPoint2d(0.5, -0.5), 1);
+  ASSERT_EQ(1ul, nearest.size());
+  EXPECT_EQ(ll1, nearest.front().second);
+  auto nearestInCopy = geometry::findNearest(copy->laneletLayer, BasicPoint2d(0.5, -0.5), 1);
+  ASSERT_EQ(1ul, nearestInCopy.size());
+  EXPECT_EQ(ll2, nearestInCopy.front().second);
+}
+
+TEST_F(LaneletMapTest, replaceLanelet) {  // NOLINT
+  map->laneletLayer.buildSegmentIndex();
+  auto copy = map->shallowCopy();
+  Lanelet patched(ll1.id(), ll1.leftBound(), ll1.rightBound(), ll1.attributes(), ll1.regulatoryElements());
+  patched.setAttribute("speed_limit", "30");
+  copy->replace(patched);
+  EXPECT_EQ(map->size(), copy->size());
+  EXPECT_FALSE(map->laneletLayer.get(ll1.id()).hasAttribute("speed_limit"));
+  EXPECT_TRUE(copy->laneletLayer.get(ll1.id()).hasAttribute("speed_limit"));
+  auto usages = copy->laneletLayer.findUsages(left);
+  ASSERT_EQ(1ul, usages.size());
+  EXPECT_EQ(patched, usages.front());
+  auto found = copy->laneletLayer.search(BoundingBox2d(BasicPoint2d(0, 0), BasicPoint2d(1, 1)));
+  ASSERT_EQ(1ul, found.size());
+  EXPECT_EQ(patched, found.front());
+  auto nearest = geometry::findNearestOnBoundary(copy->laneletLayer, BasicPoint2d(0.5, 0.8), 2);
+  ASSERT_EQ(1ul, nearest.size());
+  EXPECT_EQ(patched, nearest.front().primitive);
+  EXPECT_EQ(ll1, map->laneletLayer.findUsages(left).front());
+  EXPECT_THROW(copy->replace(ll2), NoSuchPrimitiveError);  // NOLINT
+}
+
+TEST_F(LaneletMapTest, replaceArea) {  // NOLINT
+  Area patched(ar1.id(), ar1.outerBound(), ar1.innerBounds(), ar1.attributes(), ar1.regulatoryElements());
+  patched.setAttribute("subtype", "parking");
+  map->replace(patched);
+  auto usages = map->areaLayer.findUsages(left);
+  ASSERT_EQ(1ul, usages.size());
+  EXPECT_EQ(patched, usages.front());
+  EXPECT_EQ(1ul, map->areaLayer.size());
+}
+
+TEST_F(LaneletMapTest, mapVersionsKeepSnapshotsValid) {  // NOLINT
+  LaneletMapVersions versions(map);
+  auto first = versions.snapshot();
+  auto second = versions.update([&](LaneletMap& map) { map.add(ll2); });
+  EXPECT_EQ(1ul, versions.version());
+  EXPECT_EQ(second, versions.snapshot());
+  EXPECT_FALSE(first->laneletLayer.exists(ll2.id()));
+  EXPECT_TRUE(second->laneletLayer.exists(ll2.id()));
+  EXPECT_THROW(versions.update([](LaneletMap& /*map*/) { throw LaneletError("failed"); }), LaneletError);  // NOLINT
+  EXPECT_EQ(second, versions.snapshot());
+  EXPECT_EQ(1ul, versions.version());
+}
+
+TEST_F(LaneletMapTest, mapVersionsConcurrentReaders) {  // NOLINT
+  LaneletMapVersions versions(map);
+  std::atomic<bool> done{false};
+  auto read = [&] {
+    size_t lanelets = 0;
+    while (!done) {
+      auto snapshot = versions.snapshot();
+      auto found = snapshot->laneletLayer.search(BoundingBox2d(BasicPoint2d(-100, -100), BasicPoint2d(100, 100)));
+      EXPECT_EQ(snapshot->laneletLayer.size(), found.size());
+      EXPECT_GE(found.size(), lanelets);
+      lanelets = found.size();
+    }
+    return lanelets;
+  };
+  auto reader1 = std::async(std::launch::async, read);
+  auto reader2 = std::async(std::launch::async, read);
+  for (auto i = 0; i < 50; ++i) {
+    versions.update([i](LaneletMap& map) {
+      auto offset = double(i + 2);
+      LineString3d left(getId(), {Point3d(getId(), 0, offset + 1, 0), Point3d(getId(), 1, offset + 1, 0)});
+      LineString3d right(getId(), {Point3d(getId(), 0, offset, 0), Point3d(getId(), 1, offset, 0)});
+      map.add(Lanelet(getId(), left, right));
+    });
+  }
+  done = true;
+  reader1.get();
+  reader2.get();
+  EXPECT_EQ(51ul, versions.snapshot()->laneletLayer.size());
+  EXPECT_EQ(1ul, map->laneletLayer.size());
+}
+
+TEST_F(LaneletMapTest, usageIndexGivesSameResults) {  // NOLINT
+  ll2.addRegulatoryElement(regelem1);
+  map->add(ll2);
+  map->buildUsageIndex();
+  EXPECT_TRUE(map->laneletLayer.hasUsageIndex());
+  EXPECT_TRUE(map->regulatoryElementLayer.hasUsageIndex());
+  EXPECT_FALSE(map->pointLayer.hasUsageIndex());
+  testConstAndNonConst([this](auto& map) {
+    auto usages = map->laneletLayer.findUsages(regelem1);
+    ASSERT_EQ(1ul, usages.size());
+    EXPECT_EQ(ll2, usages[0]);
+    auto polys = map->polygonLayer.findUsages(p1);
+    ASSERT_EQ(1ul, polys.size());
+    EXPECT_EQ(poly1, polys[0]);
+    EXPECT_TRUE(map->polygonLayer.findUsages(p9).empty());
+    auto regelems = map->regulatoryElementLayer.findUsages(p9);
+    ASSERT_EQ(1ul, regelems.size());
+    EXPECT_EQ(regelem1, regelems[0]);
+    EXPECT_EQ(1ul, map->regulatoryElementLayer.findUsages(ll1).size());
+    EXPECT_TRUE(map->regulatoryElementLayer.findUsages(ll2).empty());
+    EXPECT_EQ(ar1, map->areaLayer.findUsages(left).at(0));
+    EXPECT_TRUE(map->laneletLayer.findUsages(left.invert()).empty());
+  });
+  auto llts = utils::findUsagesInLanelets(*map, p4);
+  ASSERT_EQ(1ul, llts.size());
+  EXPECT_EQ(ll1, llts[0]);
+  auto ars = utils::findUsagesInAreas(*map, p4);
+  ASSERT_EQ(1ul, ars.size());
+  EXPECT_EQ(ar1, ars[0]);
+}
+
+TEST_F(LaneletMapTest, usagesView) {  // NOLINT
+  map->add(ll2);
+  auto check = [this] {
+    auto lineStrings = map->lineStringLayer.usages(p6);
+    ASSERT_EQ(1ul, lineStrings.size());
+    EXPECT_EQ(other, lineStrings[0]);
+    auto lanelets = map->laneletLayer.usages(outside);
+    ASSERT_EQ(1ul, lanelets.size());
+    EXPECT_EQ(ll2, *lanelets.begin());
+    EXPECT_TRUE(map->laneletLayer.usages(regelem1).empty());
+    EXPECT_TRUE(map->pointLayer.usages(p1).empty());
+  };
+  check();
+  map->buildUsageIndex();
+  check();
+}
+
+TEST_F(LaneletMapTest, usageIndexIsDroppedOnModification) {  // NOLINT
+  map->buildUsageIndex();
+  auto copy = map->shallowCopy();
+  copy->add(ll2);
+  EXPECT_FALSE(copy->laneletLayer.hasUsageIndex());
+  EXPECT_TRUE(copy->areaLayer.hasUsageIndex());
+  EXPECT_TRUE(map->laneletLayer.hasUsageIndex());
+  EXPECT_EQ(ll2, copy->laneletLayer.findUsages(other).at(0));
+  EXPECT_EQ(ll1, copy->laneletLayer.findUsages(left).at(0));
+  EXPECT_TRUE(map->laneletLayer.findUsages(other).empty());
+  copy->buildUsageIndex();
+  EXPECT_EQ(ll2, copy->laneletLayer.findUsages(other).at(0));
+  EXPECT_EQ(ll1, copy->laneletLayer.findUsages(left).at(0));
+}
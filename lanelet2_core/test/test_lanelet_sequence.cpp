@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
+#include <cmath>
 #include <iostream>
+#include <random>
 #include "lanelet2_core/geometry/LineString.h"
 #include "lanelet2_core/geometry/RegulatoryElement.h"
 #include "lanelet2_core/primitives/BasicRegulatoryElements.h"
+#include "lanelet2_core/primitives/FrenetFrame.h"
 #include "lanelet2_core/primitives/LaneletSequence.h"
 #include "lanelet2_core/utility/Utilities.h"
 
@@ -84,3 +87,88 @@ TEST_F(LaneletSequenceTest, RegulatoryElementExtraction) {  // NOLINT
   EXPECT_EQ(1ul, cll.regulatoryElementsAs<TrafficSign>().size());
   EXPECT_TRUE(cll.regulatoryElementsAs<RightOfWay>().empty());
 }
+
+TEST_F(LaneletSequenceTest, CenterlineArcLengthIndex) {  // NOLINT
+  auto index = cll.centerlineArcLengthIndex2d();
+  ASSERT_TRUE(!!index);
+  EXPECT_EQ(index, cll.centerlineArcLengthIndex2d());
+  EXPECT_DOUBLE_EQ(geometry::length(cll.centerline2d()), index->length());
+  auto inverted = cll.invert().centerlineArcLengthIndex2d();
+  EXPECT_DOUBLE_EQ(index->length(), inverted->length());
+  EXPECT_EQ(index->lineString().front(), inverted->lineString().back());
+  auto arc = geometry::toArcCoordinates(*index, BasicPoint2d(1.5, 1.));
+  EXPECT_DOUBLE_EQ(0.5, arc.distance);
+  EXPECT_NEAR(geometry::toArcCoordinates(cll.centerline2d(), BasicPoint2d(1.5, 1.)).length, arc.length, 1e-10);
+}
+
+namespace {
+// quarter of a circle with radius 10 around the origin, split into two lanelets that are 2 wide
+LaneletSequence makeCurve() {
+  Id id = 1000;
+  auto arc = [&id](double radius, int from, int to) {
+    LineString3d ls(++id);
+    for (auto i = from; i <= to; ++i) {
+      const double angle = M_PI_2 * i / 20.;
+      ls.push_back(Point3d(++id, radius * std::sin(angle), 10. - radius * std::cos(angle), 0.));
+    }
+    return ls;
+  };
+  Lanelet first(++id, arc(9., 0, 10), arc(11., 0, 10));
+  Lanelet second(++id, arc(9., 10, 20), arc(11., 10, 20));
+  return LaneletSequence({first, second});
+}
+}  // namespace
+
+TEST_F(LaneletSequenceTest, FrenetFrameMatchesArcCoordinates) {  // NOLINT
+  FrenetFrame frame(cll);
+  auto index = cll.centerlineArcLengthIndex2d();
+  EXPECT_DOUBLE_EQ(index->length(), frame.length());
+  std::mt19937 gen(42);  // NOLINT
+  std::uniform_real_distribution<double> coord(-1., 3.);
+  for (auto i = 0; i < 200; ++i) {
+    BasicPoint2d p(coord(gen), coord(gen));
+    auto expected = geometry::toArcCoordinates(*index, p);
+    auto arc = frame.toArcCoordinates(p);
+    EXPECT_NEAR(expected.length, arc.length, 1e-10);
+    EXPECT_NEAR(expected.distance, arc.distance, 1e-10);
+  }
+  EXPECT_EQ(frame.laneletAt(0.2), ll1);
+  EXPECT_EQ(frame.laneletAt(1.5), ll2);
+  EXPECT_EQ(frame.laneletAt(5.), ll2);
+}
+
+TEST_F(LaneletSequenceTest, FrenetFrameOnCurve) {  // NOLINT
+  auto curve = makeCurve();
+  FrenetFrame frame(curve);
+  EXPECT_NEAR(frame.length(), 10. * M_PI_2, 0.01);
+  EXPECT_NEAR(frame.curvature(5.), 0.1, 5e-3);
+  EXPECT_NEAR(frame.curvature(0.), 0.1, 5e-3);
+  EXPECT_NEAR(frame.width(5.), 2., 5e-3);
+  EXPECT_NEAR(frame.leftWidth(5.), 1., 5e-3);
+  EXPECT_NEAR(frame.heading(0.1), 0., 0.1);
+  EXPECT_NEAR(frame.heading(frame.length() - 0.1), M_PI_2, 0.1);
+  EXPECT_EQ(frame.laneletAt(frame.length() - 1.), curve.lanelets().back());
+
+  std::vector<ArcCoordinates> arcs{{1., 0.5}, {7.5, -0.8}, {12., 0.}, {15., 0.3}};
+  auto points = frame.fromArcCoordinates(arcs);
+  auto roundTrip = frame.toArcCoordinates(points);
+  ASSERT_EQ(roundTrip.size(), arcs.size());
+  for (auto i = 0u; i < arcs.size(); ++i) {
+    EXPECT_NEAR(roundTrip[i].length, arcs[i].length, 1e-9);
+    EXPECT_NEAR(roundTrip[i].distance, arcs[i].distance, 1e-9);
+  }
+}
+
+TEST_F(LaneletSequenceTest, FrenetFrameInverted) {  // NOLINT
+  auto curve = makeCurve();
+  FrenetFrame frame(curve.invert());
+  EXPECT_NEAR(frame.curvature(5.), -0.1, 5e-3);
+  EXPECT_EQ(frame.laneletAt(0.), curve.lanelets().back().invert());
+  EXPECT_NEAR(frame.rightWidth(5.), 1., 5e-3);
+  EXPECT_LT(frame.toArcCoordinates(BasicPoint2d(0., 10.)).distance, 0.);
+}
+
+TEST(FrenetFrame, NeedsTwoPoints) {  // NOLINT
+  EXPECT_THROW(FrenetFrame{LaneletSequence()}, InvalidInputError);
+  EXPECT_THROW(FrenetFrame().toArcCoordinates(BasicPoint2d(0., 0.)), InvalidInputError);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <random>
 #include "lanelet2_core/geometry/LineString.h"
 #include "lanelet2_core/primitives/LineString.h"
 using namespace lanelet;
@@ -570,3 +571,111 @@ TEST(TwoDLineStringsTest, checkInversion) {
   EXPECT_THROW(geometry::offset(l1, 2), GeometryError);  // NOLINT
   EXPECT_NO_THROW(geometry::offset(l1, 1));              // NOLINT
 }
+
+TEST(BasicLineStringGeometry, contiguousOverloadsMatchGenericVersion) {  // NOLINT
+  std::mt19937 gen(42);  // NOLINT
+  std::uniform_real_distribution<double> coord(-10., 10.);
+  LineString3d ls(InvalId);
+  for (auto i = 0; i < 23; ++i) {
+    ls.push_back(Point3d(InvalId, coord(gen), coord(gen), coord(gen)));
+  }
+  ls.push_back(ls.back());  // a degenerated segment at the end
+  auto hybrid2d = utils::toHybrid(utils::to2D(ls));
+  auto hybrid3d = utils::toHybrid(ls);
+  auto basic2d = utils::to2D(ls).basicLineString();
+  auto basic3d = ls.basicLineString();
+  for (auto i = 0; i < 200; ++i) {
+    BasicPoint3d p(coord(gen), coord(gen), coord(gen));
+    BasicPoint2d p2d = utils::to2D(p);
+    EXPECT_NEAR(0., (geometry::project(hybrid2d, p2d) - geometry::project(basic2d, p2d)).norm(), 1e-12);
+    EXPECT_NEAR(0., (geometry::project(hybrid3d, p) - geometry::project(basic3d, p)).norm(), 1e-12);
+    EXPECT_NEAR(geometry::signedDistance(hybrid2d, p2d), geometry::signedDistance(basic2d, p2d), 1e-12);
+    EXPECT_NEAR(geometry::signedDistance(hybrid3d, p), geometry::signedDistance(basic3d, p), 1e-12);
+    auto arcGeneric = geometry::toArcCoordinates(hybrid2d, p2d);
+    auto arcContiguous = geometry::toArcCoordinates(basic2d, p2d);
+    EXPECT_NEAR(arcGeneric.length, arcContiguous.length, 1e-10);
+    EXPECT_NEAR(arcGeneric.distance, arcContiguous.distance, 1e-12);
+  }
+}
+
+TEST(BasicLineStringGeometry, batchOverloadsMatchSingleCalls) {  // NOLINT
+  BasicLineString2d ls{BasicPoint2d(0, 0), BasicPoint2d(1, 0), BasicPoint2d(2, 1), BasicPoint2d(2, 2),
+                       BasicPoint2d(1, 3), BasicPoint2d(0, 3), BasicPoint2d(-1, 2)};
+  BasicPoints2d points{BasicPoint2d(0.5, 1), BasicPoint2d(3, 3), BasicPoint2d(-2, -2), BasicPoint2d(1, 1.5),
+                       BasicPoint2d(2, 2)};
+  auto projected = geometry::project(ls, points);
+  auto distances = geometry::signedDistance(ls, points);
+  auto arcCoords = geometry::toArcCoordinates(ls, points);
+  ASSERT_EQ(points.size(), projected.size());
+  ASSERT_EQ(points.size(), distances.size());
+  ASSERT_EQ(points.size(), arcCoords.size());
+  for (auto i = 0u; i < points.size(); ++i) {
+    BasicPoint2d p = points[i];
+    EXPECT_EQ(geometry::project(ls, p), BasicPoint2d(projected[i]));
+    EXPECT_DOUBLE_EQ(geometry::signedDistance(ls, p), distances[i]);
+    EXPECT_DOUBLE_EQ(geometry::toArcCoordinates(ls, p).length, arcCoords[i].length);
+    EXPECT_DOUBLE_EQ(geometry::toArcCoordinates(ls, p).distance, arcCoords[i].distance);
+  }
+  EXPECT_DOUBLE_EQ(1., arcCoords[0].distance);
+  EXPECT_DOUBLE_EQ(2 + std::sqrt(2), arcCoords[4].length);
+}
+
+TEST(BasicLineStringGeometry, contiguousOverloadsDegeneratedInput) {  // NOLINT
+  BasicLineString2d single{BasicPoint2d(1, 1)};
+  EXPECT_EQ(BasicPoint2d(1, 1), geometry::project(single, BasicPoint2d(2, 2)));
+  EXPECT_DOUBLE_EQ(0., geometry::toArcCoordinates(single, BasicPoint2d(2, 2)).length);
+  EXPECT_THROW(geometry::project(BasicLineString2d(), BasicPoint2d(2, 2)), InvalidInputError);  // NOLINT
+
+  // the arc length belongs to the closest segment, even if its start point appears earlier in the linestring
+  BasicLineString2d loop{BasicPoint2d(0, 0), BasicPoint2d(1, 0), BasicPoint2d(1, 1), BasicPoint2d(0, 0),
+                         BasicPoint2d(0, -1)};
+  EXPECT_DOUBLE_EQ(2 + std::sqrt(2) + 0.5, geometry::toArcCoordinates(loop, BasicPoint2d(0.1, -0.5)).length);
+}
+
+TYPED_TEST(TwoDLineStringsTest, arcLengthIndexMatchesLineString) {  // NOLINT
+  ArcLengthIndex2d index(this->ls4);
+  ASSERT_EQ(this->ls4.size(), index.size());
+  EXPECT_DOUBLE_EQ(geometry::length(this->ls4), index.length());
+  EXPECT_DOUBLE_EQ(geometry::rangedLength(std::next(this->ls4.begin()), this->ls4.end()), index.rangedLength(1, 2));
+  auto ratios = geometry::accumulatedLengthRatios(this->ls4);
+  auto indexRatios = index.accumulatedLengthRatios();
+  ASSERT_EQ(ratios.size(), indexRatios.size());
+  for (auto i = 0u; i < ratios.size(); ++i) {
+    EXPECT_DOUBLE_EQ(ratios[i], indexRatios[i]);
+  }
+  for (auto dist : {-3., -1.2, -0.5, 0., 0.3, 1., 1.5, 1.9, 5.}) {
+    auto p = geometry::interpolatedPointAtDistance(this->ls4, dist);
+    EXPECT_NEAR(0., (p - index.interpolatedPointAtDistance(dist)).norm(), 1e-10) << dist;
+    auto nearest = geometry::nearestPointAtDistance(this->ls4, dist);
+    EXPECT_EQ(nearest, this->ls4[index.nearestPointIndexAtDistance(dist)]) << dist;
+  }
+  for (auto arc : {ArcCoordinates{0.5, 1.}, ArcCoordinates{1.5, -0.5}, ArcCoordinates{3., 0.2}}) {
+    auto p = geometry::fromArcCoordinates(this->ls4, arc);
+    EXPECT_NEAR(0., (p - geometry::fromArcCoordinates(index, arc)).norm(), 1e-10);
+    auto arcBack = geometry::toArcCoordinates(this->ls4, p);
+    auto arcIndex = geometry::toArcCoordinates(index, p);
+    EXPECT_NEAR(arcBack.length, arcIndex.length, 1e-10);
+    EXPECT_NEAR(arcBack.distance, arcIndex.distance, 1e-10);
+  }
+}
+
+TEST(ArcLengthIndex, segmentLookup) {  // NOLINT
+  ArcLengthIndex2d index(BasicLineString2d{BasicPoint2d(0, 0), BasicPoint2d(1, 0), BasicPoint2d(3, 0)});
+  EXPECT_EQ(0ul, index.segmentIndexAtDistance(-1.));
+  EXPECT_EQ(0ul, index.segmentIndexAtDistance(0.5));
+  EXPECT_EQ(1ul, index.segmentIndexAtDistance(1.));
+  EXPECT_EQ(1ul, index.segmentIndexAtDistance(10.));
+  EXPECT_THROW(ArcLengthIndex2d().segmentIndexAtDistance(0.), InvalidInputError);  // NOLINT
+}
+
+TEST(ArcLengthIndex, subLineString) {  // NOLINT
+  ArcLengthIndex3d index(BasicLineString3d{BasicPoint3d(0, 0, 0), BasicPoint3d(1, 0, 0), BasicPoint3d(3, 0, 0)});
+  auto sub = index.subLineString(0.5, 2.);
+  ASSERT_EQ(3ul, sub.size());
+  EXPECT_DOUBLE_EQ(0.5, sub[0].x());
+  EXPECT_DOUBLE_EQ(1., sub[1].x());
+  EXPECT_DOUBLE_EQ(2., sub[2].x());
+  EXPECT_EQ(3ul, index.subLineString(-1., 5.).size());
+  EXPECT_EQ(2ul, index.subLineString(1., 3.).size());
+  EXPECT_EQ(1ul, index.subLineString(2., 1.).size());
+}
@@ -0,0 +1,213 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "lanelet2_core/LaneletMap.h"
+#include "lanelet2_core/geometry/Lanelet.h"
+#include "lanelet2_core/geometry/LineString.h"
+#include "lanelet2_core/primitives/LineString.h"
+#include "lanelet2_core/utility/Utilities.h"
+
+// Compares the geometry functions for contiguous basic linestrings against the generic versions and the nearest
+// primitive queries with and without segment index.
+// usage: lanelet2_core_benchmark [points per linestring] [queries]
+
+namespace {
+using namespace lanelet;
+
+template <typename Func>
+double measureMs(Func&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//! A curved centerline with one point per meter
+LineString3d makeCenterline(size_t numPoints) {
+  LineString3d centerline(utils::getId());
+  for (auto i = 0u; i < numPoints; ++i) {
+    centerline.push_back(Point3d(utils::getId(), i, 20. * std::sin(i / 30.), 0.));
+  }
+  return centerline;
+}
+
+//! Points scattered around the centerline, like the positions of vehicles driving on it
+BasicPoints2d makeQueries(size_t numQueries, size_t numPoints) {
+  std::mt19937 gen(42);  // NOLINT
+  std::uniform_real_distribution<double> x(0., double(numPoints - 1));
+  std::uniform_real_distribution<double> offset(-5., 5.);
+  BasicPoints2d queries;
+  for (auto i = 0u; i < numQueries; ++i) {
+    const auto s = x(gen);
+    queries.emplace_back(s, 20. * std::sin(s / 30.) + offset(gen));
+  }
+  return queries;
+}
+
+//! Runs f for all queries on the generic and the contiguous linestring and prints both times
+template <typename Func>
+void compare(const std::string& name, const ConstLineString2d& generic, const BasicLineString2d& contiguous,
+             const BasicPoints2d& queries, Func&& f) {
+  double checksum = 0.;
+  const auto genericTime = measureMs([&] {
+    for (const auto& p : queries) {
+      checksum += f(generic, p);
+    }
+  });
+  const auto contiguousTime = measureMs([&] {
+    for (const auto& p : queries) {
+      checksum -= f(contiguous, p);
+    }
+  });
+  std::cout << name << ": generic " << genericTime << " ms, contiguous " << contiguousTime << " ms ("
+            << genericTime / contiguousTime << "x), difference " << checksum << "\n";
+}
+
+void benchmarkProjection(size_t numPoints, size_t numQueries) {
+  const auto centerline = makeCenterline(numPoints);
+  const ConstLineString2d generic = utils::to2D(centerline);
+  const BasicLineString2d contiguous = generic.basicLineString();
+  const auto queries = makeQueries(numQueries, numPoints);
+  std::cout << numQueries << " queries on a linestring of " << numPoints << " points\n";
+
+  compare("project", generic, contiguous, queries,
+          [](const auto& ls, const BasicPoint2d& p) { return geometry::project(ls, p).x(); });
+  compare("signedDistance", generic, contiguous, queries,
+          [](const auto& ls, const BasicPoint2d& p) { return geometry::signedDistance(ls, p); });
+  compare("toArcCoordinates", generic, contiguous, queries,
+          [](const auto& ls, const BasicPoint2d& p) { return geometry::toArcCoordinates(ls, p).length; });
+
+  double checksum = 0.;
+  const auto batchTime = measureMs([&] {
+    for (const auto& arcCoordinates : geometry::toArcCoordinates(contiguous, queries)) {
+      checksum += arcCoordinates.length;
+    }
+  });
+  std::cout << "toArcCoordinates, batch: " << batchTime << " ms (checksum " << checksum << ")\n";
+}
+
+Lanelet makeLanelet(const std::vector<BasicPoint2d>& left, const std::vector<BasicPoint2d>& right) {
+  auto lineString = [](const std::vector<BasicPoint2d>& points) {
+    LineString3d line(utils::getId());
+    for (const auto& p : points) {
+      line.push_back(Point3d(utils::getId(), p.x(), p.y(), 0.));
+    }
+    return line;
+  };
+  return Lanelet(utils::getId(), lineString(left), lineString(right));
+}
+
+//! Few long and curved lanes with one point per meter, their bounding boxes overlap a lot
+LaneletMapUPtr makeHighwayMap(size_t numLanes, size_t numLanelets, size_t laneletLength) {
+  auto map = std::make_unique<LaneletMap>();
+  auto boundary = [](size_t b, size_t from, size_t to) {
+    std::vector<BasicPoint2d> points;
+    for (auto s = from; s <= to; ++s) {
+      points.emplace_back(s, 200. * std::sin(s / 300.) + 3.5 * b);
+    }
+    return points;
+  };
+  for (auto l = 0u; l < numLanes; ++l) {
+    for (auto i = 0u; i < numLanelets; ++i) {
+      map->add(makeLanelet(boundary(l + 1, i * laneletLength, (i + 1) * laneletLength),
+                           boundary(l, i * laneletLength, (i + 1) * laneletLength)));
+    }
+  }
+  return map;
+}
+
+//! A grid of short and straight roads with two lanes each, like the blocks of a city center
+LaneletMapUPtr makeDowntownMap(size_t numBlocks, double blockLength) {
+  auto map = std::make_unique<LaneletMap>();
+  auto road = [&](const BasicPoint2d& from, const BasicPoint2d& to) {
+    const BasicPoint2d left = BasicPoint2d(from.y() - to.y(), to.x() - from.x()).normalized() * 3.5;
+    map->add(makeLanelet({from + left, to + left}, {from, to}));
+    map->add(makeLanelet({to - left, from - left}, {to, from}));
+  };
+  for (auto i = 0u; i <= numBlocks; ++i) {
+    for (auto j = 0u; j < numBlocks; ++j) {
+      road(BasicPoint2d(i * blockLength, j * blockLength), BasicPoint2d(i * blockLength, (j + 1) * blockLength));
+      road(BasicPoint2d(j * blockLength, i * blockLength), BasicPoint2d((j + 1) * blockLength, i * blockLength));
+    }
+  }
+  return map;
+}
+
+//! Points on and next to the highway, like the positions of vehicles and of objects next to the road
+BasicPoints2d makeHighwayQueries(size_t numQueries, double length, size_t numLanes) {
+  std::mt19937 gen(42);  // NOLINT
+  std::uniform_real_distribution<double> x(0., length);
+  std::uniform_real_distribution<double> offset(-20., 3.5 * numLanes + 20.);
+  BasicPoints2d queries;
+  for (auto i = 0u; i < numQueries; ++i) {
+    const auto s = x(gen);
+    queries.emplace_back(s, 200. * std::sin(s / 300.) + offset(gen));
+  }
+  return queries;
+}
+
+//! Points anywhere in the city
+BasicPoints2d makeDowntownQueries(size_t numQueries, double size) {
+  std::mt19937 gen(42);  // NOLINT
+  std::uniform_real_distribution<double> coordinate(0., size);
+  BasicPoints2d queries;
+  for (auto i = 0u; i < numQueries; ++i) {
+    queries.emplace_back(coordinate(gen), coordinate(gen));
+  }
+  return queries;
+}
+
+//! Runs findNearest and findNearestOnBoundary for the queries, first with the bounding boxes only, then with the
+//! segment index
+void benchmarkNearest(const std::string& name, LaneletMap& map, const BasicPoints2d& queries) {
+  const auto numQueries = queries.size();
+  std::cout << name << " map, " << map.laneletLayer.size() << " lanelets, " << numQueries << " queries\n";
+
+  const auto& layer = map.laneletLayer;
+  auto nearest = [&] {
+    double checksum = 0.;
+    const auto time = measureMs([&] {
+      for (const auto& p : queries) {
+        checksum += geometry::findNearest(layer, p, 3).back().first;
+      }
+    });
+    return std::make_pair(time, checksum);
+  };
+  auto nearestOnBoundary = [&] {
+    double checksum = 0.;
+    const auto time = measureMs([&] {
+      for (const auto& p : queries) {
+        checksum += geometry::findNearestOnBoundary(layer, p, 3).back().distance;
+      }
+    });
+    return std::make_pair(time, checksum);
+  };
+  const auto nearestBoxes = nearest();
+  const auto boundaryBoxes = nearestOnBoundary();
+  const auto indexTime = measureMs([&] { map.laneletLayer.buildSegmentIndex(); });
+  const auto nearestIndex = nearest();
+  const auto boundaryIndex = nearestOnBoundary();
+  std::cout << "segment index built in " << indexTime << " ms\n";
+  std::cout << "findNearest: bounding boxes " << nearestBoxes.first << " ms, segment index " << nearestIndex.first
+            << " ms (" << nearestBoxes.first / nearestIndex.first << "x), difference "
+            << nearestBoxes.second - nearestIndex.second << "\n";
+  std::cout << "findNearestOnBoundary: bounding boxes " << boundaryBoxes.first << " ms, segment index "
+            << boundaryIndex.first << " ms (" << boundaryBoxes.first / boundaryIndex.first << "x), difference "
+            << boundaryBoxes.second - boundaryIndex.second << "\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t numPoints = argc > 1 ? std::stoul(argv[1]) : 300;
+  const size_t numQueries = argc > 2 ? std::stoul(argv[2]) : 100000;
+  benchmarkProjection(numPoints, numQueries);
+
+  // the nearest primitive queries are much slower, so they use fewer queries
+  auto highway = makeHighwayMap(4, 20, 500);
+  benchmarkNearest("highway", *highway, makeHighwayQueries(numQueries / 10, 20 * 500., 4));
+  auto downtown = makeDowntownMap(20, 100.);
+  benchmarkNearest("downtown", *downtown, makeDowntownQueries(numQueries / 10, 20 * 100.));
+  return 0;
+}
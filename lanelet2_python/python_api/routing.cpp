@@ -52,6 +52,7 @@ BOOST_PYTHON_MODULE(PYTHON_API_MODULE_NAME) {  // NOLINT
   OptionalConverter<RelationType>();
   OptionalConverter<LaneletRelation>();
   OptionalConverter<LaneletPath>();
+  OptionalConverter<CoveragePath>();
 
   VectorToListConverter<LaneletRelations>();
   VectorToListConverter<RoutingCostPtrs>();
@@ -100,6 +101,11 @@ BOOST_PYTHON_MODULE(PYTHON_API_MODULE_NAME) {  // NOLINT
       .def(self == self)   // NOLINT
       .def(self != self);  // NOLINT
 
+  class_<CoveragePath>("CoveragePath", "A path that passes as many lanelets as possible", no_init)
+      .add_property("path", &CoveragePath::path, "the path from the start to the destination")
+      .add_property("cost", &CoveragePath::cost, "the routing cost along the path")
+      .add_property("uncovered", &CoveragePath::uncovered, "reachable lanelets that are not part of the path");
+
   class_<LaneletVisitInformation>("LaneletVisitInformation",
                                   "Object passed as input for the forEachSuccessor function of the routing graph")
       .add_property("lanelet", &LaneletVisitInformation::lanelet, "the currently visited lanelet")
@@ -142,6 +148,13 @@ BOOST_PYTHON_MODULE(PYTHON_API_MODULE_NAME) {  // NOLINT
            (arg("from"), arg("via"), arg("to"), arg("routingCostId") = 0, arg("withLaneChanges") = true))
       .def("shortestPath", &RoutingGraph::shortestPath, "shortest path between 'start' and 'end'",
            (arg("from"), arg("to"), arg("routingCostId") = 0, arg("withLaneChanges") = true))
+      .def("shortestPaths", &RoutingGraph::shortestPaths,
+           "up to k loopless paths between 'start' and 'end', starting with the shortest one",
+           (arg("from"), arg("to"), arg("k"), arg("overlapPenalty") = 0., arg("routingCostId") = 0,
+            arg("withLaneChanges") = true))
+      .def("coveragePath", &RoutingGraph::coveragePath,
+           "path between 'start' and 'end' that passes all lanelets that can be reached from 'start'",
+           (arg("from"), arg("to"), arg("routingCostId") = 0, arg("withLaneChanges") = true))
       .def("shortestPathWithVia", &RoutingGraph::shortestPathVia,
            "shortest path between 'start' and 'end' using intermediate points",
            (arg("start"), arg("via"), arg("end"), arg("routingCostId") = 0, arg("withLaneChanges") = true))
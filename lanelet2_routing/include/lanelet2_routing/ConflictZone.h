@@ -0,0 +1,27 @@
+#pragma once
+#include <lanelet2_core/primitives/LaneletOrArea.h>
+#include <lanelet2_core/primitives/Point.h>
+#include <lanelet2_core/primitives/Polygon.h>
+#include <vector>
+
+namespace lanelet {
+namespace routing {
+
+/** @brief Describes where two conflicting lanelets or areas overlap
+ *
+ *  Conflict zones are computed once when the RoutingGraph is built if the configuration enables
+ *  RoutingGraph::ComputeConflictZones. They are always seen from laneletOrArea, i.e. arcLengths refer to its
+ *  centerline and otherArcLengths to the centerline of conflicting.
+ */
+struct ConflictZone {
+  ConstLaneletOrArea laneletOrArea;     //!< The lanelet or area the zone was requested for
+  ConstLaneletOrArea conflicting;       //!< The lanelet or area it conflicts with
+  BasicPolygonsWithHoles2d overlap;     //!< The area both share in 2d. Can consist of several polygons.
+  BasicPoints2d crossings;              //!< Points where the centerlines cross, ordered by arcLengths. Empty for areas.
+  std::vector<double> arcLengths;       //!< Distance along the centerline of laneletOrArea to each crossing
+  std::vector<double> otherArcLengths;  //!< Distance along the centerline of conflicting to each crossing
+};
+using ConflictZones = std::vector<ConflictZone>;
+
+}  // namespace routing
+}  // namespace lanelet
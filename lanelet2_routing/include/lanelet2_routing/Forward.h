@@ -17,6 +17,8 @@ class Graph;
 
 class RoutingGraphGraph;
 class RouteGraph;
+class CostOverlayState;
+class TimeDependentCostState;
 }  // namespace internal
 
 using LaneId = uint16_t;
@@ -28,7 +30,11 @@ using RoutingGraphConstPtr = std::shared_ptr<const RoutingGraph>;
 class RoutingGraphContainer;
 using RoutingGraphContainerUPtr = std::unique_ptr<RoutingGraphContainer>;
 
+class MultiParticipantRoutingGraph;
+using MultiParticipantRoutingGraphUPtr = std::unique_ptr<MultiParticipantRoutingGraph>;
+
 class Route;
+class ReachableSetHorizon;
 struct LaneletRelation;
 using LaneletRelations = std::vector<LaneletRelation>;
 
@@ -46,6 +52,10 @@ class LaneletPath;
 using LaneletPaths = std::vector<LaneletPath>;
 class LaneletOrAreaPath;
 using LaneletOrAreaPaths = std::vector<LaneletOrAreaPath>;
+template <typename PathT, typename ElementT>
+class PathTree;
+using LaneletPathTree = PathTree<LaneletPath, ConstLanelet>;
+using LaneletOrAreaPathTree = PathTree<LaneletOrAreaPath, ConstLaneletOrArea>;
 
 //! This enum expresses the types of relations lanelet2 distiguishes internally. Between two lanelets a and b (in this
 //! order), exactly one of these relation exists.
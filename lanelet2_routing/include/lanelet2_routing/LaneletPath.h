@@ -44,6 +44,13 @@ class LaneletPath {
   ConstLanelets lanelets_;
 };
 
+//! A path that passes as many lanelets as possible. See RoutingGraph::coveragePath.
+struct CoveragePath {
+  LaneletPath path;         //!< From the start to the destination. Lanelets can appear several times.
+  double cost{};            //!< Routing cost along the path
+  ConstLanelets uncovered;  //!< Lanelets that can be reached from the start, but are not part of the path
+};
+
 //! Similar to LaneletPath, but can also contain areas.
 class LaneletOrAreaPath {
  public:
@@ -0,0 +1,140 @@
+#pragma once
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/LaneletOrArea.h>
+#include <lanelet2_core/utility/Optional.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lanelet2_routing/Forward.h"
+#include "lanelet2_routing/RoutingGraph.h"
+#include "lanelet2_routing/LaneletPath.h"
+#include "lanelet2_routing/RoutingGraphContainer.h"
+
+namespace lanelet {
+namespace routing {
+namespace internal {
+class RoutingTopology;
+class SharedGraph;
+}  // namespace internal
+
+/** @brief Routing graph of several participants that shares everything the participants have in common
+ *
+ *  Calling RoutingGraph::build for every participant repeats the geometric part of the work each time: finding the
+ *  lanelets that succeed each other or are next to each other and checking which lanelets and areas overlap. It also
+ *  stores every vertex and every edge once per participant. This class does the geometric work once for the whole map.
+ *  The graphs of all participants are then merged: each lanelet, area and relation is stored once, together with a
+ *  bit mask of the participants that can pass it. Only the routing costs are stored per participant.
+ *
+ *  The most common queries can be run for a participant directly on the merged graph and give the same results as
+ *  the same query on a RoutingGraph built for the participant. For all other queries, graph() builds the complete
+ *  RoutingGraph of a participant on first use. The shared topology is also used to answer conflicts between the graphs
+ *  of different participants without geometric computations.
+ *
+ *  Just like for a RoutingGraph, all const member functions can be called from several threads at the same time.
+ */
+class MultiParticipantRoutingGraph {
+ public:
+  using ParticipantMask = std::uint64_t;  //!< Bit i is set if participant i can pass
+  static constexpr size_t MaxParticipants = 64;
+
+  //! Everything that is needed to build the graph of one participant
+  struct Participant {
+    traffic_rules::TrafficRulesPtr trafficRules;
+    RoutingCostPtrs routingCosts{defaultRoutingCosts()};
+    RoutingGraph::Configuration config{};
+  };
+  using Participants = std::vector<Participant>;
+
+  /** @brief Builds the graphs of all participants
+   *  @param laneletMap Map that should be used to build the graphs
+   *  @param participants Traffic rules, routing costs and configuration of each participant. Their order determines
+   * the participant index.
+   *  @throws InvalidInputError if there are more than MaxParticipants or a participant has no traffic rules */
+  static MultiParticipantRoutingGraphUPtr build(const LaneletMap& laneletMap, const Participants& participants);
+
+  //! Similar to the above but for a LaneletSubmap
+  static MultiParticipantRoutingGraphUPtr build(const LaneletSubmap& laneletSubmap, const Participants& participants);
+
+  MultiParticipantRoutingGraph() = delete;
+  MultiParticipantRoutingGraph(const MultiParticipantRoutingGraph&) = delete;
+  MultiParticipantRoutingGraph& operator=(const MultiParticipantRoutingGraph&) = delete;
+  MultiParticipantRoutingGraph(MultiParticipantRoutingGraph&& /*other*/) noexcept;
+  MultiParticipantRoutingGraph& operator=(MultiParticipantRoutingGraph&& /*other*/) noexcept;
+  ~MultiParticipantRoutingGraph();
+
+  //! Number of participants
+  size_t size() const noexcept { return participants_.size(); }
+
+  /** @brief The complete routing graph of a participant
+   *
+   *  It is built on first use, which takes as long as RoutingGraph::build without the geometric computations, and
+   *  then kept for further calls.
+   *  @throws InvalidInputError if the participant index is too high */
+  const RoutingGraph& graph(size_t participant) const;
+
+  /** @brief Name of a participant as given by its traffic rules
+   *  @throws InvalidInputError if the participant index is too high */
+  const std::string& participant(size_t participant) const;
+
+  //! Index of the first participant with the given name. Nothing if there is none.
+  Optional<size_t> find(const std::string& participant) const;
+
+  /** @brief The lanelets that can be reached directly from a lanelet by a participant
+   *  @see RoutingGraph::following
+   *  @throws InvalidInputError if the participant index is too high */
+  ConstLanelets following(size_t participant, const ConstLanelet& lanelet, bool withLaneChanges = true) const;
+
+  /** @brief The shortest path between two lanelets for a participant
+   *  @see RoutingGraph::shortestPath
+   *  @throws InvalidInputError if the participant index or the routing cost id is too high */
+  Optional<LaneletPath> shortestPath(size_t participant, const ConstLanelet& from, const ConstLanelet& to,
+                                     RoutingCostId routingCostId = {}, bool withLaneChanges = true) const;
+
+  /** @brief The lanelets a participant can reach from a lanelet within a routing cost
+   *  @see RoutingGraph::reachableSet
+   *  @throws InvalidInputError if the participant index or the routing cost id is too high */
+  ConstLanelets reachableSet(size_t participant, const ConstLanelet& lanelet, double maxRoutingCost,
+                             RoutingCostId routingCostId = {}, bool allowLaneChanges = true) const;
+
+  /** @brief Returns which participants can pass a lanelet or area, i.e. which graphs contain it.
+   *
+   *  Lanelets are considered in their direction. Lanelets and areas that are not part of the map return 0. */
+  ParticipantMask passableBy(const ConstLaneletOrArea& laneletOrArea) const noexcept;
+
+  /** @brief Returns whether a lanelet or area is part of the graph of a participant
+   *  @throws InvalidInputError if the participant index is too high */
+  bool canPass(size_t participant, const ConstLaneletOrArea& laneletOrArea) const;
+
+  /** @brief Same as RoutingGraphContainer::conflictingInGraph, but uses the shared topology
+   *
+   *  Only the candidates that overlap in 2d are checked again with the participant height. Lanelets that are not part
+   *  of the map are checked geometrically against the graph of the participant, which is built for this if necessary.
+   *  @throws InvalidInputError if the participant index is too high */
+  ConstLanelets conflictingInGraph(const ConstLanelet& lanelet, size_t participant,
+                                   double participantHeight = .0) const;
+
+  //! Same as RoutingGraphContainer::conflictingInGraphs, but uses the shared topology
+  RoutingGraphContainer::ConflictingInGraphs conflictingInGraphs(const ConstLanelet& lanelet,
+                                                                 double participantHeight = .0) const;
+
+ private:
+  struct GraphCache;
+  MultiParticipantRoutingGraph(std::unique_ptr<internal::RoutingTopology>&& topology,
+                               std::unique_ptr<internal::SharedGraph>&& shared, Participants participants);
+  static MultiParticipantRoutingGraphUPtr build(const LaneletMapLayers& laneletMapLayers,
+                                                const Participants& participants);
+  //! Returns the complete graph of a participant and builds it if necessary
+  RoutingGraphConstPtr completeGraph(size_t participant) const;
+  void checkParticipant(size_t participant) const;
+  void checkRoutingCostId(size_t participant, RoutingCostId routingCostId) const;
+
+  std::unique_ptr<internal::RoutingTopology> topology_;  //!< Geometric relations of all lanelets and areas
+  std::unique_ptr<internal::SharedGraph> shared_;        //!< The graphs of all participants, merged
+  Participants participants_;                            //!< Needed to build the complete graphs
+  std::vector<std::string> names_;                       //!< Names of the participants
+  std::unique_ptr<GraphCache> graphs_;                   //!< The complete graphs that were built so far
+};
+
+}  // namespace routing
+}  // namespace lanelet
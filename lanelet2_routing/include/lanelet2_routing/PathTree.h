@@ -0,0 +1,129 @@
+#pragma once
+#include <boost/iterator/iterator_facade.hpp>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/Forward.h"
+#include "lanelet2_routing/LaneletPath.h"
+
+namespace lanelet {
+namespace routing {
+
+/** @brief A set of paths that is stored as a tree of their shared prefixes
+ *
+ *  This is the result of RoutingGraph::possiblePathTree and its variants. Instead of a copy of every path, the tree
+ *  stores every lanelet (or area) found by the search once, together with its predecessor on the path. A path is only
+ *  built when it is requested, so that consumers that only need some of the paths (or only their ends) do not have to
+ *  pay for the others.
+ *
+ *  The paths are ordered just like the result of RoutingGraph::possiblePaths. For trees that were searched towards a
+ *  lanelet (RoutingGraph::possiblePathTreeTowards), the root is the last element of each path.
+ */
+template <typename PathT, typename ElementT>
+class PathTree {
+ public:
+  using Index = std::uint32_t;
+  struct Node {
+    ElementT element;
+    Index parent;  //!< Index of the next node towards the root. The root refers to itself.
+    Index length;  //!< Number of nodes from the root to this node (including both)
+  };
+  using Nodes = std::vector<Node>;
+  using Leaves = std::vector<Index>;
+  using Path = PathT;
+
+  //! Iterates over the paths, building each path when it is dereferenced
+  class const_iterator  // NOLINT
+      : public boost::iterator_facade<const_iterator, PathT, boost::random_access_traversal_tag, PathT> {
+    friend class boost::iterator_core_access;
+
+   public:
+    const_iterator() = default;
+    const_iterator(const PathTree* tree, size_t idx) : tree_{tree}, idx_{idx} {}
+
+   private:
+    PathT dereference() const { return (*tree_)[idx_]; }
+    bool equal(const const_iterator& other) const { return idx_ == other.idx_; }
+    void increment() { ++idx_; }
+    void decrement() { --idx_; }
+    void advance(std::ptrdiff_t n) { idx_ += n; }
+    std::ptrdiff_t distance_to(const const_iterator& other) const {
+      return std::ptrdiff_t(other.idx_) - std::ptrdiff_t(idx_);
+    }
+    const PathTree* tree_{};
+    size_t idx_{};
+  };
+
+  PathTree() = default;
+
+  //! Usually obtained from the RoutingGraph. The leaves are the nodes where the paths end (or start, if towards).
+  PathTree(Nodes nodes, Leaves leaves, bool towards)
+      : nodes_{std::move(nodes)}, leaves_{std::move(leaves)}, towards_{towards} {}
+
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, leaves_.size()}; }
+
+  //! Number of paths in the tree
+  size_t size() const noexcept { return leaves_.size(); }
+  bool empty() const noexcept { return leaves_.empty(); }
+
+  //! Builds the path with the given index
+  PathT operator[](size_t idx) const {
+    assert(idx < leaves_.size());
+    const auto* node = &nodes_[leaves_[idx]];
+    const auto size = node->length;
+    std::vector<ElementT> path(size);
+    for (Index i = 0; i < size; ++i) {
+      path[towards_ ? i : size - 1 - i] = node->element;
+      node = &nodes_[node->parent];
+    }
+    return PathT{std::move(path)};
+  }
+
+  //! Builds all paths. This is what RoutingGraph::possiblePaths returns.
+  std::vector<PathT> paths() const {
+    std::vector<PathT> result;
+    result.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      result.push_back((*this)[i]);
+    }
+    return result;
+  }
+
+  //! Number of elements of the path with the given index
+  size_t pathSize(size_t idx) const { return nodes_[leaves_[idx]].length; }
+
+  //! The element the path ends with or, if the tree was searched towards a lanelet, starts with.
+  const ElementT& leaf(size_t idx) const { return nodes_[leaves_[idx]].element; }
+
+  /** @brief Calls f on the elements of a path, starting at its leaf and ending at the root
+   *
+   *  For trees that were not searched towards a lanelet, this is the reverse order of the path. Nothing is copied
+   *  or allocated. If f returns false, the remaining elements are not visited.
+   *  @return false if f returned false */
+  template <typename Func>
+  bool forEachElement(size_t idx, Func&& f) const {
+    const auto* node = &nodes_[leaves_[idx]];
+    for (Index i = 0; i < nodes_[leaves_[idx]].length; ++i) {
+      if (!f(node->element)) {
+        return false;
+      }
+      node = &nodes_[node->parent];
+    }
+    return true;
+  }
+
+  //! All elements found by the search, each element appears once. Use this for the underlying tree structure.
+  const Nodes& nodes() const noexcept { return nodes_; }
+  const Leaves& leaves() const noexcept { return leaves_; }
+  bool isTowards() const noexcept { return towards_; }
+
+ private:
+  Nodes nodes_;
+  Leaves leaves_;
+  bool towards_{false};
+};
+
+}  // namespace routing
+}  // namespace lanelet
@@ -0,0 +1,69 @@
+#pragma once
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/utility/Optional.h>
+#include <memory>
+#include "lanelet2_routing/Forward.h"
+
+namespace lanelet {
+namespace routing {
+
+//! The lanelets that entered or left the set of a ReachableSetHorizon with an update
+struct ReachableSetDelta {
+  ConstLanelets entered;  //!< Lanelets that are part of the set now, but were not before
+  ConstLanelets left;     //!< Lanelets that were part of the set before, but are not any more
+
+  bool empty() const noexcept { return entered.empty() && left.empty(); }
+};
+
+/** @brief Keeps the reachable set of a moving vehicle up to date
+ *
+ *  RoutingGraph::reachableSet searches the graph from scratch on every call. A vehicle that is tracked at a high rate
+ *  only moves a little between two calls, so most of this search is the same as before. The horizon keeps the shortest
+ *  path tree of the last update and reuses it:
+ *  - If the vehicle is still on the same lanelet, the search is only continued up to the new limit.
+ *  - If it moved to a lanelet of the tree, the subtree of this lanelet is kept. The costs within the subtree are still
+ *    exact, only the remaining lanelets are searched again.
+ *  - Otherwise, or if the cost overlay of the routing graph was changed, the search starts from scratch.
+ *
+ *  Create horizons with RoutingGraph::reachableSetHorizon. The routing graph must outlive them. A horizon must not be
+ *  updated from several threads at once, but several horizons can be used in parallel.
+ */
+class ReachableSetHorizon {
+ public:
+  //! Use RoutingGraph::reachableSetHorizon instead. @throws InvalidInputError if the routing cost id is invalid
+  ReachableSetHorizon(const internal::RoutingGraphGraph& graph, const internal::CostOverlayState& costOverlay,
+                      double maxRoutingCost, RoutingCostId routingCostId, bool allowLaneChanges);
+  ReachableSetHorizon(ReachableSetHorizon&& rhs) noexcept;
+  ReachableSetHorizon& operator=(ReachableSetHorizon&& rhs) noexcept;
+  ~ReachableSetHorizon();
+
+  /** @brief Moves the horizon to a new position and returns the lanelets that entered and left the reachable set
+   *  @param lanelet the lanelet the vehicle is on. If it is not part of the graph, the set becomes empty.
+   *  @param costOnLanelet routing cost the vehicle has already covered on the lanelet, e.g. the distance it has driven
+   * along the lanelet for RoutingCostDistance. The set contains all lanelets that can be reached from the lanelet
+   * with maxRoutingCost + costOnLanelet, just like RoutingGraph::reachableSet. */
+  ReachableSetDelta update(const ConstLanelet& lanelet, double costOnLanelet = 0.);
+
+  //! The current reachable set in no particular order
+  ConstLanelets reachableSet() const;
+
+  bool contains(const ConstLanelet& lanelet) const;
+
+  //! The routing cost from the current lanelet to a lanelet of the set. Empty if the lanelet is not part of the set.
+  Optional<double> cost(const ConstLanelet& lanelet) const;
+
+  //! The lanelet of the last update. Empty if there was none or it was not part of the graph.
+  Optional<ConstLanelet> currentLanelet() const;
+
+  double maxRoutingCost() const noexcept;
+
+  //! Empties the set and forgets the search tree. The next update reports all lanelets as entered.
+  void reset();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace routing
+}  // namespace lanelet
@@ -30,6 +30,8 @@ namespace routing {
  * - It is recommended to check a couple of basic things with the "checkValidity" function once the Route is created
  * - Routes can also be circular (e.g. if start and end lanelet are the same). The "last" lanelet of the route will then
  * have the first lanelet of the route as successor.
+ * - All const member functions can be called from any number of threads at the same time. The route must not be moved,
+ * assigned or destroyed while this happens.
  * */
 class Route {
  public:
@@ -41,9 +43,10 @@ class Route {
   Route(Route&& other) noexcept;
   ~Route() noexcept;
 
-  //! Constructs a route. Not supposed to be called directly. Use RoutingGraph to obtain routes.
-  Route(LaneletPath shortestPath, std::unique_ptr<internal::RouteGraph> graph,
-        LaneletSubmapConstPtr laneletSubmap) noexcept;
+  //! Constructs a route. Not supposed to be called directly. Use RoutingGraph to obtain routes. If laneletSubmap is
+  //! null, it is created on the first call to laneletSubmap().
+  //! @throws InvalidInputError if the graph has no conflict table
+  Route(LaneletPath shortestPath, std::unique_ptr<internal::RouteGraph> graph, LaneletSubmapConstPtr laneletSubmap);
 
   /** @brief Returns the shortest path that was the base of this route */
   inline const LaneletPath& shortestPath() const noexcept { return shortestPath_; }
@@ -80,8 +83,11 @@ class Route {
    *
    *  Can be used to do spatial lookups like 'which Lanelets of the route are close to my position'. It does not contain
    * anything beyond that, no points, linestrings, etc.
+   *
+   * The submap is created on the first call, because building its search indices takes longer than building the rest
+   * of the route. Later calls return the same submap.
    */
-  inline LaneletSubmapConstPtr laneletSubmap() const noexcept { return laneletSubmap_; }
+  LaneletSubmapConstPtr laneletSubmap() const;
 
   /** @brief A LaneletMap with all lanelets that are part of the route and those referenced by regelems.
    *  @return A laneletMap with all lanelets of the route, excluding regulatory elements.
@@ -93,8 +99,8 @@ class Route {
    * laneletSubmap() only returns lanelets on the map. To get the old behaviour use laneletSubmap()->laneletMap().
    */
   [[deprecated("Use laneletSubmap() to obtain a view on the elements within this route")]] inline LaneletMapConstPtr
-  laneletMap() const noexcept {
-    return laneletSubmap_->laneletMap();
+  laneletMap() const {
+    return laneletSubmap()->laneletMap();
   }
 
   /** @brief Get a laneletMap that represents the Lanelets of the Route and their relationship.
@@ -199,7 +205,7 @@ class Route {
  private:
   std::unique_ptr<internal::RouteGraph> graph_;  ///< The internal graph
   LaneletPath shortestPath_;                     ///< The underlying shortest path used to create the route
-  LaneletSubmapConstPtr laneletSubmap_;          ///< LaneletSubmap with all lanelets that are part of the route
+  mutable LaneletSubmapConstPtr laneletSubmap_;  ///< LaneletSubmap with all lanelets of the route, created on demand
 };
 }  // namespace routing
 }  // namespace lanelet
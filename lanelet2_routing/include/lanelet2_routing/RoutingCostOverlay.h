@@ -0,0 +1,94 @@
+#pragma once
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_core/utility/Optional.h>
+#include <map>
+#include <utility>
+#include "lanelet2_routing/Forward.h"
+
+namespace lanelet {
+namespace routing {
+
+/** @brief Describes how a routing cost is changed by a RoutingCostOverlay
+ *
+ *  A modification either scales the cost calculated by the routing cost module, replaces it by an absolute value or
+ *  makes the relation impassable. */
+class CostModification {
+ public:
+  enum class Type : uint8_t {
+    Multiply,  //!< The routing cost is multiplied by value
+    Absolute,  //!< The routing cost is replaced by value
+    Blocked    //!< The relation can not be used at all
+  };
+
+  //! @throws InvalidInputError if the factor is negative or not finite
+  static CostModification multiply(double factor);
+  //! @throws InvalidInputError if the cost is negative or not finite
+  static CostModification absolute(double cost);
+  static CostModification blocked() noexcept { return CostModification(Type::Blocked, 0.); }
+
+  Type type() const noexcept { return type_; }
+  double value() const noexcept { return value_; }
+  bool isBlocked() const noexcept { return type_ == Type::Blocked; }
+
+  //! Returns the modified cost. Blocked relations have infinite cost.
+  double apply(double routingCost) const noexcept;
+
+  bool operator==(const CostModification& rhs) const noexcept { return type_ == rhs.type_ && value_ == rhs.value_; }
+  bool operator!=(const CostModification& rhs) const noexcept { return !(*this == rhs); }
+
+ private:
+  CostModification(Type type, double value) : type_{type}, value_{value} {}
+  Type type_{Type::Multiply};
+  double value_{1.};
+};
+
+/** @brief A set of modifications of the routing costs of a RoutingGraph
+ *
+ *  Routing costs are calculated once when the routing graph is built. An overlay allows to change them afterwards, e.g.
+ *  because of congestion or closures, without rebuilding the graph. Modifications can be set for lanelets or areas and
+ *  for single relations between two of them. Both are identified by their ids, so they apply to the inverted lanelets
+ *  as well.
+ *
+ *  A modification of a lanelet or area applies to all relations leaving it (i.e. the cost of passing it, see
+ *  RoutingCost). If it is blocked, relations leading to it are blocked as well. A modification of a relation replaces
+ *  the modification of the lanelet or area it leaves, but it can not unblock a blocked lanelet or area.
+ *
+ *  The overlay only becomes effective once it is passed to RoutingGraph::setCostOverlay.
+ */
+class RoutingCostOverlay {
+ public:
+  using Modification = CostModification;
+  using LaneletModifications = std::map<Id, CostModification>;
+  using RelationModifications = std::map<std::pair<Id, Id>, CostModification>;
+
+  //! Sets the modification of a lanelet or area, replacing any previous one
+  RoutingCostOverlay& set(Id laneletOrArea, CostModification modification);
+
+  //! Sets the modification of the relation between from and to (in this order), replacing any previous one
+  RoutingCostOverlay& set(Id from, Id to, CostModification modification);
+
+  //! Removes the modification of a lanelet or area. Returns false if there was none.
+  bool reset(Id laneletOrArea);
+
+  //! Removes the modification of a relation. Returns false if there was none.
+  bool reset(Id from, Id to);
+
+  Optional<CostModification> get(Id laneletOrArea) const;
+  Optional<CostModification> get(Id from, Id to) const;
+
+  const LaneletModifications& laneletModifications() const noexcept { return lanelets_; }
+  const RelationModifications& relationModifications() const noexcept { return relations_; }
+
+  bool empty() const noexcept { return lanelets_.empty() && relations_.empty(); }
+  void clear() noexcept {
+    lanelets_.clear();
+    relations_.clear();
+  }
+
+ private:
+  LaneletModifications lanelets_;
+  RelationModifications relations_;
+};
+
+}  // namespace routing
+}  // namespace lanelet
@@ -5,9 +5,14 @@
 #include <lanelet2_core/primitives/LaneletOrArea.h>
 #include <lanelet2_core/utility/Optional.h>
 #include <map>
+#include "lanelet2_routing/ConflictZone.h"
 #include "lanelet2_routing/Forward.h"
 #include "lanelet2_routing/LaneletPath.h"
+#include "lanelet2_routing/PathTree.h"
+#include "lanelet2_routing/ReachableSetHorizon.h"
 #include "lanelet2_routing/RoutingCost.h"
+#include "lanelet2_routing/RoutingCostOverlay.h"
+#include "lanelet2_routing/TimeDependentCost.h"
 #include "lanelet2_routing/Types.h"
 
 namespace lanelet {
@@ -22,13 +27,20 @@ namespace routing {
  * @note The direction of lanelets matters! 'lanelet' and 'lanelet.invert()' are differentiated since this matters when
  * lanelets are passable in both directions.
  * @note 'adjacent_left' and 'adjacent_right' means that there is a passable lanelet left/right of another passable
- * lanelet, but a lane change is not allowed. */
+ * lanelet, but a lane change is not allowed.
+ * @note All const member functions can be called from any number of threads at the same time, without any external
+ * locking. This includes calls while another thread replaces the cost overlay or the time dependent costs: Every
+ * query then uses either the old or the new costs, never a mix. The graph must not be moved, assigned or destroyed
+ * while it is queried. Searches keep their temporary data per thread, and lanelets are looked up by their id in a flat
+ * table, so concurrent queries do not contend for anything but the (rarely rebuilt) search graphs. */
 class RoutingGraph {
  public:
   using Errors = std::vector<std::string>;                 ///< For the checkValidity function
   using Configuration = std::map<std::string, Attribute>;  ///< Used to provide a configuration
   //! Defined configuration attributes
   static constexpr const char ParticipantHeight[] = "participant_height";
+  //! If true, the geometry of conflicts is computed while building (see RoutingGraph::conflictZones)
+  static constexpr const char ComputeConflictZones[] = "compute_conflict_zones";
 
   /** @brief Main constructor with optional configuration.
    *  @param laneletMap Map that should be used to build the graph
@@ -103,6 +115,67 @@ class RoutingGraph {
                                                          RoutingCostId routingCostId = {},
                                                          bool withLaneChanges = true) const;
 
+  /** @brief Retrieve up to k loopless paths between 'start' and 'end', starting with the shortest one.
+   *
+   *  The paths are found using Yen's algorithm and ordered by their routing cost. Paths that only differ in where a
+   * lane change happens count as different paths.
+   *  @param from Start lanelet
+   *  @param to End lanelet
+   *  @param k Maximum number of paths
+   *  @param overlapPenalty If greater than zero, the routing cost of relations that are already part of a previous path
+   * is increased by this factor when choosing the next path. This makes the paths more diverse, but the result is no
+   * longer strictly ordered by cost.
+   *  @param routingCostId ID of RoutingCost module to determine the paths
+   *  @param withLaneChanges if false, the paths will not contain lane changes
+   *  @return The paths, empty if 'to' can not be reached. */
+  LaneletPaths shortestPaths(const ConstLanelet& from, const ConstLanelet& to, size_t k, double overlapPenalty = 0.,
+                             RoutingCostId routingCostId = {}, bool withLaneChanges = true) const;
+
+  /** @brief Get up to k alternative routes from 'start' to 'end'.
+   *
+   *  The routes are built from the paths returned by shortestPaths. If a path results in a route that has the same
+   * lanelets as a previous route, it is skipped, so there may be less than k routes.
+   *  @see shortestPaths, getRoute */
+  Routes getAlternativeRoutes(const ConstLanelet& from, const ConstLanelet& to, size_t k, double overlapPenalty = 0.,
+                              RoutingCostId routingCostId = {}, bool withLaneChanges = true) const;
+
+  /** @brief Plans a path from 'from' to 'to' that passes all lanelets that can be reached from 'from'.
+   *
+   *  Lanelets are passed repeatedly where necessary. The routing cost of the path is minimized by solving a directed
+   * rural postman problem with a min cost flow (see internal::CoveragePathPlanner). If the lanelets can not all be
+   * passed by a single path, e.g. because of dead ends or branches that never rejoin, as many lanelets as possible are
+   * covered and the others are reported as uncovered.
+   *  @param from Start lanelet
+   *  @param to End lanelet. Use 'from' again for a closed tour.
+   *  @param routingCostId ID of RoutingCost module to determine the path. Its costs must not be negative.
+   *  @param withLaneChanges if false, the path will not contain lane changes
+   *  @return Nothing if 'to' can not be reached from 'from' */
+  Optional<CoveragePath> coveragePath(const ConstLanelet& from, const ConstLanelet& to,
+                                      RoutingCostId routingCostId = {}, bool withLaneChanges = true) const;
+
+  /** @brief Retrieve the shortest path between 'start' and 'end' when departing at a given time.
+   *
+   *  Like shortestPath, but the routing costs are modified by the time dependent costs of this graph (see
+   * setTimeDependentCosts) at the time a lanelet is entered. This time is the departure time plus the routing cost
+   * accumulated until then, so the routing cost module should measure travel time (e.g. RoutingCostTravelTime). The
+   * search assumes that entering a lanelet later never allows to leave it earlier and does not consider waiting for a
+   * blocked lanelet to open again.
+   *  @param from Start lanelet to find a shortest path
+   *  @param to End lanelet to find a shortest path
+   *  @param departureTime Time at which 'from' is entered, in the time base of the TimeDependentCosts
+   *  @param routingCostId ID of RoutingCost module to determine shortest path
+   *  @param withLaneChanges if false, the shortest path will not contain lane changes */
+  Optional<LaneletPath> timeDependentShortestPath(const ConstLanelet& from, const ConstLanelet& to,
+                                                  double departureTime, RoutingCostId routingCostId = {},
+                                                  bool withLaneChanges = true) const;
+
+  //! Similar to RoutingGraph::timeDependentShortestPath, but also considers areas.
+  Optional<LaneletOrAreaPath> timeDependentShortestPathIncludingAreas(const ConstLaneletOrArea& from,
+                                                                      const ConstLaneletOrArea& to,
+                                                                      double departureTime,
+                                                                      RoutingCostId routingCostId = {},
+                                                                      bool withLaneChanges = true) const;
+
   /** @brief Retrieve a shortest path between 'start' and 'end' using intermediate points.
    *  Will find a shortest path using Djikstra's shortest path algorithm and the routing cost calculated by the
    * routing cost module with the respective ID. Be aware that the shortest path may contain lane changes,
@@ -242,6 +315,17 @@ class RoutingGraph {
    *  @return All conflicting lanelets. */
   ConstLaneletOrAreas conflicting(const ConstLaneletOrArea& laneletOrArea) const;
 
+  /** @brief Returns where a lanelet or area overlaps with another one it conflicts with
+   *
+   *  The zones are computed once while building the graph, if the configuration sets
+   *  RoutingGraph::ComputeConflictZones to true. Otherwise there are none.
+   *  @return the zone as seen from laneletOrArea or nothing if the two do not conflict */
+  Optional<ConflictZone> conflictZone(const ConstLaneletOrArea& laneletOrArea,
+                                      const ConstLaneletOrArea& conflicting) const;
+
+  //! Returns the zones of all lanelets and areas conflicting with laneletOrArea. See RoutingGraph::conflictZone.
+  ConflictZones conflictZones(const ConstLaneletOrArea& laneletOrArea) const;
+
   /** @brief Retrieve a set of lanelets that can be reached from a given lanelet
    *
    *  Determines which lanelets can be reached from a give start lanelets within a given amount of routing cost.
@@ -268,6 +352,18 @@ class RoutingGraph {
   ConstLanelets reachableSetTowards(const ConstLanelet& lanelet, double maxRoutingCost,
                                     RoutingCostId routingCostId = {}, bool allowLaneChanges = true) const;
 
+  /** @brief Creates an object that keeps the reachable set of a moving vehicle up to date
+   *
+   *  Use this instead of RoutingGraph::reachableSet if the set is needed repeatedly for a vehicle that moves along the
+   *  graph. The horizon reuses the search of its previous update and reports the lanelets that entered and left the
+   *  set. See ReachableSetHorizon for details. The routing graph must outlive the horizon.
+   *  @param maxRoutingCost Maximum amount of routing cost allowed to reach other lanelets
+   *  @param routingCostId ID of the routing cost module used for routing cost.
+   *  @param allowLaneChanges Allow or forbid lane changes
+   *  @throws InvalidInputError if the routing cost id is invalid */
+  ReachableSetHorizon reachableSetHorizon(double maxRoutingCost, RoutingCostId routingCostId = {},
+                                          bool allowLaneChanges = true) const;
+
   /** @brief Determines possible routes from a given start lanelet that are "minRoutingCost"-long.
    *
    *  @return possible paths that are at least as long as specified in 'minRoutingCost'. If a lanelet can be reached
@@ -324,6 +420,41 @@ class RoutingGraph {
   LaneletOrAreaPaths possiblePathsIncludingAreas(const ConstLaneletOrArea& startPoint, uint32_t minElements,
                                                  bool allowLaneChanges = false, RoutingCostId routingCostId = {}) const;
 
+  /** @brief Determines the same paths as RoutingGraph::possiblePaths, but returns them as a tree of shared prefixes
+   *
+   *  Paths are only built once they are requested from the tree, so this is much cheaper if not all paths are needed
+   *  or if it suffices to look at the lanelets along a path (see PathTree::forEachElement).
+   *  @param prune Optional function that is called on every lanelet that is reached before the path is long enough. If
+   * it returns false, the paths through this lanelet end there, as if it had no successors. The lanelet is still part
+   * of the paths. This can be used to stop the search e.g. at lanelets that are irrelevant for a prediction. */
+  LaneletPathTree possiblePathTree(const ConstLanelet& startPoint, double minRoutingCost,
+                                   RoutingCostId routingCostId = {}, bool allowLaneChanges = false,
+                                   const LaneletVisitFunction& prune = {}) const;
+
+  //! Similar to RoutingGraph::possiblePathTree, but with paths that are "minLanelets"-long
+  LaneletPathTree possiblePathTree(const ConstLanelet& startPoint, uint32_t minLanelets, bool allowLaneChanges = false,
+                                   RoutingCostId routingCostId = {}, const LaneletVisitFunction& prune = {}) const;
+
+  //! Determines the same paths as RoutingGraph::possiblePathsTowards as a tree. See RoutingGraph::possiblePathTree.
+  LaneletPathTree possiblePathTreeTowards(const ConstLanelet& targetLanelet, double minRoutingCost,
+                                          RoutingCostId routingCostId = {}, bool allowLaneChanges = false,
+                                          const LaneletVisitFunction& prune = {}) const;
+
+  //! Determines the same paths as RoutingGraph::possiblePathsTowards as a tree. See RoutingGraph::possiblePathTree.
+  LaneletPathTree possiblePathTreeTowards(const ConstLanelet& targetLanelet, uint32_t minLanelets,
+                                          bool allowLaneChanges = false, RoutingCostId routingCostId = {},
+                                          const LaneletVisitFunction& prune = {}) const;
+
+  //! Similar to RoutingGraph::possiblePathTree, but also considers areas.
+  LaneletOrAreaPathTree possiblePathTreeIncludingAreas(const ConstLaneletOrArea& startPoint, double minRoutingCost,
+                                                       RoutingCostId routingCostId = {}, bool allowLaneChanges = false,
+                                                       const LaneletOrAreaVisitFunction& prune = {}) const;
+
+  //! Similar to RoutingGraph::possiblePathTree, but also considers areas.
+  LaneletOrAreaPathTree possiblePathTreeIncludingAreas(const ConstLaneletOrArea& startPoint, uint32_t minElements,
+                                                       bool allowLaneChanges = false, RoutingCostId routingCostId = {},
+                                                       const LaneletOrAreaVisitFunction& prune = {}) const;
+
   /** @brief Calls a function on every successor of lanelet, optionally including lane changes
    *
    * This function can be used to query the routing graph on a more direct level. The function will be called on
@@ -357,6 +488,37 @@ class RoutingGraph {
   void forEachPredecessorIncludingAreas(const ConstLaneletOrArea& lanelet, const LaneletOrAreaVisitFunction& f,
                                         bool allowLaneChanges = true, RoutingCostId routingCostId = {}) const;
 
+  /** @brief Replaces the routing cost overlay of this graph
+   *
+   *  The overlay modifies the routing costs used by all searches of the graph (shortest paths, reachable sets, possible
+   *  paths and the forEach functions) for all routing cost modules. Routes (getRoute, getRouteVia and
+   *  getAlternativeRoutes) do not contain lanelets or lane changes that the overlay blocks. Queries that are running
+   *  while the overlay is replaced finish with the previous one. This function can be called concurrently with queries.
+   *  @see RoutingCostOverlay */
+  void setCostOverlay(RoutingCostOverlay overlay);
+
+  /** @brief Atomically modifies the current routing cost overlay
+   *
+   *  update is called with a copy of the current overlay. Once it returns, the modified overlay replaces the current
+   *  one. Concurrent updates are serialized, so no modification is lost. */
+  void updateCostOverlay(const std::function<void(RoutingCostOverlay&)>& update);
+
+  //! Returns (a copy of) the routing cost overlay that is currently in use
+  RoutingCostOverlay costOverlay() const;
+
+  /** @brief Replaces the time dependent routing costs of this graph
+   *
+   *  They are only used by timeDependentShortestPath and its variants, on top of the cost overlay. Like the cost
+   *  overlay, they can be replaced while queries are running.
+   *  @see TimeDependentCosts */
+  void setTimeDependentCosts(TimeDependentCosts costs);
+
+  //! Atomically modifies the current time dependent routing costs, see updateCostOverlay
+  void updateTimeDependentCosts(const std::function<void(TimeDependentCosts&)>& update);
+
+  //! Returns (a copy of) the time dependent routing costs that are currently in use
+  TimeDependentCosts timeDependentCosts() const;
+
   /** @brief Export the internal graph to graphML (xml-based) file format.
    *  @param filename Fully qualified file name - ideally with extension (.graphml)
    *  @param edgeTypesToExclude Exclude the specified relations. E.g. conflicting. Combine them with "|".
@@ -421,8 +583,10 @@ class RoutingGraph {
 
  private:
   //! Documentation to be found in the cpp file.
-  std::unique_ptr<internal::RoutingGraphGraph> graph_;  ///< Wrapper of the routing graph
-  LaneletSubmapConstPtr passableLaneletSubmap_;         ///< Lanelet map of all passable lanelets
+  std::unique_ptr<internal::RoutingGraphGraph> graph_;                    ///< Wrapper of the routing graph
+  LaneletSubmapConstPtr passableLaneletSubmap_;                           ///< Lanelet map of all passable lanelets
+  std::unique_ptr<internal::CostOverlayState> costOverlay_;               ///< Modifications of the routing costs
+  std::unique_ptr<internal::TimeDependentCostState> timeDependentCosts_;  ///< Modifications depending on the time
 };
 
 }  // namespace routing
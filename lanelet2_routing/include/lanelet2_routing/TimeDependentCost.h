@@ -0,0 +1,113 @@
+#pragma once
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_core/utility/Optional.h>
+#include <map>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/Forward.h"
+
+namespace lanelet {
+namespace routing {
+
+/** @brief Describes how a routing cost changes depending on the time a lanelet or area is entered
+ *
+ *  The modification is a piecewise linear function of time, given by breakpoints (time, value) that are sorted by
+ *  time. Between two breakpoints the value is interpolated linearly, before the first and after the last breakpoint the
+ *  value of this breakpoint applies. Two breakpoints with the same time form a step. The value is either a factor for
+ *  the routing cost or replaces it, just like for a CostModification.
+ *
+ *  In addition, the relation can be blocked within time windows, e.g. for bus lanes or scheduled closures.
+ *
+ *  Times are in seconds and may have any origin (e.g. seconds since midnight), as long as the departure times passed to
+ *  RoutingGraph::timeDependentShortestPath have the same. If a period is set (e.g. 86400 for a daily schedule), times
+ *  are taken modulo the period, so breakpoints and windows should lie within [0, period).
+ */
+class TimeDependentCost {
+ public:
+  using Breakpoint = std::pair<double, double>;  //!< Time and value at this time
+  using Breakpoints = std::vector<Breakpoint>;
+  using TimeWindow = std::pair<double, double>;  //!< Begin (inclusive) and end (exclusive) of a time window
+  using TimeWindows = std::vector<TimeWindow>;
+
+  //! Creates a modification that does not change the routing cost, unless time windows are blocked
+  TimeDependentCost() = default;
+
+  //! @throws InvalidInputError if the breakpoints are empty, not sorted or a factor is negative or not finite
+  static TimeDependentCost multiply(Breakpoints factors);
+  //! @throws InvalidInputError if the breakpoints are empty, not sorted or a cost is negative or not finite
+  static TimeDependentCost absolute(Breakpoints costs);
+
+  //! Blocks the relation within [begin, end). @throws InvalidInputError if end < begin or a time is not finite
+  TimeDependentCost& block(double begin, double end);
+
+  //! Lets the modification repeat after period seconds, 0 disables this. @throws InvalidInputError if it is negative
+  TimeDependentCost& setPeriod(double period);
+
+  bool isAbsolute() const noexcept { return absolute_; }
+  const Breakpoints& breakpoints() const noexcept { return breakpoints_; }
+  const TimeWindows& blockedWindows() const noexcept { return blocked_; }
+  double period() const noexcept { return period_; }
+
+  //! Returns true if the relation is blocked at the given time
+  bool isBlocked(double time) const noexcept;
+
+  //! Returns the modified cost at the given time. Blocked relations have infinite cost.
+  double apply(double routingCost, double time) const noexcept;
+
+ private:
+  TimeDependentCost(bool absolute, Breakpoints breakpoints);
+  double localTime(double time) const noexcept;
+  double valueAt(double time) const noexcept;
+
+  bool absolute_{false};
+  Breakpoints breakpoints_;  //!< Empty means factor 1
+  TimeWindows blocked_;
+  double period_{0.};
+};
+
+/** @brief Time dependent modifications of the routing costs of a RoutingGraph
+ *
+ *  This is the time dependent counterpart of a RoutingCostOverlay and follows the same rules: A modification of a
+ *  lanelet or area applies to all relations leaving it, a modification of a relation replaces it. A lanelet or area can
+ *  not be entered while it is blocked and a relation modification can not unblock it.
+ *
+ *  The costs become effective once they are passed to RoutingGraph::setTimeDependentCosts and are only considered by
+ *  RoutingGraph::timeDependentShortestPath and its variants.
+ */
+class TimeDependentCosts {
+ public:
+  using Modification = TimeDependentCost;
+  using LaneletModifications = std::map<Id, TimeDependentCost>;
+  using RelationModifications = std::map<std::pair<Id, Id>, TimeDependentCost>;
+
+  //! Sets the modification of a lanelet or area, replacing any previous one
+  TimeDependentCosts& set(Id laneletOrArea, TimeDependentCost cost);
+
+  //! Sets the modification of the relation between from and to (in this order), replacing any previous one
+  TimeDependentCosts& set(Id from, Id to, TimeDependentCost cost);
+
+  //! Removes the modification of a lanelet or area. Returns false if there was none.
+  bool reset(Id laneletOrArea);
+
+  //! Removes the modification of a relation. Returns false if there was none.
+  bool reset(Id from, Id to);
+
+  Optional<TimeDependentCost> get(Id laneletOrArea) const;
+  Optional<TimeDependentCost> get(Id from, Id to) const;
+
+  const LaneletModifications& laneletModifications() const noexcept { return lanelets_; }
+  const RelationModifications& relationModifications() const noexcept { return relations_; }
+
+  bool empty() const noexcept { return lanelets_.empty() && relations_.empty(); }
+  void clear() noexcept {
+    lanelets_.clear();
+    relations_.clear();
+  }
+
+ private:
+  LaneletModifications lanelets_;
+  RelationModifications relations_;
+};
+
+}  // namespace routing
+}  // namespace lanelet
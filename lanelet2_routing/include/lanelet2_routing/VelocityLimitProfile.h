@@ -0,0 +1,139 @@
+#pragma once
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <lanelet2_core/primitives/LaneletSequence.h>
+#include <lanelet2_core/utility/Optional.h>
+#include <lanelet2_core/utility/Units.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include "lanelet2_routing/Forward.h"
+
+namespace lanelet {
+namespace routing {
+
+//! The velocity limits within a section of a VelocityLimitProfile
+struct VelocityLimit {
+  Velocity legal{std::numeric_limits<double>::infinity() * units::MPS()};  //!< Speed limit of the traffic rules
+  //! Highest velocity that does not exceed the maximum lateral acceleration. Inf on straight sections.
+  Velocity curve{std::numeric_limits<double>::infinity() * units::MPS()};
+  bool isMandatory{true};  //!< False if the legal speed limit is only a recommendation
+
+  //! The lower of the two limits
+  Velocity limit() const { return std::min(legal, curve); }
+
+  bool operator==(const VelocityLimit& rhs) const {
+    return legal == rhs.legal && curve == rhs.curve && isMandatory == rhs.isMandatory;
+  }
+  bool operator!=(const VelocityLimit& rhs) const { return !(*this == rhs); }
+};
+
+//! A part of a VelocityLimitProfile with constant limits
+struct VelocityLimitSection {
+  double start{};  //!< Arc length where the section starts
+  double end{};    //!< Arc length where the section ends
+  VelocityLimit limit;
+};
+
+//! A position along a VelocityLimitProfile where a regulatory element may require to stop
+struct StopPosition {
+  double arcLength{};                           //!< Position of the stop line or the end of the lanelet on the profile
+  ConstLanelet lanelet;                         //!< The lanelet that references the regulatory element
+  RegulatoryElementConstPtr regulatoryElement;  //!< A traffic light, an all way stop or a right of way to yield at
+  Optional<ConstLineString3d> stopLine;         //!< Empty if the regulatory element has no stop line for the lanelet
+};
+
+/** @brief Velocity limits along a path, indexed by the arc length of its centerline
+ *
+ *  Planners need the speed limit along their path in every cycle. TrafficRules::speedLimit evaluates the regulatory
+ *  elements and attributes of a lanelet on every call and the curvature of the centerline is not stored at all. The
+ *  profile evaluates them once per lanelet and stores the result as sections with constant limits:
+ *  - the legal speed limit of the traffic rules,
+ *  - the curve speed, i.e. the velocity at which the lateral acceleration reaches maxLateralAcceleration. The curvature
+ *    is estimated like in FrenetFrame and the highest curvature at the ends of a centerline segment is used for the
+ *    whole segment.
+ *  - positions where traffic lights, all way stops or right of way regulations (if the lanelet has to yield) may
+ *    require the vehicle to stop.
+ *
+ *  The arc length is measured along the centerlines of the lanelets the vehicle drives on. A lane change replaces the
+ *  lanelet it starts from, i.e. the vehicle is assumed to change lanes right at the start of the two lanelets. Its
+ *  legal limit is the lower one of both lanelets, its geometry is the one of the target lanelet.
+ *
+ *  The profile can follow a moving horizon: extend appends the lanelets that are new and dropBefore removes the part
+ *  the vehicle has passed. Arc lengths stay valid while this happens. All queries are binary searches.
+ *
+ *  The traffic rules must outlive the profile.
+ */
+class VelocityLimitProfile {
+ public:
+  /** @brief Creates an empty profile
+   *  @param maxLateralAcceleration used to compute the curve speed
+   *  @param curvatureWindow arc length before and after a point that is used to estimate the curvature */
+  explicit VelocityLimitProfile(const traffic_rules::TrafficRules& trafficRules,
+                                Acceleration maxLateralAcceleration = 2.0 * units::MPS2(),
+                                double curvatureWindow = 2.);
+
+  //! Creates the profile along a path. Consecutive lanelets have to be either successors or lane changes.
+  VelocityLimitProfile(const LaneletPath& path, const traffic_rules::TrafficRules& trafficRules,
+                       Acceleration maxLateralAcceleration = 2.0 * units::MPS2(), double curvatureWindow = 2.);
+
+  //! Creates the profile along the shortest path of a route
+  VelocityLimitProfile(const Route& route, const traffic_rules::TrafficRules& trafficRules,
+                       Acceleration maxLateralAcceleration = 2.0 * units::MPS2(), double curvatureWindow = 2.);
+
+  /** @brief Appends the lanelets of a path to the end of the profile
+   *
+   *  If the path contains the last lanelet of the profile, only the lanelets behind it are appended. This way, the
+   *  path of the current horizon can be passed in every cycle.
+   *  @throws InvalidInputError if the centerline of a lanelet has less than two distinct points */
+  void extend(const LaneletPath& path);
+  void extend(const LaneletSequence& lanelets);
+
+  //! Removes all lanelets that end before the arc length. The last lanelet is never removed.
+  void dropBefore(double arcLength);
+
+  //! Removes everything and restarts at an arc length of 0
+  void clear();
+
+  bool empty() const noexcept { return lanelets_.empty(); }
+
+  //! Arc length where the profile starts. Larger than 0 after dropBefore.
+  double startArcLength() const noexcept { return sections_.empty() ? end_ : sections_.front().start; }
+
+  //! Arc length where the profile ends
+  double endArcLength() const noexcept { return end_; }
+
+  //! The limits at the arc length. Arc lengths outside of the profile are clamped. @throws InvalidInputError if empty
+  const VelocityLimit& at(double arcLength) const;
+
+  //! The lower of the legal and the curve speed limit at the arc length
+  Velocity speedLimit(double arcLength) const { return at(arcLength).limit(); }
+
+  //! The lanelet that is driven on at the arc length. @throws InvalidInputError if empty
+  const ConstLanelet& laneletAt(double arcLength) const;
+
+  //! The first stop position at or behind the arc length
+  Optional<StopPosition> nextStop(double arcLength) const;
+
+  //! All sections, sorted by their arc length
+  const std::deque<VelocityLimitSection>& sections() const noexcept { return sections_; }
+
+  //! All stop positions, sorted by their arc length
+  const std::deque<StopPosition>& stopPositions() const noexcept { return stops_; }
+
+ private:
+  void append(const ConstLanelet& lanelet);
+
+  const traffic_rules::TrafficRules* trafficRules_;
+  double maxLateralAcceleration_;
+  double curvatureWindow_;
+  double end_{0.};
+  std::deque<VelocityLimitSection> sections_;
+  std::deque<StopPosition> stops_;
+  std::deque<std::pair<double, ConstLanelet>> lanelets_;  //!< Start arc length of each lanelet that is driven on
+  size_t lastLaneletSections_{0};                           //!< Number of sections of the last lanelet
+  traffic_rules::SpeedLimitInformation lastLegalLimit_;    //!< Legal limit of the last lanelet and its lane changes
+};
+
+}  // namespace routing
+}  // namespace lanelet
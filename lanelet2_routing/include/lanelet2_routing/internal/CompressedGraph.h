@@ -0,0 +1,110 @@
+#pragma once
+#include <boost/graph/graph_traits.hpp>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/Forward.h"
+
+namespace lanelet {
+namespace routing {
+namespace internal {
+
+//! An edge of a CompressedGraph. Only holds what is required for searching the graph.
+struct CompressedEdge {
+  std::uint32_t target;   ///< Vertex this edge leads to (or comes from, in a backward graph)
+  RelationType relation;  ///< Relation between the two lanelets
+  double routingCost;     ///< Calculated routing cost
+};
+
+/** @brief A frozen, compact copy of the edges of a (filtered) graph in one direction
+ *
+ * The edges are stored in compressed sparse row format: The edges leaving vertex v are edges_[offsets_[v]] up to
+ * edges_[offsets_[v+1]-1], in the same order as in the original graph. This makes traversals cache friendly and avoids
+ * evaluating the edge filter of a boost::filtered_graph over and over again.
+ *
+ * The class implements just enough of the boost graph interface (IncidenceGraph) to be used with the
+ * DijkstraStyleSearch. Vertex descriptors are the same as in the original graph, vertex properties have to be looked
+ * up there.
+ */
+class CompressedGraph {
+ public:
+  using vertex_descriptor = std::size_t;                          // NOLINT
+  using edge_descriptor = CompressedEdge;                         // NOLINT
+  using out_edge_iterator = const CompressedEdge*;                // NOLINT
+  using directed_category = boost::directed_tag;                  // NOLINT
+  using edge_parallel_category = boost::allow_parallel_edge_tag;  // NOLINT
+  using traversal_category = boost::incidence_graph_tag;          // NOLINT
+  using vertices_size_type = std::size_t;                         // NOLINT
+  using edges_size_type = std::size_t;                            // NOLINT
+  using degree_size_type = std::size_t;                           // NOLINT
+
+  CompressedGraph() = default;
+
+  /** @brief Copies all edges of a graph that pass a filter
+   *  @param graph a bidirectional boost graph with vecS vertex list and EdgeInfo as edge property
+   *  @param keep predicate on the edge descriptors of the graph
+   *  @param backwards if true, the in edges are stored instead of the out edges */
+  template <typename GraphT, typename FilterT>
+  CompressedGraph(const GraphT& graph, const FilterT& keep, bool backwards) {
+    const auto numVertices = boost::num_vertices(graph);
+    offsets_.reserve(numVertices + 1);
+    offsets_.push_back(0);
+    for (auto v = 0ul; v < numVertices; ++v) {
+      if (backwards) {
+        add(graph, boost::in_edges(v, graph), keep, [&](auto e) { return boost::source(e, graph); });
+      } else {
+        add(graph, boost::out_edges(v, graph), keep, [&](auto e) { return boost::target(e, graph); });
+      }
+      offsets_.push_back(std::uint32_t(edges_.size()));
+    }
+    edges_.shrink_to_fit();
+  }
+
+  std::size_t numVertices() const noexcept { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+  std::size_t numEdges() const noexcept { return edges_.size(); }
+
+  std::pair<out_edge_iterator, out_edge_iterator> outEdges(vertex_descriptor v) const noexcept {
+    return {edges_.data() + offsets_[v], edges_.data() + offsets_[v + 1]};
+  }
+
+  const CompressedEdge& operator[](const CompressedEdge& e) const noexcept { return e; }
+
+ private:
+  template <typename GraphT, typename EdgesT, typename FilterT, typename GetOtherT>
+  void add(const GraphT& graph, const EdgesT& edges, const FilterT& keep, GetOtherT&& getOther) {
+    for (auto it = edges.first; it != edges.second; ++it) {
+      if (keep(*it)) {
+        const auto& info = graph[*it];
+        edges_.push_back(CompressedEdge{std::uint32_t(getOther(*it)), info.relation, info.routingCost});
+      }
+    }
+  }
+
+  std::vector<std::uint32_t> offsets_;
+  std::vector<CompressedEdge> edges_;
+};
+
+inline std::pair<CompressedGraph::out_edge_iterator, CompressedGraph::out_edge_iterator> out_edges(  // NOLINT
+    CompressedGraph::vertex_descriptor v, const CompressedGraph& g) {
+  return g.outEdges(v);
+}
+inline CompressedGraph::vertex_descriptor target(const CompressedEdge& e, const CompressedGraph& /*g*/) {  // NOLINT
+  return e.target;
+}
+inline std::size_t out_degree(CompressedGraph::vertex_descriptor v, const CompressedGraph& g) {  // NOLINT
+  auto edges = g.outEdges(v);
+  return std::size_t(edges.second - edges.first);
+}
+inline std::size_t num_vertices(const CompressedGraph& g) { return g.numVertices(); }  // NOLINT
+
+//! The out and in edges of a filtered graph as CompressedGraphs
+struct CompressedGraphs {
+  CompressedGraph forward;
+  CompressedGraph backward;
+};
+using CompressedGraphsConstPtr = std::shared_ptr<const CompressedGraphs>;
+
+}  // namespace internal
+}  // namespace routing
+}  // namespace lanelet
@@ -0,0 +1,234 @@
+#pragma once
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "lanelet2_routing/RoutingCostOverlay.h"
+#include "lanelet2_routing/TimeDependentCost.h"
+#include "lanelet2_routing/internal/Graph.h"
+
+namespace lanelet {
+namespace routing {
+namespace internal {
+
+/** @brief Modifications of routing costs (a RoutingCostOverlay or TimeDependentCosts) translated to the vertices of a
+ *  routing graph
+ *
+ *  Lookups of modifications happen for every edge a search visits, therefore the modifications of vertices are stored
+ *  in an array indexed by the vertex. Modifications of edges are rare and looked up in a hash map only if there are
+ *  any. Both point into the modifications held by this object, which is why it can not be copied. */
+template <typename OverlayT>
+class ResolvedOverlay {
+ public:
+  using Overlay = OverlayT;
+  using Modification = typename OverlayT::Modification;
+
+  ResolvedOverlay(OverlayT overlay, const GraphType& graph,
+                  const std::unordered_multimap<Id, std::uint32_t>& vertexById)
+      : overlay_{std::move(overlay)} {
+    if (!overlay_.laneletModifications().empty()) {
+      vertices_.resize(boost::num_vertices(graph), nullptr);
+      for (const auto& mod : overlay_.laneletModifications()) {
+        auto range = vertexById.equal_range(mod.first);
+        for (auto it = range.first; it != range.second; ++it) {
+          vertices_[it->second] = &mod.second;
+        }
+      }
+    }
+    for (const auto& mod : overlay_.relationModifications()) {
+      auto from = vertexById.equal_range(mod.first.first);
+      auto to = vertexById.equal_range(mod.first.second);
+      for (auto fromIt = from.first; fromIt != from.second; ++fromIt) {
+        for (auto toIt = to.first; toIt != to.second; ++toIt) {
+          edges_.emplace(edgeKey(fromIt->second, toIt->second), &mod.second);
+        }
+      }
+    }
+  }
+  ResolvedOverlay(const ResolvedOverlay&) = delete;
+  ResolvedOverlay& operator=(const ResolvedOverlay&) = delete;
+  ResolvedOverlay(ResolvedOverlay&&) = delete;
+  ResolvedOverlay& operator=(ResolvedOverlay&&) = delete;
+  ~ResolvedOverlay() = default;
+
+  const OverlayT& overlay() const noexcept { return overlay_; }
+
+ protected:
+  //! Modification of a vertex or nullptr
+  const Modification* vertex(std::uint32_t v) const noexcept { return vertices_.empty() ? nullptr : vertices_[v]; }
+
+  //! Modification of the edge from -> to or nullptr
+  const Modification* edge(std::uint32_t from, std::uint32_t to) const {
+    if (edges_.empty()) {
+      return nullptr;
+    }
+    auto edge = edges_.find(edgeKey(from, to));
+    return edge != edges_.end() ? edge->second : nullptr;
+  }
+
+ private:
+  static std::uint64_t edgeKey(std::uint32_t from, std::uint32_t to) noexcept {
+    return (std::uint64_t(from) << 32U) | to;
+  }
+
+  OverlayT overlay_;
+  std::vector<const Modification*> vertices_;
+  std::unordered_map<std::uint64_t, const Modification*> edges_;
+};
+
+//! A RoutingCostOverlay translated to the vertices of a routing graph
+class ResolvedCostOverlay : public ResolvedOverlay<RoutingCostOverlay> {
+ public:
+  using ResolvedOverlay::ResolvedOverlay;
+
+  //! Returns the modified cost of the edge from -> to
+  double cost(std::uint32_t from, std::uint32_t to, double routingCost) const {
+    const auto* toMod = vertex(to);
+    if (toMod != nullptr && toMod->isBlocked()) {
+      return CostModification::blocked().apply(routingCost);
+    }
+    const auto* fromMod = vertex(from);
+    if (fromMod != nullptr && fromMod->isBlocked()) {
+      return fromMod->apply(routingCost);
+    }
+    const auto* edgeMod = edge(from, to);
+    if (edgeMod != nullptr) {
+      return edgeMod->apply(routingCost);
+    }
+    return fromMod != nullptr ? fromMod->apply(routingCost) : routingCost;
+  }
+};
+using ResolvedCostOverlayConstPtr = std::shared_ptr<const ResolvedCostOverlay>;
+
+//! TimeDependentCosts translated to the vertices of a routing graph
+class ResolvedTimeDependentCosts : public ResolvedOverlay<TimeDependentCosts> {
+ public:
+  using ResolvedOverlay::ResolvedOverlay;
+
+  //! Returns the modified cost of the edge from -> to if from is entered at the given time. The edge is blocked if to
+  //! is blocked at the time it is reached.
+  double cost(std::uint32_t from, std::uint32_t to, double routingCost, double time) const {
+    const auto* fromMod = vertex(from);
+    if (fromMod != nullptr && fromMod->isBlocked(time)) {
+      return std::numeric_limits<double>::infinity();
+    }
+    const auto* edgeMod = edge(from, to);
+    double cost = routingCost;
+    if (edgeMod != nullptr) {
+      cost = edgeMod->apply(routingCost, time);
+    } else if (fromMod != nullptr) {
+      cost = fromMod->apply(routingCost, time);
+    }
+    const auto* toMod = vertex(to);
+    if (toMod != nullptr && toMod->isBlocked(time + cost)) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return cost;
+  }
+};
+using ResolvedTimeDependentCostsConstPtr = std::shared_ptr<const ResolvedTimeDependentCosts>;
+
+/** @brief Holds the modifications of the routing costs that are currently active for a routing graph
+ *
+ *  Queries obtain the modifications with load() and keep using them until they are done, so an update never affects a
+ *  query that is already running. Updates are serialized, queries never wait for them. */
+template <typename ResolvedT>
+class OverlayState {
+ public:
+  using Overlay = typename ResolvedT::Overlay;
+  using ResolvedConstPtr = std::shared_ptr<const ResolvedT>;
+
+  ResolvedConstPtr load() const { return std::atomic_load_explicit(&current_, std::memory_order_acquire); }
+
+  //! Applies update to a copy of the current modifications and publishes the result
+  template <typename Func>
+  void update(const GraphType& graph, Func&& update) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto current = load();
+    Overlay overlay = !!current ? current->overlay() : Overlay{};
+    update(overlay);
+    ResolvedConstPtr resolved;
+    if (!overlay.empty()) {
+      resolved = std::make_shared<const ResolvedT>(std::move(overlay), graph, vertexById(graph));
+    }
+    std::atomic_store_explicit(&current_, std::move(resolved), std::memory_order_release);
+  }
+
+ private:
+  const std::unordered_multimap<Id, std::uint32_t>& vertexById(const GraphType& graph) {
+    if (vertexById_.empty()) {
+      const auto numVertices = boost::num_vertices(graph);
+      vertexById_.reserve(numVertices);
+      for (auto v = 0ul; v < numVertices; ++v) {
+        vertexById_.emplace(graph[v].laneletOrArea.id(), std::uint32_t(v));
+      }
+    }
+    return vertexById_;
+  }
+
+  std::mutex mutex_;
+  ResolvedConstPtr current_;
+  std::unordered_multimap<Id, std::uint32_t> vertexById_;
+};
+
+//! The RoutingCostOverlay of a routing graph
+class CostOverlayState : public OverlayState<ResolvedCostOverlay> {};
+
+//! The TimeDependentCosts of a routing graph
+class TimeDependentCostState : public OverlayState<ResolvedTimeDependentCosts> {};
+
+/** @brief Edge cost for the DijkstraStyleSearch that applies a cost overlay
+ *
+ *  For searches on a backward graph, the search walks along the edges in reverse. */
+class OverlaidEdgeCost {
+ public:
+  OverlaidEdgeCost() = default;
+  OverlaidEdgeCost(const ResolvedCostOverlay* overlay, bool backwards) : overlay_{overlay}, backwards_{backwards} {}
+
+  template <typename VertexT>
+  double operator()(VertexT from, VertexT to, double routingCost, double /*costSoFar*/) const {
+    if (overlay_ == nullptr) {
+      return routingCost;
+    }
+    return backwards_ ? overlay_->cost(std::uint32_t(to), std::uint32_t(from), routingCost)
+                      : overlay_->cost(std::uint32_t(from), std::uint32_t(to), routingCost);
+  }
+
+ private:
+  const ResolvedCostOverlay* overlay_{};
+  bool backwards_{false};
+};
+
+/** @brief Edge cost for the DijkstraStyleSearch that applies a cost overlay and time dependent costs
+ *
+ *  The time at which a vertex is entered is the departure time plus the cost accumulated so far, therefore the routing
+ *  costs should be travel times. Only works for forward searches. */
+class TimeDependentEdgeCost {
+ public:
+  TimeDependentEdgeCost() = default;
+  TimeDependentEdgeCost(const ResolvedCostOverlay* overlay, const ResolvedTimeDependentCosts* costs,
+                        double departureTime)
+      : overlaid_{overlay, false}, costs_{costs}, departureTime_{departureTime} {}
+
+  template <typename VertexT>
+  double operator()(VertexT from, VertexT to, double routingCost, double costSoFar) const {
+    const double cost = overlaid_(from, to, routingCost, costSoFar);
+    if (costs_ == nullptr || std::isinf(cost)) {
+      return cost;
+    }
+    return costs_->cost(std::uint32_t(from), std::uint32_t(to), cost, departureTime_ + costSoFar);
+  }
+
+ private:
+  OverlaidEdgeCost overlaid_;
+  const ResolvedTimeDependentCosts* costs_{};
+  double departureTime_{};
+};
+
+}  // namespace internal
+}  // namespace routing
+}  // namespace lanelet
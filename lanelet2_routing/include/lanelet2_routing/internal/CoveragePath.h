@@ -0,0 +1,599 @@
+#pragma once
+#include <lanelet2_core/utility/Optional.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/internal/ShortestPath.h"
+
+namespace lanelet {
+namespace routing {
+namespace internal {
+
+/** @brief Plans a path that passes all vertices that can be reached from a start vertex
+ *
+ * This is a directed rural postman problem: Each vertex is seen as a required arc from its entry to its exit, the edges
+ * of the graph are optional arcs from the exit of one vertex to the entry of the next. The planner proceeds in steps:
+ * 1. Only the vertices that are reachable from 'from' and can reach 'to' can be covered at all. Of their strongly
+ *    connected components, a path can only pass those that are on one chain from the start to the destination. The
+ *    chain that contains the most vertices is chosen, the others are reported as uncovered.
+ * 2. The exit of every vertex on the chain needs a path to the entry of some other vertex. The cheapest such
+ *    assignment is a min cost flow from the exits to the entries, which is computed with successive shortest paths.
+ *    These run on the sparse graph and usually stop after a few vertices, so no many-to-many cost matrix is needed.
+ * 3. The vertices and the edges of the flow form a balanced multigraph. Its Euler circuit through the start is turned
+ *    into a path by removing a virtual edge from the destination to the start.
+ * 4. The flow may also form circuits that are not connected to this path. Each of them is spliced in where the detour
+ *    to the circuit and back is the cheapest.
+ *
+ * The result is optimal if step 4 is not required, which is the case for most road networks.
+ *
+ * @tparam G a graph that supports out_edges and target, like the CompressedGraph
+ * @tparam EdgeCostT see DijkstraStyleSearch. The cost must not depend on the cost of the path so far and must not be
+ * negative. Edges with an infinite cost are not used.
+ */
+template <typename G, typename EdgeCostT = StoredEdgeCost>
+class CoveragePathPlanner {
+ public:
+  using VertexType = typename boost::graph_traits<G>::vertex_descriptor;
+
+  struct Result {
+    std::vector<VertexType> vertices;   //!< The path from 'from' to 'to'
+    double cost{};                      //!< Sum of the edge costs along the path
+    std::vector<VertexType> uncovered;  //!< Vertices that are reachable from 'from', but not part of the path
+  };
+
+  explicit CoveragePathPlanner(const G& graph, EdgeCostT edgeCost = {})
+      : graph_{graph}, edgeCost_{std::move(edgeCost)} {}
+
+  //! Plans the path. Returns nothing if 'to' can not be reached from 'from'.
+  Optional<Result> query(VertexType from, VertexType to) {
+    auto reachable = reachableFrom(from);
+    auto localIndex = indexOf(reachable);
+    if (localIndex[to] == NoVertex) {
+      return {};
+    }
+    auto canReachTo = backwardClosure(subgraph(reachable, localIndex), localIndex[to]);
+    vertices_.clear();
+    for (size_t i = 0; i < reachable.size(); ++i) {
+      if (canReachTo[i] != 0) {
+        vertices_.push_back(reachable[i]);
+      }
+    }
+    auto coverable = indexOf(vertices_);
+    forward_ = subgraph(vertices_, coverable);
+    backward_ = transposed(forward_);
+    const auto start = coverable[from];
+    const auto destination = coverable[to];
+
+    auto flow = balance(start, destination, requiredVertices(start, destination));
+    if (!flow) {
+      return {};
+    }
+    auto circuits = eulerCircuits(*flow, start, destination);
+    auto walk = std::move(circuits.front());
+    for (auto it = std::next(circuits.begin()); it != circuits.end(); ++it) {
+      splice(walk, *it);
+    }
+
+    Result result;
+    std::vector<char> covered(num_vertices(graph_), 0);
+    result.vertices.reserve(walk.size());
+    for (size_t i = 0; i < walk.size(); ++i) {
+      result.vertices.push_back(vertices_[walk[i]]);
+      covered[vertices_[walk[i]]] = 1;
+      if (i > 0) {
+        result.cost += cheapestEdge(walk[i - 1], walk[i]);
+      }
+    }
+    for (auto v : reachable) {
+      if (covered[v] == 0) {
+        result.uncovered.push_back(v);
+      }
+    }
+    return result;
+  }
+
+ private:
+  using Local = std::uint32_t;
+  using Walk = std::vector<Local>;
+  static constexpr Local NoVertex = std::numeric_limits<Local>::max();
+  static constexpr double Infinity = std::numeric_limits<double>::infinity();
+
+  struct LocalEdge {
+    Local target;
+    double cost;
+  };
+
+  //! Compressed sparse row copy of a part of the graph, with the vertices numbered from 0
+  struct LocalGraph {
+    std::vector<std::uint32_t> offsets{0};
+    std::vector<LocalEdge> edges;
+    size_t size() const noexcept { return offsets.size() - 1; }
+    const LocalEdge* begin(Local v) const noexcept { return edges.data() + offsets[v]; }
+    const LocalEdge* end(Local v) const noexcept { return edges.data() + offsets[v + 1]; }
+  };
+
+  // Preparation
+
+  std::vector<VertexType> reachableFrom(VertexType from) const {
+    std::vector<VertexType> reached{from};
+    std::vector<char> seen(num_vertices(graph_), 0);
+    seen[from] = 1;
+    for (size_t i = 0; i < reached.size(); ++i) {
+      const auto v = reached[i];
+      for (auto edges = out_edges(v, graph_); edges.first != edges.second; ++edges.first) {
+        const auto next = target(*edges.first, graph_);
+        if (seen[next] == 0 && std::isfinite(edgeCost_(v, next, graph_[*edges.first].routingCost, 0.))) {
+          seen[next] = 1;
+          reached.push_back(next);
+        }
+      }
+    }
+    return reached;
+  }
+
+  std::vector<Local> indexOf(const std::vector<VertexType>& vertices) const {
+    std::vector<Local> index(num_vertices(graph_), NoVertex);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      index[vertices[i]] = Local(i);
+    }
+    return index;
+  }
+
+  //! The usable edges between the given vertices
+  LocalGraph subgraph(const std::vector<VertexType>& vertices, const std::vector<Local>& index) const {
+    LocalGraph result;
+    result.offsets.reserve(vertices.size() + 1);
+    for (auto v : vertices) {
+      for (auto edges = out_edges(v, graph_); edges.first != edges.second; ++edges.first) {
+        const auto next = target(*edges.first, graph_);
+        const auto cost = edgeCost_(v, next, graph_[*edges.first].routingCost, 0.);
+        if (index[next] != NoVertex && std::isfinite(cost)) {
+          result.edges.push_back(LocalEdge{index[next], cost});
+        }
+      }
+      result.offsets.push_back(std::uint32_t(result.edges.size()));
+    }
+    return result;
+  }
+
+  static LocalGraph transposed(const LocalGraph& graph) {
+    LocalGraph result;
+    result.offsets.assign(graph.size() + 1, 0);
+    for (const auto& edge : graph.edges) {
+      ++result.offsets[edge.target + 1];
+    }
+    std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+    result.edges.resize(graph.edges.size());
+    auto position = result.offsets;
+    for (Local v = 0; v < graph.size(); ++v) {
+      for (auto edge = graph.begin(v); edge != graph.end(v); ++edge) {
+        result.edges[position[edge->target]++] = LocalEdge{v, edge->cost};
+      }
+    }
+    return result;
+  }
+
+  //! Marks the vertices that can reach 'to'
+  static std::vector<char> backwardClosure(const LocalGraph& graph, Local to) {
+    auto backward = transposed(graph);
+    std::vector<char> result(graph.size(), 0);
+    std::vector<Local> queue{to};
+    result[to] = 1;
+    for (size_t i = 0; i < queue.size(); ++i) {
+      for (auto edge = backward.begin(queue[i]); edge != backward.end(queue[i]); ++edge) {
+        if (result[edge->target] == 0) {
+          result[edge->target] = 1;
+          queue.push_back(edge->target);
+        }
+      }
+    }
+    return result;
+  }
+
+  //! Strongly connected components (Tarjan). Edges only lead to components with a lower or the same number.
+  std::vector<Local> components(Local& numComponents) const {
+    const auto n = forward_.size();
+    std::vector<Local> index(n, NoVertex);
+    std::vector<Local> low(n);
+    std::vector<Local> component(n, NoVertex);
+    std::vector<Local> stack;
+    std::vector<std::pair<Local, std::uint32_t>> callStack;  // vertex and its next edge
+    Local counter{};
+    numComponents = 0;
+    auto visit = [&](Local v) {
+      index[v] = low[v] = counter++;
+      stack.push_back(v);
+      callStack.emplace_back(v, forward_.offsets[v]);
+    };
+    for (Local root = 0; root < n; ++root) {
+      if (index[root] != NoVertex) {
+        continue;
+      }
+      visit(root);
+      while (!callStack.empty()) {
+        const auto v = callStack.back().first;
+        if (callStack.back().second < forward_.offsets[v + 1]) {
+          const auto w = forward_.edges[callStack.back().second++].target;
+          if (index[w] == NoVertex) {
+            visit(w);
+          } else if (component[w] == NoVertex) {
+            low[v] = std::min(low[v], index[w]);
+          }
+          continue;
+        }
+        callStack.pop_back();
+        if (!callStack.empty()) {
+          low[callStack.back().first] = std::min(low[callStack.back().first], low[v]);
+        }
+        if (low[v] == index[v]) {
+          Local w{};
+          do {
+            w = stack.back();
+            stack.pop_back();
+            component[w] = numComponents;
+          } while (w != v);
+          ++numComponents;
+        }
+      }
+    }
+    return component;
+  }
+
+  //! Marks the vertices of the chain of components from start to destination that contains the most vertices
+  std::vector<char> requiredVertices(Local start, Local destination) const {
+    Local numComponents{};
+    auto component = components(numComponents);
+    std::vector<std::uint32_t> size(numComponents, 0);
+    std::vector<std::vector<Local>> successors(numComponents);
+    for (Local v = 0; v < forward_.size(); ++v) {
+      ++size[component[v]];
+      for (auto edge = forward_.begin(v); edge != forward_.end(v); ++edge) {
+        if (component[edge->target] != component[v]) {
+          successors[component[v]].push_back(component[edge->target]);
+        }
+      }
+    }
+    // successors have lower numbers, so the longest chain can be found in one pass
+    std::vector<std::uint32_t> chainSize(numComponents, 0);
+    std::vector<Local> next(numComponents, NoVertex);
+    for (Local c = 0; c < numComponents; ++c) {
+      if (c == component[destination]) {
+        chainSize[c] = size[c];
+        continue;
+      }
+      for (auto succ : successors[c]) {
+        if (chainSize[succ] > 0 && size[c] + chainSize[succ] > chainSize[c]) {
+          chainSize[c] = size[c] + chainSize[succ];
+          next[c] = succ;
+        }
+      }
+    }
+    std::vector<char> onChain(numComponents, 0);
+    for (auto c = component[start]; c != NoVertex; c = next[c]) {
+      onChain[c] = 1;
+    }
+    return utils::transform(component, [&](Local c) { return onChain[c]; });
+  }
+
+  // Balancing
+
+  /** @brief Min cost flow from the exit of every required vertex to the entries of the others
+   *
+   *  The flow network has an entry node 2v and an exit node 2v+1 for each vertex. Arcs lead from the entry to the exit
+   *  of each vertex (passing it once more) and along the edges of the graph from exit to entry. Required vertices are
+   *  passed at least once, so their exit has to send one unit and their entry has to receive one. The virtual edge from
+   *  the destination to the start removes this for the exit of the destination and the entry of the start.
+   *  @return the flow along each edge of forward_ */
+  Optional<std::vector<std::uint32_t>> balance(Local start, Local destination, const std::vector<char>& required) {
+    const auto n = forward_.size();
+    const auto numArcs = n + forward_.edges.size();
+    // arc pair i consists of the arc 2i and its residual arc 2i+1
+    std::vector<Local> head(2 * numArcs);
+    std::vector<double> cost(2 * numArcs);
+    std::vector<std::vector<std::uint32_t>> arcs(2 * n);
+    auto addArc = [&](std::uint32_t pair, Local tail, Local to, double c) {
+      head[2 * pair] = to;
+      head[2 * pair + 1] = tail;
+      cost[2 * pair] = c;
+      cost[2 * pair + 1] = -c;
+      arcs[tail].push_back(2 * pair);
+      arcs[to].push_back(2 * pair + 1);
+    };
+    for (Local v = 0; v < n; ++v) {
+      addArc(v, 2 * v, 2 * v + 1, 0.);
+    }
+    for (Local v = 0; v < n; ++v) {
+      for (auto e = forward_.offsets[v]; e < forward_.offsets[v + 1]; ++e) {
+        addArc(n + e, 2 * v + 1, 2 * forward_.edges[e].target, forward_.edges[e].cost);
+      }
+    }
+    std::vector<std::int32_t> excess(2 * n, 0);
+    for (Local v = 0; v < n; ++v) {
+      if (required[v] != 0) {
+        excess[2 * v + 1] += v != destination ? 1 : 0;
+        excess[2 * v] -= v != start ? 1 : 0;
+      }
+    }
+
+    std::vector<std::uint32_t> flow(numArcs, 0);
+    std::vector<double> potential(2 * n, 0.);
+    std::vector<double> dist(2 * n, Infinity);
+    std::vector<std::uint32_t> predArc(2 * n);
+    std::vector<Local> touched;
+    std::vector<Local> settled;
+    using QueueEntry = std::pair<double, Local>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+    for (Local source = 0; source < 2 * n; ++source) {
+      while (excess[source] > 0) {
+        // dijkstra on the reduced costs until the first node that still needs flow is settled
+        queue.push({0., source});
+        dist[source] = 0.;
+        touched.push_back(source);
+        Local sink = NoVertex;
+        while (!queue.empty()) {
+          const auto entry = queue.top();
+          queue.pop();
+          const auto u = entry.second;
+          if (entry.first > dist[u]) {
+            continue;
+          }
+          settled.push_back(u);
+          if (excess[u] < 0) {
+            sink = u;
+            break;
+          }
+          for (auto arc : arcs[u]) {
+            if (arc % 2 == 1 && flow[arc / 2] == 0) {
+              continue;
+            }
+            const auto w = head[arc];
+            const auto d = dist[u] + std::max(0., cost[arc] + potential[u] - potential[w]);
+            if (d < dist[w]) {
+              if (dist[w] == Infinity) {
+                touched.push_back(w);
+              }
+              dist[w] = d;
+              predArc[w] = arc;
+              queue.push({d, w});
+            }
+          }
+        }
+        if (sink == NoVertex) {
+          return {};
+        }
+        for (auto u = sink; u != source; u = head[predArc[u] ^ 1U]) {
+          const auto arc = predArc[u];
+          if (arc % 2 == 0) {
+            ++flow[arc / 2];
+          } else {
+            --flow[arc / 2];
+          }
+        }
+        --excess[source];
+        ++excess[sink];
+        for (auto u : settled) {
+          potential[u] += dist[u] - dist[sink];
+        }
+        for (auto u : touched) {
+          dist[u] = Infinity;
+        }
+        touched.clear();
+        settled.clear();
+        queue = decltype(queue)();
+      }
+    }
+    return std::vector<std::uint32_t>(flow.begin() + n, flow.end());
+  }
+
+  // Euler circuits
+
+  /** @brief Splits the multigraph of the flow into circuits
+   *  @return the path from start to destination, followed by the circuits that are not connected to it. Circuits start
+   * and end at the same vertex. */
+  std::vector<Walk> eulerCircuits(const std::vector<std::uint32_t>& flow, Local start, Local destination) const {
+    const auto n = forward_.size();
+    std::vector<Local> edgeHead;
+    std::vector<std::uint32_t> offsets{0};
+    for (Local v = 0; v < n; ++v) {
+      for (auto e = forward_.offsets[v]; e < forward_.offsets[v + 1]; ++e) {
+        edgeHead.insert(edgeHead.end(), flow[e], forward_.edges[e].target);
+      }
+      if (v == destination) {
+        edgeHead.push_back(start);
+      }
+      offsets.push_back(std::uint32_t(edgeHead.size()));
+    }
+    const auto virtualEdge = offsets[destination + 1] - 1;
+    auto nextEdge = offsets;
+
+    // Hierholzer's algorithm, returns the edges of the circuit in order
+    auto circuit = [&](Local from) {
+      std::vector<std::uint32_t> edges;
+      std::vector<Local> vertexStack{from};
+      std::vector<std::uint32_t> edgeStack;
+      while (!vertexStack.empty()) {
+        const auto v = vertexStack.back();
+        if (nextEdge[v] < offsets[v + 1]) {
+          const auto e = nextEdge[v]++;
+          vertexStack.push_back(edgeHead[e]);
+          edgeStack.push_back(e);
+          continue;
+        }
+        vertexStack.pop_back();
+        if (!edgeStack.empty()) {
+          edges.push_back(edgeStack.back());
+          edgeStack.pop_back();
+        }
+      }
+      std::reverse(edges.begin(), edges.end());
+      return edges;
+    };
+
+    std::vector<Walk> result;
+    auto edges = circuit(start);
+    std::rotate(edges.begin(), std::next(std::find(edges.begin(), edges.end(), virtualEdge)), edges.end());
+    edges.pop_back();
+    Walk path{start};
+    for (auto e : edges) {
+      path.push_back(edgeHead[e]);
+    }
+    result.push_back(std::move(path));
+    for (Local v = 0; v < n; ++v) {
+      if (nextEdge[v] == offsets[v + 1]) {
+        continue;
+      }
+      Walk cycle{v};
+      for (auto e : circuit(v)) {
+        cycle.push_back(edgeHead[e]);
+      }
+      result.push_back(std::move(cycle));
+    }
+    return result;
+  }
+
+  // Splicing
+
+  double cheapestEdge(Local from, Local to) const {
+    double result = Infinity;
+    for (auto edge = forward_.begin(from); edge != forward_.end(from); ++edge) {
+      if (edge->target == to) {
+        result = std::min(result, edge->cost);
+      }
+    }
+    return result;
+  }
+
+  //! Dijkstra from several sources. 'via' is the vertex each vertex was reached from, sources refer to themselves.
+  static void search(const LocalGraph& graph, const Walk& sources, std::vector<double>& cost, std::vector<Local>& via) {
+    cost.assign(graph.size(), Infinity);
+    via.assign(graph.size(), NoVertex);
+    using QueueEntry = std::pair<double, Local>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+    for (auto s : sources) {
+      cost[s] = 0.;
+      via[s] = s;
+      queue.push({0., s});
+    }
+    while (!queue.empty()) {
+      const auto entry = queue.top();
+      queue.pop();
+      if (entry.first > cost[entry.second]) {
+        continue;
+      }
+      for (auto edge = graph.begin(entry.second); edge != graph.end(entry.second); ++edge) {
+        const auto c = entry.first + edge->cost;
+        if (c < cost[edge->target]) {
+          cost[edge->target] = c;
+          via[edge->target] = entry.second;
+          queue.push({c, edge->target});
+        }
+      }
+    }
+  }
+
+  /** @brief Inserts a circuit into the walk
+   *
+   *  The walk is left after some position p towards a vertex b of the circuit, follows the circuit and rejoins the walk
+   *  at position q <= p + 1. If q <= p, the part from q to p is driven twice. */
+  void splice(Walk& walk, const Walk& cycle) const {
+    std::vector<char> inWalk(forward_.size(), 0);
+    for (auto v : walk) {
+      inWalk[v] = 1;
+    }
+    if (std::all_of(cycle.begin(), cycle.end(), [&](Local v) { return inWalk[v] != 0; })) {
+      return;
+    }
+    // enter the circuit where it is the closest to the walk
+    std::vector<double> toCycle;
+    std::vector<Local> via;
+    search(backward_, cycle, toCycle, via);
+    const auto closest = *std::min_element(walk.begin(), walk.end(),
+                                           [&](Local lhs, Local rhs) { return toCycle[lhs] < toCycle[rhs]; });
+    if (toCycle[closest] == Infinity) {
+      return;
+    }
+    auto entry = closest;
+    while (via[entry] != entry) {
+      entry = via[entry];
+    }
+    std::vector<double> toEntry;
+    std::vector<Local> towardsEntry;
+    search(backward_, {entry}, toEntry, towardsEntry);
+    std::vector<double> fromEntry;
+    std::vector<Local> viaFromEntry;
+    search(forward_, {entry}, fromEntry, viaFromEntry);
+
+    std::vector<double> prefix(walk.size(), 0.);
+    for (size_t i = 1; i < walk.size(); ++i) {
+      prefix[i] = prefix[i - 1] + cheapestEdge(walk[i - 1], walk[i]);
+    }
+    // minimize toEntry(p) + prefix(p) + fromEntry(q) - prefix(q) over q <= p + 1
+    double bestCost = Infinity;
+    size_t bestP{};
+    size_t bestQ{};
+    double bestRejoin = Infinity;
+    size_t bestRejoinQ{};
+    auto considerRejoin = [&](size_t q) {
+      const auto c = fromEntry[walk[q]] - prefix[q];
+      if (c < bestRejoin) {
+        bestRejoin = c;
+        bestRejoinQ = q;
+      }
+    };
+    considerRejoin(0);
+    for (size_t p = 0; p < walk.size(); ++p) {
+      if (p + 1 < walk.size()) {
+        considerRejoin(p + 1);
+      }
+      const auto c = toEntry[walk[p]] + prefix[p] + bestRejoin;
+      if (c < bestCost) {
+        bestCost = c;
+        bestP = p;
+        bestQ = bestRejoinQ;
+      }
+    }
+    if (bestCost == Infinity) {
+      return;
+    }
+
+    Walk result(walk.begin(), walk.begin() + bestP + 1);
+    for (auto v = walk[bestP]; v != entry;) {
+      v = towardsEntry[v];
+      result.push_back(v);
+    }
+    auto cycleEntry = std::find(cycle.begin(), std::prev(cycle.end()), entry);
+    result.insert(result.end(), std::next(cycleEntry), std::prev(cycle.end()));
+    result.insert(result.end(), cycle.begin(), std::next(cycleEntry));
+    Walk back;
+    for (auto v = walk[bestQ]; v != entry; v = viaFromEntry[v]) {
+      back.push_back(v);
+    }
+    result.insert(result.end(), back.rbegin(), back.rend());
+    result.insert(result.end(), walk.begin() + bestQ + 1, walk.end());
+    walk = std::move(result);
+  }
+
+  const G& graph_;
+  EdgeCostT edgeCost_;
+  std::vector<VertexType> vertices_;  //!< The vertices that can be covered, in local numbering
+  LocalGraph forward_;
+  LocalGraph backward_;
+};
+
+#if __cplusplus < 201703L
+template <typename G, typename EdgeCostT>
+constexpr typename CoveragePathPlanner<G, EdgeCostT>::Local CoveragePathPlanner<G, EdgeCostT>::NoVertex;
+template <typename G, typename EdgeCostT>
+constexpr double CoveragePathPlanner<G, EdgeCostT>::Infinity;
+#endif
+
+}  // namespace internal
+}  // namespace routing
+}  // namespace lanelet
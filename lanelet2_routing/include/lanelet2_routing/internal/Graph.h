@@ -3,10 +3,19 @@
 #include <lanelet2_core/primitives/LaneletOrArea.h>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/filtered_graph.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
+#include "lanelet2_routing/ConflictZone.h"
 #include "lanelet2_routing/Exceptions.h"
 #include "lanelet2_routing/Forward.h"
+#include "lanelet2_routing/internal/CompressedGraph.h"
 
 namespace lanelet {
 namespace routing {
@@ -27,7 +36,7 @@ struct RouteVertexInfo {
 
   ConstLanelet lanelet;
   LaneId laneId{};
-  ConstLaneletOrAreas conflictingInMap;
+  std::uint32_t graphVertex{};  ///< Vertex of the lanelet in the routing graph the route was built from
 };
 
 /** @brief Internal information of an edge in the graph */
@@ -100,6 +109,87 @@ struct EdgeCostFilter {
 using LaneletOrAreaToVertex = std::unordered_map<ConstLaneletOrArea, std::uint32_t>;
 using FilteredGraphDesc = std::pair<size_t, RelationType>;
 
+/** @brief Finds vertices by the id of their lanelet or area
+ *
+ *  A flat open addressing table. Lookups do not allocate and do not copy the lanelet or area that is searched for, so
+ *  they never touch the reference count of shared data. Any number of threads can look up vertices at the same time as
+ *  long as nothing is inserted. A lanelet and its inverse (or a lanelet and an area of another layer) can have the same
+ *  id, therefore every vertex with a matching id is passed to a predicate that decides whether it is the right one.
+ */
+template <typename VertexT>
+class VertexLookup {
+ public:
+  void insert(Id id, VertexT vertex) {
+    if (2 * (size_ + 1) > slots_.size()) {
+      rehash(std::max<size_t>(16, 2 * slots_.size()));
+    }
+    place(id, vertex);
+    ++size_;
+  }
+
+  template <typename MatchT>
+  Optional<VertexT> find(Id id, MatchT&& matches) const noexcept {
+    if (slots_.empty()) {
+      return {};
+    }
+    for (auto i = bucket(id); slots_[i].used; i = (i + 1) & (slots_.size() - 1)) {
+      if (slots_[i].id == id && matches(slots_[i].vertex)) {
+        return slots_[i].vertex;
+      }
+    }
+    return {};
+  }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+ private:
+  struct Slot {
+    Id id{};
+    VertexT vertex{};
+    bool used{false};
+  };
+
+  //! Fibonacci hashing, spreads consecutive ids over the whole table
+  size_t bucket(Id id) const noexcept { return size_t((std::uint64_t(id) * 0x9E3779B97F4A7C15ULL) >> shift_); }
+
+  void place(Id id, VertexT vertex) {
+    auto i = bucket(id);
+    while (slots_[i].used) {
+      i = (i + 1) & (slots_.size() - 1);
+    }
+    slots_[i] = Slot{id, vertex, true};
+  }
+
+  void rehash(size_t capacity) {
+    auto old = std::move(slots_);
+    slots_.assign(capacity, Slot{});
+    shift_ = 64;
+    for (auto c = capacity; c > 1; c >>= 1U) {
+      --shift_;
+    }
+    for (const auto& slot : old) {
+      if (slot.used) {
+        place(slot.id, slot.vertex);
+      }
+    }
+  }
+
+  std::vector<Slot> slots_;  //!< Size is a power of two and at least twice the number of elements
+  size_t size_{0};
+  unsigned shift_{64};
+};
+
+//! Helpers to compare the primitive of a vertex with the one that is searched without copying either of them
+inline bool isSamePrimitive(const ConstLanelet& stored, const ConstLanelet& lanelet) { return stored == lanelet; }
+inline bool isSamePrimitive(const ConstLanelet& /*stored*/, const ConstArea& /*area*/) { return false; }
+inline bool isSamePrimitive(const ConstLaneletOrArea& stored, const ConstLanelet& lanelet) {
+  return stored.isLanelet() && static_cast<const ConstLanelet&>(stored) == lanelet;
+}
+inline bool isSamePrimitive(const ConstLaneletOrArea& stored, const ConstArea& area) {
+  return stored.isArea() && static_cast<const ConstArea&>(stored) == area;
+}
+
 /// @brief Manages the actual routing graph and provieds different views on the edges (lazily computed)
 template <typename BaseGraphT>
 class Graph {
@@ -114,7 +204,6 @@ class Graph {
   inline const BaseGraphT& get() const noexcept { return graph_; }
   inline BaseGraphT& get() noexcept { return graph_; }
   inline size_t numRoutingCosts() const noexcept { return numRoutingCosts_; }
-  inline const LaneletOrAreaToVertex& vertexLookup() const noexcept { return laneletOrAreaToVertex_; }
 
   FilteredGraph withLaneChanges(RoutingCostId routingCostId = 0) const {
     return getFilteredGraph(routingCostId, RelationType::Successor | RelationType::Left | RelationType::Right);
@@ -163,14 +252,40 @@ class Graph {
     return getFilteredGraph(routingCostId, allRelations() | ~RelationType::Conflicting);
   }
 
-  inline bool empty() const noexcept { return laneletOrAreaToVertex_.empty(); }
+  /** @brief Returns the edges of a filtered view in compressed form, which is much faster to search
+   *
+   *  The compressed graphs are built on first use and shared by all subsequent calls with the same arguments until a
+   *  vertex or edge is added to the graph. Modifying the graph through get() does not invalidate them! Once built, they
+   *  are returned without taking a lock, so that concurrent queries do not wait for each other.
+   *  @throws InvalidInputError if the routing cost id is invalid */
+  CompressedGraphsConstPtr compressed(RoutingCostId routingCostId, RelationType relations) const {
+    if (routingCostId >= numRoutingCosts_) {
+      throw InvalidInputError("Routing Cost ID is higher than the number of routing modules.");
+    }
+    auto& built = compressed_->built[routingCostId * CompressedGraphCache::NumRelations + size_t(relations)];
+    if (const auto* graphs = built.load(std::memory_order_acquire)) {
+      return *graphs;
+    }
+    std::lock_guard<std::mutex> lock(compressed_->mutex);
+    auto& graphs = compressed_->graphs[FilteredGraphDesc{routingCostId, relations}];
+    if (!graphs) {
+      CostFilter filter(graph_, routingCostId, relations);
+      graphs = std::make_shared<const CompressedGraphs>(
+          CompressedGraphs{CompressedGraph(graph_, filter, false), CompressedGraph(graph_, filter, true)});
+      built.store(&graphs, std::memory_order_release);
+    }
+    return graphs;
+  }
+
+  inline bool empty() const noexcept { return vertexLookup_.empty(); }
 
   //! add new lanelet to graph
   inline Vertex addVertex(const typename BaseGraphT::vertex_property_type& property) {
+    clearCompressed();
     GraphType::vertex_descriptor vd = 0;
     vd = boost::add_vertex(graph_);
     graph_[vd] = property;
-    laneletOrAreaToVertex_.emplace(property.get(), vd);
+    vertexLookup_.insert(property.get().id(), Vertex(vd));
     return vd;
   }
 
@@ -191,6 +306,7 @@ class Graph {
     if (edgeInfo.routingCost < 0.) {
       throw RoutingGraphError{"Negative costs calculated by routing cost module!"};
     }
+    clearCompressed();
     auto edge = boost::add_edge(from, to, graph_);
     assert(edge.second && "Edge could not be added to the graph.");
     graph_[edge.first] = edgeInfo;
@@ -218,17 +334,42 @@ class Graph {
     return {};
   }
 
-  //! Helper function to determine the graph vertex of a given lanelet
-  Optional<typename boost::graph_traits<BaseGraphT>::vertex_descriptor> getVertex(
-      const ConstLaneletOrArea& lanelet) const noexcept {
-    try {
-      return laneletOrAreaToVertex_.at(lanelet);
-    } catch (std::out_of_range&) {
-      return {};
+  //! Helper function to determine the graph vertex of a given lanelet or area. Safe to call from several threads.
+  Optional<Vertex> getVertex(const ConstLaneletOrArea& laneletOrArea) const noexcept {
+    if (laneletOrArea.isLanelet()) {
+      return getVertex(static_cast<const ConstLanelet&>(laneletOrArea));
     }
+    return getVertex(static_cast<const ConstArea&>(laneletOrArea));
   }
 
+  Optional<Vertex> getVertex(const ConstLanelet& lanelet) const noexcept { return findVertex(lanelet); }
+
+  Optional<Vertex> getVertex(const ConstArea& area) const noexcept { return findVertex(area); }
+
  private:
+  template <typename PrimitiveT>
+  Optional<Vertex> findVertex(const PrimitiveT& primitive) const noexcept {
+    return vertexLookup_.find(primitive.id(),
+                              [&](Vertex v) { return isSamePrimitive(graph_[v].get(), primitive); });
+  }
+
+  struct CompressedGraphCache {
+    static constexpr size_t NumRelations = size_t(std::numeric_limits<RelationUnderlyingType>::max()) + 1;
+    explicit CompressedGraphCache(size_t numRoutingCosts) : built(numRoutingCosts * NumRelations) {}
+    std::mutex mutex;                                                 //!< Held while a graph is built
+    std::map<FilteredGraphDesc, CompressedGraphsConstPtr> graphs;     //!< Owns the graphs, map nodes never move
+    std::vector<std::atomic<const CompressedGraphsConstPtr*>> built;  //!< Built graphs by cost id and relations
+  };
+
+  //! Only called while the graph is built, i.e. never concurrently with compressed()
+  void clearCompressed() {
+    std::lock_guard<std::mutex> lock(compressed_->mutex);
+    for (auto& built : compressed_->built) {
+      built.store(nullptr, std::memory_order_relaxed);
+    }
+    compressed_->graphs.clear();
+  }
+
   FilteredGraph getFilteredGraph(RoutingCostId routingCostId, RelationType relations) const {
     if (routingCostId >= numRoutingCosts_) {
       throw InvalidInputError("Routing Cost ID is higher than the number of routing modules.");
@@ -236,15 +377,102 @@ class Graph {
     return FilteredGraph(graph_, CostFilter(graph_, routingCostId, relations));
   }
   BaseGraphT graph_;                             //!< The actual graph object
-  LaneletOrAreaToVertex laneletOrAreaToVertex_;  //!< Mapping of lanelets/areas to vertices of the graph
+  VertexLookup<Vertex> vertexLookup_;            //!< Mapping of lanelets/areas to vertices of the graph
   size_t numRoutingCosts_;                       //!< Number of available routing cost calculation methods
+  std::unique_ptr<CompressedGraphCache> compressed_{
+      std::make_unique<CompressedGraphCache>(numRoutingCosts_)};  //!< Lazily built views
+};
+
+/** @brief The conflicting lanelets and areas of every vertex of a routing graph
+ *
+ *  Stored in compressed sparse row format like the CompressedGraph. It is built once per routing graph and shared by
+ *  all routes that were created from it, so that routes do not need their own copies of the conflicts.
+ */
+class ConflictTable {
+ public:
+  using Range = std::pair<const ConstLaneletOrArea*, const ConstLaneletOrArea*>;
+
+  explicit ConflictTable(const GraphType& graph) {
+    const auto numVertices = boost::num_vertices(graph);
+    offsets_.reserve(numVertices + 1);
+    offsets_.push_back(0);
+    for (auto v = 0ul; v < numVertices; ++v) {
+      // conflicting edges are added with the same cost for every routing cost module
+      auto outEdges = boost::out_edges(v, graph);
+      for (auto it = outEdges.first; it != outEdges.second; ++it) {
+        if (graph[*it].costId == 0 && graph[*it].relation == RelationType::Conflicting) {
+          conflicting_.push_back(graph[boost::target(*it, graph)].laneletOrArea);
+        }
+      }
+      offsets_.push_back(std::uint32_t(conflicting_.size()));
+    }
+    conflicting_.shrink_to_fit();
+  }
+
+  //! The lanelets and areas conflicting with a vertex of the routing graph
+  Range conflicting(std::uint32_t v) const noexcept {
+    return {conflicting_.data() + offsets_[v], conflicting_.data() + offsets_[v + 1]};
+  }
+
+ private:
+  std::vector<std::uint32_t> offsets_;
+  ConstLaneletOrAreas conflicting_;
 };
+using ConflictTableConstPtr = std::shared_ptr<const ConflictTable>;
 
 class RoutingGraphGraph : public Graph<GraphType> {
+ public:
   using Graph::Graph;
+
+  /** @brief The conflicts of all vertices, built on first use
+   *
+   *  Like the compressed graphs, the table is returned without taking a lock once it exists. It must not be requested
+   *  before the graph is completely built. */
+  ConflictTableConstPtr conflictTable() const {
+    if (const auto* table = conflictTable_->built.load(std::memory_order_acquire)) {
+      return *table;
+    }
+    std::lock_guard<std::mutex> lock(conflictTable_->mutex);
+    if (!conflictTable_->table) {
+      conflictTable_->table = std::make_shared<const ConflictTable>(get());
+      conflictTable_->built.store(&conflictTable_->table, std::memory_order_release);
+    }
+    return conflictTable_->table;
+  }
+
+  //! The conflict zones of a vertex. Empty unless they were computed by the RoutingGraphBuilder.
+  const ConflictZones& conflictZones(Vertex v) const noexcept {
+    static const ConflictZones NoZones;
+    return v < conflictZones_.size() ? conflictZones_[v] : NoZones;
+  }
+
+  void addConflictZone(Vertex v, ConflictZone zone) {
+    if (conflictZones_.size() <= v) {
+      conflictZones_.resize(v + 1);
+    }
+    conflictZones_[v].push_back(std::move(zone));
+  }
+
+ private:
+  struct ConflictTableCache {
+    std::mutex mutex;                                          //!< Held while the table is built
+    ConflictTableConstPtr table;                               //!< Owns the table
+    std::atomic<const ConflictTableConstPtr*> built{nullptr};  //!< Set once the table exists
+  };
+  std::vector<ConflictZones> conflictZones_;  //!< Indexed by vertex
+  std::unique_ptr<ConflictTableCache> conflictTable_{std::make_unique<ConflictTableCache>()};  //!< Lazily built
 };
 class RouteGraph : public Graph<RouteGraphType> {
+ public:
   using Graph::Graph;
+
+  //! The conflicts of the routing graph the route was built from. Vertices refer to it through their graphVertex.
+  const ConflictTable& conflictTable() const noexcept { return *conflictTable_; }
+  bool hasConflictTable() const noexcept { return !!conflictTable_; }
+  void setConflictTable(ConflictTableConstPtr conflictTable) noexcept { conflictTable_ = std::move(conflictTable); }
+
+ private:
+  ConflictTableConstPtr conflictTable_;
 };
 
 }  // namespace internal
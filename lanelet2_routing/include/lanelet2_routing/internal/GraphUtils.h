@@ -2,6 +2,8 @@
 #include <lanelet2_core/utility/Optional.h>
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/two_bit_color_map.hpp>
+#include <cmath>
+#include "lanelet2_routing/internal/CostOverlay.h"
 #include "lanelet2_routing/internal/Graph.h"
 
 namespace lanelet {
@@ -103,12 +105,14 @@ std::set<LaneletVertexId> getAllNeighbourLanelets(LaneletVertexId ofVertex, cons
   return result;
 }
 
-//! Filter that reduces the original graph by edges that belong to different cost types or lane changes
+//! Filter that reduces the original graph by edges that belong to different cost types or lane changes. If a cost
+//! overlay is given, edges it blocks are removed as well (conflicts are kept, they are not driven on).
 class OriginalGraphFilter {
  public:
   OriginalGraphFilter() = default;
-  OriginalGraphFilter(const GraphType& g, bool withLaneChange, RoutingCostId costId)
-      : g_{&g}, costId_{costId}, filterMask_{RelationType::Successor | RelationType::Conflicting} {
+  OriginalGraphFilter(const GraphType& g, bool withLaneChange, RoutingCostId costId,
+                      const ResolvedCostOverlay* overlay = nullptr)
+      : g_{&g}, overlay_{overlay}, costId_{costId}, filterMask_{RelationType::Successor | RelationType::Conflicting} {
     if (withLaneChange) {
       filterMask_ |=
           RelationType::Left | RelationType::Right | RelationType::AdjacentLeft | RelationType::AdjacentRight;
@@ -116,11 +120,17 @@ class OriginalGraphFilter {
   }
   bool operator()(const GraphTraits::edge_descriptor& v) const {
     const auto& edge = (*g_)[v];
-    return edge.costId == costId_ && (edge.relation & filterMask_) != RelationType::None;
+    if (edge.costId != costId_ || (edge.relation & filterMask_) == RelationType::None) {
+      return false;
+    }
+    return overlay_ == nullptr || edge.relation == RelationType::Conflicting ||
+           !std::isinf(overlay_->cost(std::uint32_t(boost::source(v, *g_)), std::uint32_t(boost::target(v, *g_)),
+                                      edge.routingCost));
   }
 
  private:
   const GraphType* g_;
+  const ResolvedCostOverlay* overlay_{nullptr};
   RoutingCostId costId_;
   RelationType filterMask_;
 };
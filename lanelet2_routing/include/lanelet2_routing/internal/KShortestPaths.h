@@ -0,0 +1,275 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <set>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/internal/ShortestPath.h"
+
+namespace lanelet {
+namespace routing {
+namespace internal {
+
+//! A path found by KShortestPaths
+template <typename VertexT>
+struct CostedPath {
+  std::vector<VertexT> vertices;
+  double cost{};
+};
+
+/** @brief Finds the k shortest loopless paths between two vertices using Yen's algorithm
+ *
+ * Yen's algorithm derives new candidates from the last path found by deviating from it at each of its vertices (the
+ * spur vertex). The vertices before the spur vertex and the edges that the paths found so far take at the spur vertex
+ * are removed for this.
+ *
+ * Instead of running a new Dijkstra search for each spur vertex, a single backward search from the destination is done
+ * up front. Its shortest path tree gives the remaining cost of every vertex. If the tree path from the spur vertex uses
+ * none of the removed vertices and edges, it is the spur path. Otherwise it is searched with A*, using the remaining
+ * costs as heuristic. This heuristic is exact on the full graph and consistent on any part of it, so the A* search
+ * usually only expands the vertices along the spur path.
+ *
+ * An overlap penalty makes the result more diverse: The next path is then the candidate with the lowest sum of its cost
+ * and overlapPenalty times the cost of the edges it shares with the paths found so far. The result is then ordered by
+ * this penalized cost.
+ *
+ * @tparam G a graph that supports out_edges and target, like the CompressedGraph
+ * @tparam EdgeCostT see DijkstraStyleSearch. The cost must not depend on the cost of the path so far.
+ */
+template <typename G, typename EdgeCostT = StoredEdgeCost>
+class KShortestPaths {
+ public:
+  using VertexType = typename boost::graph_traits<G>::vertex_descriptor;
+  using Path = CostedPath<VertexType>;
+  using Paths = std::vector<Path>;
+
+  //! The backward graph must contain the same edges as the forward graph, but in reverse.
+  KShortestPaths(const G& forward, const G& backward, EdgeCostT forwardCost = {}, EdgeCostT backwardCost = {})
+      : forward_{forward},
+        backward_{backward},
+        forwardCost_{std::move(forwardCost)},
+        backwardCost_{std::move(backwardCost)} {}
+
+  //! Returns up to k loopless paths from 'from' to 'to'. Empty if 'to' can not be reached.
+  Paths query(VertexType from, VertexType to, size_t k, double overlapPenalty = 0.) {
+    Paths result;
+    if (k == 0) {
+      return result;
+    }
+    DijkstraStyleSearch<G, EdgeCostT> tree(backward_, backwardCost_);
+    tree.query(to, [](const VertexVisitInformation& /*i*/) { return true; });
+    const auto& toGo = tree.getMap();
+    if (!toGo.contains(from)) {
+      return result;
+    }
+    reset(num_vertices(forward_));
+    result.push_back(Path{treePath(from, toGo), toGo.at(from).cost});
+    Paths candidates;
+    std::set<std::vector<VertexType>> known{result.front().vertices};
+    std::unordered_set<std::uint64_t> usedEdges;
+    while (result.size() < k) {
+      addDeviations(result, to, toGo, candidates, known);
+      if (candidates.empty()) {
+        break;
+      }
+      if (overlapPenalty > 0.) {
+        addEdges(result.back(), usedEdges);
+      }
+      auto next = leastPenalized(candidates, usedEdges, overlapPenalty);
+      result.push_back(std::move(*next));
+      candidates.erase(next);
+    }
+    return result;
+  }
+
+ private:
+  using ToGoMap = DijkstraSearchMap<VertexType>;
+  using Stamp = std::uint32_t;
+
+  //! Follows the shortest path tree from v to the destination
+  static std::vector<VertexType> treePath(VertexType v, const ToGoMap& toGo) {
+    std::vector<VertexType> path{v};
+    while (toGo.at(v).predecessor != v) {
+      v = toGo.at(v).predecessor;
+      path.push_back(v);
+    }
+    return path;
+  }
+
+  static std::uint64_t edgeKey(VertexType from, VertexType to) noexcept {
+    return (std::uint64_t(from) << 32U) | std::uint64_t(to);
+  }
+
+  //! Cost of the cheapest edge from -> to, infinity if there is none
+  double edgeCost(VertexType from, VertexType to, double costSoFar) const {
+    double cost = std::numeric_limits<double>::infinity();
+    for (auto edges = out_edges(from, forward_); edges.first != edges.second; ++edges.first) {
+      if (target(*edges.first, forward_) == to) {
+        cost = std::min(cost, forwardCost_(from, to, forward_[*edges.first].routingCost, costSoFar));
+      }
+    }
+    return cost;
+  }
+
+  void addEdges(const Path& path, std::unordered_set<std::uint64_t>& edges) const {
+    for (size_t i = 1; i < path.vertices.size(); ++i) {
+      edges.insert(edgeKey(path.vertices[i - 1], path.vertices[i]));
+    }
+  }
+
+  //! Returns the first candidate with the lowest penalized cost
+  typename Paths::iterator leastPenalized(Paths& candidates, const std::unordered_set<std::uint64_t>& usedEdges,
+                                          double overlapPenalty) const {
+    auto penalized = [&](const Path& path) {
+      if (usedEdges.empty()) {
+        return path.cost;
+      }
+      double shared{};
+      for (size_t i = 1; i < path.vertices.size(); ++i) {
+        if (usedEdges.count(edgeKey(path.vertices[i - 1], path.vertices[i])) > 0) {
+          shared += edgeCost(path.vertices[i - 1], path.vertices[i], 0.);
+        }
+      }
+      return path.cost + overlapPenalty * shared;
+    };
+    auto best = candidates.begin();
+    auto bestCost = penalized(*best);
+    for (auto it = std::next(best); it != candidates.end(); ++it) {
+      auto cost = penalized(*it);
+      if (cost < bestCost) {
+        best = it;
+        bestCost = cost;
+      }
+    }
+    return best;
+  }
+
+  //! Adds the deviations from the last path in result to the candidates
+  void addDeviations(const Paths& result, VertexType to, const ToGoMap& toGo, Paths& candidates,
+                     std::set<std::vector<VertexType>>& known) {
+    const auto& path = result.back().vertices;
+    nextStamp(blockedStamp_, blocked_);
+    double rootCost{};
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+      const auto spur = path[i];
+      excluded_.clear();
+      for (const auto& found : result) {
+        if (found.vertices.size() > i + 1 && std::equal(path.begin(), path.begin() + i + 1, found.vertices.begin())) {
+          excluded_.push_back(found.vertices[i + 1]);
+        }
+      }
+      auto spurPath = findSpurPath(spur, to, rootCost, toGo);
+      if (!spurPath.vertices.empty()) {
+        std::vector<VertexType> vertices(path.begin(), path.begin() + i);
+        vertices.insert(vertices.end(), spurPath.vertices.begin(), spurPath.vertices.end());
+        if (known.insert(vertices).second) {
+          candidates.push_back(Path{std::move(vertices), rootCost + spurPath.cost});
+        }
+      }
+      rootCost += edgeCost(spur, path[i + 1], rootCost);
+      blocked_[spur] = blockedStamp_;
+    }
+  }
+
+  bool isExcluded(VertexType spur, VertexType from, VertexType to) const {
+    return from == spur && std::find(excluded_.begin(), excluded_.end(), to) != excluded_.end();
+  }
+
+  Path findSpurPath(VertexType spur, VertexType to, double rootCost, const ToGoMap& toGo) {
+    // the tree path is the best one if it avoids everything that was removed
+    auto treeNext = toGo.at(spur).predecessor;
+    if (!isExcluded(spur, spur, treeNext)) {
+      auto path = treePath(spur, toGo);
+      auto isBlocked = [&](VertexType v) { return blocked_[v] == blockedStamp_; };
+      if (std::none_of(path.begin(), path.end(), isBlocked)) {
+        return Path{std::move(path), toGo.at(spur).cost};
+      }
+    }
+    return aStar(spur, to, rootCost, toGo);
+  }
+
+  Path aStar(VertexType spur, VertexType to, double rootCost, const ToGoMap& toGo) {
+    nextStamp(visitStamp_, visited_);
+    using QueueEntry = std::pair<double, VertexType>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+    visit(spur, spur, 0.);
+    queue.emplace(toGo.at(spur).cost, spur);
+    while (!queue.empty()) {
+      auto current = queue.top().second;
+      queue.pop();
+      if (closed_[current]) {
+        continue;
+      }
+      closed_[current] = true;
+      if (current == to) {
+        Path path{{current}, cost_[current]};
+        while (predecessor_[current] != current) {
+          current = predecessor_[current];
+          path.vertices.push_back(current);
+        }
+        std::reverse(path.vertices.begin(), path.vertices.end());
+        return path;
+      }
+      for (auto edges = out_edges(current, forward_); edges.first != edges.second; ++edges.first) {
+        const auto next = target(*edges.first, forward_);
+        if (blocked_[next] == blockedStamp_ || !toGo.contains(next) || isExcluded(spur, current, next)) {
+          continue;
+        }
+        const auto cost =
+            cost_[current] + forwardCost_(current, next, forward_[*edges.first].routingCost, rootCost + cost_[current]);
+        if (std::isinf(cost) || (visited_[next] == visitStamp_ && !(cost < cost_[next]))) {
+          continue;
+        }
+        visit(next, current, cost);
+        queue.emplace(cost + toGo.at(next).cost, next);
+      }
+    }
+    return {};
+  }
+
+  void visit(VertexType v, VertexType predecessor, double cost) {
+    visited_[v] = visitStamp_;
+    closed_[v] = false;
+    predecessor_[v] = predecessor;
+    cost_[v] = cost;
+  }
+
+  void reset(size_t numVertices) {
+    blocked_.assign(numVertices, 0);
+    visited_.assign(numVertices, 0);
+    closed_.resize(numVertices);
+    predecessor_.resize(numVertices);
+    cost_.resize(numVertices);
+    blockedStamp_ = visitStamp_ = 0;
+  }
+
+  //! Invalidates all marks of the given kind without touching the array
+  static void nextStamp(Stamp& stamp, std::vector<Stamp>& marks) {
+    if (++stamp == 0) {
+      std::fill(marks.begin(), marks.end(), 0);
+      stamp = 1;
+    }
+  }
+
+  const G& forward_;
+  const G& backward_;
+  EdgeCostT forwardCost_;
+  EdgeCostT backwardCost_;
+  std::vector<VertexType> excluded_;  //!< Targets of the edges leaving the spur vertex that must not be used
+  std::vector<Stamp> blocked_;        //!< Vertices of the root path
+  std::vector<Stamp> visited_;        //!< Vertices that have a cost in the current A* search
+  std::vector<bool> closed_;          //!< Visited vertices that were already expanded
+  std::vector<VertexType> predecessor_;
+  std::vector<double> cost_;
+  Stamp blockedStamp_{0};
+  Stamp visitStamp_{0};
+};
+
+}  // namespace internal
+}  // namespace routing
+}  // namespace lanelet
@@ -1,6 +1,7 @@
 #pragma once
 #include "lanelet2_routing/LaneletPath.h"
 #include "lanelet2_routing/Route.h"
+#include "lanelet2_routing/internal/CostOverlay.h"
 #include "lanelet2_routing/internal/Graph.h"
 
 namespace lanelet {
@@ -31,12 +32,18 @@ class RouteBuilder {
    * to the goal. So in the context of the route this is not a diverging situation but rather it's just one lanelet
    * (the right one) is following its predecessor. We would say that they are part of the same lane since there's no
    * other way to go. */
-  explicit RouteBuilder(const RoutingGraphGraph& g) : graph_{g} {}
+  //! If overlay is not null, lanelets and relations it blocks are not added to the route. It must outlive the builder.
+  //! closeOverLaneChanges only exists to compare the result against the plain iteration, it does not change the route.
+  explicit RouteBuilder(const RoutingGraphGraph& g, const ResolvedCostOverlay* overlay = nullptr,
+                        bool closeOverLaneChanges = true)
+      : graph_{g}, overlay_{overlay}, closeOverLaneChanges_{closeOverLaneChanges} {}
   Optional<Route> getRouteFromShortestPath(const LaneletPath& path, bool withLaneChanges = true,
                                            RoutingCostId costId = 0);
 
  private:
   const RoutingGraphGraph& graph_;
+  const ResolvedCostOverlay* overlay_;
+  bool closeOverLaneChanges_;  //!< Whether lane change components are added after each iteration
 };
 
 }  // namespace internal
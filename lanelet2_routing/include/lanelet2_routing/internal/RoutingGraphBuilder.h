@@ -1,5 +1,7 @@
 #pragma once
 #include <lanelet2_core/LaneletMap.h>
+#include <map>
+#include <vector>
 #include "lanelet2_routing/RoutingGraph.h"
 #include "lanelet2_routing/internal/Graph.h"
 
@@ -11,6 +13,54 @@ namespace internal {
 
 class LaneChangeLaneletsCollector;
 
+/** @brief The geometric relations between the lanelets and areas of a map, independent of any traffic rules
+ *
+ *  Most of the time spent building a RoutingGraph goes into geometry: finding the lanelets that share points and
+ *  checking which lanelets and areas overlap. None of this depends on the participant. The topology computes it once
+ *  for all lanelets (in both directions) and areas of a map, so that the graphs of several participants can be built
+ *  from it (see MultiParticipantRoutingGraph).
+ */
+class RoutingTopology {
+ public:
+  using PointsLaneletMap = std::multimap<IdPair, ConstLanelet>;
+  using PointsLaneletMapResult = std::pair<PointsLaneletMap::const_iterator, PointsLaneletMap::const_iterator>;
+
+  explicit RoutingTopology(const LaneletMapLayers& laneletMapLayers);
+
+  const ConstLanelets& lanelets() const noexcept { return lanelets_; }
+  const ConstAreas& areas() const noexcept { return areas_; }
+
+  //! Position of a lanelet (regardless of its direction) in lanelets() or of an area in areas() after the lanelets
+  Optional<size_t> index(const ConstLaneletOrArea& laneletOrArea) const;
+
+  //! Lanelets in both directions that have the given pair of points as first or last points or as ends of a bound
+  PointsLaneletMapResult laneletsAt(const IdPair& points) const { return pointsToLanelets_.equal_range(points); }
+
+  //! Lanelets whose bounding box intersects the one of the given lanelet or area. Includes the lanelet itself.
+  const ConstLanelets& nearbyLanelets(const ConstLaneletOrArea& laneletOrArea) const;
+
+  //! Areas whose bounding box intersects the one of the given area. Includes the area itself.
+  const ConstAreas& nearbyAreas(const ConstArea& area) const;
+
+  //! Result of geometry::overlaps2d for one of the nearby lanelets or areas. False for any other lanelet or area.
+  bool overlaps2d(const ConstLaneletOrArea& laneletOrArea, const ConstLaneletOrArea& nearby) const;
+
+ private:
+  struct Neighbourhood {
+    ConstLanelets lanelets;
+    ConstAreas areas;
+    std::vector<bool> laneletOverlaps;  //!< Whether the lanelet with the same index overlaps in 2d
+    std::vector<bool> areaOverlaps;     //!< Whether the area with the same index overlaps in 2d
+  };
+  const Neighbourhood* neighbourhood(const ConstLaneletOrArea& laneletOrArea) const;
+
+  ConstLanelets lanelets_;
+  ConstAreas areas_;
+  VertexLookup<std::uint32_t> index_;          //!< Refers to the lanelets in their original direction
+  std::vector<Neighbourhood> neighbourhoods_;  //!< Indexed like index()
+  PointsLaneletMap pointsToLanelets_;
+};
+
 class RoutingGraphBuilder {
  public:
   RoutingGraphBuilder(const traffic_rules::TrafficRules& trafficRules, const RoutingCostPtrs& routingCosts,
@@ -18,14 +68,26 @@ class RoutingGraphBuilder {
 
   RoutingGraphUPtr build(const LaneletMapLayers& laneletMapLayers);
 
+  //! Builds the graph for the lanelets and areas of the topology without repeating its geometric computations
+  RoutingGraphUPtr build(const RoutingTopology& topology);
+
+  //! Builds only the internal graph, e.g. to run the internal algorithms on it directly
+  std::unique_ptr<RoutingGraphGraph> buildGraph(const LaneletMapLayers& laneletMapLayers);
+
+  //! Builds only the internal graph from the topology
+  std::unique_ptr<RoutingGraphGraph> buildGraph(const RoutingTopology& topology);
+
  private:
-  using PointsLaneletMap = std::multimap<IdPair, ConstLanelet>;
-  using PointsLaneletMapIt = PointsLaneletMap::iterator;
-  using PointsLaneletMapResult = std::pair<PointsLaneletMapIt, PointsLaneletMapIt>;
+  using PointsLaneletMap = RoutingTopology::PointsLaneletMap;
+  using PointsLaneletMapResult = RoutingTopology::PointsLaneletMapResult;
 
-  static ConstLanelets getPassableLanelets(const LaneletLayer& lanelets,
-                                           const traffic_rules::TrafficRules& trafficRules);
-  static ConstAreas getPassableAreas(const AreaLayer& areas, const traffic_rules::TrafficRules& trafficRules);
+  RoutingGraphUPtr build(ConstLanelets passableLanelets, ConstAreas passableAreas);
+  //! Adds the lanelets and areas and their relations to graph_. Returns the map of them.
+  LaneletSubmapConstUPtr addToGraph(ConstLanelets passableLanelets, ConstAreas passableAreas);
+  template <typename LaneletsT>
+  static ConstLanelets getPassableLanelets(const LaneletsT& lanelets, const traffic_rules::TrafficRules& trafficRules);
+  template <typename AreasT>
+  static ConstAreas getPassableAreas(const AreasT& areas, const traffic_rules::TrafficRules& trafficRules);
   void appendBidirectionalLanelets(ConstLanelets& llts);
   void addLaneletsToGraph(ConstLanelets& llts);
   void addAreasToGraph(ConstAreas& areas);
@@ -42,8 +104,24 @@ class RoutingGraphBuilder {
   //! Helper function to read the participant height from the configuration
   Optional<double> participantHeight() const;
 
-  //! Adds the first and last points of a lanelet to the search index
-  void addPointsToSearchIndex(const ConstLanelet& ll);
+  //! Helper function to read from the configuration whether conflict zones should be computed
+  bool computeConflictZones() const;
+
+  //! Computes the conflict zone of two conflicting lanelets or areas and stores it for both, unless this was done
+  void addConflictZone(const ConstLaneletOrArea& first, const ConstLaneletOrArea& second);
+
+  //! Returns the passable lanelets whose bounding box intersects the one of the given lanelet or area
+  template <typename PrimitiveT>
+  ConstLanelets nearbyLanelets(const PrimitiveT& primitive, const LaneletLayer& passableLanelets) const;
+  ConstAreas nearbyAreas(const ConstArea& area, const AreaLayer& passableAreas) const;
+
+  //! Checks whether two lanelets or areas overlap, in 3d if a participant height is configured
+  template <typename Primitive1T, typename Primitive2T>
+  bool overlaps(const Primitive1T& first, const Primitive2T& second) const;
+
+  //! The lanelets of the graph that have the given pair of points as first or last points or as ends of a bound
+  PointsLaneletMapResult laneletsAt(const IdPair& points) const;
+  bool isVertex(const ConstLanelet& ll) const;
   bool hasEdge(const ConstLanelet& from, const ConstLanelet& to);
   void assignLaneChangeCosts(const ConstLanelets& froms, const ConstLanelets& tos, const RelationType& relation);
 
@@ -54,6 +132,7 @@ class RoutingGraphBuilder {
   void assignCosts(const ConstLaneletOrArea& from, const ConstLaneletOrArea& to, const RelationType& relation);
   std::unique_ptr<RoutingGraphGraph> graph_;
   PointsLaneletMap pointsToLanelets_;  ///< A map of tuples (first or last left and right boundary points) to lanelets
+  const RoutingTopology* topology_{};  ///< If set, geometric relations are taken from here instead of computed
   std::set<Id> bothWaysLaneletIds_;
   const traffic_rules::TrafficRules& trafficRules_;
   const RoutingCostPtrs& routingCosts_;
@@ -0,0 +1,224 @@
+#pragma once
+#include <boost/graph/graph_traits.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/internal/Graph.h"
+
+namespace lanelet {
+namespace routing {
+namespace internal {
+
+using ParticipantMask = std::uint64_t;  //!< Bit i is set for participant i
+
+//! An edge of a SharedGraph. Its routing costs are stored separately for every participant and routing cost module.
+struct SharedEdge {
+  std::uint32_t target;          ///< Vertex this edge leads to
+  RelationType relation;         ///< Relation between the two lanelets
+  ParticipantMask participants;  ///< The participants whose graph has this edge
+};
+
+/** @brief The routing graphs of several participants merged into one
+ *
+ * The vertices are the lanelets and areas of all graphs. An edge that the graphs of several participants have with the
+ * same relation is stored only once, together with a mask of these participants. The edges are stored in compressed
+ * sparse row format like in the CompressedGraph. The routing costs are kept in one array per participant and routing
+ * cost module that is indexed like the edges, so that the edges themselves stay small.
+ *
+ * Use a ParticipantGraph to search the edges of one participant.
+ */
+class SharedGraph {
+ public:
+  using Vertex = std::uint32_t;
+  using EdgeIndex = std::uint32_t;
+
+  //! Merges the graphs. The position of a graph in the vector is the index of its participant.
+  explicit SharedGraph(const std::vector<const RoutingGraphGraph*>& graphs) {
+    std::vector<std::vector<Vertex>> sharedVertices(graphs.size());
+    std::vector<std::vector<Optional<GraphTraits::vertex_descriptor>>> participantVertices(graphs.size());
+    costOffsets_.push_back(0);
+    for (auto p = 0u; p < graphs.size(); ++p) {
+      const auto& graph = graphs[p]->get();
+      for (auto v = 0ul; v < boost::num_vertices(graph); ++v) {
+        const auto& laneletOrArea = graph[v].laneletOrArea;
+        auto shared = getVertex(laneletOrArea);
+        if (!shared) {
+          shared = Vertex(vertices_.size());
+          vertices_.push_back(laneletOrArea);
+          passableBy_.push_back(0);
+          lookup_.insert(laneletOrArea.id(), *shared);
+        }
+        passableBy_[*shared] |= ParticipantMask(1) << p;
+        sharedVertices[p].push_back(*shared);
+      }
+      costOffsets_.push_back(costOffsets_.back() + graphs[p]->numRoutingCosts());
+    }
+    for (auto p = 0u; p < graphs.size(); ++p) {
+      participantVertices[p].resize(vertices_.size());
+      for (auto v = 0ul; v < sharedVertices[p].size(); ++v) {
+        participantVertices[p][sharedVertices[p][v]] = v;
+      }
+    }
+    costs_.resize(costOffsets_.back());
+    offsets_.reserve(vertices_.size() + 1);
+    offsets_.push_back(0);
+    for (auto v = 0u; v < vertices_.size(); ++v) {
+      for (auto p = 0u; p < graphs.size(); ++p) {
+        if (participantVertices[p][v]) {
+          addEdges(*graphs[p], p, *participantVertices[p][v], sharedVertices[p]);
+        }
+      }
+      offsets_.push_back(EdgeIndex(edges_.size()));
+    }
+    edges_.shrink_to_fit();
+    for (auto& costs : costs_) {
+      costs.shrink_to_fit();
+    }
+  }
+
+  size_t numVertices() const noexcept { return vertices_.size(); }
+  size_t numEdges() const noexcept { return edges_.size(); }
+  size_t numParticipants() const noexcept { return costOffsets_.size() - 1; }
+  size_t numRoutingCosts(size_t participant) const noexcept {
+    return costOffsets_[participant + 1] - costOffsets_[participant];
+  }
+
+  const ConstLaneletOrArea& laneletOrArea(Vertex v) const noexcept { return vertices_[v]; }
+
+  //! The participants whose graph contains the vertex
+  ParticipantMask passableBy(Vertex v) const noexcept { return passableBy_[v]; }
+
+  Optional<Vertex> getVertex(const ConstLaneletOrArea& laneletOrArea) const noexcept {
+    if (laneletOrArea.isLanelet()) {
+      return findVertex(static_cast<const ConstLanelet&>(laneletOrArea));
+    }
+    return findVertex(static_cast<const ConstArea&>(laneletOrArea));
+  }
+
+  //! The range of indices of the edges leaving a vertex
+  std::pair<EdgeIndex, EdgeIndex> outEdges(Vertex v) const noexcept { return {offsets_[v], offsets_[v + 1]}; }
+
+  const SharedEdge& edge(EdgeIndex e) const noexcept { return edges_[e]; }
+
+  //! The routing costs of all edges for a participant and routing cost module. Infinite for the edges it does not have.
+  const std::vector<double>& routingCosts(size_t participant, RoutingCostId routingCostId) const noexcept {
+    return costs_[costOffsets_[participant] + routingCostId];
+  }
+
+ private:
+  template <typename PrimitiveT>
+  Optional<Vertex> findVertex(const PrimitiveT& primitive) const noexcept {
+    return lookup_.find(primitive.id(), [&](Vertex v) { return isSamePrimitive(vertices_[v], primitive); });
+  }
+
+  //! Adds the edges of a vertex of a participant graph to the edges of the last vertex
+  void addEdges(const RoutingGraphGraph& graph, size_t participant, GraphTraits::vertex_descriptor v,
+                const std::vector<Vertex>& sharedVertices) {
+    const auto first = offsets_.back();
+    for (auto edges = boost::out_edges(v, graph.get()); edges.first != edges.second; ++edges.first) {
+      const auto& info = graph.get()[*edges.first];
+      const auto target = sharedVertices[boost::target(*edges.first, graph.get())];
+      auto e = first;
+      while (e < edges_.size() && !(edges_[e].target == target && edges_[e].relation == info.relation)) {
+        ++e;
+      }
+      if (e == edges_.size()) {
+        edges_.push_back(SharedEdge{target, info.relation, 0});
+        for (auto& costs : costs_) {
+          costs.push_back(std::numeric_limits<double>::infinity());
+        }
+      }
+      edges_[e].participants |= ParticipantMask(1) << participant;
+      costs_[costOffsets_[participant] + info.costId][e] = info.routingCost;
+    }
+  }
+
+  std::vector<ConstLaneletOrArea> vertices_;
+  VertexLookup<Vertex> lookup_;            //!< Mapping of lanelets/areas to vertices
+  std::vector<ParticipantMask> passableBy_;  //!< Indexed by vertex
+  std::vector<EdgeIndex> offsets_;           //!< The edges of vertex v start at offsets_[v]
+  std::vector<SharedEdge> edges_;
+  std::vector<size_t> costOffsets_;         //!< Index of the first cost array of each participant
+  std::vector<std::vector<double>> costs_;  //!< Indexed by cost array, then by edge
+};
+
+/** @brief The edges of one participant, routing cost module and set of relations in a SharedGraph
+ *
+ * Like the CompressedGraph, this implements just enough of the boost graph interface (IncidenceGraph) to be used with
+ * the DijkstraStyleSearch. The edges are filtered while they are iterated, nothing is copied.
+ */
+class ParticipantGraph {
+ public:
+  //! What the DijkstraStyleSearch reads from an edge
+  struct EdgeProperties {
+    double routingCost;
+    RelationType relation;
+  };
+  struct EdgeFilter {
+    bool operator()(SharedGraph::EdgeIndex e) const noexcept { return graph->contains(e); }
+    const ParticipantGraph* graph;
+  };
+
+  using vertex_descriptor = SharedGraph::Vertex;  // NOLINT
+  using edge_descriptor = SharedGraph::EdgeIndex;  // NOLINT
+  using out_edge_iterator =                        // NOLINT
+      boost::filter_iterator<EdgeFilter, boost::counting_iterator<SharedGraph::EdgeIndex>>;
+  using directed_category = boost::directed_tag;                  // NOLINT
+  using edge_parallel_category = boost::allow_parallel_edge_tag;  // NOLINT
+  using traversal_category = boost::incidence_graph_tag;          // NOLINT
+  using vertices_size_type = std::size_t;                         // NOLINT
+  using edges_size_type = std::size_t;                            // NOLINT
+  using degree_size_type = std::size_t;                           // NOLINT
+
+  //! The graph has to outlive this view. Participant and routing cost id must be valid.
+  ParticipantGraph(const SharedGraph& graph, size_t participant, RoutingCostId routingCostId, RelationType relations)
+      : graph_{&graph},
+        costs_{&graph.routingCosts(participant, routingCostId)},
+        participant_{ParticipantMask(1) << participant},
+        relations_{relations} {}
+
+  ParticipantGraph(const ParticipantGraph&) = delete;  // the iterators refer to this object
+  ParticipantGraph& operator=(const ParticipantGraph&) = delete;
+
+  const SharedGraph& shared() const noexcept { return *graph_; }
+
+  bool contains(SharedGraph::EdgeIndex e) const noexcept {
+    const auto& edge = graph_->edge(e);
+    return (edge.participants & participant_) != 0 && bool(edge.relation & relations_) &&
+           std::isfinite((*costs_)[e]);
+  }
+
+  std::pair<out_edge_iterator, out_edge_iterator> outEdges(vertex_descriptor v) const noexcept {
+    const auto range = graph_->outEdges(v);
+    const EdgeFilter filter{this};
+    return {out_edge_iterator(filter, range.first, range.second),
+            out_edge_iterator(filter, range.second, range.second)};
+  }
+
+  EdgeProperties operator[](SharedGraph::EdgeIndex e) const noexcept {
+    return {(*costs_)[e], graph_->edge(e).relation};
+  }
+
+ private:
+  const SharedGraph* graph_;
+  const std::vector<double>* costs_;
+  ParticipantMask participant_;
+  RelationType relations_;
+};
+
+inline std::pair<ParticipantGraph::out_edge_iterator, ParticipantGraph::out_edge_iterator> out_edges(  // NOLINT
+    ParticipantGraph::vertex_descriptor v, const ParticipantGraph& g) {
+  return g.outEdges(v);
+}
+inline ParticipantGraph::vertex_descriptor target(SharedGraph::EdgeIndex e, const ParticipantGraph& g) {  // NOLINT
+  return g.shared().edge(e).target;
+}
+inline std::size_t num_vertices(const ParticipantGraph& g) { return g.shared().numVertices(); }  // NOLINT
+
+}  // namespace internal
+}  // namespace routing
+}  // namespace lanelet
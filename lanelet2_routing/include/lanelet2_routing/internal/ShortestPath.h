@@ -1,7 +1,14 @@
 #pragma once
-#include <boost/graph/dijkstra_shortest_paths_no_color_map.hpp>
-#include <boost/graph/filtered_graph.hpp>
+#include <boost/graph/detail/d_ary_heap.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
 #include <boost/property_map/property_map.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 #include "lanelet2_routing/Exceptions.h"
 #include "lanelet2_routing/internal/Graph.h"
 #include "lanelet2_routing/internal/GraphUtils.h"
@@ -28,33 +35,157 @@ struct VertexState {
   bool isLeaf{true};                        //!< True if it has no successor that is on the shortest path
 };
 
+/**
+ * @brief The state of all vertices visited by a DijkstraStyleSearch
+ *
+ * Behaves like a (read only) std::map<VertexT, VertexState> that only contains the visited vertices, ordered by their
+ * index. Internally the states are stored in flat arrays indexed by the vertex, so that no allocation happens once
+ * the arrays have reached the size of the graph. Each search increments a generation counter instead of clearing the
+ * arrays, a state is only valid if it was written in the current generation.
+ */
 template <typename VertexT>
-using DijkstraSearchMap = std::map<VertexT, VertexState>;
+class DijkstraSearchMap {
+  static_assert(std::is_integral<VertexT>::value, "Dense search maps require graphs with vecS vertex lists");
 
-template <typename VertexT>
-struct DijkstraCostMap {
-  using key_type = VertexT;                             // NOLINT
-  using value_type = double;                            // NOLINT
-  using reference = void;                               // NOLINT
-  using category = boost::read_write_property_map_tag;  // NOLINT
-  DijkstraSearchMap<VertexT>* map{};
+ public:
+  using key_type = VertexT;                            // NOLINT
+  using mapped_type = VertexState;                     // NOLINT
+  using value_type = std::pair<VertexT, VertexState>;  // NOLINT
+  using size_type = size_t;                            // NOLINT
+  using VertexList = std::vector<VertexT>;
+  using Generation = std::uint32_t;
+
+  //! Iterates over the visited vertices in ascending order
+  class const_iterator  // NOLINT
+      : public boost::iterator_adaptor<const_iterator, typename VertexList::const_iterator, const value_type> {
+    friend class boost::iterator_core_access;
+
+   public:
+    const_iterator() = default;
+    const_iterator(typename VertexList::const_iterator it, const DijkstraSearchMap* map)
+        : const_iterator::iterator_adaptor_{it}, map_{map} {}
+
+   private:
+    const value_type& dereference() const { return map_->entries_[*this->base()]; }
+    const DijkstraSearchMap* map_{};
+  };
+
+  const_iterator begin() const { return {visited_.begin(), this}; }
+  const_iterator end() const { return {visited_.end(), this}; }
+  size_t size() const noexcept { return visited_.size(); }
+  bool empty() const noexcept { return visited_.empty(); }
+  size_t count(VertexT v) const noexcept { return contains(v) ? 1 : 0; }
+
+  const_iterator find(VertexT v) const {
+    if (!contains(v)) {
+      return end();
+    }
+    return {std::lower_bound(visited_.begin(), visited_.end(), v), this};
+  }
+
+  //! @throws std::out_of_range if the vertex was not visited, just like std::map
+  const VertexState& at(VertexT v) const {
+    if (!contains(v)) {
+      throw std::out_of_range("Vertex was not visited by the search");
+    }
+    return entries_[v].second;
+  }
+
+  bool contains(VertexT v) const noexcept { return v < generations_.size() && generations_[v] == generation_; }
+
+  //! Invalidates all states and makes sure there is space for numVertices vertices
+  void reset(size_t numVertices) {
+    if (generations_.size() < numVertices) {
+      generations_.resize(numVertices, 0);
+      entries_.resize(numVertices);
+      indexInHeap_.resize(numVertices);
+    }
+    if (++generation_ == 0) {
+      std::fill(generations_.begin(), generations_.end(), 0);
+      generation_ = 1;
+    }
+    visited_.clear();
+    heap_.clear();
+  }
+
+  //! Returns the state of v, marks the vertex as visited if this was not the case yet
+  VertexState& visit(VertexT v) {
+    if (!contains(v)) {
+      generations_[v] = generation_;
+      entries_[v] = value_type{v, VertexState{}};
+      visited_.push_back(v);
+    }
+    return entries_[v].second;
+  }
+
+  //! Sorts the visited vertices, must be called once the search is done
+  void finish() { std::sort(visited_.begin(), visited_.end()); }
+
+  //! Cost of a vertex, infinity if not yet visited
+  double cost(VertexT v) const {
+    return contains(v) ? entries_[v].second.cost : std::numeric_limits<double>::infinity();
+  }
+
+  //! Storage for the priority queue of the search, reused between searches
+  VertexList& heap() noexcept { return heap_; }
+  std::vector<size_t>& indexInHeap() noexcept { return indexInHeap_; }
+
+ private:
+  std::vector<value_type> entries_;
+  std::vector<Generation> generations_;
+  std::vector<size_t> indexInHeap_;
+  VertexList visited_;
+  VertexList heap_;
+  Generation generation_{0};
 };
 
+/**
+ * @brief Keeps the search maps that are not in use by the current thread
+ *
+ * Searches borrow a map from here and give it back when they are destroyed. This way repeated queries on a thread
+ * reuse the same memory. Searches started from within a search (e.g. in a visitor) simply borrow another map.
+ */
 template <typename VertexT>
-inline typename DijkstraCostMap<VertexT>::value_type get(const DijkstraCostMap<VertexT>& map, VertexT key) {
-  auto val = map.map->find(key);
-  if (val != map.map->end()) {
-    return val->second.cost;
+class DijkstraSearchMapPool {
+ public:
+  using SearchMap = DijkstraSearchMap<VertexT>;
+  struct GiveBack {
+    void operator()(SearchMap* map) const { release(std::unique_ptr<SearchMap>(map)); }
+  };
+  using SearchMapPtr = std::unique_ptr<SearchMap, GiveBack>;
+
+  static SearchMapPtr acquire() {
+    auto& maps = pool();
+    if (maps.empty()) {
+      return SearchMapPtr(new SearchMap);
+    }
+    SearchMapPtr map(maps.back().release());
+    maps.pop_back();
+    return map;
   }
-  return std::numeric_limits<double>::infinity();
-}
 
-template <typename VertexT>
-inline void put(DijkstraCostMap<VertexT>& map, VertexT key, typename DijkstraCostMap<VertexT>::value_type value) {
-  (*map.map)[key].cost = value;
-}
+ private:
+  static void release(std::unique_ptr<SearchMap> map) { pool().push_back(std::move(map)); }
+  static std::vector<std::unique_ptr<SearchMap>>& pool() {
+    thread_local std::vector<std::unique_ptr<SearchMap>> maps;
+    return maps;
+  }
+};
 
-template <typename G>
+//! Edge cost of a DijkstraStyleSearch that simply uses the routing cost stored in the graph
+struct StoredEdgeCost {
+  template <typename VertexT>
+  double operator()(VertexT /*from*/, VertexT /*to*/, double routingCost, double /*costSoFar*/) const noexcept {
+    return routingCost;
+  }
+};
+
+/** @brief Dijkstra search that calls a function for every vertex it visits
+ *  @tparam G the graph to search
+ *  @tparam EdgeCostT functor that returns the cost of an edge given the vertex it leaves, the vertex it reaches, the
+ *  routing cost stored in the graph and the cost of the path to the vertex it leaves. An infinite cost means that the
+ *  edge can not be used. */
+template <typename G, typename EdgeCostT = StoredEdgeCost>
 class DijkstraStyleSearch {
  public:
   using VertexType = typename boost::graph_traits<G>::vertex_descriptor;
@@ -63,74 +194,106 @@ class DijkstraStyleSearch {
   using VisitCallback = std::function<bool(const VertexVisitInformation&)>;
 
  private:
-  class LeafFilter {
+  //! Priority queue storage that lives in the search map, so that the heap does not allocate
+  class HeapStorage {
    public:
-    LeafFilter() = default;
-    LeafFilter(const DijkstraSearchMapType& m, const G& g) : m_{&m}, g_{&g} {}
-    bool operator()(EdgeType e) const { return (*m_).at(boost::source(e, *g_)).predicate; }
+    using value_type = VertexType;  // NOLINT
+    using size_type = size_t;       // NOLINT
+    explicit HeapStorage(std::vector<VertexType>& data) : data_{&data} {}
+    size_type size() const { return data_->size(); }
+    bool empty() const { return data_->empty(); }
+    void push_back(VertexType v) { data_->push_back(v); }
+    void pop_back() { data_->pop_back(); }
+    VertexType& back() { return data_->back(); }
+    VertexType& operator[](size_type idx) { return (*data_)[idx]; }
+    const VertexType& operator[](size_type idx) const { return (*data_)[idx]; }
 
    private:
-    const DijkstraSearchMapType* m_{};
-    const G* g_{};
+    std::vector<VertexType>* data_;
   };
-  using SearchGraph = boost::filtered_graph<G, LeafFilter>;
-
-  template <typename Func>
-  class DijkstraStyleVisitor : public boost::default_dijkstra_visitor {
-    using FuncT = std::remove_reference_t<Func>;
 
-   public:
-    DijkstraStyleVisitor() = default;
-    DijkstraStyleVisitor(DijkstraSearchMapType& map, FuncT* cb) : map_{&map}, cb_{cb} {}
-
-    // called whenever a minimal edge is discovered
-    void examine_vertex(VertexType v, const SearchGraph& /*g*/) {  // NOLINT
-      auto& state = map_->at(v);
-      state.predicate =
-          ((*cb_)(VertexVisitInformation{v, state.predecessor, state.cost, state.length, state.numLaneChanges}));
-      map_->at(state.predecessor).isLeaf = v == state.predecessor;  // necessary for the initial vertex
-    }
-
-    void edge_relaxed(EdgeType e, const SearchGraph& g) {  // NOLINT
-      // called whenever a shorter path to e is discovered and before "examine vertex" is called
-      // cost is automatically updated by the dijkstra algorithm
-      auto& predecessor = (*map_).at(boost::source(e, g));
-      auto& follower = (*map_)[boost::target(e, g)];
-      follower.length = predecessor.length + 1;
-      follower.predecessor = boost::source(e, g);
-      follower.numLaneChanges = predecessor.numLaneChanges + (g[e].relation != RelationType::Successor);
-    }
-
-   private:
-    DijkstraSearchMapType* map_{};
-    FuncT* cb_{};
+  struct CostMap {
+    using key_type = VertexType;                        // NOLINT
+    using value_type = double;                          // NOLINT
+    using reference = double;                           // NOLINT
+    using category = boost::readable_property_map_tag;  // NOLINT
+    friend double get(const CostMap& map, VertexType v) { return map.map->cost(v); }
+    const DijkstraSearchMapType* map;
   };
+  using IndexInHeapMap = boost::iterator_property_map<size_t*, boost::identity_property_map>;
+  // the same queue as in boost::dijkstra_shortest_paths_no_color_map, so that ties are resolved in the same order
+  using VertexQueue =
+      boost::d_ary_heap_indirect<VertexType, 4, IndexInHeapMap, CostMap, std::less<double>, HeapStorage>;
 
  public:
   //! Constructor for the graph search
-  explicit DijkstraStyleSearch(const G& graph) : graph_{graph, LeafFilter{vertices_, graph}} {}
+  explicit DijkstraStyleSearch(const G& graph, EdgeCostT edgeCost = {})
+      : graph_{graph}, edgeCost_{std::move(edgeCost)}, vertices_{DijkstraSearchMapPool<VertexType>::acquire()} {}
 
   //! Performs the dijkstra style search by calling func whenever the shortest path for a certain vertex is
   //! discovered. Whenever func returns false, the successor edges of this vertex will not be visited.
   template <typename Func>
   void query(VertexType start, Func&& func) {
-    vertices_.clear();
-    vertices_.emplace(start, VertexState{start, 0., 1, 0, true, true});
-    DijkstraStyleVisitor<decltype(func)> visitor{vertices_, &func};
-    auto inf = std::numeric_limits<double>::infinity();
-    // offering sane defaults seems to have been impossible...
-    boost::dijkstra_shortest_paths_no_color_map_no_init(
-        graph_, start, boost::dummy_property_map{}, DijkstraCostMap<VertexType>{&vertices_},
-        boost::get(&EdgeInfo::routingCost, graph_), boost::get(boost::vertex_index, graph_), std::less<double>{},
-        boost::closed_plus<double>{}, inf, 0., visitor);
+    auto& vertices = *vertices_;
+    vertices.reset(num_vertices(graph_));
+    vertices.visit(start) = VertexState{start, 0., 1, 0, true, true};
+    try {
+      search(start, func);
+    } catch (...) {
+      vertices.finish();
+      throw;
+    }
+    vertices.finish();
   }
 
   //! Returns the result
-  const DijkstraSearchMapType& getMap() const { return vertices_; }
+  const DijkstraSearchMapType& getMap() const { return *vertices_; }
 
  private:
-  SearchGraph graph_;
-  DijkstraSearchMapType vertices_;
+  template <typename Func>
+  void search(VertexType start, Func& func) {
+    auto& vertices = *vertices_;
+    VertexQueue queue(CostMap{&vertices}, IndexInHeapMap(vertices.indexInHeap().data()), std::less<double>{},
+                      HeapStorage(vertices.heap()));
+    queue.push(start);
+    while (!queue.empty()) {
+      VertexType current = queue.top();
+      queue.pop();
+      auto& state = vertices.visit(current);
+      state.predicate =
+          func(VertexVisitInformation{current, state.predecessor, state.cost, state.length, state.numLaneChanges});
+      vertices.visit(state.predecessor).isLeaf = current == state.predecessor;  // necessary for the initial vertex
+      if (!state.predicate) {
+        continue;
+      }
+      const auto& currentState = state;
+      for (auto edges = out_edges(current, graph_); edges.first != edges.second; ++edges.first) {
+        const auto& edge = *edges.first;
+        const auto& edgeInfo = graph_[edge];
+        const auto targetVertex = target(edge, graph_);
+        const bool undiscovered = !vertices.contains(targetVertex);
+        const double cost =
+            currentState.cost + edgeCost_(current, targetVertex, edgeInfo.routingCost, currentState.cost);
+        if (!(cost < vertices.cost(targetVertex))) {
+          continue;
+        }
+        auto& follower = vertices.visit(targetVertex);
+        follower.cost = cost;
+        follower.length = currentState.length + 1;
+        follower.predecessor = current;
+        follower.numLaneChanges = currentState.numLaneChanges + (edgeInfo.relation != RelationType::Successor);
+        if (undiscovered) {
+          queue.push(targetVertex);
+        } else {
+          queue.update(targetVertex);
+        }
+      }
+    }
+  }
+
+  const G& graph_;
+  EdgeCostT edgeCost_;
+  typename DijkstraSearchMapPool<VertexType>::SearchMapPtr vertices_;
 };
 
 }  // namespace internal
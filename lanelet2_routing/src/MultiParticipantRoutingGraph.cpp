@@ -0,0 +1,238 @@
+#include "lanelet2_routing/MultiParticipantRoutingGraph.h"
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include "lanelet2_routing/Exceptions.h"
+#include "lanelet2_routing/internal/RoutingGraphBuilder.h"
+#include "lanelet2_routing/internal/SharedGraph.h"
+#include "lanelet2_routing/internal/ShortestPath.h"
+
+namespace lanelet {
+namespace routing {
+
+#if __cplusplus < 201703L
+constexpr size_t MultiParticipantRoutingGraph::MaxParticipants;
+#endif
+
+namespace {
+MultiParticipantRoutingGraph::ParticipantMask bit(size_t participant) {
+  return MultiParticipantRoutingGraph::ParticipantMask(1) << participant;
+}
+
+//! Relations that are followed by the searches, the same as for a RoutingGraph
+RelationType searchRelations(bool withLaneChanges) {
+  return withLaneChanges ? RelationType::Successor | RelationType::Left | RelationType::Right
+                         : RelationType::Successor;
+}
+}  // namespace
+
+struct MultiParticipantRoutingGraph::GraphCache {
+  std::mutex mutex;                          //!< Held while a graph is looked up or built
+  std::vector<RoutingGraphConstPtr> graphs;  //!< Ordered by participant, empty if not built yet
+};
+
+MultiParticipantRoutingGraphUPtr MultiParticipantRoutingGraph::build(const LaneletMap& laneletMap,
+                                                                     const Participants& participants) {
+  return build(static_cast<const LaneletMapLayers&>(laneletMap), participants);
+}
+
+MultiParticipantRoutingGraphUPtr MultiParticipantRoutingGraph::build(const LaneletSubmap& laneletSubmap,
+                                                                     const Participants& participants) {
+  return build(static_cast<const LaneletMapLayers&>(laneletSubmap), participants);
+}
+
+MultiParticipantRoutingGraphUPtr MultiParticipantRoutingGraph::build(const LaneletMapLayers& laneletMapLayers,
+                                                                     const Participants& participants) {
+  if (participants.size() > MaxParticipants) {
+    throw InvalidInputError("Too many participants for a MultiParticipantRoutingGraph.");
+  }
+  if (std::any_of(participants.begin(), participants.end(), [](auto& p) { return !p.trafficRules; })) {
+    throw InvalidInputError("Every participant of a MultiParticipantRoutingGraph needs traffic rules.");
+  }
+  auto topology = std::make_unique<internal::RoutingTopology>(laneletMapLayers);
+  // the graphs of the participants are only needed until they are merged
+  std::vector<std::unique_ptr<internal::RoutingGraphGraph>> graphs;
+  graphs.reserve(participants.size());
+  for (const auto& participant : participants) {
+    graphs.push_back(
+        internal::RoutingGraphBuilder(*participant.trafficRules, participant.routingCosts, participant.config)
+            .buildGraph(*topology));
+  }
+  auto shared = std::make_unique<internal::SharedGraph>(
+      utils::transform(graphs, [](const auto& graph) -> const internal::RoutingGraphGraph* { return graph.get(); }));
+  return MultiParticipantRoutingGraphUPtr{
+      new MultiParticipantRoutingGraph(std::move(topology), std::move(shared), participants)};
+}
+
+MultiParticipantRoutingGraph::MultiParticipantRoutingGraph(std::unique_ptr<internal::RoutingTopology>&& topology,
+                                                           std::unique_ptr<internal::SharedGraph>&& shared,
+                                                           Participants participants)
+    : topology_{std::move(topology)},
+      shared_{std::move(shared)},
+      participants_{std::move(participants)},
+      names_{utils::transform(participants_, [](auto& p) { return p.trafficRules->participant(); })},
+      graphs_{std::make_unique<GraphCache>()} {
+  graphs_->graphs.resize(participants_.size());
+}
+
+MultiParticipantRoutingGraph::MultiParticipantRoutingGraph(MultiParticipantRoutingGraph&& /*other*/) noexcept = default;
+MultiParticipantRoutingGraph& MultiParticipantRoutingGraph::operator=(
+    MultiParticipantRoutingGraph&& /*other*/) noexcept = default;
+MultiParticipantRoutingGraph::~MultiParticipantRoutingGraph() = default;
+
+const RoutingGraph& MultiParticipantRoutingGraph::graph(size_t participant) const {
+  checkParticipant(participant);
+  return *completeGraph(participant);
+}
+
+const std::string& MultiParticipantRoutingGraph::participant(size_t participant) const {
+  checkParticipant(participant);
+  return names_[participant];
+}
+
+Optional<size_t> MultiParticipantRoutingGraph::find(const std::string& participant) const {
+  auto it = std::find(names_.begin(), names_.end(), participant);
+  if (it == names_.end()) {
+    return {};
+  }
+  return size_t(std::distance(names_.begin(), it));
+}
+
+ConstLanelets MultiParticipantRoutingGraph::following(size_t participant, const ConstLanelet& lanelet,
+                                                      bool withLaneChanges) const {
+  checkRoutingCostId(participant, 0);
+  auto vertex = shared_->getVertex(lanelet);
+  if (!vertex) {
+    return {};
+  }
+  // like RoutingGraph::following, this uses the relations of the first routing cost module
+  internal::ParticipantGraph graph(*shared_, participant, 0, searchRelations(withLaneChanges));
+  ConstLanelets result;
+  for (auto edges = graph.outEdges(*vertex); edges.first != edges.second; ++edges.first) {
+    const auto& next = shared_->laneletOrArea(target(*edges.first, graph));
+    if (next.isLanelet()) {
+      result.push_back(*next.lanelet());
+    }
+  }
+  return result;
+}
+
+Optional<LaneletPath> MultiParticipantRoutingGraph::shortestPath(size_t participant, const ConstLanelet& from,
+                                                                 const ConstLanelet& to, RoutingCostId routingCostId,
+                                                                 bool withLaneChanges) const {
+  checkRoutingCostId(participant, routingCostId);
+  auto start = shared_->getVertex(from);
+  auto end = shared_->getVertex(to);
+  if (!start || !end || !canPass(participant, from) || !canPass(participant, to)) {
+    return {};
+  }
+  internal::ParticipantGraph graph(*shared_, participant, routingCostId, searchRelations(withLaneChanges));
+  internal::DijkstraStyleSearch<internal::ParticipantGraph> search(graph);
+  bool reached = false;
+  search.query(*start, [&](const internal::VertexVisitInformation& i) {
+    reached = reached || i.vertex == *end;
+    return !reached;
+  });
+  if (!reached) {
+    return {};
+  }
+  const auto& map = search.getMap();
+  ConstLanelets path(map.at(*end).length);
+  for (auto v = *end;; v = map.at(v).predecessor) {
+    path[map.at(v).length - 1] = *shared_->laneletOrArea(v).lanelet();
+    if (map.at(v).predecessor == v) {
+      break;
+    }
+  }
+  return LaneletPath(std::move(path));
+}
+
+ConstLanelets MultiParticipantRoutingGraph::reachableSet(size_t participant, const ConstLanelet& lanelet,
+                                                         double maxRoutingCost, RoutingCostId routingCostId,
+                                                         bool allowLaneChanges) const {
+  checkRoutingCostId(participant, routingCostId);
+  auto start = shared_->getVertex(lanelet);
+  if (!start || !canPass(participant, lanelet)) {
+    return {};
+  }
+  internal::ParticipantGraph graph(*shared_, participant, routingCostId, searchRelations(allowLaneChanges));
+  internal::DijkstraStyleSearch<internal::ParticipantGraph> search(graph);
+  search.query(*start, [&](const internal::VertexVisitInformation& i) { return i.cost <= maxRoutingCost; });
+  ConstLanelets result;
+  result.reserve(search.getMap().size());
+  for (const auto& vertex : search.getMap()) {
+    if (vertex.second.predicate) {
+      result.push_back(*shared_->laneletOrArea(vertex.first).lanelet());
+    }
+  }
+  return result;
+}
+
+MultiParticipantRoutingGraph::ParticipantMask MultiParticipantRoutingGraph::passableBy(
+    const ConstLaneletOrArea& laneletOrArea) const noexcept {
+  auto vertex = shared_->getVertex(laneletOrArea);
+  return vertex ? shared_->passableBy(*vertex) : ParticipantMask{};
+}
+
+bool MultiParticipantRoutingGraph::canPass(size_t participant, const ConstLaneletOrArea& laneletOrArea) const {
+  checkParticipant(participant);
+  return (passableBy(laneletOrArea) & bit(participant)) != 0;
+}
+
+ConstLanelets MultiParticipantRoutingGraph::conflictingInGraph(const ConstLanelet& lanelet, size_t participant,
+                                                               double participantHeight) const {
+  checkParticipant(participant);
+  if (!topology_->index(lanelet)) {
+    return RoutingGraphContainer({completeGraph(participant)}).conflictingInGraph(lanelet, 0, participantHeight);
+  }
+  ConstLanelets conflicting;
+  for (const auto& candidate : topology_->nearbyLanelets(lanelet)) {
+    if (candidate == lanelet || !canPass(participant, candidate) || !topology_->overlaps2d(lanelet, candidate)) {
+      continue;
+    }
+    if (participantHeight != .0 && !geometry::overlaps3d(lanelet, candidate, participantHeight)) {
+      continue;
+    }
+    conflicting.push_back(candidate);
+  }
+  return conflicting;
+}
+
+RoutingGraphContainer::ConflictingInGraphs MultiParticipantRoutingGraph::conflictingInGraphs(
+    const ConstLanelet& lanelet, double participantHeight) const {
+  RoutingGraphContainer::ConflictingInGraphs result;
+  result.reserve(size());
+  for (size_t participant = 0; participant < size(); ++participant) {
+    result.emplace_back(participant, conflictingInGraph(lanelet, participant, participantHeight));
+  }
+  return result;
+}
+
+void MultiParticipantRoutingGraph::checkParticipant(size_t participant) const {
+  if (participant >= size()) {
+    throw InvalidInputError("Participant index is higher than the number of participants.");
+  }
+}
+
+RoutingGraphConstPtr MultiParticipantRoutingGraph::completeGraph(size_t participant) const {
+  std::lock_guard<std::mutex> lock(graphs_->mutex);
+  auto& graph = graphs_->graphs[participant];
+  if (!graph) {
+    const auto& p = participants_[participant];
+    graph = internal::RoutingGraphBuilder(*p.trafficRules, p.routingCosts, p.config).build(*topology_);
+  }
+  return graph;
+}
+
+void MultiParticipantRoutingGraph::checkRoutingCostId(size_t participant, RoutingCostId routingCostId) const {
+  checkParticipant(participant);
+  if (routingCostId >= shared_->numRoutingCosts(participant)) {
+    throw InvalidInputError("Routing Cost ID is higher than the number of routing modules.");
+  }
+}
+
+}  // namespace routing
+}  // namespace lanelet
@@ -0,0 +1,302 @@
+#include "lanelet2_routing/ReachableSetHorizon.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "lanelet2_routing/internal/CostOverlay.h"
+#include "lanelet2_routing/internal/Graph.h"
+
+namespace lanelet {
+namespace routing {
+namespace {
+constexpr double Unreached = std::numeric_limits<double>::infinity();
+}  // namespace
+
+class ReachableSetHorizon::Impl {
+ public:
+  Impl(const internal::RoutingGraphGraph& graph, const internal::CostOverlayState& costOverlay, double maxRoutingCost,
+       RoutingCostId routingCostId, bool allowLaneChanges)
+      : graph_{graph},
+        costOverlay_{costOverlay},
+        maxRoutingCost_{maxRoutingCost},
+        routingCostId_{routingCostId},
+        relations_{allowLaneChanges ? RelationType::Successor | RelationType::Left | RelationType::Right
+                                    : RelationType::Successor} {
+    refresh();
+  }
+
+  ReachableSetDelta update(const ConstLanelet& lanelet, double costOnLanelet) {
+    refresh();
+    auto vertex = graph_.getVertex(lanelet);
+    if (!vertex) {
+      clearTree();
+      return updateMembers();
+    }
+    limit_ = maxRoutingCost_ + costOnLanelet;
+    const auto newStart = Vertex(*vertex);
+    if (!start_ || *start_ != newStart) {
+      if (start_ && settled_[newStart] != 0) {
+        rebase(newStart);
+      } else {
+        clearTree();
+        seed(newStart);
+      }
+    }
+    expand();
+    return updateMembers();
+  }
+
+  ConstLanelets reachableSet() const {
+    ConstLanelets result;
+    result.reserve(members_.size());
+    for (auto v : members_) {
+      result.push_back(lanelet(v));
+    }
+    return result;
+  }
+
+  Optional<double> cost(const ConstLanelet& llt) const {
+    auto vertex = graph_.getVertex(llt);
+    if (!vertex || *vertex >= inSet_.size() || inSet_[*vertex] == 0) {
+      return {};
+    }
+    return cost_[*vertex];
+  }
+
+  Optional<ConstLanelet> currentLanelet() const {
+    if (!start_) {
+      return {};
+    }
+    return lanelet(*start_);
+  }
+
+  double maxRoutingCost() const noexcept { return maxRoutingCost_; }
+
+  void reset() {
+    clearTree();
+    for (auto v : members_) {
+      inSet_[v] = 0;
+    }
+    members_.clear();
+  }
+
+ private:
+  using Vertex = std::uint32_t;
+  using QueueEntry = std::pair<double, Vertex>;
+
+  ConstLanelet lanelet(Vertex v) const { return graph_.get()[v].lanelet(); }
+
+  //! Restarts if the graph or its cost overlay changed, the labels are not valid for them
+  void refresh() {
+    auto graphs = graph_.compressed(routingCostId_, relations_);
+    auto overlay = costOverlay_.load();
+    if (graphs == graphs_ && overlay == overlay_) {
+      return;
+    }
+    clearTree();
+    graphs_ = std::move(graphs);
+    overlay_ = std::move(overlay);
+    const auto numVertices = num_vertices(graphs_->forward);
+    if (cost_.size() < numVertices) {
+      cost_.resize(numVertices, Unreached);
+      predecessor_.resize(numVertices);
+      settled_.resize(numVertices, 0);
+      inSet_.resize(numVertices, 0);
+      branch_.resize(numVertices, Branch::Unknown);
+    }
+  }
+
+  void clearTree() {
+    for (auto v : discovered_) {
+      cost_[v] = Unreached;
+      settled_[v] = 0;
+    }
+    discovered_.clear();
+    settledVertices_.clear();
+    queue_.clear();
+    start_.reset();
+  }
+
+  void seed(Vertex start) {
+    start_ = start;
+    cost_[start] = 0.;
+    predecessor_[start] = start;
+    discovered_.push_back(start);
+    push(0., start);
+  }
+
+  //! Makes a vertex of the tree the new start. Only its subtree is kept.
+  void rebase(Vertex start) {
+    const auto offset = cost_[start];
+    branch_[start] = Branch::Inside;
+    for (auto v : settledVertices_) {
+      classify(v);
+    }
+    kept_.clear();
+    for (auto v : discovered_) {
+      if (settled_[v] != 0 && branch_[v] == Branch::Inside) {
+        cost_[v] -= offset;
+        kept_.push_back(v);
+      } else {
+        cost_[v] = Unreached;
+        settled_[v] = 0;
+      }
+    }
+    for (auto v : settledVertices_) {
+      branch_[v] = Branch::Unknown;
+    }
+    predecessor_[start] = start;
+    start_ = start;
+    discovered_ = kept_;
+    settledVertices_ = kept_;
+    queue_.clear();
+    // the costs within the subtree are final, the search continues from its borders
+    for (auto v : kept_) {
+      relax(v);
+    }
+  }
+
+  //! Finds out whether a vertex is within the subtree of the new start by following its predecessors
+  void classify(Vertex v) {
+    path_.clear();
+    auto result = Branch::Outside;
+    while (branch_[v] == Branch::Unknown) {
+      path_.push_back(v);
+      if (predecessor_[v] == v) {
+        break;
+      }
+      v = predecessor_[v];
+    }
+    if (branch_[v] != Branch::Unknown) {
+      result = branch_[v];
+    }
+    for (auto u : path_) {
+      branch_[u] = result;
+    }
+  }
+
+  //! Continues the search until all vertices within the limit are settled
+  void expand() {
+    while (!queue_.empty() && queue_.front().first <= limit_) {
+      std::pop_heap(queue_.begin(), queue_.end(), std::greater<>{});
+      const auto entry = queue_.back();
+      queue_.pop_back();
+      const auto v = entry.second;
+      if (settled_[v] != 0 || entry.first > cost_[v]) {
+        continue;
+      }
+      settled_[v] = 1;
+      settledVertices_.push_back(v);
+      relax(v);
+    }
+  }
+
+  void relax(Vertex v) {
+    const internal::OverlaidEdgeCost edgeCost(overlay_.get(), false);
+    for (auto edges = out_edges(v, graphs_->forward); edges.first != edges.second; ++edges.first) {
+      const auto next = Vertex(target(*edges.first, graphs_->forward));
+      if (settled_[next] != 0) {
+        continue;
+      }
+      const auto cost = cost_[v] + edgeCost(v, next, edges.first->routingCost, cost_[v]);
+      if (!(cost < cost_[next])) {
+        continue;
+      }
+      if (cost_[next] == Unreached) {
+        discovered_.push_back(next);
+      }
+      cost_[next] = cost;
+      predecessor_[next] = v;
+      push(cost, next);
+    }
+  }
+
+  void push(double cost, Vertex v) {
+    queue_.emplace_back(cost, v);
+    std::push_heap(queue_.begin(), queue_.end(), std::greater<>{});
+  }
+
+  //! Determines the new members and reports the difference to the old ones
+  ReachableSetDelta updateMembers() {
+    newMembers_.clear();
+    if (start_) {
+      for (auto v : settledVertices_) {
+        if (cost_[v] <= limit_) {
+          newMembers_.push_back(v);
+        }
+      }
+    }
+    ReachableSetDelta delta;
+    for (auto v : newMembers_) {
+      if (inSet_[v] == 0) {
+        delta.entered.push_back(lanelet(v));
+      }
+      inSet_[v] = 2;
+    }
+    for (auto v : members_) {
+      if (inSet_[v] == 1) {
+        delta.left.push_back(lanelet(v));
+        inSet_[v] = 0;
+      }
+    }
+    for (auto v : newMembers_) {
+      inSet_[v] = 1;
+    }
+    std::swap(members_, newMembers_);
+    return delta;
+  }
+
+  enum class Branch : std::uint8_t { Unknown, Inside, Outside };
+
+  const internal::RoutingGraphGraph& graph_;
+  const internal::CostOverlayState& costOverlay_;
+  double maxRoutingCost_;
+  RoutingCostId routingCostId_;
+  RelationType relations_;
+  internal::CompressedGraphsConstPtr graphs_;
+  internal::ResolvedCostOverlayConstPtr overlay_;
+  Optional<Vertex> start_;
+  double limit_{};
+  std::vector<double> cost_;            //!< Cost from the start, infinite if not discovered yet
+  std::vector<Vertex> predecessor_;     //!< Predecessor on the shortest path from the start
+  std::vector<std::uint8_t> settled_;   //!< The cost of the vertex is final
+  std::vector<std::uint8_t> inSet_;     //!< The vertex is part of the reported set
+  std::vector<Branch> branch_;          //!< Used by rebase to find the subtree of the new start
+  std::vector<Vertex> discovered_;      //!< All vertices with a finite cost
+  std::vector<Vertex> settledVertices_;
+  std::vector<Vertex> members_;
+  std::vector<Vertex> newMembers_;
+  std::vector<Vertex> kept_;
+  std::vector<Vertex> path_;
+  std::vector<QueueEntry> queue_;       //!< Min-heap of discovered vertices, may contain outdated entries
+};
+
+ReachableSetHorizon::ReachableSetHorizon(const internal::RoutingGraphGraph& graph,
+                                         const internal::CostOverlayState& costOverlay, double maxRoutingCost,
+                                         RoutingCostId routingCostId, bool allowLaneChanges)
+    : impl_{std::make_unique<Impl>(graph, costOverlay, maxRoutingCost, routingCostId, allowLaneChanges)} {}
+
+ReachableSetHorizon::ReachableSetHorizon(ReachableSetHorizon&& rhs) noexcept = default;
+ReachableSetHorizon& ReachableSetHorizon::operator=(ReachableSetHorizon&& rhs) noexcept = default;
+ReachableSetHorizon::~ReachableSetHorizon() = default;
+
+ReachableSetDelta ReachableSetHorizon::update(const ConstLanelet& lanelet, double costOnLanelet) {
+  return impl_->update(lanelet, costOnLanelet);
+}
+
+ConstLanelets ReachableSetHorizon::reachableSet() const { return impl_->reachableSet(); }
+
+bool ReachableSetHorizon::contains(const ConstLanelet& lanelet) const { return !!impl_->cost(lanelet); }
+
+Optional<double> ReachableSetHorizon::cost(const ConstLanelet& lanelet) const { return impl_->cost(lanelet); }
+
+Optional<ConstLanelet> ReachableSetHorizon::currentLanelet() const { return impl_->currentLanelet(); }
+
+double ReachableSetHorizon::maxRoutingCost() const noexcept { return impl_->maxRoutingCost(); }
+
+void ReachableSetHorizon::reset() { impl_->reset(); }
+
+}  // namespace routing
+}  // namespace lanelet
@@ -3,7 +3,6 @@
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_core/primitives/Lanelet.h>
 #include <lanelet2_core/utility/Utilities.h>
-#include <boost/graph/reverse_graph.hpp>
 #include <unordered_map>
 #include "lanelet2_routing/Exceptions.h"
 #include "lanelet2_routing/internal/Graph.h"
@@ -131,8 +130,27 @@ Route::Route() = default;
 Route::~Route() noexcept = default;
 Route& Route::operator=(Route&& other) noexcept = default;
 Route::Route(Route&& other) noexcept = default;
-Route::Route(LaneletPath shortestPath, std::unique_ptr<RouteGraph> graph, LaneletSubmapConstPtr laneletSubmap) noexcept
-    : graph_{std::move(graph)}, shortestPath_{std::move(shortestPath)}, laneletSubmap_{std::move(laneletSubmap)} {}
+Route::Route(LaneletPath shortestPath, std::unique_ptr<RouteGraph> graph, LaneletSubmapConstPtr laneletSubmap)
+    : graph_{std::move(graph)}, shortestPath_{std::move(shortestPath)}, laneletSubmap_{std::move(laneletSubmap)} {
+  if (graph_ && !graph_->hasConflictTable()) {
+    throw InvalidInputError("The graph of a route needs the conflict table of its routing graph");
+  }
+}
+
+LaneletSubmapConstPtr Route::laneletSubmap() const {
+  auto submap = std::atomic_load(&laneletSubmap_);
+  if (submap || !graph_) {
+    return submap;
+  }
+  const auto& g = graph_->get();
+  LaneletSubmapConstPtr created =
+      utils::createConstSubmap(utils::transform(g.vertex_set(), [&g](auto v) { return g[v].lanelet; }), {});
+  // if another thread was faster, its submap is used
+  if (std::atomic_compare_exchange_strong(&laneletSubmap_, &submap, created)) {
+    return created;
+  }
+  return submap;
+}
 
 LaneletPath Route::remainingShortestPath(const ConstLanelet& ll) const {
   auto iter = std::find(shortestPath_.begin(), shortestPath_.end(), ll);
@@ -300,8 +318,8 @@ void Route::forEachSuccessor(const ConstLanelet& lanelet, const LaneletVisitFunc
   if (!v) {
     return;
   }
-  auto g = graph_->withLaneChanges();
-  internal::DijkstraStyleSearch<FilteredRouteGraph> search(g);
+  auto g = graph_->compressed(0, RelationType::Successor | RelationType::Left | RelationType::Right);
+  internal::DijkstraStyleSearch<internal::CompressedGraph> search(g->forward);
   search.query(*v, [&](const internal::VertexVisitInformation& i) -> bool {
     return f(LaneletVisitInformation{graph_->get()[i.vertex].lanelet, graph_->get()[i.predecessor].lanelet, i.cost,
                                      i.length, i.numLaneChanges});
@@ -313,9 +331,8 @@ void Route::forEachPredecessor(const ConstLanelet& lanelet, const LaneletVisitFu
   if (!v) {
     return;
   }
-  auto g = graph_->withLaneChanges();
-  auto gInv = boost::make_reverse_graph(g);
-  internal::DijkstraStyleSearch<decltype(gInv)> search(gInv);
+  auto g = graph_->compressed(0, RelationType::Successor | RelationType::Left | RelationType::Right);
+  internal::DijkstraStyleSearch<internal::CompressedGraph> search(g->backward);
   search.query(*v, [&](const internal::VertexVisitInformation& i) -> bool {
     return f(LaneletVisitInformation{graph_->get()[i.vertex].lanelet, graph_->get()[i.predecessor].lanelet, i.cost,
                                      i.length, i.numLaneChanges});
@@ -335,15 +352,18 @@ ConstLaneletOrAreas Route::conflictingInMap(const ConstLanelet& lanelet) const {
   if (!v) {
     return {};
   }
-  return graph_->get()[*v].conflictingInMap;
+  auto conf = graph_->conflictTable().conflicting(graph_->get()[*v].graphVertex);
+  return ConstLaneletOrAreas(conf.first, conf.second);
 }
 
 ConstLaneletOrAreas lanelet::routing::Route::allConflictingInMap() const {
   auto& g = graph_->get();
-  return utils::concatenateRange(g.vertex_set(), [&](auto v) {
-    auto& conf = g[v].conflictingInMap;
-    return std::make_pair(std::begin(conf), std::end(conf));
-  });
+  ConstLaneletOrAreas conflicting;
+  for (auto v : g.vertex_set()) {
+    auto conf = graph_->conflictTable().conflicting(g[v].graphVertex);
+    conflicting.insert(conflicting.end(), conf.first, conf.second);
+  }
+  return conflicting;
 }
 
 bool Route::contains(const ConstLanelet& lanelet) const { return !!graph_->getVertex(lanelet); }
@@ -235,8 +235,7 @@ class NeighbouringGraphVisitor : public boost::default_bfs_visitor {
 class RouteConstructionVisitor : public boost::default_bfs_visitor {
  public:
   RouteConstructionVisitor() = default;
-  RouteConstructionVisitor(const OriginalGraph& graph, RouteGraph& routeGraph)
-      : graph_{&graph}, routeGraph_{&routeGraph} {}
+  explicit RouteConstructionVisitor(RouteGraph& routeGraph) : routeGraph_{&routeGraph} {}
 
   //! called by boost graph on a new vertex
   void examine_vertex(LaneletVertexId v, const OnRouteGraph& g) {  // NOLINT
@@ -244,7 +243,7 @@ class RouteConstructionVisitor : public boost::default_bfs_visitor {
     if (routeGraph_->empty()) {
       // first time
 
-      sourceElem_ = routeGraph_->addVertex(RouteVertexInfo{llt, laneId_, {}});
+      sourceElem_ = routeGraph_->addVertex(RouteVertexInfo{llt, laneId_, std::uint32_t(v)});
     } else {
       sourceElem_ = *routeGraph_->getVertex(llt);
     }
@@ -259,7 +258,7 @@ class RouteConstructionVisitor : public boost::default_bfs_visitor {
     auto type = g[e].relation;
     if (!destVertex) {
       const auto laneId = newLane ? ++laneId_ : routeGraph()[sourceElem_].laneId;
-      destVertex = routeGraph_->addVertex(RouteVertexInfo{llt, laneId, {}});
+      destVertex = routeGraph_->addVertex(RouteVertexInfo{llt, laneId, std::uint32_t(dest)});
     } else if (!!destVertex && !newLane && type == RelationType::Successor &&
                routeGraph()[sourceElem_].laneId != routeGraph()[*destVertex].laneId) {
       // this happens if we reached a lanelet because it was part of a circle of reached through a conflicting lanelet.
@@ -268,14 +267,6 @@ class RouteConstructionVisitor : public boost::default_bfs_visitor {
     }
     routeGraph_->addEdge(sourceElem_, *destVertex, g[e]);
   }
-  void finish_vertex(LaneletVertexId v, const OnRouteGraph& g) {  // NOLINT
-    // now that all neighbours are known, now is the time to add lanelets that conflict in the whole graph
-    OnlyConflictingGraph conflictInMap(*graph_, OnlyConflictingFilter{*graph_});
-    auto outGraph = boost::out_edges(v, conflictInMap);
-    std::for_each(outGraph.first, outGraph.second, [&](GraphTraits::edge_descriptor e) {
-      routeGraph()[sourceElem_].conflictingInMap.push_back(g[boost::target(e, g)].laneletOrArea);
-    });
-  }
 
  private:
   RouteGraphType& routeGraph() { return routeGraph_->get(); }
@@ -322,7 +313,6 @@ class RouteConstructionVisitor : public boost::default_bfs_visitor {
     return hasOneEdge;
   }
 
-  const OriginalGraph* graph_{};
   LaneId laneId_{1000};
   RouteGraph* routeGraph_{};
   LaneletVertexId sourceElem_{};
@@ -336,7 +326,8 @@ void breadthFirstSearch(const Graph& g, StartVertex v, Visitor vis) {
 }
 
 //! This is the class that handles building the route. It iteratively adds lanelets initial route (i.e. the shortest
-//! path) that fulfill the definition of a lanelet on the route. This is done until convergence is reached.
+//! path) that fulfill the definition of a lanelet on the route. After each iteration, the lanelets that are connected
+//! to the route by lane changes in both directions are added in one go. This is done until convergence is reached.
 class RouteUnderConstruction {
  public:
   RouteUnderConstruction(const std::vector<LaneletVertexId>& initialRoute, const OriginalGraph& originalGraph)
@@ -350,6 +341,30 @@ class RouteUnderConstruction {
         laneletVisitor_{laneletsOnRoute_},
         pathOutOfRouteFinder_{originalGraph_, laneletsOnRoute_} {}
 
+  //! Adds all lanelets that can be reached from the current route by lane changes in both directions. These would be
+  //! added by the next call to addAdjacentLaneletsToRoute anyway, but only one lane at a time. Closing the route over
+  //! them at once saves one iteration per lane on roads with many lanes.
+  void addLaneChangeComponentsToRoute() {
+    std::vector<LaneletVertexId> queue{laneletsOnRoute_.begin(), laneletsOnRoute_.end()};
+    while (!queue.empty()) {
+      auto v = queue.back();
+      queue.pop_back();
+      auto outEdges = boost::out_edges(v, originalGraph_);
+      std::for_each(outEdges.first, outEdges.second, [&](OriginalGraph::edge_descriptor e) {
+        constexpr auto LaneChange = RelationType::Left | RelationType::Right;
+        auto dest = boost::target(e, originalGraph_);
+        if (!hasRelation<LaneChange>(originalGraph_, e) || has(laneletsOnRoute_, dest)) {
+          return;
+        }
+        auto back = boost::edge(dest, v, originalGraph_);
+        if (back.second && hasRelation<LaneChange>(originalGraph_, back.first)) {
+          laneletsOnRoute_.insert(dest);
+          queue.push_back(dest);
+        }
+      });
+    }
+  }
+
   //! Adds neighbours of the current route to the route if they fulfill the criteria. Returns true if something was
   //! added.
   bool addAdjacentLaneletsToRoute() {
@@ -371,19 +386,19 @@ class RouteUnderConstruction {
     return progress;
   }
 
-  //! Creates the route object from the current state of the route.
-  Optional<Route> finalizeRoute(const OriginalGraph& theGraph, const LaneletPath& thePath) {
+  //! Creates the route object from the current state of the route. Conflicts in the map are not copied, the route
+  //! refers to the conflict table of the routing graph instead. Its submap is only created once it is requested.
+  Optional<Route> finalizeRoute(ConflictTableConstPtr conflictTable, const LaneletPath& thePath) {
     auto routeGraph = std::make_unique<RouteGraph>(1);
     // Search the graph of the route. The visitor fills elements and lanebegins
-    RouteConstructionVisitor visitor(theGraph, *routeGraph);
+    RouteConstructionVisitor visitor(*routeGraph);
     breadthFirstSearch(routeGraph_, begin_, visitor);
 
     if (!routeGraph->getVertex(thePath.back())) {
       return {};  // there was no path between begin and end
     }
-    auto& g = routeGraph->get();
-    auto map = utils::createConstSubmap(utils::transform(g.vertex_set(), [&g](auto v) { return g[v].lanelet; }), {});
-    return Route(thePath, std::move(routeGraph), std::move(map));
+    routeGraph->setConflictTable(std::move(conflictTable));
+    return Route(thePath, std::move(routeGraph), nullptr);
   }
 
  private:
@@ -405,19 +420,19 @@ Optional<Route> RouteBuilder::getRouteFromShortestPath(const LaneletPath& path,
   // translate the lanelets to graph ids
   auto vertexIds = utils::transform(path, [&](auto llt) { return LaneletVertexId{*graph_.getVertex(llt)}; });
   // decide which graph we are going to use
-  OriginalGraph originalGraph{graph_.get(), OriginalGraphFilter{graph_.get(), withLaneChanges, costId}};
+  OriginalGraph originalGraph{graph_.get(), OriginalGraphFilter{graph_.get(), withLaneChanges, costId, overlay_}};
 
   // get the container for all the things
   RouteUnderConstruction routeUnderConstruction{vertexIds, originalGraph};
 
-  //! @todo deleteme
-  auto ids = utils::transform(graph_.get().m_vertices, [&](auto& v) { return v.m_property.laneletOrArea.id(); });
-
   bool progress = true;
   while (progress) {
     progress = routeUnderConstruction.addAdjacentLaneletsToRoute();
+    if (progress && closeOverLaneChanges_) {
+      routeUnderConstruction.addLaneChangeComponentsToRoute();
+    }
   }
-  return routeUnderConstruction.finalizeRoute(originalGraph, path);
+  return routeUnderConstruction.finalizeRoute(graph_.conflictTable(), path);
 }
 }  // namespace internal
 }  // namespace routing
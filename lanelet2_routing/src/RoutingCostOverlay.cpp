@@ -0,0 +1,72 @@
+#include "lanelet2_routing/RoutingCostOverlay.h"
+#include <lanelet2_core/Exceptions.h>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace lanelet {
+namespace routing {
+namespace {
+void checkCostValue(double value, const char* what) {
+  if (!std::isfinite(value) || value < 0.) {
+    throw InvalidInputError(std::string(what) + " of a cost modification must be finite and not negative, but it is " +
+                            std::to_string(value));
+  }
+}
+
+template <typename MapT, typename KeyT>
+Optional<CostModification> find(const MapT& map, const KeyT& key) {
+  auto it = map.find(key);
+  if (it == map.end()) {
+    return {};
+  }
+  return it->second;
+}
+}  // namespace
+
+CostModification CostModification::multiply(double factor) {
+  checkCostValue(factor, "Factor");
+  return CostModification(Type::Multiply, factor);
+}
+
+CostModification CostModification::absolute(double cost) {
+  checkCostValue(cost, "Cost");
+  return CostModification(Type::Absolute, cost);
+}
+
+double CostModification::apply(double routingCost) const noexcept {
+  switch (type_) {
+    case Type::Multiply:
+      return routingCost * value_;
+    case Type::Absolute:
+      return value_;
+    case Type::Blocked:
+      break;
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+RoutingCostOverlay& RoutingCostOverlay::set(Id laneletOrArea, CostModification modification) {
+  lanelets_.erase(laneletOrArea);
+  lanelets_.emplace(laneletOrArea, modification);
+  return *this;
+}
+
+RoutingCostOverlay& RoutingCostOverlay::set(Id from, Id to, CostModification modification) {
+  relations_.erase(std::make_pair(from, to));
+  relations_.emplace(std::make_pair(from, to), modification);
+  return *this;
+}
+
+bool RoutingCostOverlay::reset(Id laneletOrArea) { return lanelets_.erase(laneletOrArea) > 0; }
+
+bool RoutingCostOverlay::reset(Id from, Id to) { return relations_.erase(std::make_pair(from, to)) > 0; }
+
+Optional<CostModification> RoutingCostOverlay::get(Id laneletOrArea) const { return find(lanelets_, laneletOrArea); }
+
+Optional<CostModification> RoutingCostOverlay::get(Id from, Id to) const {
+  return find(relations_, std::make_pair(from, to));
+}
+
+}  // namespace routing
+}  // namespace lanelet
@@ -7,16 +7,19 @@
 #include <lanelet2_core/primitives/Point.h>
 #include <lanelet2_traffic_rules/TrafficRules.h>
 #include <algorithm>
-#include <boost/graph/reverse_graph.hpp>
 #include <cassert>  // Asserts
 #include <memory>
 #include <queue>
+#include <type_traits>
 #include <utility>
 #include "lanelet2_routing/Exceptions.h"
 #include "lanelet2_routing/Forward.h"
 #include "lanelet2_routing/Route.h"
+#include "lanelet2_routing/internal/CostOverlay.h"
 #include "lanelet2_routing/internal/Graph.h"
 #include "lanelet2_routing/internal/GraphUtils.h"
+#include "lanelet2_routing/internal/CoveragePath.h"
+#include "lanelet2_routing/internal/KShortestPaths.h"
 #include "lanelet2_routing/internal/RouteBuilder.h"
 #include "lanelet2_routing/internal/RoutingGraphBuilder.h"
 #include "lanelet2_routing/internal/ShortestPath.h"
@@ -29,9 +32,12 @@ namespace routing {
 
 #if __cplusplus < 201703L
 constexpr const char RoutingGraph::ParticipantHeight[];
+constexpr const char RoutingGraph::ComputeConflictZones[];
 #endif
 
 namespace {
+using internal::CompressedGraph;
+using internal::CompressedGraphs;
 using internal::DijkstraSearchMap;
 using internal::DijkstraStyleSearch;
 using internal::FilteredRoutingGraph;
@@ -188,23 +194,63 @@ ConstLanelets getLaneletEdgesFromGraph(const RoutingGraphGraph& graph, const Fil
   return result;
 }
 
-template <bool Backw>
-struct GetGraph {};
-template <>
-struct GetGraph<true> {
-  template <typename G>
-  auto operator()(const G& g) {
-    return boost::make_reverse_graph(g);
+//! Relations that are followed by the searches of the routing graph
+RelationType searchRelations(bool withLaneChanges, bool withAreas) {
+  auto relations = RelationType::Successor;
+  if (withLaneChanges) {
+    relations |= RelationType::Left | RelationType::Right;
   }
+  if (withAreas) {
+    relations |= RelationType::Area;
+  }
+  return relations;
+}
+
+using Search = DijkstraStyleSearch<CompressedGraph, internal::OverlaidEdgeCost>;
+
+//! The edges and the cost overlay that are used by a search. Must outlive the search.
+struct SearchGraph {
+  template <bool Backw = false>
+  Search search() const {
+    return Search(Backw ? graphs->backward : graphs->forward, internal::OverlaidEdgeCost(overlay.get(), Backw));
+  }
+  internal::KShortestPaths<CompressedGraph, internal::OverlaidEdgeCost> kShortestPaths() const {
+    return {graphs->forward, graphs->backward, internal::OverlaidEdgeCost(overlay.get(), false),
+            internal::OverlaidEdgeCost(overlay.get(), true)};
+  }
+  internal::CoveragePathPlanner<CompressedGraph, internal::OverlaidEdgeCost> coveragePathPlanner() const {
+    return internal::CoveragePathPlanner<CompressedGraph, internal::OverlaidEdgeCost>(
+        graphs->forward, internal::OverlaidEdgeCost(overlay.get(), false));
+  }
+  internal::CompressedGraphsConstPtr graphs;
+  internal::ResolvedCostOverlayConstPtr overlay;
 };
-template <>
-struct GetGraph<false> {
-  template <typename G>
-  auto operator()(const G& g) {
-    return g;
+
+SearchGraph searchGraph(const RoutingGraphGraph& graph, const internal::CostOverlayState& overlay,
+                        RoutingCostId routingCostId, bool withLaneChanges, bool withAreas) {
+  return {graph.compressed(routingCostId, searchRelations(withLaneChanges, withAreas)), overlay.load()};
+}
+
+using TimeDependentSearch = DijkstraStyleSearch<CompressedGraph, internal::TimeDependentEdgeCost>;
+
+//! The edges and modifications of the routing costs used by a time dependent search. Must outlive the search.
+struct TimeDependentSearchGraph {
+  TimeDependentSearch search(double departureTime) const {
+    return TimeDependentSearch(graphs->forward,
+                               internal::TimeDependentEdgeCost(overlay.get(), costs.get(), departureTime));
   }
+  internal::CompressedGraphsConstPtr graphs;
+  internal::ResolvedCostOverlayConstPtr overlay;
+  internal::ResolvedTimeDependentCostsConstPtr costs;
 };
 
+TimeDependentSearchGraph timeDependentSearchGraph(const RoutingGraphGraph& graph,
+                                                  const internal::CostOverlayState& overlay,
+                                                  const internal::TimeDependentCostState& costs,
+                                                  RoutingCostId routingCostId, bool withLaneChanges, bool withAreas) {
+  return {graph.compressed(routingCostId, searchRelations(withLaneChanges, withAreas)), overlay.load(), costs.load()};
+}
+
 template <bool Backw, typename OutVertexT, typename GraphT>
 std::vector<OutVertexT> buildPath(const DijkstraSearchMap<LaneletVertexId>& map, LaneletVertexId vertex, GraphT g) {
   const auto* currInfo = &map.at(vertex);
@@ -222,30 +268,53 @@ std::vector<OutVertexT> buildPath(const DijkstraSearchMap<LaneletVertexId>& map,
   return path;
 }
 
-template <bool Backw, typename OutVertexT, typename OutContainerT, typename Func>
-std::vector<OutContainerT> possiblePathsImpl(const GraphType::vertex_descriptor& start,
-                                             const FilteredRoutingGraph& graph, Func stopCriterion) {
-  auto g = GetGraph<Backw>{}(graph);
-  DijkstraStyleSearch<decltype(g)> search(g);
+template <bool Backw, typename TreeT, typename Func>
+TreeT possiblePathTreeImpl(const GraphType::vertex_descriptor& start, const SearchGraph& searchGraph,
+                           const GraphType& graph, Func stopCriterion) {
+  using ElementT = std::decay_t<decltype(std::declval<typename TreeT::Node>().element)>;
+  using Index = typename TreeT::Index;
+  auto search = searchGraph.search<Backw>();
   search.query(start, stopCriterion);
-  auto keepPath = [&](auto& vertex) { return vertex.second.isLeaf && !vertex.second.predicate; };
-  auto numPaths = size_t(std::count_if(search.getMap().begin(), search.getMap().end(), keepPath));
-  std::vector<OutContainerT> result;
-  result.reserve(numPaths);
-  for (auto& vertex : search.getMap()) {
-    if (!keepPath(vertex)) {
-      continue;
+  const auto& map = search.getMap();
+  // the map iterates over the vertices in ascending order, so the position of a vertex in the map is its node index
+  typename TreeT::Nodes nodes;
+  nodes.reserve(map.size());
+  typename TreeT::Leaves leaves;
+  for (const auto& vertex : map) {
+    auto parent = std::distance(map.begin(), map.find(vertex.second.predecessor));
+    nodes.push_back({static_cast<ElementT>(graph[vertex.first].laneletOrArea), Index(parent),
+                     Index(vertex.second.length)});
+    if (vertex.second.isLeaf && !vertex.second.predicate) {
+      leaves.push_back(Index(nodes.size() - 1));
     }
-    result.emplace_back(buildPath<Backw, OutVertexT>(search.getMap(), vertex.first, graph));
   }
-  return result;
+  return TreeT{std::move(nodes), std::move(leaves), Backw};
+}
+
+template <bool Backw, typename TreeT, typename Func>
+std::vector<typename TreeT::Path> possiblePathsImpl(const GraphType::vertex_descriptor& start,
+                                                    const SearchGraph& searchGraph, const GraphType& graph,
+                                                    Func stopCriterion) {
+  return possiblePathTreeImpl<Backw, TreeT>(start, searchGraph, graph, stopCriterion).paths();
+}
+
+//! Lets the search stop where either the stop criterion or the user supplied pruning function says so
+template <typename VisitInfoT, typename StopT, typename PruneT>
+auto withPruning(StopT stopCriterion, const PruneT& prune, const GraphType& graph) {
+  using ElementT = std::decay_t<decltype(std::declval<VisitInfoT>().predecessor)>;
+  return [stopCriterion, &prune, &graph](const VertexVisitInformation& i) {
+    return stopCriterion(i) &&
+           (!prune || prune(VisitInfoT{static_cast<ElementT>(graph[i.vertex].laneletOrArea),
+                                       static_cast<ElementT>(graph[i.predecessor].laneletOrArea), i.cost, i.length,
+                                       i.numLaneChanges}));
+  };
 }
 
 template <bool Backw, typename OutVertexT, typename Func>
-std::vector<OutVertexT> reachableSetImpl(const GraphType::vertex_descriptor& start, const FilteredRoutingGraph& graph,
+std::vector<OutVertexT> reachableSetImpl(const GraphType::vertex_descriptor& start,
+                                         const SearchGraph& searchGraph, const GraphType& graph,
                                          Func stopCriterion) {
-  auto g = GetGraph<Backw>{}(graph);
-  DijkstraStyleSearch<decltype(g)> search(g);
+  auto search = searchGraph.search<Backw>();
   search.query(start, stopCriterion);
   std::vector<OutVertexT> result;
   result.reserve(search.getMap().size());
@@ -276,19 +345,14 @@ struct StopIfCostMoreThan {
   double c;
 };
 
-template <typename PathT, typename PrimT>
-Optional<PathT> shortestPathImpl(const PrimT& from, const PrimT& to, RoutingCostId routingCostId, bool withLaneChanges,
-                                 bool withAreas, const internal::RoutingGraphGraph& graph) {
+template <typename PathT, typename PrimT, typename SearchT>
+Optional<PathT> shortestPathImpl(const PrimT& from, const PrimT& to, const internal::RoutingGraphGraph& graph,
+                                 SearchT&& search) {
   auto startVertex = graph.getVertex(from);
   auto endVertex = graph.getVertex(to);
   if (!startVertex || !endVertex) {
     return {};
   }
-  auto filteredGraph =
-      withLaneChanges
-          ? withAreas ? graph.withAreasAndLaneChanges(routingCostId) : graph.withLaneChanges(routingCostId)
-          : withAreas ? graph.withAreasWithoutLaneChanges(routingCostId) : graph.withoutLaneChanges(routingCostId);
-  DijkstraStyleSearch<FilteredRoutingGraph> search(filteredGraph);
   class DestinationReached {};
   try {
     search.query(*startVertex, [endVertex](const internal::VertexVisitInformation& i) {
@@ -298,11 +362,20 @@ Optional<PathT> shortestPathImpl(const PrimT& from, const PrimT& to, RoutingCost
       return true;
     });
   } catch (DestinationReached) {  // NOLINT
-    return PathT{buildPath<false, PrimT>(search.getMap(), *endVertex, filteredGraph)};
+    return PathT{buildPath<false, PrimT>(search.getMap(), *endVertex, graph.get())};
   }
   return {};
 }
 
+//! True if both routes consist of the same lanelets
+bool sameLanelets(const Route& lhs, const Route& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  const auto& lanelets = lhs.laneletSubmap()->laneletLayer;
+  return std::all_of(lanelets.begin(), lanelets.end(), [&](const ConstLanelet& ll) { return rhs.contains(ll); });
+}
+
 template <typename RetT, typename Primitives, typename ShortestPathFunc>
 Optional<RetT> shortestPathViaImpl(Primitives routePoints, ShortestPathFunc&& shortestPath) {
   Primitives path;
@@ -340,7 +413,9 @@ Optional<Route> RoutingGraph::getRoute(const ConstLanelet& from, const ConstLane
   if (!optPath) {
     return {};
   }
-  return internal::RouteBuilder(*graph_).getRouteFromShortestPath(*optPath, withLaneChanges, routingCostId);
+  auto overlay = costOverlay_->load();
+  return internal::RouteBuilder(*graph_, overlay.get()).getRouteFromShortestPath(*optPath, withLaneChanges,
+                                                                                 routingCostId);
 }
 
 Optional<Route> RoutingGraph::getRouteVia(const ConstLanelet& from, const ConstLanelets& via, const ConstLanelet& to,
@@ -349,20 +424,90 @@ Optional<Route> RoutingGraph::getRouteVia(const ConstLanelet& from, const ConstL
   if (!optPath) {
     return {};
   }
-  return internal::RouteBuilder(*graph_).getRouteFromShortestPath(*optPath, withLaneChanges, routingCostId);
+  auto overlay = costOverlay_->load();
+  return internal::RouteBuilder(*graph_, overlay.get()).getRouteFromShortestPath(*optPath, withLaneChanges,
+                                                                                 routingCostId);
 }
 
 Optional<LaneletPath> RoutingGraph::shortestPath(const ConstLanelet& from, const ConstLanelet& to,
                                                  RoutingCostId routingCostId, bool withLaneChanges) const {
-  return shortestPathImpl<LaneletPath, ConstLanelet>(from, to, routingCostId, withLaneChanges, false, *graph_);
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, withLaneChanges, false);
+  return shortestPathImpl<LaneletPath>(from, to, *graph_, graph.search());
 }
 
 Optional<LaneletOrAreaPath> RoutingGraph::shortestPathIncludingAreas(const ConstLaneletOrArea& from,
                                                                      const ConstLaneletOrArea& to,
                                                                      RoutingCostId routingCostId,
                                                                      bool withLaneChanges) const {
-  return shortestPathImpl<LaneletOrAreaPath, ConstLaneletOrArea>(from, to, routingCostId, withLaneChanges, true,
-                                                                 *graph_);
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, withLaneChanges, true);
+  return shortestPathImpl<LaneletOrAreaPath>(from, to, *graph_, graph.search());
+}
+
+LaneletPaths RoutingGraph::shortestPaths(const ConstLanelet& from, const ConstLanelet& to, size_t k,
+                                         double overlapPenalty, RoutingCostId routingCostId,
+                                         bool withLaneChanges) const {
+  auto start = graph_->getVertex(from);
+  auto end = graph_->getVertex(to);
+  if (!start || !end) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, withLaneChanges, false);
+  auto paths = graph.kShortestPaths().query(*start, *end, k, overlapPenalty);
+  return utils::transform(paths, [&](const auto& path) {
+    return LaneletPath(utils::transform(path.vertices, [&](auto v) { return graph_->get()[v].lanelet(); }));
+  });
+}
+
+Routes RoutingGraph::getAlternativeRoutes(const ConstLanelet& from, const ConstLanelet& to, size_t k,
+                                          double overlapPenalty, RoutingCostId routingCostId,
+                                          bool withLaneChanges) const {
+  Routes routes;
+  auto overlay = costOverlay_->load();
+  internal::RouteBuilder builder(*graph_, overlay.get());
+  for (const auto& path : shortestPaths(from, to, k, overlapPenalty, routingCostId, withLaneChanges)) {
+    auto route = builder.getRouteFromShortestPath(path, withLaneChanges, routingCostId);
+    if (!route ||
+        std::any_of(routes.begin(), routes.end(), [&](const Route& other) { return sameLanelets(*route, other); })) {
+      continue;
+    }
+    routes.push_back(std::move(*route));
+  }
+  return routes;
+}
+
+Optional<CoveragePath> RoutingGraph::coveragePath(const ConstLanelet& from, const ConstLanelet& to,
+                                                  RoutingCostId routingCostId, bool withLaneChanges) const {
+  auto start = graph_->getVertex(from);
+  auto end = graph_->getVertex(to);
+  if (!start || !end) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, withLaneChanges, false);
+  auto result = graph.coveragePathPlanner().query(*start, *end);
+  if (!result) {
+    return {};
+  }
+  auto toLanelet = [&](auto v) { return graph_->get()[v].lanelet(); };
+  return CoveragePath{LaneletPath(utils::transform(result->vertices, toLanelet)), result->cost,
+                      utils::transform(result->uncovered, toLanelet)};
+}
+
+Optional<LaneletPath> RoutingGraph::timeDependentShortestPath(const ConstLanelet& from, const ConstLanelet& to,
+                                                              double departureTime, RoutingCostId routingCostId,
+                                                              bool withLaneChanges) const {
+  auto graph =
+      timeDependentSearchGraph(*graph_, *costOverlay_, *timeDependentCosts_, routingCostId, withLaneChanges, false);
+  return shortestPathImpl<LaneletPath>(from, to, *graph_, graph.search(departureTime));
+}
+
+Optional<LaneletOrAreaPath> RoutingGraph::timeDependentShortestPathIncludingAreas(const ConstLaneletOrArea& from,
+                                                                                  const ConstLaneletOrArea& to,
+                                                                                  double departureTime,
+                                                                                  RoutingCostId routingCostId,
+                                                                                  bool withLaneChanges) const {
+  auto graph =
+      timeDependentSearchGraph(*graph_, *costOverlay_, *timeDependentCosts_, routingCostId, withLaneChanges, true);
+  return shortestPathImpl<LaneletOrAreaPath>(from, to, *graph_, graph.search(departureTime));
 }
 
 Optional<LaneletPath> RoutingGraph::shortestPathVia(const ConstLanelet& start, const ConstLanelets& via,
@@ -520,14 +665,37 @@ ConstLaneletOrAreas RoutingGraph::conflicting(const ConstLaneletOrArea& laneletO
   return getAllEdgesFromGraph(*graph_, graph_->conflicting(), laneletOrArea, true);
 }
 
+Optional<ConflictZone> RoutingGraph::conflictZone(const ConstLaneletOrArea& laneletOrArea,
+                                                  const ConstLaneletOrArea& conflicting) const {
+  auto vertex = graph_->getVertex(laneletOrArea);
+  if (!vertex) {
+    return {};
+  }
+  const auto& zones = graph_->conflictZones(*vertex);
+  auto zone = std::find_if(zones.begin(), zones.end(),
+                           [&](const ConflictZone& z) { return z.conflicting == conflicting; });
+  if (zone == zones.end()) {
+    return {};
+  }
+  return *zone;
+}
+
+ConflictZones RoutingGraph::conflictZones(const ConstLaneletOrArea& laneletOrArea) const {
+  auto vertex = graph_->getVertex(laneletOrArea);
+  if (!vertex) {
+    return {};
+  }
+  return graph_->conflictZones(*vertex);
+}
+
 ConstLanelets RoutingGraph::reachableSet(const ConstLanelet& lanelet, double maxRoutingCost,
                                          RoutingCostId routingCostId, bool allowLaneChanges) const {
   auto start = graph_->getVertex(lanelet);
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  return reachableSetImpl<false, ConstLanelet>(*start, graph, StopIfCostMoreThan<true>{maxRoutingCost});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  return reachableSetImpl<false, ConstLanelet>(*start, graph, graph_->get(), StopIfCostMoreThan<true>{maxRoutingCost});
 }
 
 ConstLaneletOrAreas RoutingGraph::reachableSetIncludingAreas(const ConstLaneletOrArea& llOrAr, double maxRoutingCost,
@@ -536,8 +704,9 @@ ConstLaneletOrAreas RoutingGraph::reachableSetIncludingAreas(const ConstLaneletO
   if (!start) {
     return {};
   }
-  auto graph = graph_->withAreasAndLaneChanges(routingCostId);
-  return reachableSetImpl<false, ConstLaneletOrArea>(*start, graph, StopIfCostMoreThan<true>{maxRoutingCost});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, true, true);
+  return reachableSetImpl<false, ConstLaneletOrArea>(*start, graph, graph_->get(),
+                                                     StopIfCostMoreThan<true>{maxRoutingCost});
 }
 
 ConstLanelets RoutingGraph::reachableSetTowards(const ConstLanelet& lanelet, double maxRoutingCost,
@@ -546,8 +715,13 @@ ConstLanelets RoutingGraph::reachableSetTowards(const ConstLanelet& lanelet, dou
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  return reachableSetImpl<true, ConstLanelet>(*start, graph, StopIfCostMoreThan<true>{maxRoutingCost});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  return reachableSetImpl<true, ConstLanelet>(*start, graph, graph_->get(), StopIfCostMoreThan<true>{maxRoutingCost});
+}
+
+ReachableSetHorizon RoutingGraph::reachableSetHorizon(double maxRoutingCost, RoutingCostId routingCostId,
+                                                      bool allowLaneChanges) const {
+  return {*graph_, *costOverlay_, maxRoutingCost, routingCostId, allowLaneChanges};
 }
 
 LaneletPaths RoutingGraph::possiblePaths(const ConstLanelet& startPoint, double minRoutingCost,
@@ -556,8 +730,8 @@ LaneletPaths RoutingGraph::possiblePaths(const ConstLanelet& startPoint, double
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  return possiblePathsImpl<false, ConstLanelet, LaneletPath>(*start, graph, StopIfCostMoreThan<>{minRoutingCost});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  return possiblePathsImpl<false, LaneletPathTree>(*start, graph, graph_->get(), StopIfCostMoreThan<>{minRoutingCost});
 }
 
 LaneletPaths RoutingGraph::possiblePaths(const ConstLanelet& startPoint, uint32_t minLanelets, bool allowLaneChanges,
@@ -566,8 +740,8 @@ LaneletPaths RoutingGraph::possiblePaths(const ConstLanelet& startPoint, uint32_
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  return possiblePathsImpl<false, ConstLanelet, LaneletPath>(*start, graph, StopIfLaneletsMoreThan<>{minLanelets});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  return possiblePathsImpl<false, LaneletPathTree>(*start, graph, graph_->get(), StopIfLaneletsMoreThan<>{minLanelets});
 }
 
 LaneletPaths RoutingGraph::possiblePathsTowards(const ConstLanelet& targetLanelet, double minRoutingCost,
@@ -576,8 +750,8 @@ LaneletPaths RoutingGraph::possiblePathsTowards(const ConstLanelet& targetLanele
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  return possiblePathsImpl<true, ConstLanelet, LaneletPath>(*start, graph, StopIfCostMoreThan<>{minRoutingCost});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  return possiblePathsImpl<true, LaneletPathTree>(*start, graph, graph_->get(), StopIfCostMoreThan<>{minRoutingCost});
 }
 
 LaneletPaths RoutingGraph::possiblePathsTowards(const ConstLanelet& targetLanelet, uint32_t minLanelets,
@@ -586,8 +760,8 @@ LaneletPaths RoutingGraph::possiblePathsTowards(const ConstLanelet& targetLanele
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  return possiblePathsImpl<true, ConstLanelet, LaneletPath>(*start, graph, StopIfLaneletsMoreThan<>{minLanelets});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  return possiblePathsImpl<true, LaneletPathTree>(*start, graph, graph_->get(), StopIfLaneletsMoreThan<>{minLanelets});
 }
 
 LaneletOrAreaPaths RoutingGraph::possiblePathsIncludingAreas(const ConstLaneletOrArea& startPoint,
@@ -597,10 +771,9 @@ LaneletOrAreaPaths RoutingGraph::possiblePathsIncludingAreas(const ConstLaneletO
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withAreasAndLaneChanges(routingCostId)
-                                : graph_->withAreasWithoutLaneChanges(routingCostId);
-  return possiblePathsImpl<false, ConstLaneletOrArea, LaneletOrAreaPath>(*start, graph,
-                                                                         StopIfCostMoreThan<>{minRoutingCost});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, true);
+  return possiblePathsImpl<false, LaneletOrAreaPathTree>(*start, graph, graph_->get(),
+                                                         StopIfCostMoreThan<>{minRoutingCost});
 }
 
 LaneletOrAreaPaths RoutingGraph::possiblePathsIncludingAreas(const ConstLaneletOrArea& startPoint, uint32_t minElements,
@@ -609,10 +782,83 @@ LaneletOrAreaPaths RoutingGraph::possiblePathsIncludingAreas(const ConstLaneletO
   if (!start) {
     return {};
   }
-  auto graph = allowLaneChanges ? graph_->withAreasAndLaneChanges(routingCostId)
-                                : graph_->withAreasWithoutLaneChanges(routingCostId);
-  return possiblePathsImpl<false, ConstLaneletOrArea, LaneletOrAreaPath>(*start, graph,
-                                                                         StopIfLaneletsMoreThan<>{minElements});
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, true);
+  return possiblePathsImpl<false, LaneletOrAreaPathTree>(*start, graph, graph_->get(),
+                                                         StopIfLaneletsMoreThan<>{minElements});
+}
+
+LaneletPathTree RoutingGraph::possiblePathTree(const ConstLanelet& startPoint, double minRoutingCost,
+                                               RoutingCostId routingCostId, bool allowLaneChanges,
+                                               const LaneletVisitFunction& prune) const {
+  auto start = graph_->getVertex(startPoint);
+  if (!start) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  auto stop = withPruning<LaneletVisitInformation>(StopIfCostMoreThan<>{minRoutingCost}, prune, graph_->get());
+  return possiblePathTreeImpl<false, LaneletPathTree>(*start, graph, graph_->get(), stop);
+}
+
+LaneletPathTree RoutingGraph::possiblePathTree(const ConstLanelet& startPoint, uint32_t minLanelets,
+                                               bool allowLaneChanges, RoutingCostId routingCostId,
+                                               const LaneletVisitFunction& prune) const {
+  auto start = graph_->getVertex(startPoint);
+  if (!start) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  auto stop = withPruning<LaneletVisitInformation>(StopIfLaneletsMoreThan<>{minLanelets}, prune, graph_->get());
+  return possiblePathTreeImpl<false, LaneletPathTree>(*start, graph, graph_->get(), stop);
+}
+
+LaneletPathTree RoutingGraph::possiblePathTreeTowards(const ConstLanelet& targetLanelet, double minRoutingCost,
+                                                      RoutingCostId routingCostId, bool allowLaneChanges,
+                                                      const LaneletVisitFunction& prune) const {
+  auto start = graph_->getVertex(targetLanelet);
+  if (!start) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  auto stop = withPruning<LaneletVisitInformation>(StopIfCostMoreThan<>{minRoutingCost}, prune, graph_->get());
+  return possiblePathTreeImpl<true, LaneletPathTree>(*start, graph, graph_->get(), stop);
+}
+
+LaneletPathTree RoutingGraph::possiblePathTreeTowards(const ConstLanelet& targetLanelet, uint32_t minLanelets,
+                                                      bool allowLaneChanges, RoutingCostId routingCostId,
+                                                      const LaneletVisitFunction& prune) const {
+  auto start = graph_->getVertex(targetLanelet);
+  if (!start) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  auto stop = withPruning<LaneletVisitInformation>(StopIfLaneletsMoreThan<>{minLanelets}, prune, graph_->get());
+  return possiblePathTreeImpl<true, LaneletPathTree>(*start, graph, graph_->get(), stop);
+}
+
+LaneletOrAreaPathTree RoutingGraph::possiblePathTreeIncludingAreas(const ConstLaneletOrArea& startPoint,
+                                                                   double minRoutingCost, RoutingCostId routingCostId,
+                                                                   bool allowLaneChanges,
+                                                                   const LaneletOrAreaVisitFunction& prune) const {
+  auto start = graph_->getVertex(startPoint);
+  if (!start) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, true);
+  auto stop = withPruning<LaneletOrAreaVisitInformation>(StopIfCostMoreThan<>{minRoutingCost}, prune, graph_->get());
+  return possiblePathTreeImpl<false, LaneletOrAreaPathTree>(*start, graph, graph_->get(), stop);
+}
+
+LaneletOrAreaPathTree RoutingGraph::possiblePathTreeIncludingAreas(const ConstLaneletOrArea& startPoint,
+                                                                   uint32_t minElements, bool allowLaneChanges,
+                                                                   RoutingCostId routingCostId,
+                                                                   const LaneletOrAreaVisitFunction& prune) const {
+  auto start = graph_->getVertex(startPoint);
+  if (!start) {
+    return {};
+  }
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, true);
+  auto stop = withPruning<LaneletOrAreaVisitInformation>(StopIfLaneletsMoreThan<>{minElements}, prune, graph_->get());
+  return possiblePathTreeImpl<false, LaneletOrAreaPathTree>(*start, graph, graph_->get(), stop);
 }
 
 void RoutingGraph::forEachSuccessor(const ConstLanelet& lanelet, const LaneletVisitFunction& f, bool allowLaneChanges,
@@ -621,8 +867,8 @@ void RoutingGraph::forEachSuccessor(const ConstLanelet& lanelet, const LaneletVi
   if (!start) {
     return;
   }
-  auto graph = allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  DijkstraStyleSearch<FilteredRoutingGraph> search(graph);
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  auto search = graph.search();
   search.query(*start, [&](const VertexVisitInformation& i) -> bool {
     return f(LaneletVisitInformation{graph_->get()[i.vertex].lanelet(), graph_->get()[i.predecessor].lanelet(), i.cost,
                                      i.length, i.numLaneChanges});
@@ -636,9 +882,8 @@ void RoutingGraph::forEachSuccessorIncludingAreas(const ConstLaneletOrArea& lane
   if (!start) {
     return;
   }
-  auto graph = allowLaneChanges ? graph_->withAreasAndLaneChanges(routingCostId)
-                                : graph_->withAreasWithoutLaneChanges(routingCostId);
-  DijkstraStyleSearch<FilteredRoutingGraph> search(graph);
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, true);
+  auto search = graph.search();
   search.query(*start, [&](const VertexVisitInformation& i) -> bool {
     return f(LaneletOrAreaVisitInformation{graph_->get()[i.vertex].laneletOrArea,
                                            graph_->get()[i.predecessor].laneletOrArea, i.cost, i.length,
@@ -652,10 +897,8 @@ void RoutingGraph::forEachPredecessor(const ConstLanelet& lanelet, const Lanelet
   if (!start) {
     return;
   }
-  auto forwGraph =
-      allowLaneChanges ? graph_->withLaneChanges(routingCostId) : graph_->withoutLaneChanges(routingCostId);
-  auto graph = boost::make_reverse_graph(forwGraph);  // forwGraph needs to stay on the stack
-  internal::DijkstraStyleSearch<decltype(graph)> search(graph);
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, false);
+  auto search = graph.search<true>();
   search.query(*start, [&](const VertexVisitInformation& i) -> bool {
     return f(LaneletVisitInformation{graph_->get()[i.vertex].lanelet(), graph_->get()[i.predecessor].lanelet(), i.cost,
                                      i.length, i.numLaneChanges});
@@ -669,10 +912,8 @@ void RoutingGraph::forEachPredecessorIncludingAreas(const ConstLaneletOrArea& la
   if (!start) {
     return;
   }
-  auto forwGraph = allowLaneChanges ? graph_->withAreasAndLaneChanges(routingCostId)
-                                    : graph_->withAreasWithoutLaneChanges(routingCostId);
-  auto graph = boost::make_reverse_graph(forwGraph);  // forwGraph needs to stay on the stack
-  internal::DijkstraStyleSearch<decltype(graph)> search(graph);
+  auto graph = searchGraph(*graph_, *costOverlay_, routingCostId, allowLaneChanges, true);
+  auto search = graph.search<true>();
   search.query(*start, [&](const VertexVisitInformation& i) -> bool {
     return f(LaneletOrAreaVisitInformation{graph_->get()[i.vertex].laneletOrArea,
                                            graph_->get()[i.predecessor].laneletOrArea, i.cost, i.length,
@@ -732,10 +973,9 @@ class DebugMapBuilder {
  public:
   using LaneletOrAreaPair = std::pair<ConstLaneletOrArea, ConstLaneletOrArea>;
   explicit DebugMapBuilder(const FilteredRoutingGraph& graph) : graph_{graph} {}
-  LaneletMapPtr run(const internal::LaneletOrAreaToVertex& loa) {
-    LaneletMapPtr output = std::make_shared<LaneletMap>();
-    for (const auto& vertex : loa) {
-      visitVertex(vertex);
+  LaneletMapPtr run() {
+    for (auto vertices = boost::vertices(graph_); vertices.first != vertices.second; ++vertices.first) {
+      visitVertex(*vertices.first);
     }
     auto lineStrings = utils::transform(lineStringMap_, [](auto& mapLs) { return mapLs.second; });
     auto map = utils::createMap(lineStrings);
@@ -746,14 +986,15 @@ class DebugMapBuilder {
   }
 
  private:
-  void visitVertex(const internal::LaneletOrAreaToVertex::value_type& vertex) {
-    addPoint(vertex.first);
-    auto edges = boost::out_edges(vertex.second, graph_);
+  void visitVertex(FilteredRoutingGraph::vertex_descriptor vertex) {
+    const auto& source = graph_[vertex].laneletOrArea;
+    addPoint(source);
+    auto edges = boost::out_edges(vertex, graph_);
     for (auto edge = edges.first; edge != edges.second; ++edge) {
       const auto& target = graph_[boost::target(*edge, graph_)].laneletOrArea;
       addPoint(target);
       const auto& edgeInfo = graph_[*edge];
-      addEdge(vertex.first, target, edgeInfo);
+      addEdge(source, target, edgeInfo);
     }
   }
 
@@ -796,15 +1037,15 @@ LaneletMapPtr RoutingGraph::getDebugLaneletMap(RoutingCostId routingCostId, bool
   internal::EdgeCostFilter<GraphType> edgeFilter(
       graph_->get(), routingCostId, allowedRelationsfromConfiguration(includeAdjacent, includeConflicting));
   FilteredRoutingGraph filteredGraph(graph_->get(), edgeFilter);
-  return DebugMapBuilder(filteredGraph).run(graph_->vertexLookup());
+  return DebugMapBuilder(filteredGraph).run();
 }
 
 RoutingGraph::Errors RoutingGraph::checkValidity(bool throwOnError) const {
   Errors errors;
-  for (const auto& laWithVertex : graph_->vertexLookup()) {
-    const auto& la = laWithVertex.first;
-    auto ll = laWithVertex.first.lanelet();
-    const auto& vertex = laWithVertex.second;
+  for (auto vertices = boost::vertices(graph_->get()); vertices.first != vertices.second; ++vertices.first) {
+    const auto vertex = *vertices.first;
+    const auto& la = graph_->get()[vertex].laneletOrArea;
+    auto ll = la.lanelet();
     auto id = la.id();
     // Check left relation
     Optional<ConstLanelet> left;
@@ -898,7 +1139,36 @@ RoutingGraph::Errors RoutingGraph::checkValidity(bool throwOnError) const {
 }
 
 RoutingGraph::RoutingGraph(std::unique_ptr<RoutingGraphGraph>&& graph, LaneletSubmapConstPtr&& passableMap)
-    : graph_{std::move(graph)}, passableLaneletSubmap_{std::move(passableMap)} {}
+    : graph_{std::move(graph)},
+      passableLaneletSubmap_{std::move(passableMap)},
+      costOverlay_{std::make_unique<internal::CostOverlayState>()},
+      timeDependentCosts_{std::make_unique<internal::TimeDependentCostState>()} {}
+
+void RoutingGraph::setCostOverlay(RoutingCostOverlay overlay) {
+  costOverlay_->update(graph_->get(), [&overlay](RoutingCostOverlay& current) { current = std::move(overlay); });
+}
+
+void RoutingGraph::updateCostOverlay(const std::function<void(RoutingCostOverlay&)>& update) {
+  costOverlay_->update(graph_->get(), update);
+}
+
+RoutingCostOverlay RoutingGraph::costOverlay() const {
+  auto overlay = costOverlay_->load();
+  return !!overlay ? overlay->overlay() : RoutingCostOverlay{};
+}
+
+void RoutingGraph::setTimeDependentCosts(TimeDependentCosts costs) {
+  timeDependentCosts_->update(graph_->get(), [&costs](TimeDependentCosts& current) { current = std::move(costs); });
+}
+
+void RoutingGraph::updateTimeDependentCosts(const std::function<void(TimeDependentCosts&)>& update) {
+  timeDependentCosts_->update(graph_->get(), update);
+}
+
+TimeDependentCosts RoutingGraph::timeDependentCosts() const {
+  auto costs = timeDependentCosts_->load();
+  return !!costs ? costs->overlay() : TimeDependentCosts{};
+}
 
 }  // namespace routing
 }  // namespace lanelet
@@ -2,6 +2,11 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_core/geometry/Area.h>
 #include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/geometry/Polygon.h>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <algorithm>
+#include <numeric>
 #include <unordered_map>
 #include "lanelet2_routing/Exceptions.h"
 #include "lanelet2_routing/RoutingGraph.h"
@@ -12,6 +17,73 @@ namespace routing {
 namespace internal {
 namespace {
 inline IdPair orderedIdPair(const Id id1, const Id id2) { return (id1 < id2) ? IdPair(id1, id2) : IdPair(id2, id1); }
+
+//! Adds the first and last points of a lanelet to the search index
+void addPointsToSearchIndex(RoutingTopology::PointsLaneletMap& pointsToLanelets, const ConstLanelet& ll) {
+  using PointLaneletPair = std::pair<IdPair, ConstLanelet>;
+  pointsToLanelets.insert(
+      PointLaneletPair(orderedIdPair(ll.leftBound().front().id(), ll.rightBound().front().id()), ll));
+  pointsToLanelets.insert(PointLaneletPair(orderedIdPair(ll.leftBound().back().id(), ll.rightBound().back().id()), ll));
+  pointsToLanelets.insert(PointLaneletPair(orderedIdPair(ll.leftBound().front().id(), ll.leftBound().back().id()), ll));
+  pointsToLanelets.insert(
+      PointLaneletPair(orderedIdPair(ll.rightBound().front().id(), ll.rightBound().back().id()), ll));
+}
+
+//! The topology stores lanelets only in their original direction
+ConstLaneletOrArea originalDirection(const ConstLaneletOrArea& laneletOrArea) {
+  auto lanelet = laneletOrArea.lanelet();
+  if (lanelet && lanelet->inverted()) {
+    return lanelet->invert();
+  }
+  return laneletOrArea;
+}
+
+//! Looks up whether two primitives overlap if this was computed before with the primitives in the opposite order
+template <typename PrimitiveT>
+Optional<bool> knownOverlap(const std::vector<PrimitiveT>& nearby, const std::vector<bool>& overlaps,
+                            const PrimitiveT& primitive) {
+  auto it = std::find(nearby.begin(), nearby.end(), primitive);
+  if (it == nearby.end()) {
+    return {};
+  }
+  return bool(overlaps[size_t(std::distance(nearby.begin(), it))]);
+}
+
+//! Keeps only the lanelets or areas that are part of the passable layer
+template <typename PrimitiveT, typename LayerT>
+std::vector<PrimitiveT> passableOnly(const std::vector<PrimitiveT>& primitives, const LayerT& passableLayer) {
+  std::vector<PrimitiveT> passable;
+  passable.reserve(primitives.size());
+  std::copy_if(primitives.begin(), primitives.end(), std::back_inserter(passable),
+               [&](const PrimitiveT& primitive) { return passableLayer.exists(primitive.id()); });
+  return passable;
+}
+
+BasicPolygonWithHoles2d polygonWithHoles2d(const ConstLaneletOrArea& laneletOrArea) {
+  BasicPolygonWithHoles2d polygon;
+  if (laneletOrArea.isLanelet()) {
+    polygon.outer = laneletOrArea.lanelet()->polygon2d().basicPolygon();
+  } else {
+    polygon = laneletOrArea.area()->basicPolygonWithHoles2d();
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+//! Orders the crossings of a zone by their distance along the centerline of the zone's lanelet
+void sortCrossings(ConflictZone& zone) {
+  std::vector<size_t> order(zone.crossings.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&](size_t lhs, size_t rhs) { return zone.arcLengths[lhs] < zone.arcLengths[rhs]; });
+  ConflictZone sorted{zone.laneletOrArea, zone.conflicting, std::move(zone.overlap), {}, {}, {}};
+  for (auto i : order) {
+    sorted.crossings.push_back(zone.crossings[i]);
+    sorted.arcLengths.push_back(zone.arcLengths[i]);
+    sorted.otherArcLengths.push_back(zone.otherArcLengths[i]);
+  }
+  zone = std::move(sorted);
+}
 }  // namespace
 
 //! This class collects lane changable lanelets and combines them to a sequence of adjacent lanechangable lanelets
@@ -81,6 +153,98 @@ class LaneChangeLaneletsCollector {
   LaneChangeMap::iterator currPos_{laneChanges_.end()};
 };
 
+RoutingTopology::RoutingTopology(const LaneletMapLayers& laneletMapLayers)
+    : lanelets_(laneletMapLayers.laneletLayer.begin(), laneletMapLayers.laneletLayer.end()),
+      areas_(laneletMapLayers.areaLayer.begin(), laneletMapLayers.areaLayer.end()),
+      neighbourhoods_(lanelets_.size() + areas_.size()) {
+  for (auto i = 0u; i < lanelets_.size(); ++i) {
+    index_.insert(lanelets_[i].id(), i);
+    addPointsToSearchIndex(pointsToLanelets_, lanelets_[i]);
+    addPointsToSearchIndex(pointsToLanelets_, lanelets_[i].invert());
+  }
+  for (auto i = 0u; i < areas_.size(); ++i) {
+    index_.insert(areas_[i].id(), std::uint32_t(lanelets_.size() + i));
+  }
+  // overlaps2d is symmetric, every pair is only computed once
+  for (auto i = 0u; i < lanelets_.size(); ++i) {
+    auto& neighbourhood = neighbourhoods_[i];
+    neighbourhood.lanelets = laneletMapLayers.laneletLayer.search(geometry::boundingBox2d(lanelets_[i]));
+    for (auto& nearby : neighbourhood.lanelets) {
+      const auto nearbyIdx = *index(nearby);
+      const auto& other = neighbourhoods_[nearbyIdx];
+      auto known =
+          nearbyIdx < i ? knownOverlap(other.lanelets, other.laneletOverlaps, lanelets_[i]) : Optional<bool>{};
+      neighbourhood.laneletOverlaps.push_back(known ? *known : geometry::overlaps2d(lanelets_[i], nearby));
+    }
+  }
+  for (auto i = 0u; i < areas_.size(); ++i) {
+    const auto& area = areas_[i];
+    auto& neighbourhood = neighbourhoods_[lanelets_.size() + i];
+    neighbourhood.lanelets = laneletMapLayers.laneletLayer.search(geometry::boundingBox2d(area));
+    for (auto& nearby : neighbourhood.lanelets) {
+      neighbourhood.laneletOverlaps.push_back(geometry::overlaps2d(area, nearby));
+    }
+    neighbourhood.areas = laneletMapLayers.areaLayer.search(geometry::boundingBox2d(area));
+    for (auto& nearby : neighbourhood.areas) {
+      const auto nearbyIdx = *index(nearby);
+      const auto& other = neighbourhoods_[nearbyIdx];
+      auto known =
+          nearbyIdx < lanelets_.size() + i ? knownOverlap(other.areas, other.areaOverlaps, area) : Optional<bool>{};
+      neighbourhood.areaOverlaps.push_back(known ? *known : geometry::overlaps2d(area, nearby));
+    }
+  }
+}
+
+Optional<size_t> RoutingTopology::index(const ConstLaneletOrArea& laneletOrArea) const {
+  Optional<std::uint32_t> idx;
+  if (laneletOrArea.isLanelet()) {
+    // compares the data, so that both directions of a lanelet are found
+    const auto& lanelet = static_cast<const ConstLanelet&>(laneletOrArea);
+    idx = index_.find(lanelet.id(), [&](std::uint32_t i) {
+      return i < lanelets_.size() && lanelets_[i].constData() == lanelet.constData();
+    });
+  } else {
+    const auto& area = static_cast<const ConstArea&>(laneletOrArea);
+    idx = index_.find(area.id(),
+                      [&](std::uint32_t i) { return i >= lanelets_.size() && areas_[i - lanelets_.size()] == area; });
+  }
+  if (!idx) {
+    return {};
+  }
+  return size_t(*idx);
+}
+
+const RoutingTopology::Neighbourhood* RoutingTopology::neighbourhood(const ConstLaneletOrArea& laneletOrArea) const {
+  auto idx = index(laneletOrArea);
+  return idx ? &neighbourhoods_[*idx] : nullptr;
+}
+
+const ConstLanelets& RoutingTopology::nearbyLanelets(const ConstLaneletOrArea& laneletOrArea) const {
+  static const ConstLanelets NoLanelets;
+  const auto* neighbours = neighbourhood(laneletOrArea);
+  return neighbours != nullptr ? neighbours->lanelets : NoLanelets;
+}
+
+const ConstAreas& RoutingTopology::nearbyAreas(const ConstArea& area) const {
+  static const ConstAreas NoAreas;
+  const auto* neighbours = neighbourhood(area);
+  return neighbours != nullptr ? neighbours->areas : NoAreas;
+}
+
+bool RoutingTopology::overlaps2d(const ConstLaneletOrArea& laneletOrArea, const ConstLaneletOrArea& nearby) const {
+  const auto* neighbours = neighbourhood(laneletOrArea);
+  if (neighbours == nullptr) {
+    return false;
+  }
+  Optional<bool> overlaps;
+  if (nearby.isLanelet()) {
+    overlaps = knownOverlap(neighbours->lanelets, neighbours->laneletOverlaps, *originalDirection(nearby).lanelet());
+  } else {
+    overlaps = knownOverlap(neighbours->areas, neighbours->areaOverlaps, *nearby.area());
+  }
+  return overlaps && *overlaps;
+}
+
 RoutingGraphBuilder::RoutingGraphBuilder(const traffic_rules::TrafficRules& trafficRules,
                                          const RoutingCostPtrs& routingCosts, const RoutingGraph::Configuration& config)
     : graph_{std::make_unique<RoutingGraphGraph>(routingCosts.size())},
@@ -89,18 +253,46 @@ RoutingGraphBuilder::RoutingGraphBuilder(const traffic_rules::TrafficRules& traf
       config_{config} {}
 
 RoutingGraphUPtr RoutingGraphBuilder::build(const LaneletMapLayers& laneletMapLayers) {
-  auto passableLanelets = getPassableLanelets(laneletMapLayers.laneletLayer, trafficRules_);
-  auto passableAreas = getPassableAreas(laneletMapLayers.areaLayer, trafficRules_);
+  return build(getPassableLanelets(laneletMapLayers.laneletLayer, trafficRules_),
+               getPassableAreas(laneletMapLayers.areaLayer, trafficRules_));
+}
+
+RoutingGraphUPtr RoutingGraphBuilder::build(const RoutingTopology& topology) {
+  topology_ = &topology;
+  return build(getPassableLanelets(topology.lanelets(), trafficRules_),
+               getPassableAreas(topology.areas(), trafficRules_));
+}
+
+std::unique_ptr<RoutingGraphGraph> RoutingGraphBuilder::buildGraph(const LaneletMapLayers& laneletMapLayers) {
+  addToGraph(getPassableLanelets(laneletMapLayers.laneletLayer, trafficRules_),
+             getPassableAreas(laneletMapLayers.areaLayer, trafficRules_));
+  return std::move(graph_);
+}
+
+std::unique_ptr<RoutingGraphGraph> RoutingGraphBuilder::buildGraph(const RoutingTopology& topology) {
+  topology_ = &topology;
+  addToGraph(getPassableLanelets(topology.lanelets(), trafficRules_),
+             getPassableAreas(topology.areas(), trafficRules_));
+  return std::move(graph_);
+}
+
+RoutingGraphUPtr RoutingGraphBuilder::build(ConstLanelets passableLanelets, ConstAreas passableAreas) {
+  LaneletSubmapConstPtr passableMap = addToGraph(std::move(passableLanelets), std::move(passableAreas));
+  return std::make_unique<RoutingGraph>(std::move(graph_), std::move(passableMap));
+}
+
+LaneletSubmapConstUPtr RoutingGraphBuilder::addToGraph(ConstLanelets passableLanelets, ConstAreas passableAreas) {
   auto passableMap = utils::createConstSubmap(passableLanelets, passableAreas);
   appendBidirectionalLanelets(passableLanelets);
   addLaneletsToGraph(passableLanelets);
   addAreasToGraph(passableAreas);
   addEdges(passableLanelets, passableMap->laneletLayer);
   addEdges(passableAreas, passableMap->laneletLayer, passableMap->areaLayer);
-  return std::make_unique<RoutingGraph>(std::move(graph_), std::move(passableMap));
+  return passableMap;
 }
 
-ConstLanelets RoutingGraphBuilder::getPassableLanelets(const LaneletLayer& lanelets,
+template <typename LaneletsT>
+ConstLanelets RoutingGraphBuilder::getPassableLanelets(const LaneletsT& lanelets,
                                                        const traffic_rules::TrafficRules& trafficRules) {
   ConstLanelets llts;
   llts.reserve(lanelets.size());
@@ -109,8 +301,8 @@ ConstLanelets RoutingGraphBuilder::getPassableLanelets(const LaneletLayer& lanel
   return llts;
 }
 
-ConstAreas RoutingGraphBuilder::getPassableAreas(const AreaLayer& areas,
-                                                 const traffic_rules::TrafficRules& trafficRules) {
+template <typename AreasT>
+ConstAreas RoutingGraphBuilder::getPassableAreas(const AreasT& areas, const traffic_rules::TrafficRules& trafficRules) {
   ConstAreas ars;
   ars.reserve(areas.size());
   std::copy_if(areas.begin(), areas.end(), std::back_inserter(ars),
@@ -132,7 +324,9 @@ void RoutingGraphBuilder::appendBidirectionalLanelets(ConstLanelets& llts) {
 void RoutingGraphBuilder::addLaneletsToGraph(ConstLanelets& llts) {
   for (auto& ll : llts) {
     graph_->addVertex(VertexInfo{ll});
-    addPointsToSearchIndex(ll);
+    if (topology_ == nullptr) {
+      addPointsToSearchIndex(pointsToLanelets_, ll);
+    }
   }
 }
 
@@ -167,25 +361,14 @@ void RoutingGraphBuilder::addEdges(const ConstAreas& areas, const LaneletLayer&
 }
 
 void RoutingGraphBuilder::addFollowingEdges(const ConstLanelet& ll) {
-  auto endPointsLanelets =
-      pointsToLanelets_.equal_range(orderedIdPair(ll.leftBound().back().id(), ll.rightBound().back().id()));
+  auto endPointsLanelets = laneletsAt(orderedIdPair(ll.leftBound().back().id(), ll.rightBound().back().id()));
   // Following
   ConstLanelets following;
   std::for_each(endPointsLanelets.first, endPointsLanelets.second, [&ll, this, &following](auto it) {
-    if (geometry::follows(ll, it.second) && this->trafficRules_.canPass(ll, it.second)) {
+    if (geometry::follows(ll, it.second) && this->isVertex(it.second) && this->trafficRules_.canPass(ll, it.second)) {
       following.push_back(it.second);
     }
   });
-  if (following.empty()) {
-    return;
-  }
-  // find out if there are several previous merging lanelets
-  ConstLanelets merging;
-  std::for_each(endPointsLanelets.first, endPointsLanelets.second, [&following, this, &merging](auto it) {
-    if (geometry::follows(it.second, following.front()) && this->trafficRules_.canPass(it.second, following.front())) {
-      merging.push_back(it.second);
-    }
-  });
   RelationType relation = RelationType::Successor;
   for (auto& followingIt : following) {
     assignCosts(ll, followingIt, relation);
@@ -197,9 +380,9 @@ void RoutingGraphBuilder::addSidewayEdge(LaneChangeLaneletsCollector& laneChange
   auto directlySideway = [&relation, &ll](const ConstLanelet& sideLl) {
     return relation == RelationType::AdjacentLeft ? geometry::leftOf(sideLl, ll) : geometry::rightOf(sideLl, ll);
   };
-  auto sideOf = pointsToLanelets_.equal_range(orderedIdPair(bound.front().id(), bound.back().id()));
+  auto sideOf = laneletsAt(orderedIdPair(bound.front().id(), bound.back().id()));
   for (auto it = sideOf.first; it != sideOf.second; ++it) {
-    if (ll != it->second && !hasEdge(ll, it->second) && directlySideway(it->second)) {
+    if (ll != it->second && isVertex(it->second) && !hasEdge(ll, it->second) && directlySideway(it->second)) {
       if (trafficRules_.canChangeLane(ll, it->second)) {
         // we process lane changes later, when we know all lanelets that can participate in lane change
         laneChangeLanelets.add(ll, it->second);
@@ -212,13 +395,16 @@ void RoutingGraphBuilder::addSidewayEdge(LaneChangeLaneletsCollector& laneChange
 
 void RoutingGraphBuilder::addConflictingEdge(const ConstLanelet& ll, const LaneletLayer& passableLanelets) {
   // Conflicting
-  ConstLanelets results = passableLanelets.search(geometry::boundingBox2d(ll));
+  ConstLanelets results = nearbyLanelets(ll, passableLanelets);
   ConstLanelet other;
   for (auto& result : results) {
     if (bothWaysLaneletIds_.find(ll.id()) != bothWaysLaneletIds_.end() && result == ll) {
       other = result.invert();
       assignCosts(ll, other, RelationType::Conflicting);
       assignCosts(other, ll, RelationType::Conflicting);
+      if (computeConflictZones()) {
+        addConflictZone(ll, other);
+      }
       continue;
     }
     other = result;
@@ -229,10 +415,12 @@ void RoutingGraphBuilder::addConflictingEdge(const ConstLanelet& ll, const Lanel
     if (!vertex || result == ll) {
       continue;
     }
-    auto maxHeight = participantHeight();
-    if ((maxHeight && geometry::overlaps3d(ll, other, *maxHeight)) || (!maxHeight && geometry::overlaps2d(ll, other))) {
+    if (overlaps(ll, other)) {
       assignCosts(ll, other, RelationType::Conflicting);
       assignCosts(other, ll, RelationType::Conflicting);
+      if (computeConflictZones()) {
+        addConflictZone(ll, other);
+      }
     }
   }
 }
@@ -263,7 +451,7 @@ void RoutingGraphBuilder::addLaneChangeEdges(LaneChangeLaneletsCollector& laneCh
 }
 
 void RoutingGraphBuilder::addAreaEdge(const ConstArea& area, const LaneletLayer& passableLanelets) {
-  auto candidates = passableLanelets.search(geometry::boundingBox2d(area));
+  auto candidates = nearbyLanelets(area, passableLanelets);
   for (auto& candidate : candidates) {
     bool canPass = false;
     if (trafficRules_.canPass(area, candidate)) {
@@ -285,16 +473,17 @@ void RoutingGraphBuilder::addAreaEdge(const ConstArea& area, const LaneletLayer&
     if (canPass) {
       continue;
     }
-    auto maxHeight = participantHeight();
-    if ((maxHeight && geometry::overlaps3d(area, candidate, *maxHeight)) ||
-        (!maxHeight && geometry::overlaps2d(area, candidate))) {
+    if (overlaps(area, candidate)) {
       assignCosts(candidate, area, RelationType::Conflicting);
+      if (computeConflictZones()) {
+        addConflictZone(candidate, area);
+      }
     }
   }
 }
 
 void RoutingGraphBuilder::addAreaEdge(const ConstArea& area, const AreaLayer& passableAreas) {
-  auto candidates = passableAreas.search(geometry::boundingBox2d(area));
+  auto candidates = nearbyAreas(area, passableAreas);
   for (auto& candidate : candidates) {
     if (candidate == area) {
       continue;
@@ -303,10 +492,11 @@ void RoutingGraphBuilder::addAreaEdge(const ConstArea& area, const AreaLayer& pa
       assignCosts(area, candidate, RelationType::Area);
       continue;
     }
-    auto maxHeight = participantHeight();
-    if ((maxHeight && geometry::overlaps3d(ConstArea(area), candidate, *maxHeight)) ||
-        (!maxHeight && geometry::overlaps2d(ConstArea(area), candidate))) {
+    if (overlaps(area, candidate)) {
       assignCosts(candidate, area, RelationType::Conflicting);
+      if (computeConflictZones()) {
+        addConflictZone(candidate, area);
+      }
     }
   }
 }
@@ -319,16 +509,76 @@ Optional<double> RoutingGraphBuilder::participantHeight() const {
   return {};
 }
 
-void RoutingGraphBuilder::addPointsToSearchIndex(const ConstLanelet& ll) {
-  using PointLaneletPair = std::pair<IdPair, ConstLanelet>;
-  pointsToLanelets_.insert(
-      PointLaneletPair(orderedIdPair(ll.leftBound().front().id(), ll.rightBound().front().id()), ll));
-  pointsToLanelets_.insert(
-      PointLaneletPair(orderedIdPair(ll.leftBound().back().id(), ll.rightBound().back().id()), ll));
-  pointsToLanelets_.insert(
-      PointLaneletPair(orderedIdPair(ll.leftBound().front().id(), ll.leftBound().back().id()), ll));
-  pointsToLanelets_.insert(
-      PointLaneletPair(orderedIdPair(ll.rightBound().front().id(), ll.rightBound().back().id()), ll));
+bool RoutingGraphBuilder::computeConflictZones() const {
+  auto compute = config_.find(RoutingGraph::ComputeConflictZones);
+  return compute != config_.end() && compute->second.asBool().value_or(false);
+}
+
+void RoutingGraphBuilder::addConflictZone(const ConstLaneletOrArea& first, const ConstLaneletOrArea& second) {
+  auto firstVertex = graph_->getVertex(first);
+  auto secondVertex = graph_->getVertex(second);
+  if (!firstVertex || !secondVertex) {
+    return;
+  }
+  const auto& known = graph_->conflictZones(*firstVertex);
+  if (std::any_of(known.begin(), known.end(), [&](const ConflictZone& zone) { return zone.conflicting == second; })) {
+    return;
+  }
+  ConflictZone zone{first, second, {}, {}, {}, {}};
+  boost::geometry::intersection(polygonWithHoles2d(first), polygonWithHoles2d(second), zone.overlap);
+  auto firstLanelet = first.lanelet();
+  auto secondLanelet = second.lanelet();
+  // the centerlines of a lanelet and its inverse overlap entirely, they do not cross
+  if (firstLanelet && secondLanelet && firstLanelet->constData() != secondLanelet->constData()) {
+    zone.crossings =
+        geometry::intersectCenterlines2d(*firstLanelet, *secondLanelet, &zone.arcLengths, &zone.otherArcLengths);
+  }
+  ConflictZone reversed{second, first, zone.overlap, zone.crossings, zone.otherArcLengths, zone.arcLengths};
+  sortCrossings(zone);
+  sortCrossings(reversed);
+  graph_->addConflictZone(*firstVertex, std::move(zone));
+  graph_->addConflictZone(*secondVertex, std::move(reversed));
+}
+
+template <typename PrimitiveT>
+ConstLanelets RoutingGraphBuilder::nearbyLanelets(const PrimitiveT& primitive,
+                                                  const LaneletLayer& passableLanelets) const {
+  if (topology_ != nullptr) {
+    return passableOnly(topology_->nearbyLanelets(primitive), passableLanelets);
+  }
+  return passableLanelets.search(geometry::boundingBox2d(primitive));
+}
+
+ConstAreas RoutingGraphBuilder::nearbyAreas(const ConstArea& area, const AreaLayer& passableAreas) const {
+  if (topology_ != nullptr) {
+    return passableOnly(topology_->nearbyAreas(area), passableAreas);
+  }
+  return passableAreas.search(geometry::boundingBox2d(area));
+}
+
+template <typename Primitive1T, typename Primitive2T>
+bool RoutingGraphBuilder::overlaps(const Primitive1T& first, const Primitive2T& second) const {
+  // overlapping in 3d implies overlapping in 2d, so the topology can rule out most candidates
+  if (topology_ != nullptr && !topology_->overlaps2d(first, second)) {
+    return false;
+  }
+  auto maxHeight = participantHeight();
+  if (maxHeight) {
+    return geometry::overlaps3d(first, second, *maxHeight);
+  }
+  return topology_ != nullptr || geometry::overlaps2d(first, second);
+}
+
+RoutingGraphBuilder::PointsLaneletMapResult RoutingGraphBuilder::laneletsAt(const IdPair& points) const {
+  if (topology_ != nullptr) {
+    return topology_->laneletsAt(points);
+  }
+  return pointsToLanelets_.equal_range(points);
+}
+
+bool RoutingGraphBuilder::isVertex(const ConstLanelet& ll) const {
+  // without a topology, the search index only contains lanelets of the graph
+  return topology_ == nullptr || !!graph_->getVertex(ll);
 }
 
 bool RoutingGraphBuilder::hasEdge(const ConstLanelet& from, const ConstLanelet& to) {
@@ -0,0 +1,135 @@
+#include "lanelet2_routing/TimeDependentCost.h"
+#include <lanelet2_core/Exceptions.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace lanelet {
+namespace routing {
+namespace {
+void checkFinite(double value, const char* what) {
+  if (!std::isfinite(value)) {
+    throw InvalidInputError(std::string(what) + " of a time dependent cost must be finite, but it is " +
+                            std::to_string(value));
+  }
+}
+
+void checkBreakpoints(const TimeDependentCost::Breakpoints& breakpoints) {
+  if (breakpoints.empty()) {
+    throw InvalidInputError("A time dependent cost requires at least one breakpoint");
+  }
+  for (auto it = breakpoints.begin(); it != breakpoints.end(); ++it) {
+    checkFinite(it->first, "Time");
+    checkFinite(it->second, "Value");
+    if (it->second < 0.) {
+      throw InvalidInputError("Values of a time dependent cost must not be negative, but one is " +
+                              std::to_string(it->second));
+    }
+    if (it != breakpoints.begin() && it->first < std::prev(it)->first) {
+      throw InvalidInputError("Breakpoints of a time dependent cost must be sorted by time");
+    }
+  }
+}
+
+template <typename MapT, typename KeyT>
+Optional<TimeDependentCost> find(const MapT& map, const KeyT& key) {
+  auto it = map.find(key);
+  if (it == map.end()) {
+    return {};
+  }
+  return it->second;
+}
+}  // namespace
+
+TimeDependentCost::TimeDependentCost(bool absolute, Breakpoints breakpoints)
+    : absolute_{absolute}, breakpoints_{std::move(breakpoints)} {
+  checkBreakpoints(breakpoints_);
+}
+
+TimeDependentCost TimeDependentCost::multiply(Breakpoints factors) { return {false, std::move(factors)}; }
+
+TimeDependentCost TimeDependentCost::absolute(Breakpoints costs) { return {true, std::move(costs)}; }
+
+TimeDependentCost& TimeDependentCost::block(double begin, double end) {
+  checkFinite(begin, "Begin of a blocked window");
+  checkFinite(end, "End of a blocked window");
+  if (end < begin) {
+    throw InvalidInputError("A blocked window must not end before it begins");
+  }
+  blocked_.emplace_back(begin, end);
+  return *this;
+}
+
+TimeDependentCost& TimeDependentCost::setPeriod(double period) {
+  checkFinite(period, "Period");
+  if (period < 0.) {
+    throw InvalidInputError("The period of a time dependent cost must not be negative");
+  }
+  period_ = period;
+  return *this;
+}
+
+bool TimeDependentCost::isBlocked(double time) const noexcept {
+  const auto t = localTime(time);
+  return std::any_of(blocked_.begin(), blocked_.end(),
+                     [t](const TimeWindow& window) { return window.first <= t && t < window.second; });
+}
+
+double TimeDependentCost::apply(double routingCost, double time) const noexcept {
+  if (isBlocked(time)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const auto value = valueAt(localTime(time));
+  return absolute_ ? value : routingCost * value;
+}
+
+double TimeDependentCost::localTime(double time) const noexcept {
+  if (period_ <= 0.) {
+    return time;
+  }
+  auto t = std::fmod(time, period_);
+  return t < 0. ? t + period_ : t;
+}
+
+double TimeDependentCost::valueAt(double time) const noexcept {
+  if (breakpoints_.empty()) {
+    return 1.;
+  }
+  auto next = std::upper_bound(breakpoints_.begin(), breakpoints_.end(), time,
+                               [](double t, const Breakpoint& breakpoint) { return t < breakpoint.first; });
+  if (next == breakpoints_.begin()) {
+    return next->second;
+  }
+  auto prev = std::prev(next);
+  if (next == breakpoints_.end() || next->first == prev->first) {
+    return prev->second;
+  }
+  const auto ratio = (time - prev->first) / (next->first - prev->first);
+  return prev->second + ratio * (next->second - prev->second);
+}
+
+TimeDependentCosts& TimeDependentCosts::set(Id laneletOrArea, TimeDependentCost cost) {
+  lanelets_[laneletOrArea] = std::move(cost);
+  return *this;
+}
+
+TimeDependentCosts& TimeDependentCosts::set(Id from, Id to, TimeDependentCost cost) {
+  relations_[std::make_pair(from, to)] = std::move(cost);
+  return *this;
+}
+
+bool TimeDependentCosts::reset(Id laneletOrArea) { return lanelets_.erase(laneletOrArea) > 0; }
+
+bool TimeDependentCosts::reset(Id from, Id to) { return relations_.erase(std::make_pair(from, to)) > 0; }
+
+Optional<TimeDependentCost> TimeDependentCosts::get(Id laneletOrArea) const { return find(lanelets_, laneletOrArea); }
+
+Optional<TimeDependentCost> TimeDependentCosts::get(Id from, Id to) const {
+  return find(relations_, std::make_pair(from, to));
+}
+
+}  // namespace routing
+}  // namespace lanelet
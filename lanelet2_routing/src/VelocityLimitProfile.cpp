@@ -0,0 +1,181 @@
+#include "lanelet2_routing/VelocityLimitProfile.h"
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/primitives/BasicRegulatoryElements.h>
+#include <lanelet2_core/primitives/FrenetFrame.h>
+#include <cmath>
+#include "lanelet2_routing/Exceptions.h"
+#include "lanelet2_routing/LaneletPath.h"
+#include "lanelet2_routing/Route.h"
+
+namespace lanelet {
+namespace routing {
+namespace {
+const Velocity Unlimited{std::numeric_limits<double>::infinity() * units::MPS()};
+
+StopPosition stopAt(const FrenetFrame& frame, const ConstLanelet& lanelet, RegulatoryElementConstPtr regelem,
+                    const Optional<ConstLineString3d>& stopLine) {
+  double arcLength = frame.length();
+  if (!!stopLine) {
+    // the vehicle has to stop before any part of the line
+    for (const auto& p : *stopLine) {
+      arcLength = std::min(arcLength, frame.toArcCoordinates(p.basicPoint2d()).length);
+    }
+  }
+  return {arcLength, lanelet, std::move(regelem), stopLine};
+}
+
+std::vector<StopPosition> stopPositionsOn(const FrenetFrame& frame, const ConstLanelet& lanelet) {
+  std::vector<StopPosition> stops;
+  for (const auto& light : lanelet.regulatoryElementsAs<TrafficLight>()) {
+    stops.push_back(stopAt(frame, lanelet, light, light->stopLine()));
+  }
+  for (const auto& stop : lanelet.regulatoryElementsAs<AllWayStop>()) {
+    stops.push_back(stopAt(frame, lanelet, stop, stop->getStopLine(lanelet)));
+  }
+  for (const auto& rightOfWay : lanelet.regulatoryElementsAs<RightOfWay>()) {
+    if (rightOfWay->getManeuver(lanelet) == ManeuverType::Yield) {
+      stops.push_back(stopAt(frame, lanelet, rightOfWay, rightOfWay->stopLine()));
+    }
+  }
+  std::sort(stops.begin(), stops.end(),
+            [](const StopPosition& lhs, const StopPosition& rhs) { return lhs.arcLength < rhs.arcLength; });
+  return stops;
+}
+}  // namespace
+
+VelocityLimitProfile::VelocityLimitProfile(const traffic_rules::TrafficRules& trafficRules,
+                                           Acceleration maxLateralAcceleration, double curvatureWindow)
+    : trafficRules_{&trafficRules},
+      maxLateralAcceleration_{units::MPS2Quantity(maxLateralAcceleration).value()},
+      curvatureWindow_{curvatureWindow} {}
+
+VelocityLimitProfile::VelocityLimitProfile(const LaneletPath& path, const traffic_rules::TrafficRules& trafficRules,
+                                           Acceleration maxLateralAcceleration, double curvatureWindow)
+    : VelocityLimitProfile(trafficRules, maxLateralAcceleration, curvatureWindow) {
+  extend(path);
+}
+
+VelocityLimitProfile::VelocityLimitProfile(const Route& route, const traffic_rules::TrafficRules& trafficRules,
+                                           Acceleration maxLateralAcceleration, double curvatureWindow)
+    : VelocityLimitProfile(route.shortestPath(), trafficRules, maxLateralAcceleration, curvatureWindow) {}
+
+void VelocityLimitProfile::extend(const LaneletPath& path) {
+  auto first = path.begin();
+  if (!lanelets_.empty()) {
+    auto last = std::find(path.begin(), path.end(), lanelets_.back().second);
+    if (last != path.end()) {
+      first = std::next(last);
+    }
+  }
+  std::for_each(first, path.end(), [&](const ConstLanelet& llt) { append(llt); });
+}
+
+void VelocityLimitProfile::extend(const LaneletSequence& lanelets) {
+  extend(LaneletPath(lanelets.inverted() ? utils::transform(lanelets.lanelets(), [](auto& llt) { return llt.invert(); })
+                                         : lanelets.lanelets()));
+}
+
+void VelocityLimitProfile::append(const ConstLanelet& lanelet) {
+  auto legalLimit = trafficRules_->speedLimit(lanelet);
+  auto start = end_;
+  if (!lanelets_.empty() && !geometry::follows(lanelets_.back().second, lanelet)) {
+    // a lane change. The target lanelet replaces the sections of the lanelet the change starts from.
+    start = lanelets_.back().first;
+    sections_.erase(std::prev(sections_.end(), std::ptrdiff_t(lastLaneletSections_)), sections_.end());
+    // the lanelet is not driven, so its stop lines do not apply
+    auto firstStop = std::lower_bound(stops_.begin(), stops_.end(), start,
+                                      [](const StopPosition& elem, double s) { return elem.arcLength < s; });
+    stops_.erase(firstStop, stops_.end());
+    lanelets_.back().second = lanelet;
+    if (lastLegalLimit_.speedLimit < legalLimit.speedLimit) {
+      legalLimit = lastLegalLimit_;
+    }
+  } else {
+    lanelets_.emplace_back(start, lanelet);
+  }
+  lastLegalLimit_ = legalLimit;
+
+  FrenetFrame frame(ConstLanelets{lanelet}, curvatureWindow_);
+  const auto& lengths = frame.centerline().accumulatedLengths();
+  auto curveSpeed = [&](double curvature) {
+    return curvature > 0. ? std::sqrt(maxLateralAcceleration_ / curvature) * units::MPS() : Unlimited;
+  };
+  lastLaneletSections_ = 0;
+  auto lastCurvature = std::abs(frame.curvature(lengths.front()));
+  for (auto i = 1u; i < lengths.size(); ++i) {
+    const auto curvature = std::abs(frame.curvature(lengths[i]));
+    const VelocityLimit limit{legalLimit.speedLimit, curveSpeed(std::max(lastCurvature, curvature)),
+                              legalLimit.isMandatory};
+    lastCurvature = curvature;
+    // sections are not merged with the previous lanelet so that a lane change can replace them
+    if (lastLaneletSections_ > 0 && sections_.back().limit == limit) {
+      sections_.back().end = start + lengths[i];
+      continue;
+    }
+    sections_.push_back({start + lengths[i - 1], start + lengths[i], limit});
+    ++lastLaneletSections_;
+  }
+  end_ = start + frame.length();
+
+  for (auto& stop : stopPositionsOn(frame, lanelet)) {
+    stop.arcLength += start;
+    auto pos = std::upper_bound(stops_.begin(), stops_.end(), stop.arcLength,
+                                [](double s, const StopPosition& elem) { return s < elem.arcLength; });
+    stops_.insert(pos, std::move(stop));
+  }
+}
+
+void VelocityLimitProfile::dropBefore(double arcLength) {
+  while (lanelets_.size() > 1 && lanelets_[1].first <= arcLength) {
+    lanelets_.pop_front();
+  }
+  if (lanelets_.empty()) {
+    return;
+  }
+  const auto start = lanelets_.front().first;
+  while (!sections_.empty() && sections_.front().start < start) {
+    sections_.pop_front();
+  }
+  while (!stops_.empty() && stops_.front().arcLength < start) {
+    stops_.pop_front();
+  }
+}
+
+void VelocityLimitProfile::clear() {
+  end_ = 0.;
+  sections_.clear();
+  stops_.clear();
+  lanelets_.clear();
+  lastLaneletSections_ = 0;
+  lastLegalLimit_ = traffic_rules::SpeedLimitInformation();
+}
+
+const VelocityLimit& VelocityLimitProfile::at(double arcLength) const {
+  if (sections_.empty()) {
+    throw InvalidInputError("Can not query an empty velocity limit profile");
+  }
+  auto next = std::upper_bound(std::next(sections_.begin()), sections_.end(), arcLength,
+                               [](double s, const VelocityLimitSection& section) { return s < section.start; });
+  return std::prev(next)->limit;
+}
+
+const ConstLanelet& VelocityLimitProfile::laneletAt(double arcLength) const {
+  if (lanelets_.empty()) {
+    throw InvalidInputError("Can not query an empty velocity limit profile");
+  }
+  auto next = std::upper_bound(std::next(lanelets_.begin()), lanelets_.end(), arcLength,
+                               [](double s, const auto& lanelet) { return s < lanelet.first; });
+  return std::prev(next)->second;
+}
+
+Optional<StopPosition> VelocityLimitProfile::nextStop(double arcLength) const {
+  auto next = std::lower_bound(stops_.begin(), stops_.end(), arcLength,
+                               [](const StopPosition& elem, double s) { return elem.arcLength < s; });
+  if (next == stops_.end()) {
+    return {};
+  }
+  return *next;
+}
+
+}  // namespace routing
+}  // namespace lanelet
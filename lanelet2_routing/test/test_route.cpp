@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/primitives/BasicRegulatoryElements.h>
+#include <cmath>
+#include <set>
 #include "lanelet2_routing/Route.h"
 #include "lanelet2_routing/RoutingGraph.h"
+#include "lanelet2_routing/VelocityLimitProfile.h"
+#include "lanelet2_routing/internal/Graph.h"
+#include "lanelet2_routing/internal/RouteBuilder.h"
+#include "lanelet2_routing/internal/RoutingGraphBuilder.h"
 #include "test_routing_map.h"
 
 using namespace lanelet;
@@ -48,6 +56,7 @@ class RouteSplittedDivergingAndMerging : public TestRoute<2041, 2049> {};
 class RouteViaSimple : public TestRoute<2003, 2015, 2009> {};
 class RouteMissingLanelet : public TestRoute<2003, 2015> {};
 class RouteInCircle : public TestRoute<2029, 2068> {};
+class RouteIntoCircle : public TestRoute<2038, 2036> {};
 class RouteCircular : public TestRoute<2037, 2037, 2065> {};
 class RouteCircularNoLc : public TestRoute<2037, 2037, 2065> {
  public:
@@ -61,7 +70,8 @@ using AllRoutes =
     testing::Types<Route1, Route1NoLc, Route2, Route3, Route4, RouteMaxHoseLeftRight, RouteMaxHoseRightLeft,
                    RouteMaxHoseLeftRightDashedSolid, RouteMaxHoseLeftRightDashedSolidFurther, RouteSolidDashed,
                    RouteSolidDashedWithAdjacent, RouteSplittedDiverging, RouteSplittedDivergingAndMerging,
-                   RouteViaSimple, RouteMissingLanelet, RouteInCircle, RouteCircular, RouteCircularNoLc>;
+                   RouteViaSimple, RouteMissingLanelet, RouteInCircle, RouteIntoCircle, RouteCircular,
+                   RouteCircularNoLc>;
 
 TYPED_TEST_CASE(AllRoutesTest, AllRoutes);
 
@@ -139,6 +149,27 @@ TEST_F(Route1, Conflicting) {  // NOLINT
   EXPECT_TRUE(route.conflictingInMap(lanelets.at(2007)).empty());
 }
 
+TEST_F(Route1, ConflictingInMapMatchesGraph) {  // NOLINT
+  auto ids = [](const ConstLaneletOrAreas& llOrAs) {
+    auto result = utils::transform(llOrAs, [](auto& llOrA) { return llOrA.id(); });
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+  size_t numConflicting = 0;
+  for (const auto& llt : route.laneletSubmap()->laneletLayer) {
+    EXPECT_EQ(ids(route.conflictingInMap(llt)), ids(graph->conflicting(llt)));
+    numConflicting += route.conflictingInMap(llt).size();
+  }
+  EXPECT_EQ(route.allConflictingInMap().size(), numConflicting);
+}
+
+TEST_F(Route1, LaneletSubmapIsCreatedOnce) {  // NOLINT
+  auto submap = route.laneletSubmap();
+  EXPECT_EQ(route.laneletSubmap(), submap);
+  Route moved{std::move(route)};
+  EXPECT_EQ(moved.laneletSubmap(), submap);
+}
+
 TEST_F(Route1, forEachSuccessor) {  // NOLINT
   double cLast = 0.;
   route.forEachSuccessor(lanelets.at(2001), [&](const LaneletVisitInformation& i) {
@@ -355,6 +386,14 @@ TEST_F(RouteInCircle, create) {                                   // NOLINT
   EXPECT_EQ(route.remainingLane(lanelets.at(2067)).size(), 0ul);  // NOLINT
 }
 
+TEST_F(RouteIntoCircle, ContainsCircleBehindLaneChange) {  // NOLINT
+  // 2033 and 2034 only lead back to the route through the lane change from 2035 to the start
+  EXPECT_EQ(route.laneletSubmap()->laneletLayer.size(), 10ul);
+  EXPECT_TRUE(route.contains(lanelets.at(2033)));
+  EXPECT_TRUE(route.contains(lanelets.at(2034)));
+  EXPECT_TRUE(route.contains(lanelets.at(2035)));
+}
+
 TEST_F(RouteCircular, Circularity) {  // NOLINT
   EXPECT_EQ(route.size(), 10ul);
   // at any point of the circular route, the remaining lane should cross the circle
@@ -374,3 +413,157 @@ TEST_F(RouteCircularNoLc, Circularity) {  // NOLINT
   EXPECT_EQ(route.remainingShortestPath(lanelets.at(2036)).size(), 7ul);
   EXPECT_EQ(route.remainingLane(lanelets.at(2067)).size(), 7ul);
 }
+
+TEST_F(Route1, VelocityLimitProfile) {  // NOLINT
+  auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  VelocityLimitProfile profile(route, *trafficRules);
+  ASSERT_FALSE(profile.empty());
+  EXPECT_DOUBLE_EQ(profile.startArcLength(), 0.);
+  for (auto s = 0.; s < profile.endArcLength(); s += 0.5) {
+    const auto& limit = profile.at(s);
+    EXPECT_EQ(limit.legal, trafficRules->speedLimit(profile.laneletAt(s)).speedLimit);
+    EXPECT_LE(limit.limit(), limit.legal);
+  }
+  EXPECT_FALSE(!!profile.nextStop(0.));
+}
+
+TEST_F(Route1, VelocityLimitProfileExtends) {  // NOLINT
+  auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  const auto& path = route.shortestPath();
+  VelocityLimitProfile full(path, *trafficRules);
+  VelocityLimitProfile extended(LaneletPath(ConstLanelets(path.begin(), std::next(path.begin(), 2))), *trafficRules);
+  extended.extend(path);
+  ASSERT_EQ(extended.sections().size(), full.sections().size());
+  for (auto i = 0u; i < full.sections().size(); ++i) {
+    EXPECT_DOUBLE_EQ(extended.sections()[i].start, full.sections()[i].start);
+    EXPECT_EQ(extended.sections()[i].limit, full.sections()[i].limit);
+  }
+  EXPECT_DOUBLE_EQ(extended.endArcLength(), full.endArcLength());
+
+  const auto end = full.endArcLength();
+  full.dropBefore(end - 1.);
+  EXPECT_GT(full.startArcLength(), 0.);
+  EXPECT_EQ(full.laneletAt(end - 1.), path.back());
+  EXPECT_EQ(full.at(end - 1.), extended.at(end - 1.));
+}
+
+TEST_F(Route2, VelocityLimitProfileLaneChange) {  // NOLINT
+  // the route starts with a lane change from 2001 to 2003, the profile follows 2003 from the start
+  auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  VelocityLimitProfile profile(route, *trafficRules);
+  EXPECT_EQ(profile.laneletAt(0.), lanelets.at(2003));
+  EXPECT_EQ(profile.laneletAt(profile.endArcLength()), lanelets.at(2004));
+  const auto length = geometry::length2d(lanelets.at(2003)) + geometry::length2d(lanelets.at(2004));
+  EXPECT_NEAR(profile.endArcLength(), length, 1e-9);
+  EXPECT_EQ(profile.at(0.).legal, std::min(trafficRules->speedLimit(lanelets.at(2001)).speedLimit,
+                                           trafficRules->speedLimit(lanelets.at(2003)).speedLimit));
+}
+
+TEST(RouteBuilder, LaneChangeClosureKeepsRoutes) {  // NOLINT
+  // the routes between all lanelets must not change if the lane change components are not added after each iteration
+  const LaneletMap& map = *testData.laneletMap;
+  const RoutingCostPtrs costs{std::make_shared<RoutingCostDistance>(2.)};
+  const RoutingGraph::Configuration config;
+  auto routeLanelets = [](const Route& route) {
+    std::set<Id> ids;
+    for (const auto& llt : route.laneletSubmap()->laneletLayer) {
+      ids.insert(llt.id());
+    }
+    return ids;
+  };
+  size_t numRoutes = 0;
+  for (const auto& participant : {Participants::Vehicle, Participants::Bicycle, Participants::Pedestrian}) {
+    auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, participant);
+    auto routingGraph = RoutingGraph::build(map, *trafficRules, costs, config);
+    auto graph = routing::internal::RoutingGraphBuilder(*trafficRules, costs, config).buildGraph(map);
+    for (const auto& from : map.laneletLayer) {
+      for (const auto& to : map.laneletLayer) {
+        for (auto withLaneChanges : {true, false}) {
+          auto path = routingGraph->shortestPath(from, to, 0, withLaneChanges);
+          if (!path) {
+            continue;
+          }
+          auto closed = routing::internal::RouteBuilder(*graph).getRouteFromShortestPath(*path, withLaneChanges);
+          auto iterated =
+              routing::internal::RouteBuilder(*graph, nullptr, false).getRouteFromShortestPath(*path, withLaneChanges);
+          ASSERT_EQ(!!closed, !!iterated) << from.id() << " -> " << to.id();
+          if (!closed) {
+            continue;
+          }
+          ++numRoutes;
+          EXPECT_EQ(routeLanelets(*closed), routeLanelets(*iterated)) << from.id() << " -> " << to.id();
+          EXPECT_EQ(closed->numLanes(), iterated->numLanes()) << from.id() << " -> " << to.id();
+        }
+      }
+    }
+  }
+  EXPECT_GT(numRoutes, 1000ul);
+}
+
+TEST(Route, GraphWithoutConflictTable) {  // NOLINT
+  auto graph = std::make_unique<routing::internal::RouteGraph>(1);
+  EXPECT_THROW(Route(LaneletPath(), std::move(graph), nullptr), InvalidInputError);  // NOLINT
+}
+
+TEST(VelocityLimitProfile, LaneChangeDropsStopsOfSourceLanelet) {  // NOLINT
+  // like Route2: the path starts on "from", changes to the lanelet "to" on its right and continues on "next"
+  auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  auto point = [](double x, double y) { return Point3d(utils::getId(), x, y, 0.); };
+  auto line = [&](double y) { return LineString3d(utils::getId(), {point(0., y), point(10., y)}); };
+  LineString3d left = line(3.), middle = line(0.), right = line(-3.);
+  Lanelet from(utils::getId(), left, middle);
+  Lanelet to(utils::getId(), middle, right);
+  Lanelet next(utils::getId(), LineString3d(utils::getId(), {middle.back(), point(20., 0.)}),
+               LineString3d(utils::getId(), {right.back(), point(20., -3.)}));
+  auto lightAt = [&](double x, double y) {
+    LineString3d stopLine(utils::getId(), {point(x, y + 1.5), point(x, y - 1.5)});
+    return TrafficLight::make(utils::getId(), {}, {LineString3d(utils::getId())}, stopLine);
+  };
+  from.addRegulatoryElement(lightAt(5., 1.5));
+  next.addRegulatoryElement(lightAt(15., -1.5));
+
+  VelocityLimitProfile profile(LaneletPath({from, to, next}), *trafficRules);
+  EXPECT_EQ(profile.laneletAt(0.), to);
+  ASSERT_EQ(profile.stopPositions().size(), 1ul);
+  EXPECT_EQ(profile.stopPositions().front().lanelet, next);
+  EXPECT_DOUBLE_EQ(profile.nextStop(0.)->arcLength, 15.);
+
+  profile.clear();
+  profile.extend(LaneletPath({to}));
+  EXPECT_EQ(profile.at(0.).legal, trafficRules->speedLimit(to).speedLimit);
+  EXPECT_FALSE(!!profile.nextStop(0.));
+}
+
+TEST(VelocityLimitProfile, CurveAndStopLine) {  // NOLINT
+  auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  // a straight lanelet with a traffic light, followed by a left turn with a radius of 10
+  auto point = [](double x, double y) { return Point3d(utils::getId(), x, y, 0.); };
+  auto arc = [&](Point3d first, double radius) {
+    LineString3d ls(utils::getId(), {first});
+    for (auto i = 1; i <= 20; ++i) {
+      const auto angle = M_PI / 40. * i;
+      ls.push_back(point(10. + radius * std::sin(angle), 10. - radius * std::cos(angle)));
+    }
+    return ls;
+  };
+  Lanelet straight(utils::getId(), LineString3d(utils::getId(), {point(0., 1.), point(10., 1.)}),
+                   LineString3d(utils::getId(), {point(0., -1.), point(10., -1.)}));
+  straight.setAttribute(AttributeName::SpeedLimit, "30");
+  Lanelet curve(utils::getId(), arc(straight.leftBound().back(), 9.), arc(straight.rightBound().back(), 11.));
+  LineString3d stopLine(utils::getId(), {point(8., 1.), point(8., -1.)});
+  straight.addRegulatoryElement(TrafficLight::make(utils::getId(), {}, {LineString3d(utils::getId())}, stopLine));
+
+  VelocityLimitProfile profile(LaneletPath({straight, curve}), *trafficRules);
+  EXPECT_NEAR(profile.endArcLength(), 10. + M_PI * 5., 0.1);
+  EXPECT_NEAR(units::KmHQuantity(profile.at(5.).legal).value(), 30., 1e-6);
+  EXPECT_TRUE(std::isinf(profile.at(5.).curve.value()));
+  EXPECT_EQ(profile.at(20.).legal, trafficRules->speedLimit(curve).speedLimit);
+  EXPECT_NEAR(profile.speedLimit(20.).value(), std::sqrt(2. * 10.), 0.3);
+  EXPECT_EQ(profile.laneletAt(20.), curve);
+
+  auto stop = profile.nextStop(0.);
+  ASSERT_TRUE(!!stop);
+  EXPECT_DOUBLE_EQ(stop->arcLength, 8.);
+  EXPECT_EQ(stop->lanelet, straight);
+  EXPECT_FALSE(!!profile.nextStop(8.5));
+}
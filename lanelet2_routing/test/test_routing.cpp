@@ -1,9 +1,18 @@
 #include <gtest/gtest.h>
+#include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_core/primitives/LaneletSequence.h>
 #include <sched.h>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <thread>
 #include "lanelet2_routing/RoutingGraph.h"
+#include "lanelet2_routing/Route.h"
+#include "lanelet2_routing/internal/CoveragePath.h"
 #include "lanelet2_routing/internal/Graph.h"
+#include "lanelet2_routing/internal/KShortestPaths.h"
 #include "lanelet2_routing/internal/ShortestPath.h"
 #include "test_routing_map.h"
 
@@ -63,6 +72,134 @@ TEST(DijkstraSearch, onSimpleGraph) {
   }
 }
 
+TEST(DijkstraSearch, repeatedQueriesReuseState) {
+  auto g = getSimpleGraph();
+  DijkstraStyleSearch<GraphType> searcher(g);
+  searcher.query(0, [](const VertexVisitInformation& v) { return v.vertex != 1; });
+  searcher.query(2, [](const VertexVisitInformation& /*v*/) { return true; });
+  std::vector<GraphType::vertex_descriptor> visited;
+  for (const auto& v : searcher.getMap()) {
+    visited.push_back(v.first);
+  }
+  EXPECT_EQ(visited, (std::vector<GraphType::vertex_descriptor>{2, 3, 4, 5}));
+  EXPECT_EQ(searcher.getMap().count(0), 0ul);
+  EXPECT_THROW(searcher.getMap().at(1), std::out_of_range);  // NOLINT
+  EXPECT_DOUBLE_EQ(searcher.getMap().at(5).cost, 4.);
+  EXPECT_EQ(searcher.getMap().at(5).predecessor, 3ul);
+  EXPECT_TRUE(searcher.getMap().at(5).isLeaf);
+}
+
+TEST(DijkstraSearch, nestedQueries) {
+  auto g = getSimpleGraph();
+  DijkstraStyleSearch<GraphType> outer(g);
+  size_t numVisited{};
+  outer.query(0, [&](const VertexVisitInformation& v) {
+    DijkstraStyleSearch<GraphType> inner(g);
+    inner.query(v.vertex, [](const VertexVisitInformation& /*v*/) { return true; });
+    numVisited += inner.getMap().size();
+    return true;
+  });
+  EXPECT_EQ(numVisited, 6ul + 4ul + 4ul + 2ul + 2ul + 1ul);
+  EXPECT_EQ(outer.getMap().size(), boost::num_vertices(g));
+  EXPECT_DOUBLE_EQ(outer.getMap().at(5).cost, 3.);
+}
+
+TEST(CompressedGraph, keepsFilteredEdges) {
+  auto g = getSimpleGraph();
+  auto cheap = [&g](const GraphTraits::edge_descriptor& e) { return g[e].routingCost < 3; };
+  CompressedGraph forward(g, cheap, false);
+  CompressedGraph backward(g, cheap, true);
+  EXPECT_EQ(forward.numVertices(), boost::num_vertices(g));
+  EXPECT_EQ(forward.numEdges(), 5ul);
+  EXPECT_EQ(backward.numEdges(), 5ul);
+  auto targets = [](const CompressedGraph& cg, size_t v) {
+    std::vector<size_t> result;
+    auto edges = out_edges(v, cg);
+    std::transform(edges.first, edges.second, std::back_inserter(result),
+                   [&](const CompressedEdge& e) { return target(e, cg); });
+    return result;
+  };
+  EXPECT_EQ(targets(forward, 0), (std::vector<size_t>{1, 2}));
+  EXPECT_EQ(targets(forward, 1), (std::vector<size_t>{4}));
+  EXPECT_EQ(targets(forward, 3), (std::vector<size_t>{}));
+  EXPECT_EQ(targets(backward, 3), (std::vector<size_t>{2}));
+  EXPECT_EQ(targets(backward, 5), (std::vector<size_t>{4}));
+}
+
+TEST(CompressedGraph, searchGivesSameResult) {
+  auto g = getSimpleGraph();
+  CompressedGraph compressed(g, [](auto /*e*/) { return true; }, false);
+  DijkstraStyleSearch<GraphType> searcher(g);
+  DijkstraStyleSearch<CompressedGraph> compressedSearcher(compressed);
+  auto predicate = [](const VertexVisitInformation& v) { return v.vertex != 4; };
+  searcher.query(0, predicate);
+  compressedSearcher.query(0, predicate);
+  ASSERT_EQ(searcher.getMap().size(), compressedSearcher.getMap().size());
+  for (const auto& v : searcher.getMap()) {
+    const auto& other = compressedSearcher.getMap().at(v.first);
+    EXPECT_DOUBLE_EQ(v.second.cost, other.cost);
+    EXPECT_EQ(v.second.predecessor, other.predecessor);
+    EXPECT_EQ(v.second.isLeaf, other.isLeaf);
+    EXPECT_EQ(v.second.predicate, other.predicate);
+  }
+}
+
+TEST(KShortestPaths, onSimpleGraph) {
+  auto g = getSimpleGraph();
+  auto all = [](auto /*e*/) { return true; };
+  CompressedGraph forward(g, all, false);
+  CompressedGraph backward(g, all, true);
+  KShortestPaths<CompressedGraph> kShortest(forward, backward);
+  auto paths = kShortest.query(0, 5, 10);
+  ASSERT_EQ(paths.size(), 4ul);
+  EXPECT_EQ(paths[0].vertices, (std::vector<size_t>{0, 1, 4, 5}));
+  std::vector<double> costs = utils::transform(paths, [](auto& p) { return p.cost; });
+  EXPECT_EQ(costs, (std::vector<double>{3, 6, 6, 7}));
+  EXPECT_EQ(paths[3].vertices, (std::vector<size_t>{0, 1, 3, 5}));
+  EXPECT_EQ(kShortest.query(0, 5, 2).size(), 2ul);
+  EXPECT_TRUE(kShortest.query(5, 0, 2).empty());
+}
+
+TEST(KShortestPaths, overlapPenaltyPrefersDisjointPaths) {
+  auto g = getSimpleGraph();
+  auto all = [](auto /*e*/) { return true; };
+  CompressedGraph forward(g, all, false);
+  CompressedGraph backward(g, all, true);
+  auto paths = KShortestPaths<CompressedGraph>(forward, backward).query(0, 5, 3, 10.);
+  ASSERT_EQ(paths.size(), 3ul);
+  EXPECT_EQ(paths[1].vertices, (std::vector<size_t>{0, 2, 3, 5}));
+  EXPECT_EQ(paths[2].vertices, (std::vector<size_t>{0, 2, 4, 5}));
+}
+
+TEST(CoveragePathPlanner, coversLongestChainOfAcyclicGraph) {
+  auto g = getSimpleGraph();
+  CompressedGraph forward(g, [](auto /*e*/) { return true; }, false);
+  auto result = CoveragePathPlanner<CompressedGraph>(forward).query(0, 5);
+  ASSERT_TRUE(!!result);
+  EXPECT_EQ(result->vertices.size(), 4ul);
+  EXPECT_EQ(result->vertices.front(), 0ul);
+  EXPECT_EQ(result->vertices.back(), 5ul);
+  EXPECT_EQ(result->uncovered.size(), 2ul);
+  EXPECT_DOUBLE_EQ(result->cost, 7.);
+  EXPECT_FALSE(!!CoveragePathPlanner<CompressedGraph>(forward).query(5, 0));
+}
+
+TEST(CoveragePathPlanner, coversStronglyConnectedGraph) {
+  auto g = getSimpleGraph();
+  auto e = boost::add_edge(5, 0, g);
+  g[e.first].routingCost = 1.;
+  CompressedGraph forward(g, [](auto /*e*/) { return true; }, false);
+  auto result = CoveragePathPlanner<CompressedGraph>(forward).query(0, 0);
+  ASSERT_TRUE(!!result);
+  EXPECT_TRUE(result->uncovered.empty());
+  EXPECT_EQ(result->vertices.front(), 0ul);
+  EXPECT_EQ(result->vertices.back(), 0ul);
+  std::set<size_t> covered(result->vertices.begin(), result->vertices.end());
+  EXPECT_EQ(covered.size(), 6ul);
+  // the rounds 0-1-4-5-0 and 0-2-3-5-0 are the cheapest way to cover everything
+  EXPECT_DOUBLE_EQ(result->cost, 11.);
+}
+
 TEST_F(GermanPedestrianGraph, NumberOfLanelets) {  // NOLINT
   EXPECT_EQ(graph->passableSubmap()->laneletLayer.size(), 5ul);
   EXPECT_TRUE(graph->passableSubmap()->laneletLayer.exists(2031));
@@ -236,6 +373,78 @@ TEST_F(GermanVehicleGraph, reachableSetInvalid) {
   EXPECT_TRUE(reachable.empty());
 }
 
+std::vector<Id> sortedIds(const ConstLanelets& lanelets) {
+  std::vector<Id> ids;
+  for (const auto& llt : lanelets) {
+    ids.push_back(llt.id());
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+//! Updates the horizon and checks it against a new search and the delta against the previous set
+void expectHorizonIsReachableSet(ReachableSetHorizon& horizon, const RoutingGraph& graph, const ConstLanelet& llt,
+                                 double costOnLanelet, RoutingCostId routingCostId = 0) {
+  auto before = sortedIds(horizon.reachableSet());
+  auto delta = horizon.update(llt, costOnLanelet);
+  auto after = sortedIds(horizon.reachableSet());
+  EXPECT_EQ(after, sortedIds(graph.reachableSet(llt, horizon.maxRoutingCost() + costOnLanelet, routingCostId)))
+      << "at " << llt.id() << " + " << costOnLanelet;
+  auto entered = sortedIds(delta.entered);
+  auto left = sortedIds(delta.left);
+  std::vector<Id> expected;
+  std::set_difference(before.begin(), before.end(), left.begin(), left.end(), std::back_inserter(expected));
+  expected.insert(expected.end(), entered.begin(), entered.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(after, expected) << "at " << llt.id() << " + " << costOnLanelet;
+}
+
+TEST_F(GermanVehicleGraph, reachableSetHorizonFollowsPath) {  // NOLINT
+  auto horizon = graph->reachableSetHorizon(5., 0);
+  for (auto fromTo : {std::make_pair(2001, 2004), std::make_pair(2017, 2024)}) {
+    auto path = graph->shortestPath(lanelets.at(fromTo.first), lanelets.at(fromTo.second), 0);
+    ASSERT_TRUE(!!path);
+    for (const auto& llt : *path) {
+      for (auto costOnLanelet : {0., 0.5, 1.}) {
+        expectHorizonIsReachableSet(horizon, *graph, llt, costOnLanelet);
+      }
+    }
+  }
+  EXPECT_EQ(*horizon.currentLanelet(), lanelets.at(2024));
+  EXPECT_DOUBLE_EQ(*horizon.cost(lanelets.at(2024)), 0.);
+  EXPECT_FALSE(horizon.contains(lanelets.at(2017)));
+}
+
+TEST_F(GermanVehicleGraph, reachableSetHorizonJumps) {  // NOLINT
+  auto horizon = graph->reachableSetHorizon(3., 0, false);
+  auto delta = horizon.update(lanelets.at(2001));
+  EXPECT_TRUE(delta.left.empty());
+  EXPECT_EQ(sortedIds(delta.entered), sortedIds(graph->reachableSet(lanelets.at(2001), 3., 0, false)));
+  EXPECT_TRUE(horizon.update(lanelets.at(2001)).empty());
+
+  auto checkUpdate = [&](Id id, double costOnLanelet) {
+    horizon.update(lanelets.at(id), costOnLanelet);
+    EXPECT_EQ(sortedIds(horizon.reachableSet()),
+              sortedIds(graph->reachableSet(lanelets.at(id), 3. + costOnLanelet, 0, false)));
+  };
+  checkUpdate(2017, 0.);
+  checkUpdate(2017, 2.);
+  checkUpdate(2017, 1.);
+  checkUpdate(2001, 0.);
+
+  delta = horizon.update(ConstLanelet());
+  EXPECT_TRUE(delta.entered.empty());
+  EXPECT_EQ(sortedIds(delta.left), sortedIds(graph->reachableSet(lanelets.at(2001), 3., 0, false)));
+  EXPECT_TRUE(horizon.reachableSet().empty());
+  EXPECT_FALSE(!!horizon.currentLanelet());
+
+  horizon.update(lanelets.at(2001));
+  horizon.reset();
+  EXPECT_TRUE(horizon.reachableSet().empty());
+  EXPECT_FALSE(horizon.update(lanelets.at(2001)).entered.empty());
+  EXPECT_THROW(graph->reachableSetHorizon(3., numCostModules), InvalidInputError);  // NOLINT
+}
+
 TEST_F(GermanPedestrianGraph, reachableSetCrossingWithArea) {  // NOLINT
   auto reachable = graph->reachableSetIncludingAreas(lanelets.at(2050), 100);
   EXPECT_EQ(reachable.size(), 6ul);
@@ -354,6 +563,60 @@ TEST_F(GermanVehicleGraph, possiblePathsTowardsMinLanelets) {  // NOLINT
   EXPECT_TRUE(containsLanelet(routes[1], 2009) || containsLanelet(routes[1], 2008));
 }
 
+TEST_F(GermanVehicleGraph, possiblePathTreeEqualsPossiblePaths) {  // NOLINT
+  EXPECT_EQ(graph->possiblePathTree(lanelets.at(2001), 7, true).paths(),
+            graph->possiblePaths(lanelets.at(2001), 7, true));
+  EXPECT_EQ(graph->possiblePathTree(lanelets.at(2017), 10.0, 0, true).paths(),
+            graph->possiblePaths(lanelets.at(2017), 10.0, 0, true));
+  EXPECT_EQ(graph->possiblePathTreeTowards(lanelets.at(2015), 7, 0, true).paths(),
+            graph->possiblePathsTowards(lanelets.at(2015), 7, 0, true));
+  EXPECT_EQ(graph->possiblePathTreeTowards(lanelets.at(2015), 5, true).paths(),
+            graph->possiblePathsTowards(lanelets.at(2015), 5, true));
+  EXPECT_TRUE(graph->possiblePathTree(ConstLanelet(), 10.0).empty());
+}
+
+TEST_F(GermanVehicleGraph, possiblePathTreeSharesPrefixes) {  // NOLINT
+  auto tree = graph->possiblePathTree(lanelets.at(2001), 7, true);
+  ASSERT_EQ(tree.size(), 3ul);
+  size_t numElements{};
+  for (auto i = 0ul; i < tree.size(); ++i) {
+    auto path = tree[i];
+    ASSERT_EQ(path.size(), tree.pathSize(i));
+    EXPECT_EQ(path.front(), lanelets.at(2001));
+    EXPECT_EQ(path.back(), tree.leaf(i));
+    ConstLanelets reversed;
+    EXPECT_TRUE(tree.forEachElement(i, [&](const ConstLanelet& llt) {
+      reversed.push_back(llt);
+      return true;
+    }));
+    EXPECT_TRUE(std::equal(reversed.rbegin(), reversed.rend(), path.begin(), path.end()));
+    numElements += path.size();
+  }
+  EXPECT_LT(tree.nodes().size(), numElements);
+  size_t visited{};
+  EXPECT_FALSE(tree.forEachElement(0, [&](const ConstLanelet& /*llt*/) { return ++visited < 2; }));
+  EXPECT_EQ(visited, 2ul);
+}
+
+TEST_F(GermanVehicleGraph, possiblePathTreePruned) {  // NOLINT
+  auto notPast2002 = [](const LaneletVisitInformation& i) { return i.lanelet.id() != 2002; };
+  auto tree = graph->possiblePathTree(lanelets.at(2001), 7, true, 0, notPast2002);
+  ASSERT_FALSE(tree.empty());
+  bool endsAt2002 = false;
+  for (const auto& path : tree) {
+    if (containsLanelet(path, 2002)) {
+      EXPECT_EQ(path.back().id(), 2002);
+      endsAt2002 = true;
+    }
+  }
+  EXPECT_TRUE(endsAt2002);
+}
+
+TEST_F(GermanPedestrianGraph, possiblePathTreeWithAreas) {  // NOLINT
+  EXPECT_EQ(graph->possiblePathTreeIncludingAreas(lanelets.at(2050), 10, 0, false).paths(),
+            graph->possiblePathsIncludingAreas(lanelets.at(2050), 10, 0, false));
+}
+
 TEST_F(GermanVehicleGraph, forEachSuccessorIsMonotonic) {  // NOLINT
   double lastVal = 0.;
   bool lanelet2010Seen = false;
@@ -438,6 +701,447 @@ TEST_F(GermanPedestrianGraph, shortestPathIncludingAreasViaThroughAreas) {
   EXPECT_EQ(path->size(), 6ul);
 }
 
+TEST_F(GermanVehicleGraph, shortestPathsStartWithShortestPath) {  // NOLINT
+  auto paths = graph->shortestPaths(lanelets.at(2029), lanelets.at(2035), 5, 0., 0);
+  ASSERT_EQ(paths.size(), 3ul);
+  EXPECT_EQ(paths.front(), *graph->shortestPath(lanelets.at(2029), lanelets.at(2035), 0));
+  for (auto it = paths.begin(); it != paths.end(); ++it) {
+    EXPECT_EQ(it->front(), lanelets.at(2029));
+    EXPECT_EQ(it->back(), lanelets.at(2035));
+    EXPECT_EQ(std::find(paths.begin(), it, *it), it);
+    auto sorted = ConstLanelets(it->begin(), it->end());
+    std::sort(sorted.begin(), sorted.end(), [](auto& lhs, auto& rhs) { return lhs.id() < rhs.id(); });
+    EXPECT_EQ(std::adjacent_find(sorted.begin(), sorted.end()), sorted.end());
+  }
+  EXPECT_TRUE(graph->shortestPaths(lanelets.at(2004), lanelets.at(2001), 5).empty());
+}
+
+TEST_F(GermanVehicleGraph, alternativeRoutes) {  // NOLINT
+  auto routes = graph->getAlternativeRoutes(lanelets.at(2029), lanelets.at(2035), 3, 0., 0);
+  ASSERT_EQ(routes.size(), 2ul);
+  EXPECT_EQ(routes.front().shortestPath(), *graph->shortestPath(lanelets.at(2029), lanelets.at(2035), 0));
+  EXPECT_EQ(routes.back().shortestPath().back(), lanelets.at(2035));
+  EXPECT_TRUE(routes.back().contains(lanelets.at(2036)));
+}
+
+namespace {
+//! Routing cost of the relation between two lanelets
+double relationCost(const RoutingGraph& graph, const ConstLanelet& from, const ConstLanelet& to) {
+  double cost = std::numeric_limits<double>::infinity();
+  graph.forEachSuccessor(from, [&](const LaneletVisitInformation& i) {
+    if (i.lanelet == to && i.predecessor == from) {
+      cost = i.cost;
+    }
+    return i.lanelet == from;
+  });
+  return cost;
+}
+
+double pathCost(const RoutingGraph& graph, const LaneletPath& path) {
+  double cost{};
+  for (size_t i = 1; i < path.size(); ++i) {
+    cost += relationCost(graph, path[i - 1], path[i]);
+  }
+  return cost;
+}
+}  // namespace
+
+TEST_F(GermanVehicleGraph, coveragePathPassesReachableLanelets) {  // NOLINT
+  auto from = lanelets.at(2001);
+  auto to = lanelets.at(2004);
+  auto coverage = graph->coveragePath(from, to, 0);
+  ASSERT_TRUE(!!coverage);
+  const auto& path = coverage->path;
+  ASSERT_FALSE(path.empty());
+  EXPECT_EQ(path.front(), from);
+  EXPECT_EQ(path.back(), to);
+  for (size_t i = 1; i < path.size(); ++i) {
+    EXPECT_TRUE(!!graph->routingRelation(path[i - 1], path[i])) << path[i - 1].id() << " -> " << path[i].id();
+  }
+  EXPECT_NEAR(coverage->cost, pathCost(*graph, path), 1e-6);
+  std::set<Id> covered;
+  std::transform(path.begin(), path.end(), std::inserter(covered, covered.end()), [](auto& llt) { return llt.id(); });
+  auto uncovered = sortedIds(coverage->uncovered);
+  covered.insert(uncovered.begin(), uncovered.end());
+  auto reachable = sortedIds(graph->reachableSet(from, std::numeric_limits<double>::infinity(), 0));
+  EXPECT_EQ(covered, std::set<Id>(reachable.begin(), reachable.end()));
+}
+
+TEST_F(GermanVehicleGraph, coveragePathCosts) {  // NOLINT
+  struct Expected {
+    Id from;
+    Id to;
+    bool withLaneChanges;
+    double cost;
+    std::vector<Id> path;
+  };
+  const std::vector<Expected> expected{
+      {2014, 2014, true, 8., {2014, 2013, 2014, 2015, 2014}},
+      {2047, 2049, true, 7.0615528128088307, {2047, 2048, 2047, 2049}},
+      {2043, 2049, true, 12.477207591867346, {2043, 2045, 2047, 2048, 2047, 2049}},
+      // 2048 can only be reached by a lane change
+      {2043, 2049, false, 8.4772075918673462, {2043, 2045, 2047, 2049}},
+      {2029, 2068, true, 49.041788249525197, {2029, 2036, 2037, 2038, 2064, 2065, 2066, 2067, 2033, 2034, 2035, 2038,
+                                              2064, 2065, 2066, 2068}}};
+  for (const auto& exp : expected) {
+    auto coverage = graph->coveragePath(lanelets.at(exp.from), lanelets.at(exp.to), 0, exp.withLaneChanges);
+    ASSERT_TRUE(!!coverage) << exp.from << " -> " << exp.to;
+    EXPECT_NEAR(coverage->cost, exp.cost, 1e-9) << exp.from << " -> " << exp.to;
+    EXPECT_NEAR(coverage->cost, pathCost(*graph, coverage->path), 1e-9) << exp.from << " -> " << exp.to;
+    EXPECT_EQ(utils::transform(coverage->path, [](auto& llt) { return llt.id(); }), exp.path);
+    EXPECT_TRUE(coverage->uncovered.empty()) << exp.from << " -> " << exp.to;
+  }
+}
+
+TEST_F(GermanVehicleGraph, coveragePathToUnreachableLanelet) {  // NOLINT
+  EXPECT_FALSE(!!graph->coveragePath(lanelets.at(2014), lanelets.at(2007), 0));
+}
+
+class ConflictZoneGraph : public GermanVehicleGraph {
+ public:
+  ConflictZoneGraph() {
+    traffic_rules::TrafficRulesPtr trafficRules{traffic_rules::TrafficRulesFactory::create(
+        Locations::Germany, Participants::Vehicle, traffic_rules::TrafficRules::Configuration())};
+    RoutingCostPtrs costPtrs{std::make_shared<RoutingCostDistance>(testData.laneChangeCost)};
+    RoutingGraph::Configuration configuration;
+    configuration.emplace(RoutingGraph::ParticipantHeight, Attribute(2.));
+    configuration.emplace(RoutingGraph::ComputeConflictZones, Attribute(true));
+    zoneGraph = RoutingGraph::build(*testData.laneletMap, *trafficRules, costPtrs, configuration);
+  }
+  RoutingGraphPtr zoneGraph;
+};
+
+TEST_F(GermanVehicleGraph, noConflictZonesByDefault) {  // NOLINT
+  EXPECT_TRUE(graph->conflictZones(lanelets.at(2005)).empty());
+  EXPECT_FALSE(!!graph->conflictZone(lanelets.at(2005), lanelets.at(2006)));
+}
+
+TEST_F(ConflictZoneGraph, conflictZonesMatchConflicting) {  // NOLINT
+  for (const auto& llt : zoneGraph->passableSubmap()->laneletLayer) {
+    auto conflicting = zoneGraph->conflicting(llt);
+    auto zones = zoneGraph->conflictZones(llt);
+    EXPECT_EQ(zones.size(), conflicting.size()) << llt.id();
+    for (const auto& zone : zones) {
+      EXPECT_EQ(zone.laneletOrArea, ConstLaneletOrArea(llt));
+      EXPECT_TRUE(std::find(conflicting.begin(), conflicting.end(), zone.conflicting) != conflicting.end());
+      EXPECT_FALSE(zone.overlap.empty()) << llt.id() << " - " << zone.conflicting.id();
+      EXPECT_EQ(zone.crossings.size(), zone.arcLengths.size());
+      EXPECT_EQ(zone.crossings.size(), zone.otherArcLengths.size());
+      EXPECT_TRUE(std::is_sorted(zone.arcLengths.begin(), zone.arcLengths.end()));
+    }
+  }
+}
+
+TEST_F(ConflictZoneGraph, conflictZoneIsSymmetric) {  // NOLINT
+  auto zone = zoneGraph->conflictZone(lanelets.at(2005), lanelets.at(2006));
+  ASSERT_TRUE(!!zone);
+  auto other = zoneGraph->conflictZone(lanelets.at(2006), lanelets.at(2005));
+  ASSERT_TRUE(!!other);
+  EXPECT_EQ(other->conflicting, ConstLaneletOrArea(lanelets.at(2005)));
+  double area{};
+  for (const auto& polygon : zone->overlap) {
+    area += boost::geometry::area(polygon);
+  }
+  EXPECT_GT(std::abs(area), 0.);
+  ASSERT_EQ(zone->crossings.size(), other->crossings.size());
+  auto centerline = lanelets.at(2005).centerline2d();
+  auto otherCenterline = lanelets.at(2006).centerline2d();
+  for (auto i = 0ul; i < zone->crossings.size(); ++i) {
+    EXPECT_NEAR(geometry::toArcCoordinates(centerline, zone->crossings[i]).length, zone->arcLengths[i], 1e-6);
+    EXPECT_NEAR(geometry::toArcCoordinates(otherCenterline, zone->crossings[i]).length, zone->otherArcLengths[i],
+                1e-6);
+  }
+  EXPECT_FALSE(!!zoneGraph->conflictZone(lanelets.at(2005), lanelets.at(2001)));
+}
+
+TEST_F(ConflictZoneGraph, conflictZoneBothWays) {  // NOLINT
+  auto zone = zoneGraph->conflictZone(lanelets.at(2020), lanelets.at(2020).invert());
+  ASSERT_TRUE(!!zone);
+  EXPECT_TRUE(zone->crossings.empty());
+  EXPECT_FALSE(zone->overlap.empty());
+}
+
+class CostOverlayGraph : public GermanVehicleGraph {
+ public:
+  RoutingGraphPtr overlaidGraph{setUpGermanVehicleGraph(*testData.laneletMap, testData.laneChangeCost)};
+};
+
+TEST_F(CostOverlayGraph, blockedLaneletIsAvoided) {  // NOLINT
+  overlaidGraph->setCostOverlay(RoutingCostOverlay().set(2003, CostModification::blocked()));
+  auto shortestPath = overlaidGraph->shortestPath(lanelets.at(2001), lanelets.at(2004), 0);
+  if (!!shortestPath) {
+    EXPECT_FALSE(has(*shortestPath, ConstLanelet(lanelets.at(2003))));
+  }
+  auto reachable = overlaidGraph->reachableSet(lanelets.at(2001), 1000, 0);
+  EXPECT_FALSE(has(reachable, ConstLanelet(lanelets.at(2003))));
+  EXPECT_TRUE(has(reachable, ConstLanelet(lanelets.at(2001))));
+
+  overlaidGraph->setCostOverlay({});
+  shortestPath = overlaidGraph->shortestPath(lanelets.at(2001), lanelets.at(2004), 0);
+  ASSERT_TRUE(!!shortestPath);
+  EXPECT_EQ(*shortestPath, *graph->shortestPath(lanelets.at(2001), lanelets.at(2004), 0));
+}
+
+TEST_F(CostOverlayGraph, routeExcludesBlockedLanelets) {  // NOLINT
+  // 2003 is a lane change neighbour of 2001 on the route 2001 -> 2014
+  ASSERT_TRUE(overlaidGraph->getRoute(lanelets.at(2001), lanelets.at(2014), 0)->contains(lanelets.at(2003)));
+  overlaidGraph->setCostOverlay(RoutingCostOverlay().set(2003, CostModification::blocked()));
+  auto route = overlaidGraph->getRoute(lanelets.at(2001), lanelets.at(2014), 0);
+  ASSERT_TRUE(!!route);
+  EXPECT_FALSE(route->contains(lanelets.at(2003)));
+  EXPECT_TRUE(route->contains(lanelets.at(2001)));
+  EXPECT_TRUE(route->contains(lanelets.at(2014)));
+  auto viaRoute = overlaidGraph->getRouteVia(lanelets.at(2001), {lanelets.at(2007)}, lanelets.at(2014), 0);
+  ASSERT_TRUE(!!viaRoute);
+  EXPECT_FALSE(viaRoute->contains(lanelets.at(2003)));
+}
+
+TEST_F(CostOverlayGraph, reachableSetHorizonFollowsOverlay) {  // NOLINT
+  auto horizon = overlaidGraph->reachableSetHorizon(1000., 0);
+  expectHorizonIsReachableSet(horizon, *overlaidGraph, lanelets.at(2001), 0.);
+  EXPECT_TRUE(horizon.contains(lanelets.at(2003)));
+  overlaidGraph->setCostOverlay(RoutingCostOverlay().set(2003, CostModification::blocked()));
+  expectHorizonIsReachableSet(horizon, *overlaidGraph, lanelets.at(2001), 0.);
+  EXPECT_FALSE(horizon.contains(lanelets.at(2003)));
+}
+
+TEST_F(CostOverlayGraph, absoluteCosts) {  // NOLINT
+  overlaidGraph->updateCostOverlay([&](RoutingCostOverlay& overlay) {
+    for (const auto& ll : lanelets) {
+      overlay.set(ll.first, CostModification::absolute(1.));
+    }
+  });
+  size_t numVisited{};
+  overlaidGraph->forEachSuccessor(lanelets.at(2001), [&](const LaneletVisitInformation& i) {
+    EXPECT_DOUBLE_EQ(i.cost, double(i.length - 1)) << i.lanelet.id();
+    ++numVisited;
+    return true;
+  });
+  EXPECT_GT(numVisited, 2ul);
+  overlaidGraph->forEachPredecessor(lanelets.at(2004), [&](const LaneletVisitInformation& i) {
+    EXPECT_DOUBLE_EQ(i.cost, double(i.length - 1)) << i.lanelet.id();
+    return true;
+  });
+}
+
+TEST_F(CostOverlayGraph, relationAndLaneletModifications) {  // NOLINT
+  double originalCost{};
+  graph->forEachSuccessor(lanelets.at(2001), [&](const LaneletVisitInformation& i) {
+    if (i.lanelet == lanelets.at(2003)) {
+      originalCost = i.cost;
+    }
+    return i.lanelet == lanelets.at(2001);
+  });
+  ASSERT_GT(originalCost, 0.);
+  auto costTo2003 = [&]() {
+    double cost = -1.;
+    overlaidGraph->forEachSuccessor(lanelets.at(2001), [&](const LaneletVisitInformation& i) {
+      if (i.lanelet == lanelets.at(2003)) {
+        cost = i.cost;
+      }
+      return i.lanelet == lanelets.at(2001);
+    });
+    return cost;
+  };
+  overlaidGraph->updateCostOverlay([](auto& overlay) { overlay.set(2001, CostModification::multiply(3.)); });
+  EXPECT_DOUBLE_EQ(costTo2003(), 3 * originalCost);
+  overlaidGraph->updateCostOverlay([](auto& overlay) { overlay.set(2001, 2003, CostModification::absolute(0.5)); });
+  EXPECT_DOUBLE_EQ(costTo2003(), 0.5);
+  EXPECT_EQ(overlaidGraph->costOverlay().laneletModifications().size(), 1ul);
+  EXPECT_EQ(overlaidGraph->costOverlay().relationModifications().size(), 1ul);
+  overlaidGraph->updateCostOverlay([](auto& overlay) { overlay.set(2003, CostModification::blocked()); });
+  EXPECT_DOUBLE_EQ(costTo2003(), -1.);
+  overlaidGraph->updateCostOverlay([](auto& overlay) { overlay.clear(); });
+  EXPECT_DOUBLE_EQ(costTo2003(), originalCost);
+  EXPECT_TRUE(overlaidGraph->costOverlay().empty());
+}
+
+TEST_F(CostOverlayGraph, concurrentUpdatesAndQueries) {  // NOLINT
+  auto original = graph->shortestPath(lanelets.at(2001), lanelets.at(2004), 0);
+  overlaidGraph->setCostOverlay(RoutingCostOverlay().set(2003, CostModification::blocked()));
+  auto blocked = overlaidGraph->shortestPath(lanelets.at(2001), lanelets.at(2004), 0);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  std::atomic<size_t> numInvalid{0};
+  for (auto i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        auto path = overlaidGraph->shortestPath(lanelets.at(2001), lanelets.at(2004), 0);
+        numInvalid += (path != original && path != blocked) ? 1 : 0;
+      }
+    });
+  }
+  for (auto i = 0; i < 200; ++i) {
+    overlaidGraph->updateCostOverlay([i](auto& overlay) {
+      if (i % 2 == 0) {
+        overlay.reset(2003);
+      } else {
+        overlay.set(2003, CostModification::blocked());
+      }
+    });
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(numInvalid, 0ul);
+}
+
+TEST_F(GermanVehicleGraph, concurrentQueriesMatchSequentialResults) {  // NOLINT
+  // Build with LANELET2_SANITIZE_THREAD to check that the const queries are free of data races
+  auto route = graph->getRoute(lanelets.at(2001), lanelets.at(2004), 0);
+  ASSERT_TRUE(!!route);
+  ConstLanelets queried;
+  for (const auto& llt : graph->passableSubmap()->laneletLayer) {
+    queried.push_back(llt);
+    queried.push_back(llt.invert());
+  }
+  auto runQueries = [&](const ConstLanelet& llt) {
+    std::vector<Id> result;
+    auto append = [&result](const auto& primitives) {
+      for (const auto& primitive : primitives) {
+        result.push_back(primitive.id());
+      }
+      result.push_back(InvalId);
+    };
+    append(graph->following(llt, true));
+    append(graph->previous(llt, true));
+    append(graph->besides(llt));
+    append(graph->conflicting(llt));
+    append(graph->reachableSet(llt, 50., 0));
+    append(graph->shortestPath(llt, lanelets.at(2004), 0).value_or(LaneletPath{}));
+    for (const auto& path : graph->possiblePaths(llt, 3, 0, false)) {
+      append(path);
+    }
+    append(route->following(llt));
+    append(route->conflictingInMap(llt));
+    append(route->remainingLane(llt));
+    return result;
+  };
+  std::vector<std::vector<Id>> expected = utils::transform(queried, runQueries);
+
+  const auto numThreads = std::max(2U, std::min(8U, std::thread::hardware_concurrency()));
+  const auto numRounds = 20;
+  std::atomic<size_t> numWrong{0};
+  std::vector<std::thread> threads;
+  for (auto t = 0U; t < numThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (auto round = 0; round < numRounds; ++round) {
+        // every thread walks the lanelets in a different order, so that they query different things at a time
+        for (size_t i = 0; i < queried.size(); ++i) {
+          const auto idx = (i + t * queried.size() / numThreads) % queried.size();
+          numWrong += runQueries(queried[idx]) != expected[idx] ? 1 : 0;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(numWrong, 0ul);
+}
+
+TEST(VertexLookup, distinguishesPrimitivesWithTheSameId) {  // NOLINT
+  std::vector<ConstLaneletOrArea> primitives;
+  routing::internal::VertexLookup<std::uint32_t> lookup;
+  for (Id id = 1; id < 100; ++id) {
+    Lanelet llt(id, LineString3d(), LineString3d());
+    primitives.emplace_back(llt);
+    primitives.emplace_back(llt.invert());
+    primitives.emplace_back(Area(id, {}));
+  }
+  for (auto i = 0U; i < primitives.size(); ++i) {
+    lookup.insert(primitives[i].id(), i);
+  }
+  EXPECT_EQ(lookup.size(), primitives.size());
+  for (auto i = 0U; i < primitives.size(); ++i) {
+    auto found = lookup.find(primitives[i].id(), [&](std::uint32_t v) { return primitives[v] == primitives[i]; });
+    ASSERT_TRUE(!!found);
+    EXPECT_EQ(*found, i);
+  }
+  EXPECT_FALSE(!!lookup.find(100, [](std::uint32_t /*v*/) { return true; }));
+}
+
+TEST(CostModification, invalidValues) {                                       // NOLINT
+  EXPECT_THROW(CostModification::multiply(-1.), InvalidInputError);           // NOLINT
+  EXPECT_THROW(CostModification::absolute(std::nan("")), InvalidInputError);  // NOLINT
+  EXPECT_DOUBLE_EQ(CostModification::multiply(2.).apply(3.), 6.);
+  EXPECT_TRUE(std::isinf(CostModification::blocked().apply(3.)));
+}
+
+class TimeDependentCostGraph : public GermanVehicleGraph {
+ public:
+  RoutingGraphPtr timedGraph{setUpGermanVehicleGraph(*testData.laneletMap, testData.laneChangeCost)};
+  static constexpr RoutingCostId TravelTime{1};
+};
+
+TEST_F(TimeDependentCostGraph, withoutCostsEqualsShortestPath) {  // NOLINT
+  auto path = timedGraph->timeDependentShortestPath(lanelets.at(2001), lanelets.at(2004), 100., TravelTime);
+  ASSERT_TRUE(!!path);
+  EXPECT_EQ(*path, *graph->shortestPath(lanelets.at(2001), lanelets.at(2004), TravelTime));
+}
+
+TEST_F(TimeDependentCostGraph, scheduledClosure) {  // NOLINT
+  const auto original = graph->shortestPath(lanelets.at(2001), lanelets.at(2004), TravelTime);
+  timedGraph->setTimeDependentCosts(
+      TimeDependentCosts().set(2003, TimeDependentCost().block(1000., 2000.).setPeriod(86400.)));
+  auto before = timedGraph->timeDependentShortestPath(lanelets.at(2001), lanelets.at(2004), 0., TravelTime);
+  ASSERT_TRUE(!!before);
+  EXPECT_EQ(*before, *original);
+  for (auto departure : {1000., 86400. + 1500.}) {
+    auto during = timedGraph->timeDependentShortestPath(lanelets.at(2001), lanelets.at(2004), departure, TravelTime);
+    if (!!during) {
+      EXPECT_FALSE(has(*during, ConstLanelet(lanelets.at(2003))));
+    }
+  }
+  EXPECT_EQ(timedGraph->timeDependentCosts().laneletModifications().size(), 1ul);
+}
+
+TEST_F(TimeDependentCostGraph, closureAppliesWhenLaneletIsReached) {  // NOLINT
+  auto reach2004 = [&](double departure) {
+    return !!timedGraph->timeDependentShortestPath(lanelets.at(2001), lanelets.at(2004), departure, TravelTime);
+  };
+  timedGraph->setTimeDependentCosts(TimeDependentCosts().set(2004, TimeDependentCost().block(0., 1.)));
+  EXPECT_TRUE(reach2004(0.));
+  timedGraph->setTimeDependentCosts(TimeDependentCosts().set(2004, TimeDependentCost().block(2., 3.)));
+  EXPECT_FALSE(reach2004(0.));
+  EXPECT_TRUE(reach2004(1.));
+
+  // slowing down 2001 at departure lets the vehicle arrive after the closure
+  timedGraph->updateTimeDependentCosts(
+      [](auto& costs) { costs.set(2001, TimeDependentCost::multiply({{0., 100.}, {1., 1.}})); });
+  EXPECT_TRUE(reach2004(0.));
+  timedGraph->updateTimeDependentCosts([](auto& costs) { costs.clear(); });
+  EXPECT_TRUE(timedGraph->timeDependentCosts().empty());
+}
+
+TEST(TimeDependentCost, piecewiseLinear) {  // NOLINT
+  auto cost = TimeDependentCost::multiply({{10., 1.}, {20., 3.}, {20., 2.}});
+  EXPECT_DOUBLE_EQ(cost.apply(2., 0.), 2.);
+  EXPECT_DOUBLE_EQ(cost.apply(2., 15.), 4.);
+  EXPECT_DOUBLE_EQ(cost.apply(2., 20.), 4.);
+  EXPECT_DOUBLE_EQ(cost.apply(2., 100.), 4.);
+  EXPECT_DOUBLE_EQ(TimeDependentCost::absolute({{0., 5.}}).apply(2., 3.), 5.);
+  EXPECT_DOUBLE_EQ(TimeDependentCost().apply(2., 3.), 2.);
+}
+
+TEST(TimeDependentCost, periodAndBlockedWindows) {  // NOLINT
+  auto cost = TimeDependentCost::multiply({{0., 1.}, {10., 2.}}).block(5., 6.).setPeriod(20.);
+  EXPECT_DOUBLE_EQ(cost.apply(1., 27.), 1.7);
+  EXPECT_DOUBLE_EQ(cost.apply(1., -12.), 1.8);
+  EXPECT_TRUE(cost.isBlocked(45.5));
+  EXPECT_TRUE(std::isinf(cost.apply(1., 5.)));
+  EXPECT_FALSE(cost.isBlocked(6.));
+}
+
+TEST(TimeDependentCost, invalidValues) {                                                 // NOLINT
+  EXPECT_THROW(TimeDependentCost::multiply({}), InvalidInputError);                      // NOLINT
+  EXPECT_THROW(TimeDependentCost::multiply({{1., 1.}, {0., 1.}}), InvalidInputError);    // NOLINT
+  EXPECT_THROW(TimeDependentCost::absolute({{0., -1.}}), InvalidInputError);             // NOLINT
+  EXPECT_THROW(TimeDependentCost().block(2., 1.), InvalidInputError);                    // NOLINT
+  EXPECT_THROW(TimeDependentCost().setPeriod(std::nan("")), InvalidInputError);          // NOLINT
+}
+
 TEST(RoutingCostInitialization, NegativeLaneChangeCost) {    // NOLINT
   EXPECT_NO_THROW(RoutingCostDistance(1));                   // NOLINT
   EXPECT_THROW(RoutingCostDistance(-1), InvalidInputError);  // NOLINT
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <lanelet2_core/LaneletMap.h>
+#include <algorithm>
+#include <string>
 #include "lanelet2_routing/Forward.h"
+#include "lanelet2_routing/MultiParticipantRoutingGraph.h"
 #include "lanelet2_routing/RoutingGraph.h"
 #include "lanelet2_routing/RoutingGraphContainer.h"
 #include "test_routing_map.h"
@@ -34,6 +37,152 @@ class RouteRoutingGraphContainerTest : public RoutingGraphContainerTest {
   std::unique_ptr<Route> route;
 };
 
+class MultiParticipantGraphTest : public RoutingGraphTest {
+ public:
+  MultiParticipantGraphTest() {
+    using traffic_rules::TrafficRulesFactory;
+    MultiParticipantRoutingGraph::Participant vehicle{
+        TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle),
+        {std::make_shared<RoutingCostDistance>(testData.laneChangeCost),
+         std::make_shared<RoutingCostTravelTime>(testData.laneChangeCost)},
+        {{RoutingGraph::ParticipantHeight, Attribute(2.)}}};
+    MultiParticipantRoutingGraph::Participant pedestrian{
+        TrafficRulesFactory::create(Locations::Germany, Participants::Pedestrian),
+        {std::make_shared<RoutingCostDistance>(testData.laneChangeCost)}};
+    MultiParticipantRoutingGraph::Participant bicycle{
+        TrafficRulesFactory::create(Locations::Germany, Participants::Bicycle),
+        {std::make_shared<RoutingCostDistance>(testData.laneChangeCost)}};
+    graphs = MultiParticipantRoutingGraph::build(*laneletMap, {vehicle, pedestrian, bicycle});
+  }
+
+  MultiParticipantRoutingGraphUPtr graphs;
+  std::vector<RoutingGraphConstPtr> separateGraphs{testData.vehicleGraph, testData.pedestrianGraph,
+                                                   testData.bicycleGraph};
+};
+
+namespace {
+std::string describe(const ConstLaneletOrArea& laneletOrArea) {
+  auto lanelet = laneletOrArea.lanelet();
+  return std::to_string(laneletOrArea.id()) + (lanelet && lanelet->inverted() ? "-" : "+");
+}
+
+std::vector<std::string> describe(const ConstLaneletOrAreas& primitives) {
+  auto result = utils::transform(primitives, [](auto& p) { return describe(p); });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+std::vector<std::string> describe(const LaneletRelations& relations) {
+  auto result =
+      utils::transform(relations, [](auto& r) { return describe(r.lanelet) + relationToString(r.relationType); });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void expectSameRelations(const RoutingGraph& graph, const RoutingGraph& expected, const ConstLanelet& llt) {
+  EXPECT_EQ(describe(graph.followingRelations(llt, true)), describe(expected.followingRelations(llt, true)));
+  EXPECT_EQ(describe(graph.previousRelations(llt, true)), describe(expected.previousRelations(llt, true)));
+  EXPECT_EQ(describe(graph.leftRelations(llt)), describe(expected.leftRelations(llt)));
+  EXPECT_EQ(describe(graph.rightRelations(llt)), describe(expected.rightRelations(llt)));
+  EXPECT_EQ(describe(graph.conflicting(llt)), describe(expected.conflicting(llt)));
+  EXPECT_EQ(describe(graph.reachableSetIncludingAreas(llt, 100)),
+            describe(expected.reachableSetIncludingAreas(llt, 100)));
+}
+}  // namespace
+
+TEST_F(MultiParticipantGraphTest, SameRelationsAsSeparateGraphs) {  // NOLINT
+  ASSERT_EQ(graphs->size(), separateGraphs.size());
+  for (size_t participant = 0; participant < graphs->size(); ++participant) {
+    const auto& graph = graphs->graph(participant);
+    const auto& expected = *separateGraphs[participant];
+    EXPECT_EQ(graph.passableSubmap()->laneletLayer.size(), expected.passableSubmap()->laneletLayer.size());
+    EXPECT_EQ(graph.passableSubmap()->areaLayer.size(), expected.passableSubmap()->areaLayer.size());
+    for (const auto& llt : laneletMap->laneletLayer) {
+      expectSameRelations(graph, expected, llt);
+      expectSameRelations(graph, expected, llt.invert());
+    }
+    for (const auto& area : laneletMap->areaLayer) {
+      EXPECT_EQ(describe(graph.conflicting(ConstArea(area))), describe(expected.conflicting(ConstArea(area))));
+      EXPECT_EQ(describe(graph.reachableSetIncludingAreas(ConstArea(area), 100)),
+                describe(expected.reachableSetIncludingAreas(ConstArea(area), 100)));
+    }
+    EXPECT_TRUE(graph.checkValidity(false).empty());
+  }
+}
+
+TEST_F(MultiParticipantGraphTest, SameQueryResultsAsSeparateGraphs) {  // NOLINT
+  auto toPrimitives = [](const ConstLanelets& llts) {
+    return utils::transform(llts, [](auto& l) { return ConstLaneletOrArea(l); });
+  };
+  std::vector<RoutingCostId> numRoutingCosts{2, 1, 1};
+  for (size_t participant = 0; participant < graphs->size(); ++participant) {
+    const auto& expected = *separateGraphs[participant];
+    for (const auto& from : laneletMap->laneletLayer) {
+      for (const auto& llt : {ConstLanelet(from), ConstLanelet(from).invert()}) {
+        for (bool withLaneChanges : {true, false}) {
+          EXPECT_EQ(describe(toPrimitives(graphs->following(participant, llt, withLaneChanges))),
+                    describe(toPrimitives(expected.following(llt, withLaneChanges))));
+          for (RoutingCostId costId = 0; costId < numRoutingCosts[participant]; ++costId) {
+            EXPECT_EQ(describe(toPrimitives(graphs->reachableSet(participant, llt, 50, costId, withLaneChanges))),
+                      describe(toPrimitives(expected.reachableSet(llt, 50, costId, withLaneChanges))));
+          }
+        }
+      }
+      for (const auto& to : laneletMap->laneletLayer) {
+        auto path = graphs->shortestPath(participant, from, to, 0, true);
+        auto expectedPath = expected.shortestPath(from, to, 0, true);
+        ASSERT_EQ(!!path, !!expectedPath);
+        if (!!path) {
+          EXPECT_EQ(path->size(), expectedPath->size());
+          EXPECT_EQ(path->front(), from);
+          EXPECT_EQ(path->back(), to);
+        }
+      }
+    }
+  }
+  EXPECT_THROW(graphs->reachableSet(1, lanelets.at(2020), 10, 1), InvalidInputError);  // NOLINT
+}
+
+TEST_F(MultiParticipantGraphTest, PassableBy) {  // NOLINT
+  EXPECT_EQ(graphs->participant(0), Participants::Vehicle);
+  EXPECT_EQ(*graphs->find(Participants::Pedestrian), 1ul);
+  EXPECT_FALSE(!!graphs->find("unicorn"));
+  for (size_t participant = 0; participant < graphs->size(); ++participant) {
+    auto passable = graphs->graph(participant).passableSubmap();
+    for (const auto& llt : laneletMap->laneletLayer) {
+      EXPECT_EQ(graphs->canPass(participant, llt), passable->laneletLayer.exists(llt.id()));
+      EXPECT_EQ(!!(graphs->passableBy(llt) & (1ul << participant)), passable->laneletLayer.exists(llt.id()));
+    }
+    for (const auto& area : laneletMap->areaLayer) {
+      EXPECT_EQ(graphs->canPass(participant, ConstArea(area)), passable->areaLayer.exists(area.id()));
+    }
+  }
+  // 2020 can be used in both directions, 2001 only in one
+  EXPECT_TRUE(graphs->canPass(0, lanelets.at(2020).invert()));
+  EXPECT_TRUE(graphs->canPass(0, lanelets.at(2001)));
+  EXPECT_FALSE(graphs->canPass(0, lanelets.at(2001).invert()));
+  EXPECT_THROW(graphs->canPass(3, lanelets.at(2020)), InvalidInputError);  // NOLINT
+  EXPECT_THROW(graphs->graph(3), InvalidInputError);                       // NOLINT
+}
+
+TEST_F(MultiParticipantGraphTest, ConflictingInGraph) {  // NOLINT
+  RoutingGraphContainer container(separateGraphs);
+  for (const auto& llt : laneletMap->laneletLayer) {
+    for (size_t participant = 0; participant < graphs->size(); ++participant) {
+      for (double height : {0., 4.}) {
+        auto conflicting = utils::transform(graphs->conflictingInGraph(llt, participant, height),
+                                            [](auto& l) { return ConstLaneletOrArea(l); });
+        auto expected = utils::transform(container.conflictingInGraph(llt, participant, height),
+                                         [](auto& l) { return ConstLaneletOrArea(l); });
+        EXPECT_EQ(describe(conflicting), describe(expected));
+      }
+    }
+  }
+  ConstLanelets conflictingVehicle{graphs->conflictingInGraph(lanelets.at(2031), 0)};
+  ASSERT_EQ(conflictingVehicle.size(), 1ul);
+  EXPECT_EQ(conflictingVehicle[0], lanelets.at(2020));
+}
+
 TEST_F(RoutingGraphContainerTest, ConflictingInGraph) {  // NOLINT
   ConstLanelet pedestrianLanelet{*laneletMap->laneletLayer.find(2031)};
   ConstLanelets conflictingVehicle{container->conflictingInGraph(pedestrianLanelet, 0)};
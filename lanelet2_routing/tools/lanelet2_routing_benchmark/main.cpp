@@ -0,0 +1,244 @@
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "lanelet2_routing/MultiParticipantRoutingGraph.h"
+#include "lanelet2_routing/Route.h"
+#include "lanelet2_routing/RoutingGraph.h"
+
+// Measures routing queries on a synthetic straight highway: the searches a behavior planner repeats in every cycle and
+// the throughput of concurrent queries. Also compares the memory and build time of separate graphs for several
+// participants with a MultiParticipantRoutingGraph.
+// usage: lanelet2_routing_benchmark [lanes] [lanelets per lane] [threads]
+
+namespace {
+//! Bytes currently allocated with new. Every allocation stores its size in front of the memory it returns.
+std::atomic<size_t> allocatedBytes{0};
+constexpr size_t AllocationHeader = alignof(std::max_align_t);
+}  // namespace
+
+void* operator new(size_t size) {
+  auto* memory = static_cast<char*>(std::malloc(size + AllocationHeader));
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<size_t*>(memory) = size;
+  allocatedBytes += size;
+  return memory + AllocationHeader;
+}
+void operator delete(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto* memory = static_cast<char*>(ptr) - AllocationHeader;
+  allocatedBytes -= *reinterpret_cast<size_t*>(memory);
+  std::free(memory);
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t /*size*/) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t /*size*/) noexcept { operator delete(ptr); }
+
+namespace {
+using namespace lanelet;
+using namespace lanelet::routing;
+
+constexpr double LaneletLength = 10.;
+constexpr double LaneWidth = 3.5;
+
+//! Lanes next to each other, separated by dashed lines so that the lane can be changed everywhere
+LaneletMapUPtr makeHighway(size_t numLanes, size_t length) {
+  std::vector<std::vector<Point3d>> points(numLanes + 1);
+  for (auto b = 0u; b <= numLanes; ++b) {
+    for (auto s = 0u; s <= length; ++s) {
+      points[b].emplace_back(utils::getId(), s * LaneletLength, b * LaneWidth, 0.);
+    }
+  }
+  auto boundary = [&](size_t b, size_t s) {
+    LineString3d line(utils::getId(), {points[b][s], points[b][s + 1]});
+    const bool isOuter = b == 0 || b == numLanes;
+    line.setAttribute(AttributeName::Type, AttributeValueString::LineThin);
+    line.setAttribute(AttributeName::Subtype, isOuter ? AttributeValueString::Solid : AttributeValueString::Dashed);
+    return line;
+  };
+  std::vector<std::vector<LineString3d>> boundaries(numLanes + 1);
+  for (auto b = 0u; b <= numLanes; ++b) {
+    for (auto s = 0u; s < length; ++s) {
+      boundaries[b].push_back(boundary(b, s));
+    }
+  }
+  auto map = std::make_unique<LaneletMap>();
+  for (auto l = 0u; l < numLanes; ++l) {
+    for (auto s = 0u; s < length; ++s) {
+      Lanelet llt(utils::getId(), boundaries[l + 1][s], boundaries[l][s]);
+      llt.setAttribute(AttributeName::Type, AttributeValueString::Lanelet);
+      llt.setAttribute(AttributeName::Subtype, AttributeValueString::Road);
+      llt.setAttribute(AttributeName::Location, AttributeValueString::Nonurban);
+      llt.setAttribute(AttributeName::OneWay, true);
+      map->add(llt);
+    }
+  }
+  return map;
+}
+
+template <typename Func>
+double measureMs(Func&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//! The const queries a planner typically runs for the lanelet a vehicle is on. Returns the number of results.
+size_t runQueries(const RoutingGraph& graph, const Route& route, const ConstLanelet& llt, const ConstLanelet& goal) {
+  size_t numResults = 0;
+  numResults += graph.following(llt, true).size();
+  numResults += graph.previous(llt, true).size();
+  numResults += graph.besides(llt).size();
+  numResults += graph.reachableSet(llt, 50.).size();
+  numResults += graph.shortestPath(llt, goal) ? 1 : 0;
+  numResults += graph.possiblePaths(llt, uint32_t(3), false).size();
+  numResults += route.following(llt).size();
+  numResults += route.remainingLane(llt).size();
+  return numResults;
+}
+
+//! Repeats the searches a behavior planner runs around the vehicle in every cycle for every lanelet and prints the time
+//! per search
+void benchmarkRepeatedSearches(const RoutingGraph& graph, const ConstLanelets& lanelets) {
+  constexpr size_t NumRounds = 20;
+  constexpr double Horizon = 100.;
+  size_t numResults = 0;
+  auto perSearch = [&](double elapsed) { return elapsed * 1000. / double(NumRounds * lanelets.size()); };
+  const auto successorTime = measureMs([&] {
+    for (auto round = 0u; round < NumRounds; ++round) {
+      for (const auto& llt : lanelets) {
+        graph.forEachSuccessor(llt, [&](const LaneletVisitInformation& i) {
+          ++numResults;
+          return i.cost < Horizon;
+        });
+      }
+    }
+  });
+  const auto reachableTime = measureMs([&] {
+    for (auto round = 0u; round < NumRounds; ++round) {
+      for (const auto& llt : lanelets) {
+        numResults += graph.reachableSet(llt, Horizon).size();
+      }
+    }
+  });
+  const auto reachableInLaneTime = measureMs([&] {
+    for (auto round = 0u; round < NumRounds; ++round) {
+      for (const auto& llt : lanelets) {
+        numResults += graph.reachableSet(llt, Horizon, {}, false).size();
+      }
+    }
+  });
+  std::cout << "forEachSuccessor within " << Horizon << ": " << perSearch(successorTime) << " us\n";
+  std::cout << "reachableSet within " << Horizon << ": " << perSearch(reachableTime) << " us\n";
+  std::cout << "reachableSet within " << Horizon << " without lane changes: " << perSearch(reachableInLaneTime)
+            << " us (" << numResults << " results)\n";
+}
+
+//! Five participants with different traffic rules or routing costs, like the ones a traffic simulation needs
+MultiParticipantRoutingGraph::Participants makeParticipants() {
+  using traffic_rules::TrafficRulesFactory;
+  const traffic_rules::TrafficRulesPtr vehicle = TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  MultiParticipantRoutingGraph::Participants participants;
+  participants.push_back({vehicle});
+  // a truck that avoids lane changes and a bus that only cares about the distance
+  participants.push_back(
+      {vehicle, {std::make_shared<RoutingCostDistance>(50.), std::make_shared<RoutingCostTravelTime>(50.)}});
+  participants.push_back({vehicle, {std::make_shared<RoutingCostDistance>(0.)}});
+  for (const auto& other : {Participants::Bicycle, Participants::Pedestrian}) {
+    participants.push_back({TrafficRulesFactory::create(Locations::Germany, other)});
+  }
+  return participants;
+}
+
+//! Builds a RoutingGraph for each participant and a MultiParticipantRoutingGraph and prints their memory and build time
+void benchmarkParticipants(const LaneletMap& map) {
+  const auto participants = makeParticipants();
+  auto before = allocatedBytes.load();
+  std::vector<RoutingGraphUPtr> graphs;
+  const auto separateTime = measureMs([&] {
+    for (const auto& participant : participants) {
+      graphs.push_back(
+          RoutingGraph::build(map, *participant.trafficRules, participant.routingCosts, participant.config));
+    }
+  });
+  const auto separateBytes = allocatedBytes.load() - before;
+  graphs.clear();
+
+  before = allocatedBytes.load();
+  MultiParticipantRoutingGraphUPtr multiGraph;
+  const auto multiTime = measureMs([&] { multiGraph = MultiParticipantRoutingGraph::build(map, participants); });
+  const auto multiBytes = allocatedBytes.load() - before;
+  std::cout << participants.size() << " participants: separate graphs " << separateBytes / 1024 << " KiB, built in "
+            << separateTime << " ms; multi participant graph " << multiBytes / 1024 << " KiB, built in " << multiTime
+            << " ms\n";
+}
+
+//! Runs the queries for every lanelet on each of the threads at the same time and prints the throughput
+void benchmarkConcurrentQueries(const RoutingGraph& graph, const Route& route, const ConstLanelets& lanelets,
+                                const ConstLanelet& goal, size_t numThreads) {
+  constexpr size_t NumRounds = 5;
+  std::vector<size_t> numResults(numThreads);
+  const auto elapsed = measureMs([&] {
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < numThreads; ++t) {
+      threads.emplace_back([&, t] {
+        for (auto round = 0u; round < NumRounds; ++round) {
+          for (const auto& llt : lanelets) {
+            numResults[t] += runQueries(graph, route, llt, goal);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+  const auto numQueries = double(numThreads * NumRounds * lanelets.size());
+  std::cout << "concurrent queries, " << numThreads << " threads: " << numQueries / elapsed * 1000.
+            << " lanelets/s (" << elapsed << " ms)\n";
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const size_t numLanes = argc > 1 ? std::stoul(argv[1]) : 4;
+  const size_t length = argc > 2 ? std::stoul(argv[2]) : 100;
+  const size_t maxThreads = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+  auto map = makeHighway(numLanes, length);
+  auto trafficRules = traffic_rules::TrafficRulesFactory::create(Locations::Germany, Participants::Vehicle);
+  RoutingGraphUPtr graph;
+  const auto buildTime = measureMs([&] { graph = RoutingGraph::build(*map, *trafficRules); });
+  std::cout << "highway of " << numLanes << " lanes with " << length << " lanelets each, graph built in " << buildTime
+            << " ms\n";
+
+  ConstLanelets lanelets(map->laneletLayer.begin(), map->laneletLayer.end());
+  std::sort(lanelets.begin(), lanelets.end(), [](auto& lhs, auto& rhs) { return lhs.id() < rhs.id(); });
+  // from the start of the rightmost lane to the end of the leftmost one
+  const auto start = lanelets.front();
+  const auto goal = lanelets.back();
+  auto route = graph->getRoute(start, goal);
+  if (!route) {
+    std::cerr << "no route on the highway\n";
+    return 1;
+  }
+
+  benchmarkParticipants(*map);
+  benchmarkRepeatedSearches(*graph, lanelets);
+  for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    benchmarkConcurrentQueries(*graph, *route, lanelets, goal, numThreads);
+  }
+  return 0;
+}
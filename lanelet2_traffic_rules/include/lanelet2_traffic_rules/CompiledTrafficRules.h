@@ -0,0 +1,62 @@
+#pragma once
+#include <lanelet2_core/LaneletMap.h>
+#include <memory>
+#include "lanelet2_traffic_rules/GenericTrafficRules.h"
+
+namespace lanelet {
+namespace traffic_rules {
+
+/** @brief Traffic rules that were evaluated in advance for all lanelets and areas of a map
+ *
+ *  GenericTrafficRules interpret the attributes of a primitive (type, subtype, location, participant and one way
+ *  overrides, ...) on every call. Routing graph builders, validators and planners ask the same questions for the same
+ *  primitives over and over again. CompiledTrafficRules evaluate the rules they wrap once for every lanelet, area and
+ *  lanelet or area boundary of a map, using several threads, and store the results in flat tables indexed by id:
+ *  whether the primitive is passable (in both directions for lanelets), whether it is one way, whether it has dynamic
+ *  rules, its speed limit and the lane change type of boundaries. Afterwards, all functions of the TrafficRules
+ *  interface only look up these tables and compare the geometry of the primitives.
+ *
+ *  Primitives that are not part of the map are forwarded to the wrapped rules, as are primitives that only share the id
+ *  with one of the map. The tables are a snapshot: If attributes or regulatory elements of the map are changed, the
+ *  rules have to be compiled again.
+ *
+ *  Functions that involve two primitives are evaluated like GenericTrafficRules does, but with the compiled results.
+ *  If the wrapped rules override them, the overrides are not used. All member functions can be called from several
+ *  threads at the same time.
+ */
+class CompiledTrafficRules : public GenericTrafficRules {  // NOLINT
+ public:
+  /** @brief Evaluates the rules for all lanelets and areas of the map
+   *  @param numThreads number of threads used for the evaluation. 0 uses one thread per core.
+   *  @throws InvalidInputError if the rules are not derived from GenericTrafficRules */
+  CompiledTrafficRules(TrafficRulesPtr rules, const LaneletMapLayers& map, size_t numThreads = 0);
+  ~CompiledTrafficRules() override;
+
+  bool canPass(const ConstLanelet& lanelet) const override;
+  bool canPass(const ConstArea& area) const override;
+  using GenericTrafficRules::canPass;
+
+  SpeedLimitInformation speedLimit(const ConstLanelet& lanelet) const override;
+  SpeedLimitInformation speedLimit(const ConstArea& area) const override;
+
+  bool isOneWay(const ConstLanelet& lanelet) const override;
+  bool hasDynamicRules(const ConstLanelet& lanelet) const override;
+
+  //! The rules that were compiled
+  const GenericTrafficRules& uncompiled() const noexcept { return *rules_; }
+
+ protected:
+  Optional<bool> canPass(const RegulatoryElementConstPtrs& regElems) const override;
+  Optional<bool> canPass(const std::string& type, const std::string& location) const override;
+  LaneChangeType laneChangeType(const ConstLineString3d& boundary, bool virtualIsPassable) const override;
+  const CountrySpeedLimits& countrySpeedLimits() const override;
+  Optional<SpeedLimitInformation> speedLimit(const RegulatoryElementConstPtrs& regelems) const override;
+
+ private:
+  struct Tables;
+  std::shared_ptr<const GenericTrafficRules> rules_;
+  std::unique_ptr<const Tables> tables_;
+};
+
+}  // namespace traffic_rules
+}  // namespace lanelet
@@ -25,6 +25,8 @@ using TrafficRulesUPtr = std::unique_ptr<TrafficRules>;
 //! to make sense for most countries and participants. Country specific details (traffic signs, speed limits
 //! regulations, ...) must be implemented by inheriting classes.
 class GenericTrafficRules : public TrafficRules {  // NOLINT
+  friend class CompiledTrafficRules;
+
  public:
   using TrafficRules::TrafficRules;
 
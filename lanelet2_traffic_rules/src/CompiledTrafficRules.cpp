@@ -0,0 +1,261 @@
+#include "lanelet2_traffic_rules/CompiledTrafficRules.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace lanelet {
+namespace traffic_rules {
+namespace {
+/** A flat open addressing table with a fixed capacity. The data pointer of the primitive is stored along with its id,
+ *  so that primitives that only share the id with a compiled one are not found. */
+template <typename ValueT>
+class IdTable {
+ public:
+  explicit IdTable(size_t size) {
+    size_t capacity = 16;
+    while (capacity < 2 * size) {
+      capacity *= 2;
+      --shift_;
+    }
+    slots_.resize(capacity);
+  }
+
+  void insert(Id id, const void* data, const ValueT& value) {
+    auto i = bucket(id);
+    while (slots_[i].data != nullptr) {
+      i = (i + 1) & (slots_.size() - 1);
+    }
+    slots_[i] = Slot{id, data, value};
+  }
+
+  const ValueT* find(Id id, const void* data) const noexcept {
+    for (auto i = bucket(id); slots_[i].data != nullptr; i = (i + 1) & (slots_.size() - 1)) {
+      if (slots_[i].data == data) {
+        return &slots_[i].value;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  struct Slot {
+    Id id{};
+    const void* data{nullptr};  //!< nullptr if the slot is empty
+    ValueT value{};
+  };
+
+  //! Fibonacci hashing, spreads consecutive ids over the whole table
+  size_t bucket(Id id) const noexcept { return size_t((std::uint64_t(id) * 0x9E3779B97F4A7C15ULL) >> shift_); }
+
+  std::vector<Slot> slots_;
+  unsigned shift_{60};  //!< 64 - log2(capacity)
+};
+
+enum LaneletFlags : std::uint8_t {
+  CanPass = 0b1,
+  CanPassInverted = 0b10,
+  IsOneWay = 0b100,
+  HasDynamicRules = 0b1000,
+};
+
+struct LaneletRules {
+  SpeedLimitInformation speedLimit;
+  std::uint8_t flags{};
+};
+
+struct AreaRules {
+  SpeedLimitInformation speedLimit;
+  bool canPass{};
+};
+
+//! Lane change types of a boundary in its original orientation
+struct BoundaryRules {
+  LaneChangeType laneChange{LaneChangeType::None};
+  LaneChangeType laneChangeVirtualIsPassable{LaneChangeType::None};
+};
+
+LaneChangeType invert(LaneChangeType type) {
+  if (type == LaneChangeType::ToLeft) {
+    return LaneChangeType::ToRight;
+  }
+  if (type == LaneChangeType::ToRight) {
+    return LaneChangeType::ToLeft;
+  }
+  return type;
+}
+
+//! Evaluates func for all elements. Threads take chunks of elements until all are done.
+template <typename T, typename Func>
+auto evaluate(const std::vector<T>& elements, size_t numThreads, Func&& func) {
+  constexpr size_t ChunkSize = 256;
+  std::vector<decltype(func(elements.front()))> results(elements.size());
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto work = [&] {
+    try {
+      for (auto begin = next.fetch_add(ChunkSize); begin < elements.size(); begin = next.fetch_add(ChunkSize)) {
+        const auto end = std::min(begin + ChunkSize, elements.size());
+        for (auto i = begin; i < end; ++i) {
+          results[i] = func(elements[i]);
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      error = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  const auto numWorkers = std::min(numThreads, (elements.size() + ChunkSize - 1) / ChunkSize);
+  for (auto i = 1u; i < numWorkers; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return results;
+}
+
+std::shared_ptr<const GenericTrafficRules> toGeneric(TrafficRulesPtr rules) {
+  auto generic = std::dynamic_pointer_cast<const GenericTrafficRules>(std::move(rules));
+  if (!generic) {
+    throw InvalidInputError("Only traffic rules that are derived from GenericTrafficRules can be compiled");
+  }
+  return generic;
+}
+
+ConstLineString3d nonInverted(const ConstLineString3d& lineString) {
+  return lineString.inverted() ? lineString.invert() : lineString;
+}
+}  // namespace
+
+struct CompiledTrafficRules::Tables {
+  Tables(size_t numLanelets, size_t numAreas, size_t numBoundaries)
+      : lanelets{numLanelets}, areas{numAreas}, boundaries{numBoundaries} {}
+  IdTable<LaneletRules> lanelets;
+  IdTable<AreaRules> areas;
+  IdTable<BoundaryRules> boundaries;
+};
+
+CompiledTrafficRules::CompiledTrafficRules(TrafficRulesPtr rules, const LaneletMapLayers& map, size_t numThreads)
+    : GenericTrafficRules(rules ? rules->configuration() : Configuration()), rules_{toGeneric(std::move(rules))} {
+  if (numThreads == 0) {
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const std::vector<ConstLanelet> lanelets(map.laneletLayer.begin(), map.laneletLayer.end());
+  const std::vector<ConstArea> areas(map.areaLayer.begin(), map.areaLayer.end());
+  std::vector<ConstLineString3d> boundaries;
+  std::unordered_set<const void*> knownBoundaries;
+  auto addBoundary = [&](const ConstLineString3d& boundary) {
+    if (knownBoundaries.insert(boundary.constData().get()).second) {
+      boundaries.push_back(nonInverted(boundary));
+    }
+  };
+  for (const auto& llt : lanelets) {
+    addBoundary(llt.leftBound());
+    addBoundary(llt.rightBound());
+  }
+  for (const auto& area : areas) {
+    for (const auto& boundary : area.outerBound()) {
+      addBoundary(boundary);
+    }
+  }
+
+  const auto& generic = *rules_;
+  auto laneletRules = evaluate(lanelets, numThreads, [&](const ConstLanelet& llt) {
+    LaneletRules result{generic.speedLimit(llt), 0};
+    result.flags |= generic.canPass(llt) ? CanPass : 0;
+    result.flags |= generic.canPass(llt.invert()) ? CanPassInverted : 0;
+    result.flags |= generic.isOneWay(llt) ? IsOneWay : 0;
+    result.flags |= generic.hasDynamicRules(llt) ? HasDynamicRules : 0;
+    return result;
+  });
+  auto areaRules = evaluate(areas, numThreads, [&](const ConstArea& area) {
+    return AreaRules{generic.speedLimit(area), generic.canPass(area)};
+  });
+  auto boundaryRules = evaluate(boundaries, numThreads, [&](const ConstLineString3d& boundary) {
+    return BoundaryRules{generic.laneChangeType(boundary, false), generic.laneChangeType(boundary, true)};
+  });
+
+  auto tables = std::make_unique<Tables>(lanelets.size(), areas.size(), boundaries.size());
+  for (auto i = 0u; i < lanelets.size(); ++i) {
+    tables->lanelets.insert(lanelets[i].id(), lanelets[i].constData().get(), laneletRules[i]);
+  }
+  for (auto i = 0u; i < areas.size(); ++i) {
+    tables->areas.insert(areas[i].id(), areas[i].constData().get(), areaRules[i]);
+  }
+  for (auto i = 0u; i < boundaries.size(); ++i) {
+    tables->boundaries.insert(boundaries[i].id(), boundaries[i].constData().get(), boundaryRules[i]);
+  }
+  tables_ = std::move(tables);
+}
+
+CompiledTrafficRules::~CompiledTrafficRules() = default;
+
+bool CompiledTrafficRules::canPass(const ConstLanelet& lanelet) const {
+  const auto* rules = tables_->lanelets.find(lanelet.id(), lanelet.constData().get());
+  if (rules == nullptr) {
+    return rules_->canPass(lanelet);
+  }
+  return (rules->flags & (lanelet.inverted() ? CanPassInverted : CanPass)) != 0;
+}
+
+bool CompiledTrafficRules::canPass(const ConstArea& area) const {
+  const auto* rules = tables_->areas.find(area.id(), area.constData().get());
+  return rules == nullptr ? rules_->canPass(area) : rules->canPass;
+}
+
+SpeedLimitInformation CompiledTrafficRules::speedLimit(const ConstLanelet& lanelet) const {
+  const auto* rules = tables_->lanelets.find(lanelet.id(), lanelet.constData().get());
+  return rules == nullptr ? rules_->speedLimit(lanelet) : rules->speedLimit;
+}
+
+SpeedLimitInformation CompiledTrafficRules::speedLimit(const ConstArea& area) const {
+  const auto* rules = tables_->areas.find(area.id(), area.constData().get());
+  return rules == nullptr ? rules_->speedLimit(area) : rules->speedLimit;
+}
+
+bool CompiledTrafficRules::isOneWay(const ConstLanelet& lanelet) const {
+  const auto* rules = tables_->lanelets.find(lanelet.id(), lanelet.constData().get());
+  return rules == nullptr ? rules_->isOneWay(lanelet) : (rules->flags & IsOneWay) != 0;
+}
+
+bool CompiledTrafficRules::hasDynamicRules(const ConstLanelet& lanelet) const {
+  const auto* rules = tables_->lanelets.find(lanelet.id(), lanelet.constData().get());
+  return rules == nullptr ? rules_->hasDynamicRules(lanelet) : (rules->flags & HasDynamicRules) != 0;
+}
+
+LaneChangeType CompiledTrafficRules::laneChangeType(const ConstLineString3d& boundary, bool virtualIsPassable) const {
+  const auto* rules = tables_->boundaries.find(boundary.id(), boundary.constData().get());
+  if (rules == nullptr) {
+    return rules_->laneChangeType(boundary, virtualIsPassable);
+  }
+  const auto type = virtualIsPassable ? rules->laneChangeVirtualIsPassable : rules->laneChange;
+  return boundary.inverted() ? invert(type) : type;
+}
+
+Optional<bool> CompiledTrafficRules::canPass(const RegulatoryElementConstPtrs& regElems) const {
+  return rules_->canPass(regElems);
+}
+
+Optional<bool> CompiledTrafficRules::canPass(const std::string& type, const std::string& location) const {
+  return rules_->canPass(type, location);
+}
+
+const CountrySpeedLimits& CompiledTrafficRules::countrySpeedLimits() const { return rules_->countrySpeedLimits(); }
+
+Optional<SpeedLimitInformation> CompiledTrafficRules::speedLimit(const RegulatoryElementConstPtrs& regelems) const {
+  return rules_->speedLimit(regelems);
+}
+
+}  // namespace traffic_rules
+}  // namespace lanelet
@@ -2,6 +2,7 @@
 #include <lanelet2_core/primitives/Lanelet.h>
 #include <lanelet2_core/utility/Units.h>
 #include "gtest/gtest.h"
+#include "lanelet2_traffic_rules/CompiledTrafficRules.h"
 #include "lanelet2_traffic_rules/TrafficRules.h"
 #include "lanelet2_traffic_rules/TrafficRulesFactory.h"
 
@@ -546,3 +547,82 @@ TEST_F(GermanTrafficRulesVehicle, factoryReturnsVehicleForCar) {  // NOLINT
   EXPECT_EQ(trafficRules->participant(), Participants::VehicleCar);
 }
 }  // namespace other
+
+namespace compiled {
+void expectSameRules(const lanelet::traffic_rules::TrafficRules& compiled,
+                     const lanelet::traffic_rules::TrafficRules& rules, const lanelet::ConstLanelets& lanelets,
+                     const lanelet::ConstAreas& areas) {
+  using namespace lanelet;
+  ConstLanelets allLanelets;
+  for (const auto& llt : lanelets) {
+    allLanelets.push_back(llt);
+    allLanelets.push_back(llt.invert());
+  }
+  for (const auto& llt : allLanelets) {
+    EXPECT_EQ(compiled.canPass(llt), rules.canPass(llt)) << llt;
+    EXPECT_EQ(compiled.isOneWay(llt), rules.isOneWay(llt)) << llt;
+    EXPECT_EQ(compiled.hasDynamicRules(llt), rules.hasDynamicRules(llt)) << llt;
+    EXPECT_EQ(compiled.speedLimit(llt).speedLimit, rules.speedLimit(llt).speedLimit) << llt;
+    EXPECT_EQ(compiled.speedLimit(llt).isMandatory, rules.speedLimit(llt).isMandatory) << llt;
+    for (const auto& other : allLanelets) {
+      EXPECT_EQ(compiled.canPass(llt, other), rules.canPass(llt, other)) << llt << " -> " << other;
+      EXPECT_EQ(compiled.canChangeLane(llt, other), rules.canChangeLane(llt, other)) << llt << " -> " << other;
+    }
+    for (const auto& area : areas) {
+      EXPECT_EQ(compiled.canPass(llt, area), rules.canPass(llt, area)) << llt << " -> " << area;
+      EXPECT_EQ(compiled.canPass(area, llt), rules.canPass(area, llt)) << area << " -> " << llt;
+    }
+  }
+  for (const auto& area : areas) {
+    EXPECT_EQ(compiled.canPass(area), rules.canPass(area)) << area;
+    EXPECT_EQ(compiled.speedLimit(area).speedLimit, rules.speedLimit(area).speedLimit) << area;
+    for (const auto& other : areas) {
+      EXPECT_EQ(compiled.canPass(area, other), rules.canPass(area, other)) << area << " -> " << other;
+    }
+  }
+}
+
+class CompiledTrafficRules : public TrafficRules {
+ public:
+  CompiledTrafficRules() {
+    ls3.setAttribute(Attr::Type, Value::LineThin);
+    ls3.setAttribute(Attr::Subtype, Value::Dashed);
+    ls2.setAttribute(Attr::Type, Value::LineThin);
+    ls2.setAttribute(Attr::Subtype, Value::SolidDashed);
+    ls5.setAttribute(Attr::Type, Value::Virtual);
+    next.setAttribute(Attr::OneWay, false);
+    right.setAttribute(AttrStr::SpeedLimit, 30);
+    area.attributes() = pedestrianAttr;
+    nextArea.attributes() = pedestrianAttr;
+  }
+  lanelet::LaneletMapUPtr map() { return lanelet::utils::createMap({lanelet, left, right, next}, {area, nextArea}); }
+  lanelet::ConstLanelets lanelets() const { return {lanelet, left, right, next}; }
+  lanelet::ConstAreas areas() const { return {area, nextArea}; }
+};
+
+TEST_F(CompiledTrafficRules, sameAsGermanRules) {  // NOLINT
+  using lanelet::traffic_rules::TrafficRulesPtr;
+  auto map = this->map();
+  for (const TrafficRulesPtr& rules : {germanVehicleRules(), germanBikeRules(), germanPedestrianRules()}) {
+    lanelet::traffic_rules::CompiledTrafficRules compiled(rules, *map, 2);
+    EXPECT_EQ(compiled.participant(), rules->participant());
+    expectSameRules(compiled, *rules, lanelets(), areas());
+  }
+}
+
+TEST_F(CompiledTrafficRules, forwardsUnknownPrimitives) {  // NOLINT
+  auto map = lanelet::utils::createMap({left, right, next}, {});
+  lanelet::traffic_rules::CompiledTrafficRules compiled(germanVehicleRules(), *map);
+  lanelet.setAttribute(Attr::Subtype, Value::Walkway);
+  EXPECT_FALSE(compiled.canPass(lanelet));
+  // same id, but a different lanelet
+  lanelet::Lanelet copy(left.id(), left.leftBound(), left.rightBound(), pedestrianAttr);
+  EXPECT_TRUE(compiled.canPass(left));
+  EXPECT_FALSE(compiled.canPass(copy));
+}
+
+TEST_F(CompiledTrafficRules, rejectsMissingRules) {  // NOLINT
+  auto map = this->map();
+  EXPECT_THROW(lanelet::traffic_rules::CompiledTrafficRules(nullptr, *map), lanelet::InvalidInputError);  // NOLINT
+}
+}  // namespace compiled
@@ -28,6 +28,8 @@
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
+#include <vector>
+
 namespace lanelet
 {
 namespace utils
@@ -79,6 +81,29 @@ geometry_msgs::Point toGeomMsgPt(const lanelet::ConstPoint2d & src);
 lanelet::ConstPoint3d toLaneletPoint(const geometry_msgs::Point & src);
 void toLaneletPoint(const geometry_msgs::Point & src, lanelet::ConstPoint3d * dst);
 
+/**
+ * [toGeomMsgPts converts all points of a linestring to geometry_msgs points at
+ * once. dst is resized to the number of points, so its memory is reused if it
+ * already has enough capacity. Unlike toGeomMsgPt, no lanelet point is copied]
+ * @param src [input linestring]
+ * @param dst [converted geometry_msgs points]
+ */
+void toGeomMsgPts(const lanelet::ConstLineString3d & src, std::vector<geometry_msgs::Point> * dst);
+void toGeomMsgPts(const lanelet::BasicLineString3d & src, std::vector<geometry_msgs::Point> * dst);
+std::vector<geometry_msgs::Point> toGeomMsgPts(const lanelet::ConstLineString3d & src);
+std::vector<geometry_msgs::Point> toGeomMsgPts(const lanelet::BasicLineString3d & src);
+
+/**
+ * [toBasicLineString converts geometry_msgs points to a basic linestring.
+ * Unlike toLaneletPoint, this does not create a lanelet point for every input
+ * point. dst is resized to the number of points]
+ * @param src [input geometry_msgs points]
+ * @param dst [converted linestring]
+ */
+void toBasicLineString(
+  const std::vector<geometry_msgs::Point> & src, lanelet::BasicLineString3d * dst);
+lanelet::BasicLineString3d toBasicLineString(const std::vector<geometry_msgs::Point> & src);
+
 /**
  * [toGeomMsgPoly converts lanelet polygon to geometry_msgs polygon]
  * @param ll_poly   [input polygon]
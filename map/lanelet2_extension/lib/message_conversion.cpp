@@ -31,8 +31,10 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 
+#include <iterator>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace lanelet
 {
@@ -40,6 +42,25 @@ namespace utils
 {
 namespace conversion
 {
+namespace
+{
+// BasicIterators of linestrings and polygons refer to the coordinates directly, so iterating them
+// does not copy the shared point data like iterating the primitives does
+template <typename BasicIterator>
+void copyToGeomMsgPts(
+  BasicIterator begin, BasicIterator end, std::vector<geometry_msgs::Point> * dst)
+{
+  dst->resize(std::distance(begin, end));
+  auto dst_it = dst->begin();
+  for (auto it = begin; it != end; ++it, ++dst_it) {
+    const lanelet::BasicPoint3d & src = *it;
+    dst_it->x = src.x();
+    dst_it->y = src.y();
+    dst_it->z = src.z();
+  }
+}
+}  // namespace
+
 void toBinMsg(const lanelet::LaneletMapPtr & map, autoware_lanelet2_msgs::MapBin * msg)
 {
   if (msg == nullptr) {
@@ -179,14 +200,62 @@ void toLaneletPoint(const geometry_msgs::Point & src, lanelet::ConstPoint3d * ds
   *dst = lanelet::Point3d(lanelet::InvalId, src.x, src.y, src.z);
 }
 
+void toGeomMsgPts(const lanelet::ConstLineString3d & src, std::vector<geometry_msgs::Point> * dst)
+{
+  if (dst == nullptr) {
+    ROS_ERROR_STREAM(__FUNCTION__ << "pointer is null!");
+    return;
+  }
+  copyToGeomMsgPts(src.basicBegin(), src.basicEnd(), dst);
+}
+void toGeomMsgPts(const lanelet::BasicLineString3d & src, std::vector<geometry_msgs::Point> * dst)
+{
+  if (dst == nullptr) {
+    ROS_ERROR_STREAM(__FUNCTION__ << "pointer is null!");
+    return;
+  }
+  copyToGeomMsgPts(src.begin(), src.end(), dst);
+}
+
+std::vector<geometry_msgs::Point> toGeomMsgPts(const lanelet::ConstLineString3d & src)
+{
+  std::vector<geometry_msgs::Point> dst;
+  toGeomMsgPts(src, &dst);
+  return dst;
+}
+std::vector<geometry_msgs::Point> toGeomMsgPts(const lanelet::BasicLineString3d & src)
+{
+  std::vector<geometry_msgs::Point> dst;
+  toGeomMsgPts(src, &dst);
+  return dst;
+}
+
+void toBasicLineString(
+  const std::vector<geometry_msgs::Point> & src, lanelet::BasicLineString3d * dst)
+{
+  if (dst == nullptr) {
+    ROS_ERROR_STREAM(__FUNCTION__ << "pointer is null!");
+    return;
+  }
+  dst->resize(src.size());
+  for (size_t i = 0; i < src.size(); ++i) {
+    (*dst)[i] = lanelet::BasicPoint3d(src[i].x, src[i].y, src[i].z);
+  }
+}
+
+lanelet::BasicLineString3d toBasicLineString(const std::vector<geometry_msgs::Point> & src)
+{
+  lanelet::BasicLineString3d dst;
+  toBasicLineString(src, &dst);
+  return dst;
+}
+
 void toGeomMsgPoly(const lanelet::ConstPolygon3d & ll_poly, geometry_msgs::Polygon * geom_poly)
 {
-  geom_poly->points.clear();
-  geom_poly->points.reserve(ll_poly.size());
-  for (const auto & ll_pt : ll_poly) {
-    geometry_msgs::Point32 geom_pt32;
-    utils::conversion::toGeomMsgPt32(ll_pt.basicPoint(), &geom_pt32);
-    geom_poly->points.push_back(geom_pt32);
+  geom_poly->points.resize(ll_poly.size());
+  auto geom_pt_it = geom_poly->points.begin();
+  for (auto it = ll_poly.basicBegin(); it != ll_poly.basicEnd(); ++it, ++geom_pt_it) {
+    utils::conversion::toGeomMsgPt32(*it, &*geom_pt_it);
   }
 }
 
@@ -23,6 +23,7 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
 #include <lanelet2_core/geometry/Lanelet.h>
+#include <lanelet2_core/primitives/ArcLengthIndex.h>
 
 #include <lanelet2_extension/utility/message_conversion.h>
 #include <lanelet2_extension/utility/query.h>
@@ -82,145 +83,68 @@ void getContactingLanelets(
   }
 }
 
-std::vector<double> calculateSegmentDistances(const lanelet::ConstLineString3d & line_string)
-{
-  std::vector<double> segment_distances;
-  segment_distances.reserve(line_string.size() - 1);
-
-  for (size_t i = 1; i < line_string.size(); ++i) {
-    const auto distance = lanelet::geometry::distance(line_string[i], line_string[i - 1]);
-    segment_distances.push_back(distance);
-  }
-
-  return segment_distances;
-}
-
-std::vector<double> calculateAccumulatedLengths(const lanelet::ConstLineString3d & line_string)
-{
-  const auto segment_distances = calculateSegmentDistances(line_string);
-
-  std::vector<double> accumulated_lengths{0};
-  accumulated_lengths.reserve(segment_distances.size() + 1);
-  std::partial_sum(
-    std::begin(segment_distances), std::end(segment_distances),
-    std::back_inserter(accumulated_lengths));
-
-  return accumulated_lengths;
-}
-
-std::pair<size_t, size_t> findNearestIndexPair(
-  const std::vector<double> & accumulated_lengths, const double target_length)
-{
-  // List size
-  const auto N = accumulated_lengths.size();
-
-  // Front
-  if (target_length < accumulated_lengths.at(1)) {
-    return std::make_pair(0, 1);
-  }
-
-  // Back
-  if (target_length > accumulated_lengths.at(N - 2)) {
-    return std::make_pair(N - 2, N - 1);
-  }
-
-  // Middle
-  for (auto i = 1; i < N; ++i) {
-    if (
-      accumulated_lengths.at(i - 1) <= target_length &&
-      target_length <= accumulated_lengths.at(i)) {
-      return std::make_pair(i - 1, i);
-    }
-  }
-
-  // Throw an exception because this never happens
-  throw std::runtime_error("No nearest point found.");
-}
-
 std::vector<lanelet::BasicPoint3d> resamplePoints(
   const lanelet::ConstLineString3d & line_string, const int num_segments)
 {
-  // Calculate length
-  const auto line_length = lanelet::geometry::length(line_string);
-
-  // Calculate accumulated lengths
-  const auto accumulated_lengths = calculateAccumulatedLengths(line_string);
+  // Accumulated lengths are computed once, each target point is then found by binary search
+  const lanelet::ArcLengthIndex3d arc_length_index(line_string);
+  const auto line_length = arc_length_index.length();
 
   // Create each segment
   std::vector<lanelet::BasicPoint3d> resampled_points;
+  resampled_points.reserve(num_segments + 1);
   for (auto i = 0; i <= num_segments; ++i) {
-    // Find two nearest points
     const auto target_length = (static_cast<double>(i) / num_segments) * line_length;
-    const auto index_pair = findNearestIndexPair(accumulated_lengths, target_length);
-
-    // Apply linear interpolation
-    const lanelet::BasicPoint3d back_point = line_string[index_pair.first];
-    const lanelet::BasicPoint3d front_point = line_string[index_pair.second];
-    const auto direction_vector = (front_point - back_point);
+    resampled_points.push_back(arc_length_index.interpolatedPointAtDistance(target_length));
+  }
 
-    const auto back_length = accumulated_lengths.at(index_pair.first);
-    const auto front_length = accumulated_lengths.at(index_pair.second);
-    const auto segment_length = front_length - back_length;
-    const auto target_point =
-      back_point + (direction_vector * (target_length - back_length) / segment_length);
+  return resampled_points;
+}
 
-    // Add to list
-    resampled_points.push_back(target_point);
+// returns the index of the segment that contains the arc length s or the size of the linestring if s is beyond its end
+size_t findSegmentIndex(const lanelet::ArcLengthIndex3d & arc_length_index, const double s)
+{
+  const auto & accumulated_lengths = arc_length_index.accumulatedLengths();
+  const auto segment_end = std::upper_bound(
+    std::next(accumulated_lengths.begin()), accumulated_lengths.end(), s);
+  if (segment_end == accumulated_lengths.end()) {
+    return arc_length_index.size();
   }
+  return std::distance(accumulated_lengths.begin(), segment_end) - 1;
+}
 
-  return resampled_points;
+lanelet::Point3d pointOnSegment(
+  const lanelet::ArcLengthIndex3d & arc_length_index, const size_t segment_index, const double s)
+{
+  const auto & line_string = arc_length_index.lineString();
+  const double residue = s - arc_length_index.accumulatedLengths().at(segment_index);
+  const auto direction_vector =
+    (line_string.at(segment_index + 1) - line_string.at(segment_index)).normalized();
+  const lanelet::BasicPoint3d basic_point = line_string.at(segment_index) + residue * direction_vector;
+  return lanelet::Point3d(lanelet::InvalId, basic_point);
 }
+
 lanelet::LineString3d getLineStringFromArcLength(
-  const lanelet::ConstLineString3d & linestring, const double s1, const double s2)
+  const lanelet::ConstLineString3d & linestring, const lanelet::ArcLengthIndex3d & arc_length_index,
+  const double s1, const double s2)
 {
   lanelet::Points3d points;
-  double accumulated_length = 0;
-  size_t start_index = linestring.size();
-  for (size_t i = 0; i < linestring.size() - 1; i++) {
-    const auto p1 = linestring[i];
-    const auto p2 = linestring[i + 1];
-    const double length = boost::geometry::distance(p1.basicPoint(), p2.basicPoint());
-    if (accumulated_length + length > s1) {
-      start_index = i;
-      break;
-    }
-    accumulated_length += length;
+  if (linestring.size() < 2) {
+    return lanelet::LineString3d(lanelet::InvalId, points);
   }
+  const auto & accumulated_lengths = arc_length_index.accumulatedLengths();
+  const size_t start_index = findSegmentIndex(arc_length_index, s1);
   if (start_index < linestring.size() - 1) {
-    const auto p1 = linestring[start_index];
-    const auto p2 = linestring[start_index + 1];
-    const double residue = s1 - accumulated_length;
-    const auto direction_vector = (p2.basicPoint() - p1.basicPoint()).normalized();
-    const auto start_basic_point = p1.basicPoint() + residue * direction_vector;
-    const auto start_point = lanelet::Point3d(lanelet::InvalId, start_basic_point);
-    points.push_back(start_point);
+    points.push_back(pointOnSegment(arc_length_index, start_index, s1));
   }
 
-  accumulated_length = 0;
-  size_t end_index = linestring.size();
-  for (size_t i = 0; i < linestring.size() - 1; i++) {
-    const auto p1 = linestring[i];
-    const auto p2 = linestring[i + 1];
-    const double length = boost::geometry::distance(p1.basicPoint(), p2.basicPoint());
-    if (accumulated_length + length > s2) {
-      end_index = i;
-      break;
-    }
-    accumulated_length += length;
+  for (size_t i = start_index + 1; i < linestring.size() && accumulated_lengths.at(i) < s2; i++) {
+    points.push_back(lanelet::Point3d(linestring[i]));
   }
 
-  for (size_t i = start_index + 1; i < end_index; i++) {
-    const auto p = lanelet::Point3d(linestring[i]);
-    points.push_back(p);
-  }
+  const size_t end_index = findSegmentIndex(arc_length_index, s2);
   if (end_index < linestring.size() - 1) {
-    const auto p1 = linestring[end_index];
-    const auto p2 = linestring[end_index + 1];
-    const double residue = s2 - accumulated_length;
-    const auto direction_vector = (p2.basicPoint() - p1.basicPoint()).normalized();
-    const auto end_basic_point = p1.basicPoint() + residue * direction_vector;
-    const auto end_point = lanelet::Point3d(lanelet::InvalId, end_basic_point);
-    points.push_back(end_point);
+    points.push_back(pointOnSegment(arc_length_index, end_index, s2));
   }
   return lanelet::LineString3d(lanelet::InvalId, points);
 }
@@ -426,22 +350,18 @@ lanelet::CompoundPolygon3d getPolygonFromArcLength(
   const lanelet::ConstLanelets & lanelets, const double s1, const double s2)
 {
   const auto combined_lanelet = combineLanelets(lanelets);
-  const auto ratio_s1 = s1 / getLaneletLength2d(combined_lanelet);
-  const auto ratio_s2 = s2 / getLaneletLength2d(combined_lanelet);
-
-  const auto s1_left =
-    ratio_s1 * boost::geometry::length(combined_lanelet.leftBound().basicLineString());
-  const auto s2_left =
-    ratio_s2 * boost::geometry::length(combined_lanelet.leftBound().basicLineString());
-  const auto s1_right =
-    ratio_s1 * boost::geometry::length(combined_lanelet.rightBound().basicLineString());
-  const auto s2_right =
-    ratio_s2 * boost::geometry::length(combined_lanelet.rightBound().basicLineString());
-
-  const auto left_bound =
-    getLineStringFromArcLength(combined_lanelet.leftBound(), s1_left, s2_left);
-  const auto right_bound =
-    getLineStringFromArcLength(combined_lanelet.rightBound(), s1_right, s2_right);
+  const auto lanelet_length = getLaneletLength2d(combined_lanelet);
+  const auto ratio_s1 = s1 / lanelet_length;
+  const auto ratio_s2 = s2 / lanelet_length;
+
+  const lanelet::ArcLengthIndex3d left_index(combined_lanelet.leftBound());
+  const lanelet::ArcLengthIndex3d right_index(combined_lanelet.rightBound());
+  const auto left_bound = getLineStringFromArcLength(
+    combined_lanelet.leftBound(), left_index, ratio_s1 * left_index.length(),
+    ratio_s2 * left_index.length());
+  const auto right_bound = getLineStringFromArcLength(
+    combined_lanelet.rightBound(), right_index, ratio_s1 * right_index.length(),
+    ratio_s2 * right_index.length());
 
   const auto & lanelet = lanelet::Lanelet(lanelet::InvalId, left_bound, right_bound);
   return lanelet.polygon3d();
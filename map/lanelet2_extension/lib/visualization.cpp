@@ -838,13 +838,7 @@ void visualization::lineString2Marker(
   line_strip->color = c;
 
   // fill out lane line
-  for (auto i = ls.begin(); i != ls.end(); i++) {
-    geometry_msgs::Point p;
-    p.x = (*i).x();
-    p.y = (*i).y();
-    p.z = (*i).z();
-    line_strip->points.push_back(p);
-  }
+  utils::conversion::toGeomMsgPts(ls, &line_strip->points);
 }
 
 }  // namespace lanelet
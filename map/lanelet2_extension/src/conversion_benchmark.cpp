@@ -0,0 +1,81 @@
+/*
+ * Copyright 2015-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <lanelet2_extension/utility/message_conversion.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Compares converting a path point by point with the batch conversion into a reused buffer, the
+// way a planner converts its path every cycle.
+// usage: lanelet2_extension_conversion_benchmark [number of points] [number of cycles]
+
+namespace
+{
+template <typename Func>
+double measureMicroseconds(const int cycles, Func && func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < cycles; i++) {
+    func();
+  }
+  const std::chrono::duration<double, std::micro> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / cycles;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const int num_points = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const int cycles = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+  lanelet::LineString3d path(lanelet::utils::getId());
+  for (int i = 0; i < num_points; i++) {
+    path.push_back(lanelet::Point3d(lanelet::utils::getId(), i * 0.5, 0.01 * i * i, 0.0));
+  }
+  const lanelet::ConstLineString3d const_path = path;
+
+  std::vector<geometry_msgs::Point> geom_pts;
+  const double per_point_to_msg = measureMicroseconds(cycles, [&]() {
+    geom_pts.clear();
+    for (const auto & pt : const_path) {
+      geom_pts.push_back(lanelet::utils::conversion::toGeomMsgPt(pt));
+    }
+  });
+  const double batch_to_msg = measureMicroseconds(
+    cycles, [&]() { lanelet::utils::conversion::toGeomMsgPts(const_path, &geom_pts); });
+
+  lanelet::ConstPoints3d lanelet_pts;
+  const double per_point_from_msg = measureMicroseconds(cycles, [&]() {
+    lanelet_pts.clear();
+    for (const auto & pt : geom_pts) {
+      lanelet_pts.push_back(lanelet::utils::conversion::toLaneletPoint(pt));
+    }
+  });
+  lanelet::BasicLineString3d basic_path;
+  const double batch_from_msg = measureMicroseconds(
+    cycles, [&]() { lanelet::utils::conversion::toBasicLineString(geom_pts, &basic_path); });
+
+  std::cout << "points: " << num_points << ", cycles: " << cycles << std::endl;
+  std::cout << "lanelet -> geometry_msgs [us/cycle] per point: " << per_point_to_msg
+            << ", batch: " << batch_to_msg << std::endl;
+  std::cout << "geometry_msgs -> lanelet [us/cycle] per point: " << per_point_from_msg
+            << ", batch: " << batch_from_msg << std::endl;
+  return 0;
+}
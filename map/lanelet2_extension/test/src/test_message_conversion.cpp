@@ -21,11 +21,15 @@
 #include <lanelet2_extension/utility/message_conversion.h>
 #include <lanelet2_extension/utility/query.h>
 
+#include <vector>
+
 using lanelet::Lanelet;
 using lanelet::LineString3d;
 using lanelet::Point3d;
 using lanelet::utils::getId;
+using lanelet::utils::conversion::toBasicLineString;
 using lanelet::utils::conversion::toGeomMsgPt;
+using lanelet::utils::conversion::toGeomMsgPts;
 
 class TestSuite : public ::testing::Test
 {
@@ -155,6 +159,46 @@ TEST_F(TestSuite, ToGeomMsgPt)
     << " converted value is different from original lanelet::Point2d";
 }
 
+TEST_F(TestSuite, ToGeomMsgPts)
+{
+  LineString3d ls(getId(), {Point3d(getId(), -0.1, 0.2, 3.0), Point3d(getId(), 1.0, 2.0, 0.5)});
+
+  std::vector<geometry_msgs::Point> geom_pts(5);
+  toGeomMsgPts(ls, &geom_pts);
+  ASSERT_EQ(ls.size(), geom_pts.size()) << " converted points have a different size";
+  for (size_t i = 0; i < ls.size(); i++) {
+    ASSERT_DOUBLE_EQ(ls[i].x(), geom_pts[i].x)
+      << " converted value is different from original lanelet::LineString3d";
+    ASSERT_DOUBLE_EQ(ls[i].y(), geom_pts[i].y)
+      << " converted value is different from original lanelet::LineString3d";
+    ASSERT_DOUBLE_EQ(ls[i].z(), geom_pts[i].z)
+      << " converted value is different from original lanelet::LineString3d";
+  }
+
+  const lanelet::ConstLineString3d inverted_ls = ls.invert();
+  geom_pts = toGeomMsgPts(inverted_ls);
+  ASSERT_EQ(inverted_ls.size(), geom_pts.size()) << " converted points have a different size";
+  ASSERT_DOUBLE_EQ(inverted_ls.front().x(), geom_pts.front().x)
+    << " converted value is different from original inverted lanelet::LineString3d";
+
+  const lanelet::BasicLineString3d basic_ls = toBasicLineString(geom_pts);
+  ASSERT_EQ(geom_pts.size(), basic_ls.size()) << " converted linestring has a different size";
+  for (size_t i = 0; i < basic_ls.size(); i++) {
+    ASSERT_DOUBLE_EQ(geom_pts[i].x, basic_ls[i].x())
+      << " converted value is different from original geometry_msgs::Point";
+    ASSERT_DOUBLE_EQ(geom_pts[i].y, basic_ls[i].y())
+      << " converted value is different from original geometry_msgs::Point";
+    ASSERT_DOUBLE_EQ(geom_pts[i].z, basic_ls[i].z())
+      << " converted value is different from original geometry_msgs::Point";
+  }
+
+  geom_pts.clear();
+  toGeomMsgPts(basic_ls, &geom_pts);
+  ASSERT_EQ(basic_ls.size(), geom_pts.size()) << " converted points have a different size";
+  ASSERT_DOUBLE_EQ(basic_ls.back().z(), geom_pts.back().z)
+    << " converted value is different from original lanelet::BasicLineString3d";
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -24,7 +24,10 @@
 // Autoware
 #include <autoware_lanelet2_msgs/MapBin.h>
 #include <mission_planner/lanelet2_impl/route_handler.h>
+#include <mission_planner/lanelet2_impl/route_repair.h>
+#include <mission_planner/lanelet2_impl/route_sections.h>
 #include <mission_planner/mission_planner_base.h>
+#include <std_msgs/Int64MultiArray.h>
 
 // lanelet
 #include <lanelet2_core/LaneletMap.h>
@@ -33,8 +36,8 @@
 
 // others
 #include <string>
-
-using RouteSections = std::vector<autoware_planning_msgs::RouteSection>;
+#include <unordered_set>
+#include <vector>
 
 namespace mission_planner
 {
@@ -45,23 +48,41 @@ public:
 
 private:
   bool is_graph_ready_;
+  // number of threads that plan checkpoint segments, 0 uses one per core
+  int num_planning_threads_;
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
 
   ros::Subscriber map_subscriber_;
+  ros::Subscriber blocked_lanelets_subscriber_;
+  ros::Timer progress_timer_;
+
+  // main path and route sections of each checkpoint segment of the last planned route
+  SegmentedRoute route_;
+  // position of the vehicle on route_, it only moves forward
+  RoutePosition route_progress_;
+  std::unordered_set<lanelet::Id> blocked_lanelet_ids_;
 
   void mapCallback(const autoware_lanelet2_msgs::MapBin & msg);
+  void blockedLaneletsCallback(const std_msgs::Int64MultiArray & msg);
+  void progressTimerCallback(const ros::TimerEvent & event);
   bool isGoalValid() const;
 
   // virtual functions
   bool isRoutingGraphReady() const;
   autoware_planning_msgs::Route planRoute();
+  autoware_planning_msgs::Route planReroute(const geometry_msgs::PoseStamped & current_pose);
   void visualizeRoute(const autoware_planning_msgs::Route & route) const;
   void visualizeRouteStepByStep(const autoware_planning_msgs::Route& route) const;
 
   // routing
+  bool planSegment(
+    const geometry_msgs::PoseStamped & start_checkpoint,
+    const geometry_msgs::PoseStamped & goal_checkpoint, lanelet::ConstLanelets * path_lanelets_ptr,
+    RouteSections * route_sections_ptr) const;
+  autoware_planning_msgs::Route createRoute() const;
   bool planPathBetweenCheckpoints(
     const geometry_msgs::PoseStamped & start_checkpoint,
     const geometry_msgs::PoseStamped & goal_checkpoint,
@@ -72,8 +93,6 @@ private:
     lanelet::ConstLanelets* path_lanelets_ptr) const;
   lanelet::ConstLanelets getMainLanelets(
     const lanelet::ConstLanelets & path_lanelets, const RouteHandler & lanelet_sequence_finder);
-  RouteSections createRouteSections(
-    const lanelet::ConstLanelets & main_path, const RouteHandler & route_handler);
 };
 }  // namespace mission_planner
 
@@ -25,6 +25,8 @@
 #include <lanelet2_routing/Route.h>
 #include <lanelet2_routing/RoutingCost.h>
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace mission_planner
@@ -38,13 +40,35 @@ private:
   lanelet::ConstLanelets start_lanelets_;
   lanelet::ConstLanelets goal_lanelets_;
 
+  // lookup tables for the route lanelets, filled once at construction
+  std::unordered_set<lanelet::Id> route_lanelet_ids_;
+  std::unordered_set<lanelet::Id> start_lanelet_ids_;
+  std::unordered_set<lanelet::Id> goal_lanelet_ids_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> next_lanelets_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> previous_lanelets_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> neighbors_within_route_;
+
   void setRouteLanelets(
     const lanelet::LaneletMapConstPtr & lanelet_map_ptr,
     const lanelet::routing::RoutingGraphPtr & routing_graph_ptr,
     const lanelet::ConstLanelets & path_lanelets);
+  void setLookupTables();
   bool isBijectiveConnection(
     const lanelet::ConstLanelets & lanelet_section1,
     const lanelet::ConstLanelets & lanelet_section2) const;
+  bool findNextLaneletWithinRoute(
+    const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const;
+  bool findPreviousLaneletWithinRoute(
+    const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const;
+  lanelet::ConstLanelets findNeighborsWithinRoute(const lanelet::ConstLanelet & lanelet) const;
+  lanelet::ConstLanelets buildLaneletSequence(
+    const lanelet::ConstLanelet & lanelet, size_t * position) const;
+  lanelet::ConstLanelets buildLaneSequence(
+    const lanelet::ConstLanelet & lanelet, size_t * position) const;
+  template <typename NextT, typename PreviousT>
+  lanelet::ConstLanelets buildSequence(
+    const lanelet::ConstLanelet & lanelet, const NextT & get_next, const PreviousT & get_previous,
+    size_t * position) const;
 
 public:
   bool getPreviousLaneletWithinRoute(
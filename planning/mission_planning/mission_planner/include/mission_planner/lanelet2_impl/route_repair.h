@@ -0,0 +1,76 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MISSION_PLANNER_LANELET2_IMPL_ROUTE_REPAIR_H
+#define MISSION_PLANNER_LANELET2_IMPL_ROUTE_REPAIR_H
+
+// Autoware
+#include <mission_planner/lanelet2_impl/route_sections.h>
+
+// lanelet
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+
+// others
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+namespace mission_planner
+{
+// main path and route sections of every checkpoint segment of a route. A segment ends at the
+// lanelet the next one starts at, and each lanelet of a main path has one route section.
+struct SegmentedRoute
+{
+  std::vector<lanelet::ConstLanelets> paths;
+  std::vector<RouteSections> route_sections;
+};
+
+// position of a lanelet within the main paths of a SegmentedRoute
+struct RoutePosition
+{
+  std::size_t segment;
+  std::size_t index;
+};
+
+// finds the first occurrence of the lanelet at or after the given position. Coverage tours pass
+// the same lanelets many times, so the search has to start at the progress of the vehicle.
+bool findOnRoute(
+  const SegmentedRoute & route, const lanelet::ConstLanelet & lanelet, const RoutePosition & from,
+  RoutePosition * position);
+
+// Repairs a route so that it starts at the current lanelet and avoids the blocked lanelets, which
+// have to be blocked in the cost overlay of the routing graph as well.
+// The part of the route before the progress of the vehicle is dropped. If the vehicle is on the
+// rest of the route, it stays on it. Otherwise, it rejoins the route at the earliest lanelet at or
+// after the progress that it can reach. Every stretch of blocked lanelets is replaced by a detour
+// to the earliest unblocked lanelet behind it that can be reached, so all other lanelets are still
+// covered in their order. Only the detours get new route sections.
+// The order of the route is kept, so lanelets that the old order only reaches through blocked
+// lanelets are dropped. Every detour is a search in the routing graph, so with many blocked
+// stretches planning the route again is faster and covers more.
+// Checkpoints that are skipped by a detour are dropped. segment_ids_ptr receives the index of the
+// segment of the old route that each segment of the repaired route comes from.
+// Returns false if a detour can not be found. The route is not changed then.
+bool repairRoute(
+  const lanelet::LaneletMapConstPtr & lanelet_map_ptr,
+  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr,
+  const std::unordered_set<lanelet::Id> & blocked_lanelet_ids,
+  const lanelet::ConstLanelet & current_lanelet, const RoutePosition & progress,
+  SegmentedRoute * route_ptr, std::vector<std::size_t> * segment_ids_ptr);
+}  // namespace mission_planner
+
+#endif  // MISSION_PLANNER_LANELET2_IMPL_ROUTE_REPAIR_H
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MISSION_PLANNER_LANELET2_IMPL_ROUTE_SECTIONS_H
+#define MISSION_PLANNER_LANELET2_IMPL_ROUTE_SECTIONS_H
+
+// Autoware
+#include <autoware_planning_msgs/RouteSection.h>
+#include <mission_planner/lanelet2_impl/route_handler.h>
+
+// lanelet
+#include <lanelet2_core/Forward.h>
+
+// others
+#include <vector>
+
+using RouteSections = std::vector<autoware_planning_msgs::RouteSection>;
+
+namespace mission_planner
+{
+// one route section for each lanelet of the main path, containing its neighbors within the route
+RouteSections createRouteSections(
+  const lanelet::ConstLanelets & main_path, const RouteHandler & route_handler);
+}  // namespace mission_planner
+
+#endif  // MISSION_PLANNER_LANELET2_IMPL_ROUTE_SECTIONS_H
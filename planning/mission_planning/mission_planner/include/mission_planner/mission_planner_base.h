@@ -25,8 +25,10 @@
 #include <autoware_planning_msgs/Route.h>
 #include <geometry_msgs/PoseStamped.h>
 #include <geometry_msgs/PoseWithCovarianceStamped.h>
+#include <std_msgs/Empty.h>
 
 // others
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -50,21 +52,34 @@ protected:
 
   virtual bool isRoutingGraphReady() const = 0;
   virtual autoware_planning_msgs::Route planRoute() = 0;
+  // repairs the last planned route from the current pose of the vehicle
+  virtual autoware_planning_msgs::Route planReroute(
+    const geometry_msgs::PoseStamped & current_pose) = 0;
   virtual void visualizeRoute(const autoware_planning_msgs::Route & route) const = 0;
   virtual void visualizeRouteStepByStep(const autoware_planning_msgs::Route & route) const = 0;
   virtual void publishRoute(const autoware_planning_msgs::Route & route) const;
+  void reroute();
+  bool getEgoVehiclePose(geometry_msgs::PoseStamped * ego_vehicle_pose);
 
 private:
   ros::Publisher route_publisher_;
   ros::Subscriber goal_subscriber_;
   ros::Subscriber checkpoint_subscriber_;
+  ros::Subscriber reroute_subscriber_;
 
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
 
-  bool getEgoVehiclePose(geometry_msgs::PoseStamped * ego_vehicle_pose);
+  // time of the goal or reroute request that is planned, used to report the latency until the
+  // route is published
+  ros::WallTime request_time_;
+  // latencies of the last published routes, oldest first
+  std::deque<double> route_latencies_;
+
+  void reportLatency(const autoware_planning_msgs::Route & route);
   void goalPoseCallback(const geometry_msgs::PoseStampedConstPtr & goal_msg_ptr);
   void checkpointCallback(const geometry_msgs::PoseStampedConstPtr & checkpoint_msg_ptr);
+  void rerouteCallback(const std_msgs::EmptyConstPtr & reroute_msg_ptr);
   bool transformPose(
     const geometry_msgs::PoseStamped & input_pose, geometry_msgs::PoseStamped * output_pose,
     const std::string target_frame);
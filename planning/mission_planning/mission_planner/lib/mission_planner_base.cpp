@@ -24,6 +24,8 @@
 #include <lanelet2_extension/utility/query.h>
 #include <lanelet2_extension/visualization/visualization.h>
 
+#include <algorithm>
+
 namespace mission_planner
 {
 MissionPlanner::MissionPlanner() : pnh_("~"), tf_listener_(tf_buffer_)
@@ -34,6 +36,8 @@ MissionPlanner::MissionPlanner() : pnh_("~"), tf_listener_(tf_buffer_)
   goal_subscriber_ = pnh_.subscribe("input/goal_pose", 10, &MissionPlanner::goalPoseCallback, this);
   checkpoint_subscriber_ =
     pnh_.subscribe("input/checkpoint", 10, &MissionPlanner::checkpointCallback, this);
+  reroute_subscriber_ =
+    pnh_.subscribe("input/reroute", 1, &MissionPlanner::rerouteCallback, this);
 
   route_publisher_ = pnh_.advertise<autoware_planning_msgs::Route>("output/route", 1, true);
   marker_publisher_ =
@@ -73,6 +77,8 @@ bool MissionPlanner::transformPose(
 
 void MissionPlanner::goalPoseCallback(const geometry_msgs::PoseStampedConstPtr & goal_msg_ptr)
 {
+  request_time_ = ros::WallTime::now();
+
   // set start pose
   if (!getEgoVehiclePose(&start_pose_)) {
     ROS_ERROR("Failed to get ego vehicle pose in map frame. Aborting mission planning");
@@ -96,6 +102,7 @@ void MissionPlanner::goalPoseCallback(const geometry_msgs::PoseStampedConstPtr &
 
   autoware_planning_msgs::Route route = planRoute();
   publishRoute(route);
+  reportLatency(route);
 }  // namespace mission_planner
 
 void MissionPlanner::checkpointCallback(
@@ -119,6 +126,36 @@ void MissionPlanner::checkpointCallback(
   // publishRoute(route);
 }
 
+void MissionPlanner::rerouteCallback(const std_msgs::EmptyConstPtr & reroute_msg_ptr)
+{
+  reroute();
+}
+
+void MissionPlanner::reroute()
+{
+  request_time_ = ros::WallTime::now();
+
+  if (checkpoints_.size() < 2) {
+    ROS_ERROR("You must set start and goal before rerouting. Aborting mission planning");
+    return;
+  }
+
+  if (!isRoutingGraphReady()) {
+    ROS_ERROR("RoutingGraph is not ready. Aborting mission planning");
+    return;
+  }
+
+  geometry_msgs::PoseStamped current_pose;
+  if (!getEgoVehiclePose(&current_pose)) {
+    ROS_ERROR("Failed to get ego vehicle pose in map frame. Aborting rerouting");
+    return;
+  }
+
+  autoware_planning_msgs::Route route = planReroute(current_pose);
+  publishRoute(route);
+  reportLatency(route);
+}
+
 void MissionPlanner::publishRoute(const autoware_planning_msgs::Route & route) const
 {
   if (!route.route_sections.empty()) {
@@ -130,4 +167,26 @@ void MissionPlanner::publishRoute(const autoware_planning_msgs::Route & route) c
   }
 }
 
+void MissionPlanner::reportLatency(const autoware_planning_msgs::Route & route)
+{
+  // number of requests the tail latency is computed over
+  constexpr size_t latency_window = 100;
+  if (route.route_sections.empty()) {
+    return;
+  }
+
+  // latency from the request to the publication, including the tail over the last requests
+  route_latencies_.push_back((ros::WallTime::now() - request_time_).toSec());
+  if (route_latencies_.size() > latency_window) {
+    route_latencies_.pop_front();
+  }
+  std::vector<double> latencies(route_latencies_.begin(), route_latencies_.end());
+  const auto p95 = latencies.begin() + (latencies.size() * 95) / 100;
+  std::nth_element(latencies.begin(), p95, latencies.end());
+  ROS_INFO_STREAM(
+    "Route published " << route_latencies_.back() << " s after the request. p95 latency of the "
+                       << "last " << latencies.size() << " requests: " << *p95 << " s, max: "
+                       << *std::max_element(latencies.begin(), latencies.end()) << " s");
+}
+
 }  // namespace mission_planner
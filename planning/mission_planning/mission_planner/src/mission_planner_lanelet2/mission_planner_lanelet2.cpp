@@ -16,6 +16,8 @@
 
 #include <mission_planner/lanelet2_impl/mission_planner_lanelet2.h>
 #include <mission_planner/lanelet2_impl/route_handler.h>
+#include <mission_planner/lanelet2_impl/route_repair.h>
+#include <mission_planner/lanelet2_impl/route_sections.h>
 #include <mission_planner/lanelet2_impl/utility_functions.h>
 
 #include <tf2/utils.h>
@@ -25,15 +27,17 @@
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_routing/Route.h>
 #include <lanelet2_routing/RoutingCost.h>
+#include <lanelet2_routing/RoutingCostOverlay.h>
 
 #include <lanelet2_extension/utility/message_conversion.h>
 #include <lanelet2_extension/utility/query.h>
 #include <lanelet2_extension/utility/utilities.h>
 #include <lanelet2_extension/visualization/visualization.h>
 
-#include <unordered_set>
-#include <stack>
-#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
 
 namespace
 {
@@ -125,10 +129,18 @@ bool isInParkingLot(
 
 namespace mission_planner
 {
-MissionPlannerLanelet2::MissionPlannerLanelet2() : is_graph_ready_(false)
+MissionPlannerLanelet2::MissionPlannerLanelet2()
+: is_graph_ready_(false), route_progress_(RoutePosition())
 {
+  pnh_.param<int>("num_planning_threads", num_planning_threads_, 0);
+
   map_subscriber_ =
     pnh_.subscribe("input/vector_map", 10, &MissionPlannerLanelet2::mapCallback, this);
+  blocked_lanelets_subscriber_ = pnh_.subscribe(
+    "input/blocked_lanelets", 1, &MissionPlannerLanelet2::blockedLaneletsCallback, this);
+  // often enough that the vehicle can not drive around a loop of the route in between
+  progress_timer_ =
+    pnh_.createTimer(ros::Duration(0.1), &MissionPlannerLanelet2::progressTimerCallback, this);
 }
 
 void MissionPlannerLanelet2::mapCallback(const autoware_lanelet2_msgs::MapBin & msg)
@@ -136,9 +148,56 @@ void MissionPlannerLanelet2::mapCallback(const autoware_lanelet2_msgs::MapBin &
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
     msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  route_ = SegmentedRoute();
+  blocked_lanelet_ids_.clear();
   is_graph_ready_ = true;
 }
 
+void MissionPlannerLanelet2::blockedLaneletsCallback(const std_msgs::Int64MultiArray & msg)
+{
+  if (!is_graph_ready_) {
+    ROS_WARN("RoutingGraph is not ready. Ignoring blocked lanelets");
+    return;
+  }
+
+  // blocked lanelets are excluded from all searches of the routing graph
+  const std::unordered_set<lanelet::Id> blocked_lanelet_ids(msg.data.begin(), msg.data.end());
+  routing_graph_ptr_->updateCostOverlay([&](lanelet::routing::RoutingCostOverlay & overlay) {
+    for (const auto & id : blocked_lanelet_ids_) {
+      overlay.reset(id);
+    }
+    for (const auto & id : blocked_lanelet_ids) {
+      overlay.set(id, lanelet::routing::CostModification::blocked());
+    }
+  });
+  blocked_lanelet_ids_ = blocked_lanelet_ids;
+  ROS_INFO_STREAM("Number of blocked lanelets: " << blocked_lanelet_ids_.size());
+
+  if (!route_.paths.empty()) {
+    reroute();
+  }
+}
+
+void MissionPlannerLanelet2::progressTimerCallback(const ros::TimerEvent & event)
+{
+  if (!is_graph_ready_ || route_.paths.empty()) {
+    return;
+  }
+  geometry_msgs::PoseStamped current_pose;
+  if (!getEgoVehiclePose(&current_pose)) {
+    return;
+  }
+  lanelet::Lanelet current_lanelet;
+  if (!getClosestLanelet(current_pose.pose, lanelet_map_ptr_, &current_lanelet)) {
+    return;
+  }
+  // the lanelet may be passed again later, the next visit is the one the vehicle is on
+  RoutePosition position;
+  if (findOnRoute(route_, current_lanelet, route_progress_, &position)) {
+    route_progress_ = position;
+  }
+}
+
 bool MissionPlannerLanelet2::isRoutingGraphReady() const { return (is_graph_ready_); }
 
 void MissionPlannerLanelet2::visualizeRoute(const autoware_planning_msgs::Route & route) const
@@ -233,29 +292,115 @@ autoware_planning_msgs::Route MissionPlannerLanelet2::planRoute()
   }
   ROS_INFO_STREAM("start planning route with checkpoints: " << std::endl << ss.str());
 
-  autoware_planning_msgs::Route route_msg;
-  RouteSections route_sections;
+  route_ = SegmentedRoute();
+  route_progress_ = RoutePosition();
 
   if (!isGoalValid()) {
     ROS_WARN("Goal is not valid! Please check position and angle of goal_pose");
-    return route_msg;
+    return autoware_planning_msgs::Route();
   }
 
-  for (std::size_t i = 1; i < checkpoints_.size(); i++) {
-    const auto start_checkpoint = checkpoints_.at(i - 1);
-    const auto goal_checkpoint = checkpoints_.at(i);
-    lanelet::ConstLanelets path_lanelets;
-    if (!planFullCoveragePath(start_checkpoint, goal_checkpoint, &path_lanelets)) {
-      return route_msg;
+  // segments only read the map and the routing graph, so they are planned concurrently and
+  // merged in order afterwards
+  const std::size_t num_segments = checkpoints_.size() - 1;
+  std::vector<lanelet::ConstLanelets> segment_paths(num_segments);
+  std::vector<RouteSections> segment_route_sections(num_segments);
+  std::vector<char> is_segment_planned(num_segments, false);
+  std::atomic<std::size_t> next_segment(0);
+  const auto plan_segments = [&]() {
+    for (std::size_t i = next_segment++; i < num_segments; i = next_segment++) {
+      is_segment_planned.at(i) = planSegment(
+        checkpoints_.at(i), checkpoints_.at(i + 1), &segment_paths.at(i),
+        &segment_route_sections.at(i));
     }
+  };
+
+  const std::size_t num_threads = num_planning_threads_ > 0
+                                    ? static_cast<std::size_t>(num_planning_threads_)
+                                    : std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < std::min(num_threads, num_segments); i++) {
+    threads.emplace_back(plan_segments);
+  }
+  plan_segments();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  if (!std::all_of(is_segment_planned.begin(), is_segment_planned.end(), [](char is_planned) {
+        return is_planned;
+      })) {
+    return autoware_planning_msgs::Route();
+  }
+  route_.paths = std::move(segment_paths);
+  route_.route_sections = std::move(segment_route_sections);
+
+  return createRoute();
+}
+
+autoware_planning_msgs::Route MissionPlannerLanelet2::planReroute(
+  const geometry_msgs::PoseStamped & current_pose)
+{
+  if (route_.paths.empty() || route_.paths.size() + 1 != checkpoints_.size()) {
+    ROS_WARN("There is no route to repair. Planning the whole route");
+    checkpoints_.front() = current_pose;
+    return planRoute();
+  }
+
+  lanelet::Lanelet current_lanelet;
+  if (!getClosestLanelet(current_pose.pose, lanelet_map_ptr_, &current_lanelet)) {
+    return autoware_planning_msgs::Route();
+  }
+
+  std::vector<std::size_t> segment_ids;
+  if (!repairRoute(
+        lanelet_map_ptr_, routing_graph_ptr_, blocked_lanelet_ids_, current_lanelet,
+        route_progress_, &route_, &segment_ids)) {
+    ROS_WARN("Previous route can not be repaired. Planning the whole route");
+    // the checkpoints of the segments the vehicle has finished are not planned again
+    checkpoints_.erase(checkpoints_.begin(), checkpoints_.begin() + route_progress_.segment);
+    checkpoints_.front() = current_pose;
+    return planRoute();
+  }
 
-    ROS_INFO_STREAM("planFullCoveragePath is compeleted!" << std::endl);
+  // the repaired route starts at the vehicle and skips the checkpoints of dropped segments
+  std::vector<geometry_msgs::PoseStamped> checkpoints{current_pose};
+  for (std::size_t i = 1; i < segment_ids.size(); i++) {
+    checkpoints.push_back(checkpoints_.at(segment_ids.at(i)));
+  }
+  checkpoints.push_back(checkpoints_.back());
+  checkpoints_ = checkpoints;
+  route_progress_ = RoutePosition();
+
+  ROS_INFO_STREAM(
+    "rerouted from lanelet " << current_lanelet.id() << " around "
+                             << blocked_lanelet_ids_.size() << " blocked lanelets");
+  return createRoute();
+}
+
+bool MissionPlannerLanelet2::planSegment(
+  const geometry_msgs::PoseStamped & start_checkpoint,
+  const geometry_msgs::PoseStamped & goal_checkpoint, lanelet::ConstLanelets * path_lanelets_ptr,
+  RouteSections * route_sections_ptr) const
+{
+  if (!planFullCoveragePath(start_checkpoint, goal_checkpoint, path_lanelets_ptr)) {
+    return false;
+  }
+
+  ROS_INFO_STREAM("planFullCoveragePath is compeleted!" << std::endl);
 
-    RouteHandler route_handler(lanelet_map_ptr_, routing_graph_ptr_, path_lanelets);
-    // const auto main_lanelets = getMainLanelets(path_lanelets, route_handler);
+  RouteHandler route_handler(lanelet_map_ptr_, routing_graph_ptr_, *path_lanelets_ptr);
+  // const auto main_lanelets = getMainLanelets(path_lanelets, route_handler);
 
-    // //  create routesections
-    const auto local_route_sections = createRouteSections(path_lanelets, route_handler);
+  // //  create routesections
+  *route_sections_ptr = createRouteSections(*path_lanelets_ptr, route_handler);
+  return true;
+}
+
+autoware_planning_msgs::Route MissionPlannerLanelet2::createRoute() const
+{
+  RouteSections route_sections;
+  for (const auto & local_route_sections : route_.route_sections) {
     route_sections = combineConsecutiveRouteSections(route_sections, local_route_sections);
   }
 
@@ -263,6 +408,7 @@ autoware_planning_msgs::Route MissionPlannerLanelet2::planRoute()
     ROS_WARN("Loop detected within route! Be aware that looped route is not debugged!");
   }
 
+  autoware_planning_msgs::Route route_msg;
   route_msg.header.stamp = ros::Time::now();
   route_msg.header.frame_id = map_frame_;
   route_msg.route_sections = route_sections;
@@ -318,36 +464,14 @@ lanelet::ConstLanelets MissionPlannerLanelet2::getMainLanelets(
   return main_lanelets;
 }
 
-RouteSections MissionPlannerLanelet2::createRouteSections(
-  const lanelet::ConstLanelets & main_path, const RouteHandler & route_handler)
-{
-  RouteSections route_sections;
-
-  if (main_path.empty()) return route_sections;
-
-  for (const auto & main_llt : main_path) {
-    autoware_planning_msgs::RouteSection route_section_msg;
-    lanelet::ConstLanelets route_section_lanelets = route_handler.getNeighborsWithinRoute(main_llt);
-    route_section_msg.preferred_lane_id = main_llt.id();
-    for (const auto & section_llt : route_section_lanelets) {
-      route_section_msg.lane_ids.push_back(section_llt.id());
-      lanelet::ConstLanelet next_lanelet;
-      if (route_handler.getNextLaneletWithinRoute(section_llt, &next_lanelet)) {
-        route_section_msg.continued_lane_ids.push_back(section_llt.id());
-      }
-    }
-    route_sections.push_back(route_section_msg);
-  }
-  return route_sections;
-}
-
-// full coverage 
+// full coverage
 bool MissionPlannerLanelet2::planFullCoveragePath(
   const geometry_msgs::PoseStamped & start_checkpoint,
   const geometry_msgs::PoseStamped & goal_checkpoint,
   lanelet::ConstLanelets * path_lanelets_ptr) const
 {
-  clock_t begin = clock();
+  // wall time, segments are planned on several threads at once
+  const ros::WallTime begin = ros::WallTime::now();
 
   lanelet::Lanelet start_lanelet;
   if (!getClosestLanelet(start_checkpoint.pose, lanelet_map_ptr_, &start_lanelet)) {
@@ -358,84 +482,34 @@ bool MissionPlannerLanelet2::planFullCoveragePath(
     return false;
   }
 
-  // lanelet::ConstLanelet lanelet = lanelet_map_ptr_->laneletLayer.get();
-  lanelet::ConstLanelets full_coverage_path;
-  std::unordered_set<lanelet::Id> visited_lanelet;
-  std::stack<lanelet::ConstLanelet> dfs_stk;
-  // visited_lanelet.emplace(start_lanelet.id());
-  dfs_stk.push(start_lanelet);
-  full_coverage_path.push_back(start_lanelet);
-  while (!dfs_stk.empty())
-  // while(full_coverage_path.size() < 30)
-  {
-    lanelet::ConstLanelet pose_lanelet = full_coverage_path.back();    // the pose of vehicle now
-    lanelet::ConstLanelet cur_lanelet = dfs_stk.top(); // the lanelet that will be processed 
-    dfs_stk.pop();
-    
-    if(!visited_lanelet.count(cur_lanelet.id())){
-      // connect backtracking lanelet with current pose lanelet
-      if (pose_lanelet != cur_lanelet) {
-        lanelet::Optional<lanelet::routing::Route> back_route =
-          routing_graph_ptr_->getRoute(pose_lanelet, cur_lanelet, 0);
-        if (!back_route) {
-          ROS_ERROR_STREAM(
-            "Failed to find a proper back_route!"
-            << std::endl
-            << "start lane id: " << pose_lanelet.id() << std::endl
-            << "goal lane id: " << cur_lanelet.id() << std::endl);
-          return false;
-        }
-        const lanelet::routing::LaneletPath back_path = back_route->shortestPath();
-        full_coverage_path.pop_back();
-        for (const auto& llt : back_path) {
-          if(!visited_lanelet.count(llt.id())){
-            visited_lanelet.emplace(llt.id());
-          }
-          full_coverage_path.push_back(llt);
-          lanelet::ConstLanelets following_llts = routing_graph_ptr_->following(llt);
-          for (const auto & following_llt : following_llts){
-            dfs_stk.push(following_llt);
-          }
-        }
-      }
-
-      lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(cur_lanelet);
-      for (const auto & following_llt : following_lanelets){
-        dfs_stk.push(following_llt);
-      }
-      
-      visited_lanelet.emplace(cur_lanelet.id());
-      full_coverage_path.push_back(cur_lanelet);
-    }
-  }
-  // go to the goal lanelet
-  lanelet::Optional<lanelet::routing::Route> last_route =
-            routing_graph_ptr_->getRoute(full_coverage_path.back(), goal_lanelet, 0);
-  if (!last_route) {
+  // path through every lanelet that can be reached from the start lanelet by following lanelets,
+  // ending at the goal lanelet. Lanelets that are only reachable by lane changes are not covered.
+  const lanelet::Optional<lanelet::routing::CoveragePath> coverage =
+    routing_graph_ptr_->coveragePath(start_lanelet, goal_lanelet, 0, false);
+  if (!coverage) {
     ROS_ERROR_STREAM(
-      "Failed to find a proper back_route!"
+      "Failed to find a proper full coverage path!"
       << std::endl
-      << "start lane id: " << full_coverage_path.back().id() << std::endl
+      << "start lane id: " << start_lanelet.id() << std::endl
       << "goal lane id: " << goal_lanelet.id() << std::endl);
     return false;
   }
-  const lanelet::routing::LaneletPath last_path = last_route->shortestPath();
-  full_coverage_path.pop_back();
-  for (const auto& llt : last_path) {
-    if(!visited_lanelet.count(llt.id())){
-      visited_lanelet.emplace(llt.id());
+  if (!coverage->uncovered.empty()) {
+    std::stringstream ss;
+    for (const auto & llt : coverage->uncovered) {
+      ss << llt.id() << " ";
     }
-    full_coverage_path.push_back(llt);
+    ROS_WARN_STREAM(
+      "Full coverage path can not pass " << coverage->uncovered.size()
+                                         << " reachable lanelets: " << ss.str());
   }
 
-  clock_t end = clock();
-  double elapsed_secs = static_cast<double>(end - begin) / CLOCKS_PER_SEC;
-  std::cout << "elapsed time: " << elapsed_secs << "\n";
+  ROS_INFO_STREAM("elapsed time: " << (ros::WallTime::now() - begin).toSec());
 
   ROS_INFO_STREAM("laneletLayer size: " << lanelet_map_ptr_->laneletLayer.size());
-  ROS_INFO_STREAM("visited_lanelet_set size: " << visited_lanelet.size());
-  ROS_INFO_STREAM("full_coverage_path size: " << full_coverage_path.size() << std::endl);
-  for (const auto & llt : full_coverage_path) {
+  ROS_INFO_STREAM("full_coverage_path size: " << coverage->path.size());
+  ROS_INFO_STREAM("full_coverage_path cost: " << coverage->cost << std::endl);
+  for (const auto & llt : coverage->path) {
     path_lanelets_ptr->push_back(llt);
     ROS_INFO_STREAM("path_lanelets_ptr id [" << path_lanelets_ptr->size() <<"] : "<< llt.id());
   }
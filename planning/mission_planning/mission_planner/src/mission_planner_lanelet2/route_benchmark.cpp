@@ -0,0 +1,159 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mission_planner/lanelet2_impl/route_handler.h>
+#include <mission_planner/lanelet2_impl/route_repair.h>
+#include <mission_planner/lanelet2_impl/route_sections.h>
+
+#include <lanelet2_extension/projection/mgrs_projector.h>
+
+#include <lanelet2_io/Io.h>
+#include <lanelet2_routing/RoutingCostOverlay.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Measures the wall time of the steps the mission planner runs for every checkpoint segment on the
+// full coverage path between two lanelets of a map. Then the given lanelets (by default the one in
+// the middle of the path) are blocked, and repairing the route from a quarter of the path is
+// compared to planning the rest of it from scratch.
+// usage: mission_planner_route_benchmark <map.osm> <start lanelet id> <goal lanelet id>
+//          [cycles [blocked lanelet ids...]]
+
+namespace
+{
+template <typename Func>
+double measureMilliseconds(const int cycles, Func && func)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < cycles; i++) {
+    func();
+  }
+  const std::chrono::duration<double, std::milli> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / cycles;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc < 4) {
+    std::cerr << "usage: " << argv[0]
+              << " <map.osm> <start lanelet id> <goal lanelet id> [cycles [blocked lanelet ids...]]"
+              << std::endl;
+    return 1;
+  }
+  const lanelet::Id start_id = std::atoll(argv[2]);
+  const lanelet::Id goal_id = std::atoll(argv[3]);
+  const int cycles = argc > 4 ? std::atoi(argv[4]) : 10;
+
+  lanelet::ErrorMessages errors;
+  lanelet::projection::MGRSProjector projector;
+  const lanelet::LaneletMapPtr lanelet_map_ptr =
+    lanelet::load(argv[1], "autoware_osm_handler", projector, &errors);
+  const auto traffic_rules_ptr = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  const lanelet::routing::RoutingGraphPtr routing_graph_ptr =
+    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr, *traffic_rules_ptr);
+
+  // the planner covers the lanelets that can be reached without lane changes
+  const auto coverage = routing_graph_ptr->coveragePath(
+    lanelet_map_ptr->laneletLayer.get(start_id), lanelet_map_ptr->laneletLayer.get(goal_id), 0,
+    false);
+  if (!coverage) {
+    std::cerr << "lanelet " << goal_id << " can not be reached from " << start_id << std::endl;
+    return 1;
+  }
+  const lanelet::ConstLanelets path_lanelets(coverage->path.begin(), coverage->path.end());
+
+  const double coverage_ms = measureMilliseconds(cycles, [&]() {
+    routing_graph_ptr->coveragePath(path_lanelets.front(), path_lanelets.back(), 0, false);
+  });
+  const double route_handler_ms = measureMilliseconds(cycles, [&]() {
+    mission_planner::RouteHandler(lanelet_map_ptr, routing_graph_ptr, path_lanelets);
+  });
+  const mission_planner::RouteHandler route_handler(
+    lanelet_map_ptr, routing_graph_ptr, path_lanelets);
+  const double route_sections_ms = measureMilliseconds(cycles, [&]() {
+    mission_planner::createRouteSections(path_lanelets, route_handler);
+  });
+
+  std::cout << "lanelets in map: " << lanelet_map_ptr->laneletLayer.size()
+            << ", coverage path: " << path_lanelets.size()
+            << ", route: " << route_handler.getRouteLanelets().size() << ", cycles: " << cycles
+            << std::endl;
+  std::cout << "wall time [ms] coverage path: " << coverage_ms
+            << ", RouteHandler: " << route_handler_ms
+            << ", createRouteSections: " << route_sections_ms << std::endl;
+
+  std::unordered_set<lanelet::Id> blocked_lanelet_ids;
+  for (int i = 5; i < argc; i++) {
+    blocked_lanelet_ids.insert(std::atoll(argv[i]));
+  }
+  if (blocked_lanelet_ids.empty()) {
+    blocked_lanelet_ids.insert(path_lanelets.at(path_lanelets.size() / 2).id());
+  }
+  routing_graph_ptr->updateCostOverlay([&](lanelet::routing::RoutingCostOverlay & overlay) {
+    for (const auto & id : blocked_lanelet_ids) {
+      overlay.set(id, lanelet::routing::CostModification::blocked());
+    }
+  });
+
+  // the vehicle has driven a quarter of the route
+  const mission_planner::RoutePosition progress{0, path_lanelets.size() / 4};
+  const lanelet::ConstLanelet current_lanelet = path_lanelets.at(progress.index);
+  mission_planner::SegmentedRoute route;
+  route.paths.push_back(path_lanelets);
+  route.route_sections.push_back(
+    mission_planner::createRouteSections(path_lanelets, route_handler));
+  std::vector<mission_planner::SegmentedRoute> routes(cycles, route);
+  std::vector<std::size_t> segment_ids;
+  bool is_repaired = true;
+  int cycle = 0;
+  const double reroute_ms = measureMilliseconds(cycles, [&]() {
+    is_repaired &= mission_planner::repairRoute(
+      lanelet_map_ptr, routing_graph_ptr, blocked_lanelet_ids, current_lanelet, progress,
+      &routes.at(cycle++), &segment_ids);
+  });
+  if (!is_repaired) {
+    std::cerr << "the route can not be repaired around the blocked lanelets" << std::endl;
+    return 1;
+  }
+  bool is_replanned = true;
+  const double replan_ms = measureMilliseconds(cycles, [&]() {
+    const auto replanned =
+      routing_graph_ptr->coveragePath(current_lanelet, path_lanelets.back(), 0, false);
+    is_replanned &= !!replanned;
+    if (replanned) {
+      const lanelet::ConstLanelets replanned_path(replanned->path.begin(), replanned->path.end());
+      const mission_planner::RouteHandler replanned_route_handler(
+        lanelet_map_ptr, routing_graph_ptr, replanned_path);
+      mission_planner::createRouteSections(replanned_path, replanned_route_handler);
+    }
+  });
+
+  std::cout << "blocked lanelets: " << blocked_lanelet_ids.size()
+            << ", repaired path: " << routes.front().paths.front().size() << std::endl;
+  std::cout << "wall time [ms] reroute: " << reroute_ms << ", full replan"
+            << (is_replanned ? "" : " (failed)") << ": " << replan_ms << std::endl;
+  return 0;
+}
@@ -17,6 +17,8 @@
 #include <mission_planner/lanelet2_impl/route_handler.h>
 #include <ros/ros.h>
 
+#include <algorithm>
+
 namespace mission_planner
 {
 RouteHandler::RouteHandler(
@@ -41,6 +43,12 @@ void RouteHandler::setRouteLanelets(
     auto last_lanelet = path_lanelets.back();
     goal_lanelets_ = lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, last_lanelet);
   }
+  for (const auto & llt : start_lanelets_) {
+    start_lanelet_ids_.insert(llt.id());
+  }
+  for (const auto & llt : goal_lanelets_) {
+    goal_lanelet_ids_.insert(llt.id());
+  }
 
   // set route lanelets
   std::unordered_set<lanelet::Id> route_lanelets_id;
@@ -71,7 +79,7 @@ void RouteHandler::setRouteLanelets(
     auto previous_lanelets = routing_graph_ptr_->previous(lanelet);
     bool is_connected_to_main_lanes_prev = false;
     bool is_connected_to_candidate_prev = true;
-    if (exists(start_lanelets_, lanelet)) {
+    if (exists(start_lanelet_ids_, lanelet.id())) {
       is_connected_to_candidate_prev = false;
     }
     while (!previous_lanelets.empty() && is_connected_to_candidate_prev &&
@@ -83,7 +91,7 @@ void RouteHandler::setRouteLanelets(
           is_connected_to_main_lanes_prev = true;
           break;
         }
-        if (exists(start_lanelets_, prev_lanelet)) {
+        if (exists(start_lanelet_ids_, prev_lanelet.id())) {
           break;
         }
 
@@ -98,7 +106,7 @@ void RouteHandler::setRouteLanelets(
     auto following_lanelets = routing_graph_ptr_->following(lanelet);
     bool is_connected_to_main_lanes_next = false;
     bool is_connected_to_candidate_next = true;
-    if (exists(goal_lanelets_, lanelet)) {
+    if (exists(goal_lanelet_ids_, lanelet.id())) {
       is_connected_to_candidate_next = false;
     }
     while (!following_lanelets.empty() && is_connected_to_candidate_next &&
@@ -109,7 +117,7 @@ void RouteHandler::setRouteLanelets(
           is_connected_to_main_lanes_next = true;
           break;
         }
-        if (exists(goal_lanelets_, next_lanelet)) {
+        if (exists(goal_lanelet_ids_, next_lanelet.id())) {
           break;
         }
         if (candidate_lanes_id.find(next_lanelet.id()) != candidate_lanes_id.end()) {
@@ -128,82 +136,123 @@ void RouteHandler::setRouteLanelets(
   for (const auto & id : route_lanelets_id) {
     route_lanelets_.push_back(lanelet_map_ptr_->laneletLayer.get(id));
   }
-}
+  route_lanelet_ids_ = std::move(route_lanelets_id);
 
-lanelet::ConstLanelets RouteHandler::getRouteLanelets() const { return route_lanelets_; }
+  setLookupTables();
+}
 
-lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
-  const lanelet::ConstLanelet & lanelet) const
+void RouteHandler::setLookupTables()
 {
-  lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lanelet_sequence_forward;
-  }
-
-  lanelet_sequence_forward.push_back(lanelet);
-
-  lanelet::ConstLanelet current_lanelet = lanelet;
-  while (ros::ok()) {
+  for (const auto & llt : route_lanelets_) {
     lanelet::ConstLanelet next_lanelet;
-    if (!getNextLaneletWithinRoute(current_lanelet, &next_lanelet)) {
-      break;
+    if (findNextLaneletWithinRoute(llt, &next_lanelet)) {
+      next_lanelets_.emplace(llt.id(), next_lanelet);
     }
-    lanelet_sequence_forward.push_back(next_lanelet);
-    current_lanelet = next_lanelet;
+    lanelet::ConstLanelet prev_lanelet;
+    if (findPreviousLaneletWithinRoute(llt, &prev_lanelet)) {
+      previous_lanelets_.emplace(llt.id(), prev_lanelet);
+    }
+    neighbors_within_route_.emplace(llt.id(), findNeighborsWithinRoute(llt));
   }
-
-  return lanelet_sequence_forward;
 }
 
-lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
-  const lanelet::ConstLanelet & lanelet) const
+// Sequences are walked through the lookup tables on demand instead of being stored for every
+// lanelet: on looped routes (e.g. coverage tours) every lanelet has a different sequence, and
+// storing them all is quadratic. The getters copy the sequence anyway.
+template <typename NextT, typename PreviousT>
+lanelet::ConstLanelets RouteHandler::buildSequence(
+  const lanelet::ConstLanelet & lanelet, const NextT & get_next, const PreviousT & get_previous,
+  size_t * position) const
 {
-  lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lanelet_sequence_backward;
-  }
-
+  // follow the links in both directions, a lanelet is never added twice in case of loops
+  std::unordered_set<lanelet::Id> visited{lanelet.id()};
+  lanelet::ConstLanelets lanelet_sequence_forward{lanelet};
   lanelet::ConstLanelet current_lanelet = lanelet;
-  while (ros::ok()) {
-    lanelet::ConstLanelet prev_lanelet;
-    if (!getPreviousLaneletWithinRoute(current_lanelet, &prev_lanelet)) {
-      break;
-    }
-    lanelet_sequence_backward.push_back(prev_lanelet);
-    current_lanelet = prev_lanelet;
+  lanelet::ConstLanelet linked_lanelet;
+  while (get_next(current_lanelet, &linked_lanelet) &&
+         visited.insert(linked_lanelet.id()).second) {
+    lanelet_sequence_forward.push_back(linked_lanelet);
+    current_lanelet = linked_lanelet;
   }
-
-  std::reverse(lanelet_sequence_backward.begin(), lanelet_sequence_backward.end());
-  return lanelet_sequence_backward;
+  lanelet::ConstLanelets lanelet_sequence;
+  current_lanelet = lanelet;
+  while (get_previous(current_lanelet, &linked_lanelet) &&
+         visited.insert(linked_lanelet.id()).second) {
+    lanelet_sequence.push_back(linked_lanelet);
+    current_lanelet = linked_lanelet;
+  }
+  std::reverse(lanelet_sequence.begin(), lanelet_sequence.end());
+  *position = lanelet_sequence.size();
+  lanelet_sequence.insert(
+    lanelet_sequence.end(), lanelet_sequence_forward.begin(), lanelet_sequence_forward.end());
+  return lanelet_sequence;
 }
 
-lanelet::ConstLanelets RouteHandler::getLaneletSequence(const lanelet::ConstLanelet & lanelet) const
+lanelet::ConstLanelets RouteHandler::buildLaneletSequence(
+  const lanelet::ConstLanelet & lanelet, size_t * position) const
 {
-  lanelet::ConstLanelets lanelet_sequence;
-  lanelet::ConstLanelets lanelet_sequence_backward;
-  lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lanelet_sequence;
+  if (!exists(route_lanelet_ids_, lanelet.id())) {
+    return lanelet::ConstLanelets();
   }
+  return buildSequence(
+    lanelet,
+    [this](const lanelet::ConstLanelet & llt, lanelet::ConstLanelet * next_lanelet) {
+      return getNextLaneletWithinRoute(llt, next_lanelet);
+    },
+    [this](const lanelet::ConstLanelet & llt, lanelet::ConstLanelet * prev_lanelet) {
+      return getPreviousLaneletWithinRoute(llt, prev_lanelet);
+    },
+    position);
+}
 
-  lanelet_sequence_forward = getLaneletSequenceAfter(lanelet);
-  lanelet_sequence_backward = getLaneletSequenceUpTo(lanelet);
-
-  // loop check
-  if (lanelet_sequence_forward.empty() > 1 && lanelet_sequence_backward.empty() > 1) {
-    if (lanelet_sequence_backward.back().id() == lanelet_sequence_forward.front().id()) {
-      return lanelet_sequence_forward;
-    }
+lanelet::ConstLanelets RouteHandler::buildLaneSequence(
+  const lanelet::ConstLanelet & lanelet, size_t * position) const
+{
+  if (!exists(route_lanelet_ids_, lanelet.id())) {
+    return lanelet::ConstLanelets();
   }
+  return buildSequence(
+    lanelet,
+    // a lane continues between two lanelets if their sections map onto each other
+    [this](const lanelet::ConstLanelet & llt, lanelet::ConstLanelet * next_lanelet) {
+      return getNextLaneletWithinRoute(llt, next_lanelet) &&
+             isBijectiveConnection(
+               getNeighborsWithinRoute(llt), getNeighborsWithinRoute(*next_lanelet));
+    },
+    [this](const lanelet::ConstLanelet & llt, lanelet::ConstLanelet * prev_lanelet) {
+      return getPreviousLaneletWithinRoute(llt, prev_lanelet) &&
+             isBijectiveConnection(
+               getNeighborsWithinRoute(*prev_lanelet), getNeighborsWithinRoute(llt));
+    },
+    position);
+}
 
-  lanelet_sequence.insert(
-    lanelet_sequence.end(), lanelet_sequence_backward.begin(), lanelet_sequence_backward.end());
-  lanelet_sequence.insert(
-    lanelet_sequence.end(), lanelet_sequence_forward.begin(), lanelet_sequence_forward.end());
+lanelet::ConstLanelets RouteHandler::getRouteLanelets() const { return route_lanelets_; }
 
+lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  size_t position = 0;
+  auto lanelet_sequence = buildLaneletSequence(lanelet, &position);
+  lanelet_sequence.erase(lanelet_sequence.begin(), lanelet_sequence.begin() + position);
+  return lanelet_sequence;
+}
+
+lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  size_t position = 0;
+  auto lanelet_sequence = buildLaneletSequence(lanelet, &position);
+  lanelet_sequence.resize(position);
   return lanelet_sequence;
 }
 
+lanelet::ConstLanelets RouteHandler::getLaneletSequence(const lanelet::ConstLanelet & lanelet) const
+{
+  size_t position = 0;
+  return buildLaneletSequence(lanelet, &position);
+}
+
 lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
   const lanelet::ConstLanelets & lanelet_sequence) const
 {
@@ -211,7 +260,7 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
   if (lanelet_sequence.empty()) return previous_lanelet_sequence;
 
   auto first_lane = lanelet_sequence.front();
-  if (exists(start_lanelets_, first_lane)) {
+  if (exists(start_lanelet_ids_, first_lane.id())) {
     return previous_lanelet_sequence;
   }
 
@@ -236,79 +285,46 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
 
 lanelet::ConstLanelets RouteHandler::getLaneSequence(const lanelet::ConstLanelet & lanelet) const
 {
-  lanelet::ConstLanelets lane_sequence;
-  lanelet::ConstLanelets lane_sequence_up_to = getLaneSequenceUpTo(lanelet);
-  lanelet::ConstLanelets lane_sequence_after = getLaneSequenceAfter(lanelet);
-
-  lane_sequence.insert(lane_sequence.end(), lane_sequence_up_to.begin(), lane_sequence_up_to.end());
-  lane_sequence.insert(lane_sequence.end(), lane_sequence_after.begin(), lane_sequence_after.end());
-  return lane_sequence;
+  size_t position = 0;
+  return buildLaneSequence(lanelet, &position);
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneSequenceUpTo(
   const lanelet::ConstLanelet & lanelet) const
 {
-  lanelet::ConstLanelets lane_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lane_sequence_backward;
-  }
-
-  lanelet::ConstLanelet current_lanelet = lanelet;
-  while (ros::ok()) {
-    lanelet::ConstLanelet prev_lanelet;
-    if (!getPreviousLaneletWithinRoute(current_lanelet, &prev_lanelet)) {
-      break;
-    }
-
-    lanelet::ConstLanelets current_lanelet_section = getNeighborsWithinRoute(current_lanelet);
-    lanelet::ConstLanelets prev_lanelet_section = getNeighborsWithinRoute(prev_lanelet);
-    if (!isBijectiveConnection(prev_lanelet_section, current_lanelet_section)) {
-      break;
-    }
-    lane_sequence_backward.push_back(prev_lanelet);
-    current_lanelet = prev_lanelet;
-  }
-
-  std::reverse(lane_sequence_backward.begin(), lane_sequence_backward.end());
-  return lane_sequence_backward;
+  size_t position = 0;
+  auto lane_sequence = buildLaneSequence(lanelet, &position);
+  lane_sequence.resize(position);
+  return lane_sequence;
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneSequenceAfter(
   const lanelet::ConstLanelet & lanelet) const
 {
-  lanelet::ConstLanelets lane_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lane_sequence_forward;
-  }
-  lane_sequence_forward.push_back(lanelet);
-
-  lanelet::ConstLanelet current_lanelet = lanelet;
-  while (ros::ok()) {
-    lanelet::ConstLanelet next_lanelet;
-    if (!getNextLaneletWithinRoute(current_lanelet, &next_lanelet)) {
-      break;
-    }
+  size_t position = 0;
+  auto lane_sequence = buildLaneSequence(lanelet, &position);
+  lane_sequence.erase(lane_sequence.begin(), lane_sequence.begin() + position);
+  return lane_sequence;
+}
 
-    lanelet::ConstLanelets current_lanelet_section = getNeighborsWithinRoute(current_lanelet);
-    lanelet::ConstLanelets next_lanelet_section = getNeighborsWithinRoute(next_lanelet);
-    if (!isBijectiveConnection(current_lanelet_section, next_lanelet_section)) {
-      break;
-    }
-    lane_sequence_forward.push_back(next_lanelet);
-    current_lanelet = next_lanelet;
+lanelet::ConstLanelets RouteHandler::getNeighborsWithinRoute(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  const auto it = neighbors_within_route_.find(lanelet.id());
+  if (it != neighbors_within_route_.end() && exists(route_lanelet_ids_, lanelet.id())) {
+    return it->second;
   }
-
-  return lane_sequence_forward;
+  return findNeighborsWithinRoute(lanelet);
 }
 
-lanelet::ConstLanelets RouteHandler::getNeighborsWithinRoute(
+lanelet::ConstLanelets RouteHandler::findNeighborsWithinRoute(
   const lanelet::ConstLanelet & lanelet) const
 {
   lanelet::ConstLanelets neighbor_lanelets =
     lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, lanelet);
   lanelet::ConstLanelets neighbors_within_route;
   for (const auto & llt : neighbor_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (exists(route_lanelet_ids_, llt.id())) {
       neighbors_within_route.push_back(llt);
     }
   }
@@ -329,12 +345,40 @@ std::vector<lanelet::ConstLanelets> RouteHandler::getLaneSection(
 bool RouteHandler::getNextLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  if (!exists(route_lanelet_ids_, lanelet.id())) {
+    return findNextLaneletWithinRoute(lanelet, next_lanelet);
+  }
+  const auto it = next_lanelets_.find(lanelet.id());
+  if (it == next_lanelets_.end()) {
+    return false;
+  }
+  *next_lanelet = it->second;
+  return true;
+}
+
+bool RouteHandler::getPreviousLaneletWithinRoute(
+  const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
+{
+  if (!exists(route_lanelet_ids_, lanelet.id())) {
+    return findPreviousLaneletWithinRoute(lanelet, prev_lanelet);
+  }
+  const auto it = previous_lanelets_.find(lanelet.id());
+  if (it == previous_lanelets_.end()) {
+    return false;
+  }
+  *prev_lanelet = it->second;
+  return true;
+}
+
+bool RouteHandler::findNextLaneletWithinRoute(
+  const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
+{
+  if (exists(goal_lanelet_ids_, lanelet.id())) {
     return false;
   }
   lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
   for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt) && !exists(start_lanelets_, llt)) {
+    if (exists(route_lanelet_ids_, llt.id()) && !exists(start_lanelet_ids_, llt.id())) {
       *next_lanelet = llt;
       return true;
     }
@@ -342,15 +386,15 @@ bool RouteHandler::getNextLaneletWithinRoute(
   return false;
 }
 
-bool RouteHandler::getPreviousLaneletWithinRoute(
+bool RouteHandler::findPreviousLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  if (exists(start_lanelet_ids_, lanelet.id())) {
     return false;
   }
   lanelet::ConstLanelets previous_lanelets = routing_graph_ptr_->previous(lanelet);
   for (const auto & llt : previous_lanelets) {
-    if (exists(route_lanelets_, llt) && !(exists(goal_lanelets_, llt))) {
+    if (exists(route_lanelet_ids_, llt.id()) && !exists(goal_lanelet_ids_, llt.id())) {
       *prev_lanelet = llt;
       return true;
     }
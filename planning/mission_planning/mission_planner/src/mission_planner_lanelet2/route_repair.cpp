@@ -0,0 +1,237 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mission_planner/lanelet2_impl/route_handler.h>
+#include <mission_planner/lanelet2_impl/route_repair.h>
+#include <mission_planner/lanelet2_impl/utility_functions.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+// the segments of a route joined into one path, without the lanelets that two segments share
+struct FlatRoute
+{
+  lanelet::ConstLanelets lanelets;
+  RouteSections route_sections;
+  std::vector<std::size_t> segment_starts;
+  std::vector<std::size_t> segment_ids;
+};
+
+FlatRoute flattenRoute(
+  const mission_planner::SegmentedRoute & route, const mission_planner::RoutePosition & from)
+{
+  FlatRoute flat_route;
+  for (std::size_t i = from.segment; i < route.paths.size(); i++) {
+    const auto & path = route.paths.at(i);
+    const auto & route_sections = route.route_sections.at(i);
+    const std::size_t begin = i == from.segment ? from.index : 0;
+    const std::size_t end = i + 1 < route.paths.size() ? path.size() - 1 : path.size();
+    if (begin >= end) {
+      continue;
+    }
+    flat_route.segment_starts.push_back(flat_route.lanelets.size());
+    flat_route.segment_ids.push_back(i);
+    flat_route.lanelets.insert(
+      flat_route.lanelets.end(), path.begin() + begin, path.begin() + end);
+    flat_route.route_sections.insert(
+      flat_route.route_sections.end(), route_sections.begin() + begin,
+      route_sections.begin() + end);
+  }
+  return flat_route;
+}
+
+mission_planner::SegmentedRoute splitRoute(const FlatRoute & flat_route)
+{
+  mission_planner::SegmentedRoute route;
+  const auto & starts = flat_route.segment_starts;
+  for (std::size_t i = 0; i < starts.size(); i++) {
+    // every segment but the last ends at the first lanelet of the next one
+    const std::size_t end =
+      i + 1 < starts.size() ? starts.at(i + 1) + 1 : flat_route.lanelets.size();
+    route.paths.emplace_back(
+      flat_route.lanelets.begin() + starts.at(i), flat_route.lanelets.begin() + end);
+    route.route_sections.emplace_back(
+      flat_route.route_sections.begin() + starts.at(i), flat_route.route_sections.begin() + end);
+  }
+  return route;
+}
+
+// shortest path from the source to the earliest unblocked lanelet of the route at or after the
+// minimum index that can be reached
+bool findDetour(
+  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr,
+  const std::unordered_set<lanelet::Id> & blocked_lanelet_ids, const FlatRoute & flat_route,
+  const lanelet::ConstLanelet & source, const std::size_t min_index, std::size_t * target_index,
+  lanelet::ConstLanelets * detour_ptr)
+{
+  std::unordered_map<lanelet::Id, std::size_t> candidates;
+  for (std::size_t i = min_index; i < flat_route.lanelets.size(); i++) {
+    const auto id = flat_route.lanelets.at(i).id();
+    if (!exists(blocked_lanelet_ids, id)) {
+      candidates.emplace(id, i);
+    }
+  }
+
+  // blocked lanelets are never visited. The search ends early if the first candidate is reached.
+  // The source itself is no candidate: a later visit of it would skip everything in between.
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelet> predecessors;
+  std::size_t best_index = flat_route.lanelets.size();
+  lanelet::ConstLanelet best_lanelet;
+  routing_graph_ptr->forEachSuccessor(
+    source,
+    [&](const lanelet::routing::LaneletVisitInformation & info) -> bool {
+      if (info.lanelet == source) {
+        return true;
+      }
+      predecessors.emplace(info.lanelet.id(), info.predecessor);
+      const auto candidate = candidates.find(info.lanelet.id());
+      if (candidate != candidates.end() && candidate->second < best_index) {
+        best_index = candidate->second;
+        best_lanelet = info.lanelet;
+      }
+      return best_index != min_index;
+    },
+    true, 0);
+  if (best_index == flat_route.lanelets.size()) {
+    return false;
+  }
+
+  *target_index = best_index;
+  lanelet::ConstLanelet current_lanelet = best_lanelet;
+  detour_ptr->push_back(current_lanelet);
+  while (current_lanelet != source) {
+    current_lanelet = predecessors.at(current_lanelet.id());
+    detour_ptr->push_back(current_lanelet);
+  }
+  std::reverse(detour_ptr->begin(), detour_ptr->end());
+  return true;
+}
+
+// replaces the lanelets from first to last index by the detour. Checkpoints in between are skipped.
+void replaceByDetour(
+  const lanelet::LaneletMapConstPtr & lanelet_map_ptr,
+  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr, const std::size_t first_index,
+  const std::size_t last_index, const lanelet::ConstLanelets & detour, FlatRoute * flat_route_ptr)
+{
+  mission_planner::RouteHandler route_handler(lanelet_map_ptr, routing_graph_ptr, detour);
+  const auto detour_route_sections = mission_planner::createRouteSections(detour, route_handler);
+
+  auto & lanelets = flat_route_ptr->lanelets;
+  lanelets.erase(lanelets.begin() + first_index, lanelets.begin() + last_index + 1);
+  lanelets.insert(lanelets.begin() + first_index, detour.begin(), detour.end());
+  // the section of the last lanelet is kept, it belongs to the rest of the route
+  auto & route_sections = flat_route_ptr->route_sections;
+  route_sections.erase(
+    route_sections.begin() + first_index, route_sections.begin() + last_index);
+  route_sections.insert(
+    route_sections.begin() + first_index, detour_route_sections.begin(),
+    detour_route_sections.end() - 1);
+
+  std::vector<std::size_t> segment_starts;
+  std::vector<std::size_t> segment_ids;
+  for (std::size_t i = 0; i < flat_route_ptr->segment_starts.size(); i++) {
+    const std::size_t start = flat_route_ptr->segment_starts.at(i);
+    if (start > first_index && start < last_index) {
+      continue;
+    }
+    // segments behind the detour move with the end of it
+    segment_starts.push_back(
+      start <= first_index ? start : start - last_index + first_index + detour.size() - 1);
+    segment_ids.push_back(flat_route_ptr->segment_ids.at(i));
+  }
+  flat_route_ptr->segment_starts = segment_starts;
+  flat_route_ptr->segment_ids = segment_ids;
+}
+}  // anonymous namespace
+
+namespace mission_planner
+{
+bool findOnRoute(
+  const SegmentedRoute & route, const lanelet::ConstLanelet & lanelet, const RoutePosition & from,
+  RoutePosition * position)
+{
+  for (std::size_t i = from.segment; i < route.paths.size(); i++) {
+    const auto & path = route.paths.at(i);
+    for (std::size_t j = i == from.segment ? from.index : 0; j < path.size(); j++) {
+      if (path.at(j) == lanelet) {
+        position->segment = i;
+        position->index = j;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool repairRoute(
+  const lanelet::LaneletMapConstPtr & lanelet_map_ptr,
+  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr,
+  const std::unordered_set<lanelet::Id> & blocked_lanelet_ids,
+  const lanelet::ConstLanelet & current_lanelet, const RoutePosition & progress,
+  SegmentedRoute * route_ptr, std::vector<std::size_t> * segment_ids_ptr)
+{
+  RoutePosition vehicle_position = progress;
+  const bool is_on_route = findOnRoute(*route_ptr, current_lanelet, progress, &vehicle_position);
+  FlatRoute flat_route = flattenRoute(*route_ptr, vehicle_position);
+  if (flat_route.lanelets.empty()) {
+    return false;
+  }
+
+  std::size_t target_index = 0;
+  if (!is_on_route) {
+    lanelet::ConstLanelets rejoin_path;
+    if (!findDetour(
+          routing_graph_ptr, blocked_lanelet_ids, flat_route, current_lanelet, 0, &target_index,
+          &rejoin_path)) {
+      return false;
+    }
+    replaceByDetour(
+      lanelet_map_ptr, routing_graph_ptr, 0, target_index, rejoin_path, &flat_route);
+  }
+
+  // the vehicle is on the first lanelet. Blocked lanelets behind it are bypassed from the
+  // lanelet before them. If that one only leads into the blocked lanelets, e.g. a turn into a
+  // blocked road, the detour starts further back, but never behind the vehicle.
+  for (std::size_t i = 1; i < flat_route.lanelets.size(); i++) {
+    if (!exists(blocked_lanelet_ids, flat_route.lanelets.at(i).id())) {
+      continue;
+    }
+    std::size_t source_index = i;
+    lanelet::ConstLanelets detour;
+    bool is_found = false;
+    while (!is_found && source_index > 0) {
+      source_index--;
+      detour.clear();
+      is_found = findDetour(
+        routing_graph_ptr, blocked_lanelet_ids, flat_route, flat_route.lanelets.at(source_index),
+        i, &target_index, &detour);
+    }
+    if (!is_found) {
+      return false;
+    }
+    replaceByDetour(
+      lanelet_map_ptr, routing_graph_ptr, source_index, target_index, detour, &flat_route);
+    // continue behind the end of the detour
+    i = source_index + detour.size() - 1;
+  }
+
+  *route_ptr = splitRoute(flat_route);
+  *segment_ids_ptr = flat_route.segment_ids;
+  return true;
+}
+}  // namespace mission_planner
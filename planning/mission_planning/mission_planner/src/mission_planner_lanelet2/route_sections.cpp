@@ -0,0 +1,43 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mission_planner/lanelet2_impl/route_sections.h>
+
+namespace mission_planner
+{
+RouteSections createRouteSections(
+  const lanelet::ConstLanelets & main_path, const RouteHandler & route_handler)
+{
+  RouteSections route_sections;
+
+  if (main_path.empty()) return route_sections;
+
+  for (const auto & main_llt : main_path) {
+    autoware_planning_msgs::RouteSection route_section_msg;
+    lanelet::ConstLanelets route_section_lanelets = route_handler.getNeighborsWithinRoute(main_llt);
+    route_section_msg.preferred_lane_id = main_llt.id();
+    for (const auto & section_llt : route_section_lanelets) {
+      route_section_msg.lane_ids.push_back(section_llt.id());
+      lanelet::ConstLanelet next_lanelet;
+      if (route_handler.getNextLaneletWithinRoute(section_llt, &next_lanelet)) {
+        route_section_msg.continued_lane_ids.push_back(section_llt.id());
+      }
+    }
+    route_sections.push_back(route_section_msg);
+  }
+  return route_sections;
+}
+}  // namespace mission_planner